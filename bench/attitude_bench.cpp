@@ -0,0 +1,90 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+
+// Number of stars in a typical star tracker frame
+static const int kStars = 20;
+
+struct Observations {
+  explicit Observations(int n)
+      : bodies(RandomObjects<Vec3>(n)), references(RandomObjects<Vec3>(n)), weights(n, 1),
+        body(n), reference(n) {
+    const Quaternion q = Quaternion(0.9, 0.2, -0.3, 0.1).Normalize();
+    for (int i = 0; i < n; ++i) {
+      references[i].NormalizeInPlace();
+      bodies[i] = q.RotatePassive(references[i]) + bodies[i] * 1e-3;
+      bodies[i].NormalizeInPlace();
+      body.Set(i, bodies[i]);
+      reference.Set(i, references[i]);
+    }
+  }
+
+  std::vector<Vec3> bodies;
+  std::vector<Vec3> references;
+  std::vector<sfloat> weights;
+  Vec3Array body;
+  Vec3Array reference;
+};
+
+/*
+ * Accumulation of the attitude profile matrix from n observations, where n is the
+ * benchmark argument, either from interleaved vectors or from Vec3Arrays.
+ */
+static void BM_ProfileInterleaved(benchmark::State& state) {
+  const int n = state.range(0);
+  const Observations obs(n);
+  for (auto _ : state) {
+    AttitudeProfile profile(obs.bodies.data(), obs.references.data(), obs.weights.data(),
+                            n);
+    benchmark::DoNotOptimize(profile);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ProfileInterleaved)->Arg(1 << 10)->Arg(1 << 14);
+
+static void BM_ProfileBlocked(benchmark::State& state) {
+  const int n = state.range(0);
+  const Observations obs(n);
+  for (auto _ : state) {
+    AttitudeProfile profile;
+    profile.Add(obs.body, obs.reference, obs.weights.data());
+    benchmark::DoNotOptimize(profile);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ProfileBlocked)->Arg(1 << 10)->Arg(1 << 14);
+
+// Solvers, from the profile of a single frame
+template <AttitudeEstimate (AttitudeProfile::*Solve)() const>
+static void BM_Solve(benchmark::State& state) {
+  const Observations obs(kStars);
+  const AttitudeProfile profile(obs.bodies.data(), obs.references.data(),
+                                obs.weights.data(), kStars);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize((profile.*Solve)());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Solve, &AttitudeProfile::Quest);
+BENCHMARK_TEMPLATE(BM_Solve, &AttitudeProfile::Esoq2);
+BENCHMARK_TEMPLATE(BM_Solve, &AttitudeProfile::DavenportQ);
+
+// A frame from its observations to the attitude and its covariance
+static void BM_QuestFrame(benchmark::State& state) {
+  const Observations obs(kStars);
+  for (auto _ : state) {
+    const AttitudeProfile profile(obs.bodies.data(), obs.references.data(),
+                                  obs.weights.data(), kStars);
+    benchmark::DoNotOptimize(profile.Quest());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuestFrame);
@@ -0,0 +1,135 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "star/typedefs.h"
+
+// Registers a benchmark for a single call and for batches of calls on distinct data
+#define STAR_BENCHMARK(func) BENCHMARK(func)->Arg(1)->Arg(64)->Arg(4096)
+
+// Defines and registers BM_<kernel>, which calls a kernel taking only sfloat arrays, given
+// the number of elements in each of its arguments
+#define STAR_BENCHMARK_KERNEL(kernel, ...)                     \
+  static void BM_##kernel(benchmark::State& state) {           \
+    star::bench::BenchArrays<__VA_ARGS__>(state, kernel);      \
+  }                                                            \
+  STAR_BENCHMARK(BM_##kernel)
+
+namespace star::bench {
+
+/*
+ * n contiguous arrays of `size` random values in [-1, 1], so that consecutive calls in a
+ * batch work on different data.
+ */
+class Batch {
+ public:
+  Batch(int size, int n) : size_(size), data_(size * n) {
+    std::mt19937 gen(size * 7919 + n);
+    std::uniform_real_distribution<sfloat> dist(-1, 1);
+    for (sfloat& x : data_) {
+      x = dist(gen);
+    }
+  }
+
+  sfloat* operator[](int i) { return data_.data() + size_ * i; }
+  int Count() const { return data_.size() / size_; }
+
+  // Normalizes every array, e.g. to get unit quaternions
+  Batch& Normalize() {
+    for (int i = 0; i < Count(); ++i) {
+      sfloat* x = (*this)[i];
+      sfloat norm2 = 0;
+      for (int k = 0; k < size_; ++k) {
+        norm2 += x[k] * x[k];
+      }
+      sfloat inv_norm = 1 / std::sqrt(norm2);
+      for (int k = 0; k < size_; ++k) {
+        x[k] *= inv_norm;
+      }
+    }
+    return *this;
+  }
+
+  // Replaces every 3x3 matrix A with the positive definite matrix A A^T + I
+  Batch& PositiveDefinite33() {
+    for (int i = 0; i < Count(); ++i) {
+      sfloat* A = (*this)[i];
+      sfloat P[9];
+      for (int c = 0; c < 3; ++c) {
+        for (int r = 0; r < 3; ++r) {
+          P[r + 3 * c] = (r == c);
+          for (int k = 0; k < 3; ++k) {
+            P[r + 3 * c] += A[r + 3 * k] * A[c + 3 * k];
+          }
+        }
+      }
+      std::copy(P, P + 9, A);
+    }
+    return *this;
+  }
+
+ private:
+  int size_;
+  std::vector<sfloat> data_;
+};
+
+/*
+ * Calls kernel(i) for i in [0, n), where n is the benchmark argument, and reports the
+ * throughput in calls per second. The time per call is the time per iteration divided by n.
+ */
+template <class Kernel>
+void RunBatch(benchmark::State& state, Kernel kernel) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      if constexpr (std::is_void_v<decltype(kernel(i))>) {
+        kernel(i);
+      } else {
+        benchmark::DoNotOptimize(kernel(i));
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <int... Sizes, class Kernel, size_t... I>
+void BenchArrays(benchmark::State& state, Kernel kernel, std::index_sequence<I...>) {
+  const int n = state.range(0);
+  std::array<Batch, sizeof...(Sizes)> args = {Batch(Sizes, n)...};
+  RunBatch(state, [&](int i) { return kernel(args[I][i]...); });
+}
+
+// Benchmarks a kernel whose arguments are sfloat arrays with the given numbers of elements
+template <int... Sizes, class Kernel>
+void BenchArrays(benchmark::State& state, Kernel kernel) {
+  BenchArrays<Sizes...>(state, kernel, std::make_index_sequence<sizeof...(Sizes)>());
+}
+
+/*
+ * n random objects of a star type, such as Vec3 or Mat3, with elements in [-1, 1]
+ */
+template <class T>
+std::vector<T> RandomObjects(int n) {
+  Batch batch(T::kSize, n);
+  std::vector<T> objects(n);
+  for (int i = 0; i < n; ++i) {
+    std::copy(batch[i], batch[i] + T::kSize, objects[i].data());
+  }
+  return objects;
+}
+
+}  // namespace star::bench
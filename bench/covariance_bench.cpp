@@ -0,0 +1,72 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "star/star.hpp"
+
+using namespace star;
+
+/*
+ * Propagates the covariances of n landmarks, P = A P A^T, with two general matrix products,
+ * with the fused kernel, and with the batched kernel.
+ */
+
+static void MakeLandmarks(std::vector<Mat3>& A, std::vector<Mat3>& P, int n) {
+  A.resize(n);
+  P.resize(n);
+  for (int i = 0; i < n; ++i) {
+    A[i] = Mat3::ByRows(1, 0.01 * i, 0, -0.01 * i, 1, 0.02, 0, -0.02, 1);
+    P[i] = Mat3::Diagonal(1 + 0.1 * i, 2, 3);
+  }
+}
+
+static void BM_Covariance_MatMul(benchmark::State& state) {
+  const int n = state.range(0);
+  std::vector<Mat3> A;
+  std::vector<Mat3> P;
+  MakeLandmarks(A, P, n);
+  std::vector<Mat3> C(n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      C[i] = A[i] * P[i] * Transpose(A[i]);
+    }
+    benchmark::DoNotOptimize(C.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Covariance_MatMul)->Arg(1)->Arg(64)->Arg(4096);
+
+static void BM_Covariance_Fused(benchmark::State& state) {
+  const int n = state.range(0);
+  std::vector<Mat3> A;
+  std::vector<Mat3> P;
+  MakeLandmarks(A, P, n);
+  std::vector<Mat3> C(n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      C[i] = CongruenceTransform(A[i], P[i]);
+    }
+    benchmark::DoNotOptimize(C.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Covariance_Fused)->Arg(1)->Arg(64)->Arg(4096);
+
+static void BM_Covariance_Batch(benchmark::State& state) {
+  const int n = state.range(0);
+  std::vector<Mat3> A;
+  std::vector<Mat3> P;
+  MakeLandmarks(A, P, n);
+  std::vector<Mat3> C(n);
+  for (auto _ : state) {
+    CongruenceTransform(C.data(), A.data(), P.data(), n);
+    benchmark::DoNotOptimize(C.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Covariance_Batch)->Arg(1)->Arg(64)->Arg(4096);
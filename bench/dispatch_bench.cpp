@@ -0,0 +1,151 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+extern "C" {
+#include "star/star.h"
+}
+
+/*
+ * Runs the dispatched kernels with every instruction set supported by the host, selected
+ * with star_SetIsa. The argument is the star_Isa value.
+ */
+
+using star::bench::Batch;
+
+static bool SelectIsa(benchmark::State& state) {
+  star_Isa isa = static_cast<star_Isa>(state.range(0));
+  if (star_SetIsa(isa) != isa) {
+    state.SkipWithError("Instruction set not supported by the host");
+    return false;
+  }
+  state.SetLabel(star_IsaName(isa));
+  return true;
+}
+
+static void IsaArgs(benchmark::internal::Benchmark* bench) {
+  for (int isa = STAR_ISA_BASELINE; isa <= star_DetectIsa(); ++isa) {
+    bench->Arg(isa);
+  }
+}
+
+static void BM_MatMul44(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  sfloat A[16];
+  sfloat B[16];
+  sfloat C[16];
+  for (int i = 0; i < 16; ++i) {
+    A[i] = i + 1;
+    B[i] = 0.5 * i - 3;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A);
+    star_MatMul44(C, A, B);
+    benchmark::DoNotOptimize(C);
+  }
+}
+BENCHMARK(BM_MatMul44)->Apply(IsaArgs);
+
+static void BM_MatMul33(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  sfloat A[9] = {1, 2, 3, 4, 5, 6, 7, 8, 10};
+  sfloat B[9] = {-1, 0.5, 2, 3, -4, 1, 0, 2, 1};
+  sfloat C[9];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A);
+    star_MatMul33(C, A, B);
+    benchmark::DoNotOptimize(C);
+  }
+}
+BENCHMARK(BM_MatMul33)->Apply(IsaArgs);
+
+static void BM_MatMul443(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  sfloat A[16];
+  sfloat B[12];
+  sfloat C[12];
+  for (int i = 0; i < 16; ++i) {
+    A[i] = i + 1;
+  }
+  for (int i = 0; i < 12; ++i) {
+    B[i] = 0.5 * i - 3;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A);
+    star_MatMul443(C, A, B);
+    benchmark::DoNotOptimize(C);
+  }
+}
+BENCHMARK(BM_MatMul443)->Apply(IsaArgs);
+
+static void BM_QuatCompose(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  sfloat q1[4] = {0.5, 0.5, -0.5, 0.5};
+  sfloat q2[4] = {0.9, 0.1, 0.3, -0.3};
+  sfloat q3[4];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q1);
+    star_QuatCompose(q3, q1, q2);
+    benchmark::DoNotOptimize(q3);
+  }
+}
+BENCHMARK(BM_QuatCompose)->Apply(IsaArgs);
+
+static void BM_QuatRotateActive(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  sfloat q[4] = {0.5, 0.5, -0.5, 0.5};
+  sfloat v[3] = {1, -2, 3};
+  sfloat v_rot[3];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v);
+    star_QuatRotateActive(v_rot, q, v);
+    benchmark::DoNotOptimize(v_rot);
+  }
+}
+BENCHMARK(BM_QuatRotateActive)->Apply(IsaArgs);
+
+// Batched kernels, on 4096 problems
+static const int kBatch = 4096;
+
+static void BM_VecMulBatch33(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  Batch A(9, 1);
+  Batch x(kBatch, 3);
+  Batch y(kBatch, 3);
+  for (auto _ : state) {
+    star_VecMulBatch33(y[0], y[1], y[2], A[0], x[0], x[1], x[2], kBatch);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_VecMulBatch33)->Apply(IsaArgs);
+
+static void BM_CongruenceTransformBatch33(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  Batch A(9, kBatch);
+  Batch P(9, kBatch);
+  Batch C(9, kBatch);
+  for (auto _ : state) {
+    star_CongruenceTransformBatch33(C[0], A[0], P[0], kBatch);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_CongruenceTransformBatch33)->Apply(IsaArgs);
+
+static void BM_AttitudeProjectHessianBatch(benchmark::State& state) {
+  if (!SelectIsa(state)) return;
+  Batch P(9, kBatch);
+  Batch q(4, kBatch);
+  Batch H(16, kBatch);
+  q.Normalize();
+  for (auto _ : state) {
+    star_AttitudeProjectHessianBatch(P[0], q[0], H[0], kBatch);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_AttitudeProjectHessianBatch)->Apply(IsaArgs);
@@ -0,0 +1,97 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/Dual.hpp"
+#include "star/Quaternion.hpp"
+
+extern "C" {
+#include "star/quaternion.h"
+}
+
+using star::Dual;
+using star::Quat;
+using star::Vec3;
+using star::Vector;
+
+/*---------------------------------*/
+/* Gradient of a rotation cost     */
+/*---------------------------------*/
+// f(q) = |R(q) v - w|^2 through the class API, templated on the scalar type
+template <class T>
+static T RotationCost(const Quat<T>& q, const Vec3& v, const Vec3& w) {
+  const Vector<3, T> r = q.RotateActive({v.x, v.y, v.z});
+  T f = 0;
+  for (int i = 0; i < 3; ++i) {
+    f += (r[i] - w[i]) * (r[i] - w[i]);
+  }
+  return f;
+}
+
+// The value only, through Quaternion, as a baseline for the gradients
+static sfloat RotationCostValue(const sfloat q[4], const sfloat v[3], const sfloat w[3]) {
+  return RotationCost(star::Quaternion(q[0], q[1], q[2], q[3]), Vec3(v), Vec3(w));
+}
+STAR_BENCHMARK_KERNEL(RotationCostValue, 4, 3, 3);
+
+// The value and the gradient in a single forward pass of Quat<Dual<4>>
+static void RotationCostDual(sfloat grad[4], const sfloat q[4], const sfloat v[3],
+                             const sfloat w[3]) {
+  using D4 = Dual<4>;
+  const Quat<D4> qd(D4::Variable(q[0], 0), D4::Variable(q[1], 1), D4::Variable(q[2], 2),
+                    D4::Variable(q[3], 3));
+  const D4 f = RotationCost(qd, Vec3(v), Vec3(w));
+  for (int i = 0; i < 4; ++i) {
+    grad[i] = f.Grad(i);
+  }
+}
+STAR_BENCHMARK_KERNEL(RotationCostDual, 4, 4, 3, 3);
+
+// The gradient through the closed-form rotation Jacobian, 2 D^T (R(q) v - w)
+static void RotationCostAnalytic(sfloat grad[4], const sfloat q[4], const sfloat v[3],
+                                 const sfloat w[3]) {
+  sfloat r[3];
+  sfloat D[12];
+  star_QuatRotateActive(r, q, v);
+  star_QuatRotateActiveJacobian(D, q, v);
+  for (int j = 0; j < 4; ++j) {
+    grad[j] = 0;
+    for (int i = 0; i < 3; ++i) {
+      grad[j] += 2 * D[i + 3 * j] * (r[i] - w[i]);
+    }
+  }
+}
+STAR_BENCHMARK_KERNEL(RotationCostAnalytic, 4, 4, 3, 3);
+
+// The gradient from central differences, which takes 8 evaluations of the cost
+static void RotationCostFiniteDiff(sfloat grad[4], const sfloat q[4], const sfloat v[3],
+                                   const sfloat w[3]) {
+  const sfloat h = 1e-6;
+  for (int j = 0; j < 4; ++j) {
+    sfloat qp[4] = {q[0], q[1], q[2], q[3]};
+    sfloat qm[4] = {q[0], q[1], q[2], q[3]};
+    qp[j] += h;
+    qm[j] -= h;
+    grad[j] = (RotationCostValue(qp, v, w) - RotationCostValue(qm, v, w)) / (2 * h);
+  }
+}
+STAR_BENCHMARK_KERNEL(RotationCostFiniteDiff, 4, 4, 3, 3);
+
+/*---------------------------------*/
+/* Jacobian of the exponential map */
+/*---------------------------------*/
+static void QuatExpmDual(sfloat D[12], const sfloat phi[3]) {
+  using D3 = Dual<3>;
+  const Quat<D3> q = Quat<D3>::Expm(D3::Variable(phi[0], 0), D3::Variable(phi[1], 1),
+                                    D3::Variable(phi[2], 2));
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      D[i + 4 * j] = q[i].Grad(j);
+    }
+  }
+}
+STAR_BENCHMARK_KERNEL(QuatExpmDual, 12, 3);
+STAR_BENCHMARK_KERNEL(star_QuatExpmJacobian, 12, 3);
@@ -0,0 +1,101 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "star/star.hpp"
+
+extern "C" {
+#include "star/matrix4.h"
+}
+
+using namespace star;
+
+/*
+ * Evaluates y = a + 2 b - c / d with the eager methods, which create a temporary for every
+ * intermediate result, and with the lazy operators, which evaluate it in a single pass.
+ */
+
+static void BM_Vec3_Eager(benchmark::State& state) {
+  Vec3 a(1, 2, 3);
+  Vec3 b(4, 5, 6);
+  Vec3 c(-1, 0.5, 2);
+  Vec3 d(2, 4, 8);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Vec3 y = a.Add(Vec3::Const(2).Mul(b)).Sub(c.Div(d));
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK(BM_Vec3_Eager);
+
+static void BM_Vec3_Lazy(benchmark::State& state) {
+  Vec3 a(1, 2, 3);
+  Vec3 b(4, 5, 6);
+  Vec3 c(-1, 0.5, 2);
+  Vec3 d(2, 4, 8);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Vec3 y = a + 2.0 * b - c / d;
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK(BM_Vec3_Lazy);
+
+static void BM_Vec4_Eager(benchmark::State& state) {
+  Vec4 a(1, 2, 3, 4);
+  Vec4 b(4, 5, 6, 7);
+  Vec4 c(-1, 0.5, 2, 3);
+  Vec4 d(2, 4, 8, 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Vec4 y = a.Add(Vec4::Const(2).Mul(b)).Sub(c.Div(d));
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK(BM_Vec4_Eager);
+
+static void BM_Vec4_Lazy(benchmark::State& state) {
+  Vec4 a(1, 2, 3, 4);
+  Vec4 b(4, 5, 6, 7);
+  Vec4 c(-1, 0.5, 2, 3);
+  Vec4 d(2, 4, 8, 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Vec4 y = a + 2.0 * b - c / d;
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK(BM_Vec4_Lazy);
+
+// The matrices have no eager element-wise methods, so compare against the C kernels
+static void BM_Mat4_Eager(benchmark::State& state) {
+  Mat4 A = Mat4::Identity();
+  Mat4 B = Mat4::Const(2);
+  Mat4 C = Mat4::Diagonal(1, 2, 3, 4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A);
+    Mat4 tmp;
+    Mat4 Y;
+    star_MulConst44(tmp.data(), B.data(), 2);
+    star_Add44(Y.data(), A.data(), tmp.data());
+    star_MulConst44(tmp.data(), C.data(), 0.5);
+    star_Sub44(Y.data(), Y.data(), tmp.data());
+    benchmark::DoNotOptimize(Y);
+  }
+}
+BENCHMARK(BM_Mat4_Eager);
+
+static void BM_Mat4_Lazy(benchmark::State& state) {
+  Mat4 A = Mat4::Identity();
+  Mat4 B = Mat4::Const(2);
+  Mat4 C = Mat4::Diagonal(1, 2, 3, 4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A);
+    Mat4 Y = A + 2.0 * B - C / 2.0;
+    benchmark::DoNotOptimize(Y);
+  }
+}
+BENCHMARK(BM_Mat4_Lazy);
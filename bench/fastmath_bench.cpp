@@ -0,0 +1,67 @@
+//
+// Created by Brian Jackson on 5/15/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+}
+
+using star::bench::Batch;
+using star::bench::RunBatch;
+
+/*
+ * Benchmarks each accuracy tier of the functions in fastmath.h on random arguments, with
+ * the tier as the second benchmark argument.
+ */
+#define STAR_BENCHMARK_TIERS(func)                                             \
+  BENCHMARK(func)->ArgsProduct({{64, 4096},                                     \
+                                {STAR_FASTMATH_LIBM, STAR_FASTMATH_HIGH,        \
+                                 STAR_FASTMATH_LOW}})
+
+template <class Kernel>
+static void RunTiers(benchmark::State& state, Kernel kernel) {
+  const int tier = state.range(1);
+  switch (tier) {
+    case STAR_FASTMATH_HIGH:
+      kernel(std::integral_constant<int, STAR_FASTMATH_HIGH>());
+      break;
+    case STAR_FASTMATH_LOW:
+      kernel(std::integral_constant<int, STAR_FASTMATH_LOW>());
+      break;
+    default:
+      kernel(std::integral_constant<int, STAR_FASTMATH_LIBM>());
+  }
+  state.SetLabel(tier == STAR_FASTMATH_HIGH  ? "1e-12"
+                 : tier == STAR_FASTMATH_LOW ? "1e-7"
+                                             : "libm");
+}
+
+static void BM_SinCos(benchmark::State& state) {
+  Batch x(1, state.range(0));
+  Batch sc(2, state.range(0));
+  RunTiers(state, [&](auto tier) {
+    RunBatch(state, [&](int i) {
+      star_SinCosTier(4 * x[i][0], sc[i], sc[i] + 1, tier);
+    });
+  });
+}
+STAR_BENCHMARK_TIERS(BM_SinCos);
+
+static void BM_Atan2(benchmark::State& state) {
+  Batch yx(2, state.range(0));
+  RunTiers(state, [&](auto tier) {
+    RunBatch(state, [&](int i) { return star_Atan2Tier(yx[i][0], yx[i][1], tier); });
+  });
+}
+STAR_BENCHMARK_TIERS(BM_Atan2);
+
+static void BM_RSqrt(benchmark::State& state) {
+  Batch x(1, state.range(0));
+  RunTiers(state, [&](auto tier) {
+    RunBatch(state, [&](int i) { return star_RSqrtTier(2 + x[i][0], tier); });
+  });
+}
+STAR_BENCHMARK_TIERS(BM_RSqrt);
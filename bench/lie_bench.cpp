@@ -0,0 +1,115 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <cmath>
+
+#include "bench_utils.hpp"
+
+#include "star/matrix_kernels.hpp"
+
+extern "C" {
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+using star::bench::Batch;
+
+/*---------------------------------*/
+/* Generic implementations         */
+/*---------------------------------*/
+// J_l = I + a S + b S^2 with dense skew-symmetric matrices and a generic product
+static void SO3LeftJacobianGeneric(sfloat J[9], const sfloat phi[3]) {
+  sfloat theta = std::sqrt(phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2]);
+  sfloat a = (1 - std::cos(theta)) / (theta * theta);
+  sfloat b = (theta - std::sin(theta)) / (theta * theta * theta);
+  sfloat S[9];
+  sfloat SS[9];
+  star_SkewSymmetricMatrix(S, phi);
+  star::MatMul<3, 3, 3>(SS, S, S);
+  for (int k = 0; k < 9; ++k) {
+    J[k] = a * S[k] + b * SS[k] + (k % 4 == 0);
+  }
+}
+
+// The SE(3) left Jacobian with every product of the Q block formed densely
+static void SE3LeftJacobianGeneric(sfloat J[36], const sfloat xi[6]) {
+  const sfloat* phi = xi + 3;
+  sfloat theta2 = phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+  sfloat theta = std::sqrt(theta2);
+  sfloat s = std::sin(theta);
+  sfloat c = std::cos(theta);
+  sfloat b = (theta - s) / (theta2 * theta);
+  sfloat c2 = (theta2 + 2 * c - 2) / (2 * theta2 * theta2);
+  sfloat c3 = (2 * theta - 3 * s + theta * c) / (2 * theta2 * theta2 * theta);
+  sfloat J_rot[9];
+  sfloat S[9];
+  sfloat P[9];
+  sfloat SP[9];
+  sfloat PS[9];
+  sfloat SPS[9];
+  sfloat SSP[9];
+  sfloat PSS[9];
+  sfloat SPSS[9];
+  sfloat SSPS[9];
+  SO3LeftJacobianGeneric(J_rot, phi);
+  star_SkewSymmetricMatrix(S, phi);
+  star_SkewSymmetricMatrix(P, xi);
+  star::MatMul<3, 3, 3>(SP, S, P);
+  star::MatMul<3, 3, 3>(PS, P, S);
+  star::MatMul<3, 3, 3>(SPS, SP, S);
+  star::MatMul<3, 3, 3>(SSP, S, SP);
+  star::MatMul<3, 3, 3>(PSS, PS, S);
+  star::MatMul<3, 3, 3>(SPSS, SPS, S);
+  star::MatMul<3, 3, 3>(SSPS, S, SPS);
+  for (int j = 0; j < 6; ++j) {
+    for (int i = 0; i < 6; ++i) {
+      J[i + 6 * j] = 0;
+    }
+  }
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      int k = i + 3 * j;
+      J[i + 6 * j] = J_rot[k];
+      J[(i + 3) + 6 * (j + 3)] = J_rot[k];
+      J[i + 6 * (j + 3)] = P[k] / 2 + b * (SP[k] + PS[k] + SPS[k]) +
+                           c2 * (SSP[k] + PSS[k] - 3 * SPS[k]) + c3 * (SPSS[k] + SSPS[k]);
+    }
+  }
+}
+
+STAR_BENCHMARK_KERNEL(SO3LeftJacobianGeneric, 9, 3);
+STAR_BENCHMARK_KERNEL(SE3LeftJacobianGeneric, 36, 6);
+
+/*---------------------------------*/
+/* SO(3)                           */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SO3Expm, 9, 3);
+STAR_BENCHMARK_KERNEL(star_SO3LeftJacobian, 9, 3);
+STAR_BENCHMARK_KERNEL(star_SO3RightJacobian, 9, 3);
+STAR_BENCHMARK_KERNEL(star_SO3LeftJacobianInverse, 9, 3);
+STAR_BENCHMARK_KERNEL(star_SO3RightJacobianInverse, 9, 3);
+
+/*---------------------------------*/
+/* SE(3)                           */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SE3Expm, 4, 3, 6);
+STAR_BENCHMARK_KERNEL(star_SE3Logm, 6, 4, 3);
+STAR_BENCHMARK_KERNEL(star_SE3LeftJacobian, 36, 6);
+STAR_BENCHMARK_KERNEL(star_SE3RightJacobian, 36, 6);
+STAR_BENCHMARK_KERNEL(star_SE3LeftJacobianInverse, 36, 6);
+STAR_BENCHMARK_KERNEL(star_SE3RightJacobianInverse, 36, 6);
+
+// The batched kernels process a whole trajectory in a single call
+static void BM_star_SE3LeftJacobianBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch xi(6, n);
+  Batch J(36, n);
+  for (auto _ : state) {
+    star_SE3LeftJacobianBatch(J[0], xi[0], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_SE3LeftJacobianBatch);
@@ -0,0 +1,154 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+extern "C" {
+#include "star/matrix3.h"
+}
+
+using star::bench::Batch;
+using star::bench::BenchArrays;
+using star::bench::RunBatch;
+
+/*---------------------------------*/
+/* Setters                         */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SetZero33, 9);
+STAR_BENCHMARK_KERNEL(star_SetDiagonal33, 9, 3);
+STAR_BENCHMARK_KERNEL(star_Copy33, 9, 9);
+STAR_BENCHMARK_KERNEL(star_Transpose33, 9, 9);
+STAR_BENCHMARK_KERNEL(star_TransposeInPlace33, 9);
+
+static void BM_star_SetConst33(benchmark::State& state) {
+  BenchArrays<9>(state, [](sfloat* A) { star_SetConst33(A, 2); });
+}
+STAR_BENCHMARK(BM_star_SetConst33);
+
+static void BM_star_SetIdentity33(benchmark::State& state) {
+  BenchArrays<9>(state, [](sfloat* A) { star_SetIdentity33(A, 1); });
+}
+STAR_BENCHMARK(BM_star_SetIdentity33);
+
+/*---------------------------------*/
+/* Multiplication                  */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_MatMul33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_VecMul33, 3, 9, 3);
+STAR_BENCHMARK_KERNEL(star_TransposedMatMul33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_MatMulTransposed33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_TransposedVecMul33, 3, 9, 3);
+STAR_BENCHMARK_KERNEL(star_CongruenceTransform33, 9, 9, 9);
+
+// The batched kernels process the whole batch in a single call
+static void BM_star_VecMulBatch33(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch A(9, 1);
+  Batch x(n, 3);
+  Batch y(n, 3);
+  for (auto _ : state) {
+    star_VecMulBatch33(y[0], y[1], y[2], A[0], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_VecMulBatch33);
+
+static void BM_star_AffineMulBatch33(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch A(9, 1);
+  Batch b(3, 1);
+  Batch x(n, 3);
+  Batch y(n, 3);
+  for (auto _ : state) {
+    star_AffineMulBatch33(y[0], y[1], y[2], A[0], b[0], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_AffineMulBatch33);
+
+static void BM_star_CongruenceTransformBatch33(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch A(9, n);
+  Batch P(9, n);
+  Batch C(9, n);
+  for (auto _ : state) {
+    star_CongruenceTransformBatch33(C[0], A[0], P[0], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_CongruenceTransformBatch33);
+
+/*---------------------------------*/
+/* Triangular Matrices             */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_UpperMatMul33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_UpperVecMul33, 3, 9, 3);
+STAR_BENCHMARK_KERNEL(star_LowerMatMul33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_LowerVecMul33, 3, 9, 3);
+STAR_BENCHMARK_KERNEL(star_UpperTriSolve33, 3, 9, 3);
+STAR_BENCHMARK_KERNEL(star_LowerTriSolve33, 3, 9, 3);
+
+/*---------------------------------*/
+/* Decompositions                  */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_Det33, 9);
+STAR_BENCHMARK_KERNEL(star_QR33, 9, 9, 9);
+STAR_BENCHMARK_KERNEL(star_SVD33, 9, 3, 9, 9);
+
+static void BM_star_Chol33(benchmark::State& state) {
+  Batch U(9, state.range(0));
+  Batch P = Batch(9, state.range(0)).PositiveDefinite33();
+  RunBatch(state, [&](int i) { return star_Chol33(U[i], P[i]); });
+}
+STAR_BENCHMARK(BM_star_Chol33);
+
+static void BM_star_LU33(benchmark::State& state) {
+  Batch L(9, state.range(0));
+  Batch U(9, state.range(0));
+  Batch A(9, state.range(0));
+  int perm[3];
+  RunBatch(state, [&](int i) { star_LU33(L[i], U[i], perm, A[i]); });
+}
+STAR_BENCHMARK(BM_star_LU33);
+
+static void BM_star_Eigen33(benchmark::State& state) {
+  Batch lambda(3, state.range(0));
+  Batch V(9, state.range(0));
+  Batch P = Batch(9, state.range(0)).PositiveDefinite33();
+  RunBatch(state, [&](int i) { star_Eigen33(lambda[i], V[i], P[i]); });
+}
+STAR_BENCHMARK(BM_star_Eigen33);
+
+static void BM_star_CholSolve33(benchmark::State& state) {
+  Batch x(3, state.range(0));
+  Batch P = Batch(9, state.range(0)).PositiveDefinite33();
+  Batch b(3, state.range(0));
+  RunBatch(state, [&](int i) { return star_CholSolve33(x[i], P[i], b[i]); });
+}
+STAR_BENCHMARK(BM_star_CholSolve33);
+
+// The in-place inverses are applied to a copy, so every iteration inverts the same matrices
+static void BM_star_Inverse33(benchmark::State& state) {
+  Batch A(9, state.range(0));
+  Batch Ainv(9, state.range(0));
+  RunBatch(state, [&](int i) {
+    star_Copy33(Ainv[i], A[i]);
+    star_Inverse33(Ainv[i]);
+  });
+}
+STAR_BENCHMARK(BM_star_Inverse33);
+
+static void BM_star_InversePSD33(benchmark::State& state) {
+  Batch P = Batch(9, state.range(0)).PositiveDefinite33();
+  Batch Pinv(9, state.range(0));
+  RunBatch(state, [&](int i) {
+    star_Copy33(Pinv[i], P[i]);
+    return star_InversePSD33(Pinv[i]);
+  });
+}
+STAR_BENCHMARK(BM_star_InversePSD33);
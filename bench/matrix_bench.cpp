@@ -0,0 +1,81 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+extern "C" {
+#include "star/matrix4.h"
+#include "star/matrix43.h"
+}
+
+using star::bench::BenchArrays;
+
+/*---------------------------------*/
+/* 4x4 Matrices                    */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SetZero44, 16);
+STAR_BENCHMARK_KERNEL(star_SetDiagonal44, 16, 4);
+STAR_BENCHMARK_KERNEL(star_Copy44, 16, 16);
+STAR_BENCHMARK_KERNEL(star_Transpose44, 16, 16);
+STAR_BENCHMARK_KERNEL(star_TransposeInPlace44, 16);
+
+STAR_BENCHMARK_KERNEL(star_MatMul44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_VecMul44, 4, 16, 4);
+STAR_BENCHMARK_KERNEL(star_TransposedMatMul44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_MatMulTransposed44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_TransposedVecMul44, 4, 16, 4);
+
+STAR_BENCHMARK_KERNEL(star_Add44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_Sub44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_Mul44, 16, 16, 16);
+STAR_BENCHMARK_KERNEL(star_Div44, 16, 16, 16);
+
+static void BM_star_SetConst44(benchmark::State& state) {
+  BenchArrays<16>(state, [](sfloat* A) { star_SetConst44(A, 2); });
+}
+STAR_BENCHMARK(BM_star_SetConst44);
+
+static void BM_star_SetIdentity44(benchmark::State& state) {
+  BenchArrays<16>(state, [](sfloat* A) { star_SetIdentity44(A, 1); });
+}
+STAR_BENCHMARK(BM_star_SetIdentity44);
+
+static void BM_star_AddConst44(benchmark::State& state) {
+  BenchArrays<16, 16>(state, [](sfloat* C, sfloat* A) { star_AddConst44(C, A, 2); });
+}
+STAR_BENCHMARK(BM_star_AddConst44);
+
+static void BM_star_SubConst44(benchmark::State& state) {
+  BenchArrays<16, 16>(state, [](sfloat* C, sfloat* A) { star_SubConst44(C, A, 2); });
+}
+STAR_BENCHMARK(BM_star_SubConst44);
+
+static void BM_star_MulConst44(benchmark::State& state) {
+  BenchArrays<16, 16>(state, [](sfloat* C, sfloat* A) { star_MulConst44(C, A, 2); });
+}
+STAR_BENCHMARK(BM_star_MulConst44);
+
+static void BM_star_DivConst44(benchmark::State& state) {
+  BenchArrays<16, 16>(state, [](sfloat* C, sfloat* A) { star_DivConst44(C, A, 2); });
+}
+STAR_BENCHMARK(BM_star_DivConst44);
+
+/*---------------------------------*/
+/* 4x3 Matrices                    */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SetZero43, 12);
+STAR_BENCHMARK_KERNEL(star_Copy43, 12, 12);
+
+STAR_BENCHMARK_KERNEL(star_MatMul433, 12, 12, 9);
+STAR_BENCHMARK_KERNEL(star_MatMulTransposed433, 12, 12, 9);
+STAR_BENCHMARK_KERNEL(star_MatMul443, 12, 16, 12);
+STAR_BENCHMARK_KERNEL(star_TransposedMatMul443, 12, 16, 12);
+STAR_BENCHMARK_KERNEL(star_VecMul43, 4, 12, 3);
+STAR_BENCHMARK_KERNEL(star_TransposedVecMul43, 3, 12, 4);
+
+static void BM_star_SetConst43(benchmark::State& state) {
+  BenchArrays<12>(state, [](sfloat* A) { star_SetConst43(A, 2); });
+}
+STAR_BENCHMARK(BM_star_SetConst43);
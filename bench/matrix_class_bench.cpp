@@ -0,0 +1,157 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+using star::bench::RunBatch;
+
+/*
+ * Benchmarks an expression on a batch of random operands: matrices `A` and `B` of type Mat,
+ * `C` of type Mat3 and `D` of type Mat4, and vectors `x` of type Vec and `y` of type Vec4.
+ */
+#define STAR_BENCHMARK_MATRIX(Mat, Vec, name, expr)             \
+  static void BM_##Mat##_##name(benchmark::State& state) {      \
+    std::vector<Mat> As = RandomObjects<Mat>(state.range(0));   \
+    std::vector<Mat> Bs = RandomObjects<Mat>(state.range(0));   \
+    std::vector<Mat3> Cs = RandomObjects<Mat3>(state.range(0)); \
+    std::vector<Mat4> Ds = RandomObjects<Mat4>(state.range(0)); \
+    std::vector<Vec> xs = RandomObjects<Vec>(state.range(0));   \
+    std::vector<Vec4> ys = RandomObjects<Vec4>(state.range(0)); \
+    RunBatch(state, [&](int i) {                                \
+      Mat& A = As[i];                                           \
+      Mat& B = Bs[i];                                     \
+      Mat3& C = Cs[i];                                    \
+      Mat4& D = Ds[i];                                    \
+      Vec& x = xs[i];                                     \
+      Vec4& y = ys[i];                                    \
+      (void)A;                                                  \
+      (void)B;                                                  \
+      (void)C;                                                  \
+      (void)D;                                                  \
+      (void)x;                                                  \
+      (void)y;                                                  \
+      return expr;                                              \
+    });                                                         \
+  }                                                             \
+  STAR_BENCHMARK(BM_##Mat##_##name)
+
+/*---------------------------------*/
+/* 3x3 Matrices                    */
+/*---------------------------------*/
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetZero, A.SetZero());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetIdentity, A.SetIdentity());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetConst, A.SetConst(2));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetDiagonal, A.SetDiagonal(x));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetRow, A.SetRow(1, x));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, SetCol, A.SetCol(1, x));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, Transpose, A.Transpose());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, TransposeInPlace, A.TransposeInPlace());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, Determinant, A.Determinant());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, Inverse, A.Inverse());
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, AddExpression, Mat3(A + 2.0 * B));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, MatMul, A * B);
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, TransposedMatMul, Transpose(A) * B);
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, MatMulTransposed, A * Transpose(B));
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, VecMul, A * x);
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, TransposedVecMul, Transpose(A) * x);
+STAR_BENCHMARK_MATRIX(Mat3, Vec3, CongruenceTransform, CongruenceTransform(A, B));
+
+// The decompositions work on positive definite matrices A A^T + I
+#define STAR_BENCHMARK_PSD(name, expr)                                       \
+  STAR_BENCHMARK_MATRIX(Mat3, Vec3, name, ([&] {                             \
+                          Mat3 P = A * Transpose(A) + Mat3::Identity();      \
+                          Mat3 U;                                            \
+                          Mat3 V;                                            \
+                          Vec3 v;                                            \
+                          int perm[3];                                       \
+                          (void)U;                                           \
+                          (void)V;                                           \
+                          (void)v;                                           \
+                          (void)perm;                                        \
+                          return expr;                                       \
+                        }()))
+
+STAR_BENCHMARK_PSD(Cholesky, P.Cholesky(U));
+STAR_BENCHMARK_PSD(QR, (P.QR(U, V), U));
+STAR_BENCHMARK_PSD(LU, (P.LU(U, V, perm), U));
+STAR_BENCHMARK_PSD(Eigen, (P.Eigen(v, V), V));
+STAR_BENCHMARK_PSD(SVD, (P.SVD(U, v, V), V));
+STAR_BENCHMARK_PSD(CholSolve, P.CholSolve(v, x));
+STAR_BENCHMARK_PSD(InversePSDInPlace, P.InversePSDInPlace());
+// Cost of forming P, included in each of the above
+STAR_BENCHMARK_PSD(PositiveDefinite, P);
+
+/*---------------------------------*/
+/* 4x4 Matrices                    */
+/*---------------------------------*/
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, SetZero, A.SetZero());
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, SetIdentity, A.SetIdentity());
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, SetConst, A.SetConst(2));
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, SetRow, A.SetRow(1, x));
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, SetCol, A.SetCol(1, x));
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, GetDiagonal, A.GetDiagonal());
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, AddExpression, Mat4(A + 2.0 * B));
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, MatMul, A * B);
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, TransposedMatMul, Transpose(A) * B);
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, MatMulTransposed, A * Transpose(B));
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, VecMul, A * x);
+STAR_BENCHMARK_MATRIX(Mat4, Vec4, TransposedVecMul, Transpose(A) * x);
+
+/*---------------------------------*/
+/* 4x3 Matrices                    */
+/*---------------------------------*/
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, SetZero, A.SetZero());
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, SetConst, A.SetConst(2));
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, SetRow, A.SetRow(1, x));
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, AddExpression, Mat43(A + 2.0 * B));
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, MatMul433, A * C);
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, MatMulTransposed433, A * Transpose(C));
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, MatMul443, D * A);
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, TransposedMatMul443, Transpose(D) * A);
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, VecMul, A * x);
+STAR_BENCHMARK_MATRIX(Mat43, Vec3, TransposedVecMul, Transpose(A) * y);
+
+/*---------------------------------*/
+/* Generic Matrices                */
+/*---------------------------------*/
+using Mat34 = Matrix<3, 4>;
+using Mat66 = Matrix<6, 6>;
+using Mat1212 = Matrix<12, 12>;
+
+STAR_BENCHMARK_MATRIX(Mat34, Vec3, MatMul334, C * A);
+STAR_BENCHMARK_MATRIX(Mat34, Vec3, TransposedMatMul334, Transpose(C) * A);
+STAR_BENCHMARK_MATRIX(Mat34, Vec3, MatMul344, A * D);
+STAR_BENCHMARK_MATRIX(Mat34, Vec3, MatMulTransposed344, A * Transpose(D));
+
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, Transpose, A.Transpose());
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, MatMul, A * B);
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, TransposedMatMul, Transpose(A) * B);
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, MatMulTransposed, A * Transpose(B));
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, TransposedMatMulTransposed, Transpose(A) * Transpose(B));
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, AddTransposed, Mat66(A + Transpose(B)));
+STAR_BENCHMARK_MATRIX(Mat66, Vec3, Solve, ([&] { Mat66 X; return A.Solve(X, B); }()));
+
+STAR_BENCHMARK_MATRIX(Mat1212, Vec3, MatMul, A * B);
+STAR_BENCHMARK_MATRIX(Mat1212, Vec3, Solve, ([&] { Mat1212 X; return A.Solve(X, B); }()));
+
+/*---------------------------------*/
+/* Rotation Matrices               */
+/*---------------------------------*/
+using ActiveRotMat = RotMat<Active>;
+
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, RotX, ActiveRotMat::RotX(x[0]));
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, Transpose, A.Transpose());
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, Inverse, A.Inverse());
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, Compose, A * B);
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, ComposePassive, A * RotMat<Passive>(B));
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, Orthonormalize, A.Orthonormalize());
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, FromAxisAngle,
+                      ActiveRotMat::FromAxisAngle(x[0], 0, 0.6, 0.8));
+STAR_BENCHMARK_MATRIX(ActiveRotMat, Vec3, FromQuaternion,
+                      ActiveRotMat::FromQuaternion(y[0], y[1], y[2], y[3]));
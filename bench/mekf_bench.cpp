@@ -0,0 +1,91 @@
+//
+// Created by Brian Jackson on 5/22/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+
+/*
+ * Runs n attitude and gyro bias filters, where n is the benchmark argument, either as a
+ * std::vector<Mekf<6>> or as a MekfBank<6>. Each step propagates every filter with a
+ * gyroscope sample and updates it with a vector measurement, and the benchmarks report the
+ * filters stepped per second.
+ */
+#define STAR_BENCHMARK_FILTERS(func) BENCHMARK(func)->Arg(1 << 10)->Arg(1 << 12)
+
+static const sfloat kDt = 0.01;
+static const Mat3 kGyroNoise = Mat3::Identity() * 1e-6;
+static const Mat3 kBiasNoise = Mat3::Identity() * 1e-8;
+static const Mat3 kVectorNoise = Mat3::Identity() * 1e-4;
+
+struct Measurements {
+  explicit Measurements(int n)
+      : gyros(RandomObjects<Vec3>(n)), bodies(RandomObjects<Vec3>(n)),
+        references(RandomObjects<Vec3>(n)), attitudes(RandomObjects<Quaternion>(n)),
+        gyro(n), body(n), reference(n) {
+    for (int i = 0; i < n; ++i) {
+      bodies[i].NormalizeInPlace();
+      references[i].NormalizeInPlace();
+      attitudes[i].NormalizeInPlace();
+      gyro.Set(i, gyros[i]);
+      body.Set(i, bodies[i]);
+      reference.Set(i, references[i]);
+    }
+  }
+
+  std::vector<Vec3> gyros;
+  std::vector<Vec3> bodies;
+  std::vector<Vec3> references;
+  std::vector<Quaternion> attitudes;
+  Vec3Array gyro;
+  Vec3Array body;
+  Vec3Array reference;
+};
+
+static Matrix<6, 6> InitialCovariance() {
+  Matrix<6, 6> cov = Matrix<6, 6>::Identity() * 1e-2;
+  for (int i = 3; i < 6; ++i) {
+    cov(i, i) = 1e-4;
+  }
+  return cov;
+}
+
+static void BM_MekfLoop(benchmark::State& state) {
+  const int n = state.range(0);
+  const Measurements meas(n);
+  std::vector<Mekf<6>> filters(n, Mekf<6>(kGyroNoise, kBiasNoise));
+  for (int i = 0; i < n; ++i) {
+    filters[i].Reset(meas.attitudes[i], InitialCovariance());
+  }
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      filters[i].Propagate(meas.gyros[i], kDt);
+      filters[i].UpdateVector(meas.bodies[i], meas.references[i], kVectorNoise);
+    }
+    benchmark::DoNotOptimize(filters.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK_FILTERS(BM_MekfLoop);
+
+static void BM_MekfBank(benchmark::State& state) {
+  const int n = state.range(0);
+  const Measurements meas(n);
+  MekfBank<6> bank(n, kGyroNoise, kBiasNoise);
+  for (int i = 0; i < n; ++i) {
+    bank.Reset(i, meas.attitudes[i], InitialCovariance());
+  }
+  for (auto _ : state) {
+    bank.Propagate(meas.gyro, kDt);
+    bank.UpdateVector(meas.body, meas.reference, kVectorNoise);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK_FILTERS(BM_MekfBank);
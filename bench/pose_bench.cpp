@@ -0,0 +1,96 @@
+//
+// Created by Brian Jackson on 5/19/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::Batch;
+using star::bench::RandomObjects;
+
+/*
+ * Transforms a point cloud of n points, where n is the benchmark argument, and reports the
+ * points per second.
+ */
+#define STAR_BENCHMARK_POINTS(func) \
+  BENCHMARK(func)->Arg(1)->Arg(64)->Arg(4096)->Arg(1 << 20)
+
+static Pose RandomPose() {
+  Batch q(4, 1);
+  Batch t(3, 1);
+  q.Normalize();
+  return {Quaternion(q[0][0], q[0][1], q[0][2], q[0][3]), Vec3(t[0][0], t[0][1], t[0][2])};
+}
+
+// Points stored as separate x, y, z arrays
+template <class Transform>
+void BenchSeparate(benchmark::State& state, Transform transform) {
+  const int n = state.range(0);
+  const Pose T = RandomPose();
+  Batch points(n, 3);
+  Batch out(n, 3);
+  for (auto _ : state) {
+    transform(T, out[0], out[1], out[2], points[0], points[1], points[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Points stored as contiguous Vec3s
+template <class Transform>
+void BenchInterleaved(benchmark::State& state, Transform transform) {
+  const int n = state.range(0);
+  const Pose T = RandomPose();
+  std::vector<Vec3> points = RandomObjects<Vec3>(n);
+  std::vector<Vec3> out(n);
+  for (auto _ : state) {
+    transform(T, out.data(), points.data(), n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Rotate each point by the quaternion and add the translation
+static void BM_QuatRotateAddLoop(benchmark::State& state) {
+  BenchInterleaved(state, [](const Pose& T, Vec3* out, const Vec3* points, int n) {
+    for (int i = 0; i < n; ++i) {
+      out[i] = T.Rotation().RotateActive(points[i]) + T.Translation();
+    }
+  });
+}
+STAR_BENCHMARK_POINTS(BM_QuatRotateAddLoop);
+
+static void BM_PoseTransformLoop(benchmark::State& state) {
+  BenchInterleaved(state, [](const Pose& T, Vec3* out, const Vec3* points, int n) {
+    for (int i = 0; i < n; ++i) {
+      out[i] = T.Transform(points[i]);
+    }
+  });
+}
+STAR_BENCHMARK_POINTS(BM_PoseTransformLoop);
+
+static void BM_PoseTransformInterleaved(benchmark::State& state) {
+  BenchInterleaved(state, [](const Pose& T, Vec3* out, const Vec3* points, int n) {
+    T.Transform(out, points, n);
+  });
+}
+STAR_BENCHMARK_POINTS(BM_PoseTransformInterleaved);
+
+static void BM_PoseTransformSeparate(benchmark::State& state) {
+  BenchSeparate(state, [](const Pose& T, sfloat* x_out, sfloat* y_out, sfloat* z_out,
+                          const sfloat* x, const sfloat* y, const sfloat* z, int n) {
+    T.Transform(x_out, y_out, z_out, x, y, z, n);
+  });
+}
+STAR_BENCHMARK_POINTS(BM_PoseTransformSeparate);
+
+static void BM_PoseInverseTransformSeparate(benchmark::State& state) {
+  BenchSeparate(state, [](const Pose& T, sfloat* x_out, sfloat* y_out, sfloat* z_out,
+                          const sfloat* x, const sfloat* y, const sfloat* z, int n) {
+    T.InverseTransform(x_out, y_out, z_out, x, y, z, n);
+  });
+}
+STAR_BENCHMARK_POINTS(BM_PoseInverseTransformSeparate);
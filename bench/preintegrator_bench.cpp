@@ -0,0 +1,155 @@
+//
+// Created by Brian Jackson on 5/21/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+extern "C" {
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+using namespace star;
+using star::bench::RandomObjects;
+
+/*
+ * Integrates a buffer of n IMU samples, where n is the benchmark argument, and reports the
+ * samples per second.
+ */
+#define STAR_BENCHMARK_SAMPLES(func) BENCHMARK(func)->Arg(200)->Arg(1000)
+
+static const sfloat kDt = 0.005;
+
+static Preintegrator BenchPreintegrator() {
+  return {Mat3::Identity() * 1e-4, Mat3::Identity() * 1e-3, Vec3(0.01, -0.02, 0.005),
+          Vec3(0.1, 0.05, -0.2)};
+}
+
+template <class Integrate>
+void BenchSamples(benchmark::State& state, Integrate integrate) {
+  const int n = state.range(0);
+  const std::vector<Vec3> gyro = RandomObjects<Vec3>(n);
+  const std::vector<Vec3> accel = RandomObjects<Vec3>(n);
+  for (auto _ : state) {
+    integrate(gyro.data(), accel.data(), n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// The deltas only, composing the exponential of each sample
+static void BM_QuatExpmComposeLoop(benchmark::State& state) {
+  BenchSamples(state, [](const Vec3* gyro, const Vec3* accel, int n) {
+    Quaternion q = Quaternion::Identity();
+    Vec3 v = Vec3::Zero();
+    Vec3 p = Vec3::Zero();
+    for (int i = 0; i < n; ++i) {
+      const Vec3 a = q.RotateActive(accel[i]);
+      p += kDt * v + (kDt * kDt / 2) * a;
+      v += kDt * a;
+      q = q.Compose(Quaternion::Expm(kDt * gyro[i]));
+    }
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+  });
+}
+STAR_BENCHMARK_SAMPLES(BM_QuatExpmComposeLoop);
+
+// Deltas plus the covariance propagated with dense 9x9 products
+static void BM_DenseCovarianceLoop(benchmark::State& state) {
+  BenchSamples(state, [](const Vec3* gyro, const Vec3* accel, int n) {
+    Quaternion q = Quaternion::Identity();
+    Vec3 v = Vec3::Zero();
+    Vec3 p = Vec3::Zero();
+    Matrix<9, 9> cov = Matrix<9, 9>::Zero();
+    Matrix<6, 6> Q = Matrix<6, 6>::Identity() * (1e-3 / kDt);
+    for (int i = 0; i < n; ++i) {
+      const Vec3 phi = kDt * gyro[i];
+      const Quaternion dq = Quaternion::Expm(phi);
+      Mat3 R;
+      Mat3 dR;
+      Mat3 A;
+      Mat3 Jr;
+      star_QuatToRotMatActive(R.data(), q.data());
+      star_QuatToRotMatActive(dR.data(), dq.data());
+      star_SkewSymmetricMatrix(A.data(), accel[i].data());
+      star_SO3RightJacobian(Jr.data(), phi.data());
+      const Mat3 RA = R * A;
+      Matrix<9, 9> F = Matrix<9, 9>::Identity();
+      F.SetBlock(0, 0, dR.Transpose());
+      F.SetBlock(3, 0, Mat3(RA * -kDt));
+      F.SetBlock(6, 0, Mat3(RA * (-kDt * kDt / 2)));
+      F.SetBlock(6, 3, Mat3(Mat3::Identity() * kDt));
+      Matrix<9, 6> G = Matrix<9, 6>::Zero();
+      G.SetBlock(0, 0, Mat3(Jr * kDt));
+      G.SetBlock(3, 3, Mat3(R * kDt));
+      G.SetBlock(6, 3, Mat3(R * (kDt * kDt / 2)));
+      cov = F * cov * F.Transpose() + G * Q * G.Transpose();
+
+      const Vec3 a = R * accel[i];
+      p += kDt * v + (kDt * kDt / 2) * a;
+      v += kDt * a;
+      q = q.Compose(dq);
+    }
+    benchmark::DoNotOptimize(cov);
+    benchmark::DoNotOptimize(p);
+  });
+}
+STAR_BENCHMARK_SAMPLES(BM_DenseCovarianceLoop);
+
+// Deltas, covariance and bias Jacobians, one sample per call
+static void BM_PreintegratorLoop(benchmark::State& state) {
+  Preintegrator preint = BenchPreintegrator();
+  BenchSamples(state, [&](const Vec3* gyro, const Vec3* accel, int n) {
+    preint.Reset();
+    for (int i = 0; i < n; ++i) {
+      preint.Integrate(gyro[i], accel[i], kDt);
+    }
+  });
+}
+STAR_BENCHMARK_SAMPLES(BM_PreintegratorLoop);
+
+static void BM_PreintegratorBatch(benchmark::State& state) {
+  Preintegrator preint = BenchPreintegrator();
+  BenchSamples(state, [&](const Vec3* gyro, const Vec3* accel, int n) {
+    preint.Reset();
+    preint.Integrate(gyro, accel, kDt, n);
+  });
+}
+STAR_BENCHMARK_SAMPLES(BM_PreintegratorBatch);
+
+/*-------------------------------------
+ * Bias Update
+ *-----------------------------------*/
+// Reintegrating the buffer for a new bias, versus the first-order correction
+static void BM_BiasUpdateReintegrate(benchmark::State& state) {
+  Preintegrator preint = BenchPreintegrator();
+  const Vec3 bg = {0.012, -0.018, 0.004};
+  const Vec3 ba = {0.11, 0.04, -0.19};
+  BenchSamples(state, [&](const Vec3* gyro, const Vec3* accel, int n) {
+    preint.Reset(bg, ba);
+    preint.Integrate(gyro, accel, kDt, n);
+    benchmark::DoNotOptimize(preint.DeltaPosition());
+  });
+}
+STAR_BENCHMARK_SAMPLES(BM_BiasUpdateReintegrate);
+
+static void BM_BiasUpdateCorrected(benchmark::State& state) {
+  const int n = state.range(0);
+  const std::vector<Vec3> gyro = RandomObjects<Vec3>(n);
+  const std::vector<Vec3> accel = RandomObjects<Vec3>(n);
+  Preintegrator preint = BenchPreintegrator();
+  preint.Integrate(gyro.data(), accel.data(), kDt, n);
+  const Vec3 bg = {0.012, -0.018, 0.004};
+  const Vec3 ba = {0.11, 0.04, -0.19};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(preint.CorrectedDeltaRotation(bg));
+    benchmark::DoNotOptimize(preint.CorrectedDeltaVelocity(bg, ba));
+    benchmark::DoNotOptimize(preint.CorrectedDeltaPosition(bg, ba));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK_SAMPLES(BM_BiasUpdateCorrected);
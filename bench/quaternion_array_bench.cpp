@@ -0,0 +1,124 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+
+/*
+ * Compares each bulk operation of QuaternionArray on a trajectory of n knot points with the
+ * equivalent loop over a std::vector<Quaternion>. Both report the knot points per second.
+ */
+#define STAR_BENCHMARK_TRAJECTORY(func) \
+  BENCHMARK(func)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 17)
+
+struct Trajectories {
+  explicit Trajectories(int n)
+      : qs(RandomObjects<Quaternion>(n)), ps(RandomObjects<Quaternion>(n)),
+        vs(RandomObjects<Vec3>(n)), q(n), p(n), v(n) {
+    for (int i = 0; i < n; ++i) {
+      qs[i].NormalizeInPlace();
+      ps[i].NormalizeInPlace();
+      q.Set(i, qs[i]);
+      p.Set(i, ps[i]);
+      v.Set(i, vs[i]);
+    }
+  }
+
+  std::vector<Quaternion> qs;
+  std::vector<Quaternion> ps;
+  std::vector<Vec3> vs;
+  QuaternionArray q;
+  QuaternionArray p;
+  Vec3Array v;
+};
+
+#define STAR_BENCHMARK_LOOP(name, Type, expr)                        \
+  static void BM_Loop_##name(benchmark::State& state) {              \
+    const int n = state.range(0);                                    \
+    Trajectories traj(n);                                            \
+    std::vector<Type> out(n);                                        \
+    for (auto _ : state) {                                           \
+      for (int i = 0; i < n; ++i) {                                  \
+        const Quaternion& q = traj.qs[i];                            \
+        const Quaternion& p = traj.ps[i];                            \
+        const Vec3& v = traj.vs[i];                                  \
+        (void)q;                                                     \
+        (void)p;                                                     \
+        (void)v;                                                     \
+        out[i] = expr;                                               \
+      }                                                              \
+      benchmark::DoNotOptimize(out.data());                          \
+      benchmark::ClobberMemory();                                    \
+    }                                                                \
+    state.SetItemsProcessed(state.iterations() * n);                 \
+  }                                                                  \
+  STAR_BENCHMARK_TRAJECTORY(BM_Loop_##name)
+
+#define STAR_BENCHMARK_BULK(name, kernel, out, ...)                  \
+  static void BM_Bulk_##name(benchmark::State& state) {              \
+    const int n = state.range(0);                                    \
+    Trajectories traj(n);                                            \
+    out result(n);                                                   \
+    for (auto _ : state) {                                           \
+      kernel(result.data(), __VA_ARGS__, n);                         \
+      benchmark::DoNotOptimize(result.data());                       \
+      benchmark::ClobberMemory();                                    \
+    }                                                                \
+    state.SetItemsProcessed(state.iterations() * n);                 \
+  }                                                                  \
+  STAR_BENCHMARK_TRAJECTORY(BM_Bulk_##name)
+
+STAR_BENCHMARK_LOOP(Normalize, Quaternion, q.Normalize());
+STAR_BENCHMARK_BULK(Normalize, star_QuatNormalizeBlocked, QuaternionArray, traj.q.data());
+
+STAR_BENCHMARK_LOOP(Inverse, Quaternion, q.Inverse());
+STAR_BENCHMARK_BULK(Inverse, star_QuatInverseBlocked, QuaternionArray, traj.q.data());
+
+STAR_BENCHMARK_LOOP(Compose, Quaternion, q.Compose(p));
+STAR_BENCHMARK_BULK(Compose, star_QuatComposeBlocked, QuaternionArray, traj.q.data(),
+                    traj.p.data());
+
+STAR_BENCHMARK_LOOP(Diff, Quaternion, p.Conjugate().Compose(q));
+STAR_BENCHMARK_BULK(Diff, star_QuatDiffBlocked, QuaternionArray, traj.q.data(),
+                    traj.p.data());
+
+STAR_BENCHMARK_LOOP(Logm, Vec3, q.Log().Vec() * 2);
+STAR_BENCHMARK_BULK(Logm, star_QuatLogmBlocked, Vec3Array, traj.q.data());
+
+STAR_BENCHMARK_LOOP(Expm, Quaternion, Quaternion::Expm(v));
+STAR_BENCHMARK_BULK(Expm, star_QuatExpmBlocked, QuaternionArray, traj.v.data());
+
+STAR_BENCHMARK_LOOP(RotateActive, Vec3, q.RotateActive(v));
+STAR_BENCHMARK_BULK(RotateActive, star_QuatRotateActiveBlocked, Vec3Array, traj.q.data(),
+                    traj.v.data());
+
+// Resamples a smooth trajectory at 4 query times per knot point, reporting queries per
+// second
+static void BM_Bulk_Resample(benchmark::State& state) {
+  const int n = state.range(0);
+  QuaternionArray q(n);
+  std::vector<sfloat> times(n);
+  std::vector<sfloat> query_times(4 * n);
+  for (int i = 0; i < n; ++i) {
+    times[i] = i;
+    q.Set(i, Quaternion::Expm(0.01 * i, 0.02 * i, -0.005 * i));
+  }
+  for (int j = 0; j < 4 * n; ++j) {
+    query_times[j] = 0.25 * j + 0.1;
+  }
+  QuaternionArray result(4 * n);
+  for (auto _ : state) {
+    star_QuatResampleBlocked(result.data(), query_times.data(), 4 * n, q.data(), times.data(),
+                             n);
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 4 * n);
+}
+STAR_BENCHMARK_TRAJECTORY(BM_Bulk_Resample);
@@ -0,0 +1,201 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/matrix_kernels.hpp"
+
+extern "C" {
+#include "star/matrix43.h"
+#include "star/quaternion.h"
+}
+
+using star::bench::Batch;
+using star::bench::BenchArrays;
+
+/*---------------------------------*/
+/* Scalar values                   */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_QuatNorm, 4);
+STAR_BENCHMARK_KERNEL(star_QuatNormSquared, 4);
+STAR_BENCHMARK_KERNEL(star_QuatVecNorm, 4);
+STAR_BENCHMARK_KERNEL(star_QuatVecNormSquared, 4);
+STAR_BENCHMARK_KERNEL(star_PrincipalAngle, 4);
+STAR_BENCHMARK_KERNEL(star_QuatAngleBetween, 4, 4);
+
+/*---------------------------------*/
+/* Quaternion operations           */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_QuatIdentity, 4);
+STAR_BENCHMARK_KERNEL(star_QuatNormalize, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatFlip, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatVec, 3, 4);
+STAR_BENCHMARK_KERNEL(star_QuatConjugate, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatInverse, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatCompose, 4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatComposeLeft, 4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatDiff, 4, 4, 4);
+
+/*---------------------------------*/
+/* Operations on vectors           */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_QuatLogm, 3, 4);
+STAR_BENCHMARK_KERNEL(star_QuatLog, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatExpm, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatExp, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatRotateActive, 3, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatRotatePassive, 3, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatPure, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatComposePure, 4, 4, 3);
+
+// The batched kernels rotate the whole batch in a single call
+static void BM_star_QuatRotateActiveBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch q = Batch(4, 1).Normalize();
+  Batch x(n, 3);
+  Batch x_rot(n, 3);
+  for (auto _ : state) {
+    star_QuatRotateActiveBatch(x_rot[0], x_rot[1], x_rot[2], q[0], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_QuatRotateActiveBatch);
+
+static void BM_star_QuatRotatePassiveBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch q = Batch(4, 1).Normalize();
+  Batch x(n, 3);
+  Batch x_rot(n, 3);
+  for (auto _ : state) {
+    star_QuatRotatePassiveBatch(x_rot[0], x_rot[1], x_rot[2], q[0], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_QuatRotatePassiveBatch);
+
+/*---------------------------------*/
+/* Interpolation                   */
+/*---------------------------------*/
+static void BM_star_QuatSlerp(benchmark::State& state) {
+  BenchArrays<4, 4, 4>(state, [](sfloat* q, sfloat* q0, sfloat* q1) {
+    star_QuatSlerp(q, q0, q1, 0.3);
+  });
+}
+STAR_BENCHMARK(BM_star_QuatSlerp);
+
+static void BM_star_QuatNlerp(benchmark::State& state) {
+  BenchArrays<4, 4, 4>(state, [](sfloat* q, sfloat* q0, sfloat* q1) {
+    star_QuatNlerp(q, q0, q1, 0.3);
+  });
+}
+STAR_BENCHMARK(BM_star_QuatNlerp);
+
+static void BM_star_QuatSquad(benchmark::State& state) {
+  BenchArrays<4, 4, 4, 4, 4>(
+      state, [](sfloat* q, sfloat* q0, sfloat* q1, sfloat* s0, sfloat* s1) {
+        star_QuatSquad(q, q0, q1, s0, s1, 0.3);
+      });
+}
+STAR_BENCHMARK(BM_star_QuatSquad);
+
+STAR_BENCHMARK_KERNEL(star_QuatSquadControlPoint, 4, 4, 4, 4);
+
+/*---------------------------------*/
+/* Conversions                     */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_QuatToRotMatActive, 9, 4);
+STAR_BENCHMARK_KERNEL(star_QuatToRotMatPassive, 9, 4);
+STAR_BENCHMARK_KERNEL(star_QuatToRodriguesParam, 3, 4);
+STAR_BENCHMARK_KERNEL(star_RodriguesParamToQuat, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatToMRP, 3, 4);
+STAR_BENCHMARK_KERNEL(star_MRPToQuat, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatToAxisAngle, 4, 4);
+STAR_BENCHMARK_KERNEL(star_AxisAngleToQuat, 4, 4);
+STAR_BENCHMARK_KERNEL(star_QuatToEulerXYZ, 3, 4);
+STAR_BENCHMARK_KERNEL(star_QuatToEulerZYX, 3, 4);
+
+/*---------------------------------*/
+/* Cardinal rotations              */
+/*---------------------------------*/
+static void BM_star_QuatRotX(benchmark::State& state) {
+  BenchArrays<4>(state, [](sfloat* q) { star_QuatRotX(q, 0.3); });
+}
+STAR_BENCHMARK(BM_star_QuatRotX);
+
+static void BM_star_QuatRotY(benchmark::State& state) {
+  BenchArrays<4>(state, [](sfloat* q) { star_QuatRotY(q, 0.3); });
+}
+STAR_BENCHMARK(BM_star_QuatRotY);
+
+static void BM_star_QuatRotZ(benchmark::State& state) {
+  BenchArrays<4>(state, [](sfloat* q) { star_QuatRotZ(q, 0.3); });
+}
+STAR_BENCHMARK(BM_star_QuatRotZ);
+
+/*---------------------------------*/
+/* Jacobians and matrices          */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_QuatRotateActiveJacobian, 12, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatRotatePassiveJacobian, 12, 4, 3);
+STAR_BENCHMARK_KERNEL(star_QuatExpmJacobian, 12, 3);
+STAR_BENCHMARK_KERNEL(star_QuatLogmJacobian, 12, 4);
+STAR_BENCHMARK_KERNEL(star_QuatCayleyJacobian, 12, 3);
+STAR_BENCHMARK_KERNEL(star_QuatInvCayleyJacobian, 12, 4);
+STAR_BENCHMARK_KERNEL(star_MRPToQuatJacobian, 12, 3);
+STAR_BENCHMARK_KERNEL(star_QuatToMRPJacobian, 12, 4);
+
+// Central finite differences of star_QuatExpm, for comparison with the analytic Jacobian
+static void QuatExpmFiniteDiff(sfloat D[12], const sfloat phi[3]) {
+  const sfloat h = 1e-6;
+  for (int j = 0; j < 3; ++j) {
+    sfloat xp[3] = {phi[0], phi[1], phi[2]};
+    sfloat xm[3] = {phi[0], phi[1], phi[2]};
+    xp[j] += h;
+    xm[j] -= h;
+    sfloat qp[4];
+    sfloat qm[4];
+    star_QuatExpm(qp, xp);
+    star_QuatExpm(qm, xm);
+    for (int i = 0; i < 4; ++i) {
+      D[i + 4 * j] = (qp[i] - qm[i]) / (2 * h);
+    }
+  }
+}
+STAR_BENCHMARK_KERNEL(QuatExpmFiniteDiff, 12, 3);
+STAR_BENCHMARK_KERNEL(star_SkewSymmetricMatrix, 9, 3);
+STAR_BENCHMARK_KERNEL(star_LMat, 16, 4);
+STAR_BENCHMARK_KERNEL(star_RMat, 16, 4);
+STAR_BENCHMARK_KERNEL(star_GMat, 12, 4);
+
+/*---------------------------------*/
+/* Hessian projection              */
+/*---------------------------------*/
+// G(q)^T H G(q) through a dense G, for comparison with the fused kernel
+static void AttitudeProjectHessianDense(sfloat P[9], const sfloat q[4],
+                                        const sfloat H[16]) {
+  sfloat G[12];
+  sfloat HG[12];
+  star_GMat(G, q);
+  star_MatMul443(HG, H, G);
+  star::TransposedMatMul<3, 4, 3>(P, G, HG);
+}
+STAR_BENCHMARK_KERNEL(AttitudeProjectHessianDense, 9, 4, 16);
+STAR_BENCHMARK_KERNEL(star_AttitudeProjectHessian, 9, 4, 16);
+
+static void BM_star_AttitudeProjectHessianBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Batch P(9, n);
+  Batch q(4, n);
+  Batch H(16, n);
+  q.Normalize();
+  for (auto _ : state) {
+    star_AttitudeProjectHessianBatch(P[0], q[0], H[0], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_star_AttitudeProjectHessianBatch);
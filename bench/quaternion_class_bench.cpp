@@ -0,0 +1,97 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::Batch;
+using star::bench::RandomObjects;
+using star::bench::RunBatch;
+
+/*
+ * Benchmarks an expression on a batch of random unit quaternions `q` and `p` and random
+ * vectors `v`.
+ */
+#define STAR_BENCHMARK_QUATERNION(name, expr)                      \
+  static void BM_Quaternion_##name(benchmark::State& state) {      \
+    std::vector<Quaternion> qs = RandomQuaternions(state.range(0)); \
+    std::vector<Quaternion> ps = RandomQuaternions(state.range(0)); \
+    std::vector<Vec3> vs = RandomObjects<Vec3>(state.range(0));    \
+    RunBatch(state, [&](int i) {                                   \
+      Quaternion& q = qs[i];                                       \
+      const Quaternion& p = ps[i];                                 \
+      const Vec3& v = vs[i];                                       \
+      (void)q;                                                     \
+      (void)p;                                                     \
+      (void)v;                                                     \
+      return expr;                                                 \
+    });                                                            \
+  }                                                                \
+  STAR_BENCHMARK(BM_Quaternion_##name)
+
+static std::vector<Quaternion> RandomQuaternions(int n) {
+  std::vector<Quaternion> qs = RandomObjects<Quaternion>(n);
+  for (Quaternion& q : qs) {
+    q.NormalizeInPlace();
+  }
+  return qs;
+}
+
+STAR_BENCHMARK_QUATERNION(Expm, Quaternion::Expm(v));
+STAR_BENCHMARK_QUATERNION(FromAxisAngle, Quaternion::FromAxisAngle(v[0], v));
+STAR_BENCHMARK_QUATERNION(RotX, Quaternion::RotX(v[0]));
+STAR_BENCHMARK_QUATERNION(VecNorm, q.VecNorm());
+STAR_BENCHMARK_QUATERNION(VecNormSquared, q.VecNormSquared());
+STAR_BENCHMARK_QUATERNION(AngleBetween, q.AngleBetween(p));
+STAR_BENCHMARK_QUATERNION(Exp, q.Exp());
+STAR_BENCHMARK_QUATERNION(Log, q.Log());
+STAR_BENCHMARK_QUATERNION(Flip, q.Flip());
+STAR_BENCHMARK_QUATERNION(Conjugate, q.Conjugate());
+STAR_BENCHMARK_QUATERNION(Inverse, q.Inverse());
+STAR_BENCHMARK_QUATERNION(Compose, q.Compose(p));
+STAR_BENCHMARK_QUATERNION(ComposeLeft, q.ComposeLeft(p));
+STAR_BENCHMARK_QUATERNION(Slerp, q.Slerp(p, 0.3));
+STAR_BENCHMARK_QUATERNION(Nlerp, q.Nlerp(p, 0.3));
+// Slerp through the logarithm and exponential, for comparison
+STAR_BENCHMARK_QUATERNION(SlerpLogExpm,
+                          q.Compose(Quaternion::Expm(p.Conjugate().Compose(q).Log().Vec() *
+                                                     (2 * 0.3))));
+STAR_BENCHMARK_QUATERNION(RotateActive, q.RotateActive(v));
+STAR_BENCHMARK_QUATERNION(RotatePassive, q.RotatePassive(v));
+STAR_BENCHMARK_QUATERNION(ComposePure, q.ComposePure(v));
+STAR_BENCHMARK_QUATERNION(AttitudeJacobian, q.AttitudeJacobian());
+STAR_BENCHMARK_QUATERNION(L, q.L());
+STAR_BENCHMARK_QUATERNION(R, q.R());
+STAR_BENCHMARK_QUATERNION(H, q.H());
+STAR_BENCHMARK_QUATERNION(IsApprox, q.IsApprox(p));
+
+// Rotates n vectors stored as separate x, y, z arrays in a single call
+static void BM_Quaternion_RotateActiveBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Quaternion q = Quaternion::RotZ(0.3);
+  Batch x(n, 3);
+  Batch x_rot(n, 3);
+  for (auto _ : state) {
+    q.RotateActive(x_rot[0], x_rot[1], x_rot[2], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_Quaternion_RotateActiveBatch);
+
+static void BM_Quaternion_RotatePassiveBatch(benchmark::State& state) {
+  const int n = state.range(0);
+  Quaternion q = Quaternion::RotZ(0.3);
+  Batch x(n, 3);
+  Batch x_rot(n, 3);
+  for (auto _ : state) {
+    q.RotatePassive(x_rot[0], x_rot[1], x_rot[2], x[0], x[1], x[2], n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+STAR_BENCHMARK(BM_Quaternion_RotatePassiveBatch);
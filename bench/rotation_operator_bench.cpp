@@ -0,0 +1,86 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::Batch;
+
+/*
+ * Rotates a batch of n vectors, stored as separate x, y, z arrays, by a fresh unit
+ * quaternion, where n is the benchmark argument. Reports the vectors per second, so
+ * BM_QuatRotateLoop and BM_RotMatBatch cross where building the rotation matrix starts to
+ * pay off. Since star_QuatRotateActive builds the matrix for every vector, that is
+ * already at n = 1, which is why RotationOperator always uses the matrix.
+ */
+#define STAR_BENCHMARK_ROTATION(func) BENCHMARK(func)->DenseRange(1, 8)->Arg(64)->Arg(4096)
+
+template <class Rotate>
+void BenchRotation(benchmark::State& state, Rotate rotate) {
+  const int n = state.range(0);
+  Batch q(4, 1);
+  q.Normalize();
+  Batch v(3, n);
+  std::vector<sfloat> x(n);
+  std::vector<sfloat> y(n);
+  std::vector<sfloat> z(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = v[i][0];
+    y[i] = v[i][1];
+    z[i] = v[i][2];
+  }
+  for (auto _ : state) {
+    // Rotate in place, so the output of one iteration is the input of the next
+    rotate(q[0], x.data(), y.data(), z.data(), n);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Rotate each vector by the quaternion
+static void BM_QuatRotateLoop(benchmark::State& state) {
+  BenchRotation(state, [](const sfloat* q, sfloat* x, sfloat* y, sfloat* z, int n) {
+    for (int i = 0; i < n; ++i) {
+      sfloat v[3] = {x[i], y[i], z[i]};
+      star_QuatRotateActive(v, q, v);
+      x[i] = v[0];
+      y[i] = v[1];
+      z[i] = v[2];
+    }
+  });
+}
+STAR_BENCHMARK_ROTATION(BM_QuatRotateLoop);
+
+// Build the rotation matrix, then multiply every vector by it
+static void BM_RotMatBatch(benchmark::State& state) {
+  BenchRotation(state, [](const sfloat* q, sfloat* x, sfloat* y, sfloat* z, int n) {
+    sfloat R[9];
+    star_QuatToRotMatActive(R, q);
+    star_VecMulBatch33(x, y, z, R, x, y, z, n);
+  });
+}
+STAR_BENCHMARK_ROTATION(BM_RotMatBatch);
+
+// Builds the matrix when the operator is created
+static void BM_RotationOperator(benchmark::State& state) {
+  BenchRotation(state, [](const sfloat* q, sfloat* x, sfloat* y, sfloat* z, int n) {
+    RotationOperator op(Quaternion(q[0], q[1], q[2], q[3]));
+    op.RotateActive(x, y, z, x, y, z, n);
+  });
+}
+STAR_BENCHMARK_ROTATION(BM_RotationOperator);
+
+// An operator reused for many batches
+static void BM_RotationOperatorReused(benchmark::State& state) {
+  Batch q(4, 1);
+  q.Normalize();
+  RotationOperator op(Quaternion(q[0][0], q[0][1], q[0][2], q[0][3]));
+  BenchRotation(state, [&op](const sfloat*, sfloat* x, sfloat* y, sfloat* z, int n) {
+    op.RotateActive(x, y, z, x, y, z, n);
+  });
+}
+STAR_BENCHMARK_ROTATION(BM_RotationOperatorReused);
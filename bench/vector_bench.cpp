@@ -0,0 +1,89 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+extern "C" {
+#include "star/vector3.h"
+#include "star/vector4.h"
+}
+
+using star::bench::BenchArrays;
+
+static sfloat Square(sfloat x) { return x * x; }
+static sfloat Hypot(sfloat x, sfloat y) { return std::sqrt(x * x + y * y); }
+
+/*---------------------------------*/
+/* 3-Vectors                       */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SetZero, 3);
+STAR_BENCHMARK_KERNEL(star_NormSquared3, 3);
+STAR_BENCHMARK_KERNEL(star_Norm3, 3);
+STAR_BENCHMARK_KERNEL(star_OneNorm3, 3);
+STAR_BENCHMARK_KERNEL(star_InfNorm3, 3);
+STAR_BENCHMARK_KERNEL(star_Normalize3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Dot3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Cross, 3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Add3, 3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Sub3, 3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Mul3, 3, 3, 3);
+STAR_BENCHMARK_KERNEL(star_Div3, 3, 3, 3);
+
+static void BM_star_SetConst(benchmark::State& state) {
+  BenchArrays<3>(state, [](sfloat* x) { star_SetConst(x, 2); });
+}
+STAR_BENCHMARK(BM_star_SetConst);
+
+static void BM_star_SetAxis(benchmark::State& state) {
+  BenchArrays<3>(state, [](sfloat* x) { star_SetAxis(x, star_Yaxis); });
+}
+STAR_BENCHMARK(BM_star_SetAxis);
+
+static void BM_star_Scale3(benchmark::State& state) {
+  BenchArrays<3, 3>(state, [](sfloat* out, sfloat* x) { star_Scale3(out, 0.5, x); });
+}
+STAR_BENCHMARK(BM_star_Scale3);
+
+static void BM_star_UnaryMap(benchmark::State& state) {
+  BenchArrays<3, 3>(state, [](sfloat* out, sfloat* x) { star_UnaryMap(out, x, Square); });
+}
+STAR_BENCHMARK(BM_star_UnaryMap);
+
+static void BM_star_BinaryMap(benchmark::State& state) {
+  BenchArrays<3, 3, 3>(
+      state, [](sfloat* out, sfloat* x, sfloat* y) { star_BinaryMap(out, x, y, Hypot); });
+}
+STAR_BENCHMARK(BM_star_BinaryMap);
+
+/*---------------------------------*/
+/* 4-Vectors                       */
+/*---------------------------------*/
+STAR_BENCHMARK_KERNEL(star_SetZero4, 4);
+STAR_BENCHMARK_KERNEL(star_NormSquared4, 4);
+STAR_BENCHMARK_KERNEL(star_Norm4, 4);
+STAR_BENCHMARK_KERNEL(star_OneNorm4, 4);
+STAR_BENCHMARK_KERNEL(star_InfNorm4, 4);
+STAR_BENCHMARK_KERNEL(star_Normalize4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_Dot4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_Add4, 4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_Sub4, 4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_Mul4, 4, 4, 4);
+STAR_BENCHMARK_KERNEL(star_Div4, 4, 4, 4);
+
+static void BM_star_SetConst4(benchmark::State& state) {
+  BenchArrays<4>(state, [](sfloat* x) { star_SetConst4(x, 2); });
+}
+STAR_BENCHMARK(BM_star_SetConst4);
+
+static void BM_star_UnaryMap4(benchmark::State& state) {
+  BenchArrays<4, 4>(state, [](sfloat* out, sfloat* x) { star_UnaryMap4(out, x, Square); });
+}
+STAR_BENCHMARK(BM_star_UnaryMap4);
+
+static void BM_star_BinaryMap4(benchmark::State& state) {
+  BenchArrays<4, 4, 4>(
+      state, [](sfloat* out, sfloat* x, sfloat* y) { star_BinaryMap4(out, x, y, Hypot); });
+}
+STAR_BENCHMARK(BM_star_BinaryMap4);
@@ -0,0 +1,61 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+using star::bench::RunBatch;
+
+static sfloat Square(sfloat x) { return x * x; }
+static sfloat Hypot(sfloat x, sfloat y) { return std::sqrt(x * x + y * y); }
+
+/*
+ * Benchmarks a method of a vector type on a batch of random vectors. Unary methods get `x`,
+ * binary methods get `x` and `y`, and in-place methods update `x`.
+ */
+#define STAR_BENCHMARK_VECTOR(Vec, name, expr)                   \
+  static void BM_##Vec##_##name(benchmark::State& state) {       \
+    std::vector<Vec> xs = RandomObjects<Vec>(state.range(0));    \
+    std::vector<Vec> ys = RandomObjects<Vec>(state.range(0));    \
+    RunBatch(state, [&](int i) {                                 \
+      Vec& x = xs[i];                                            \
+      const Vec& y = ys[i];                                      \
+      (void)y;                                                   \
+      return expr;                                               \
+    });                                                          \
+  }                                                              \
+  STAR_BENCHMARK(BM_##Vec##_##name)
+
+#define STAR_BENCHMARK_VECTOR_METHODS(Vec)                             \
+  STAR_BENCHMARK_VECTOR(Vec, SetConst, x.SetConst(2));                 \
+  STAR_BENCHMARK_VECTOR(Vec, SetZero, x.SetZero());                    \
+  STAR_BENCHMARK_VECTOR(Vec, Norm, x.Norm());                          \
+  STAR_BENCHMARK_VECTOR(Vec, NormSquared, x.NormSquared());            \
+  STAR_BENCHMARK_VECTOR(Vec, InfNorm, x.InfNorm());                    \
+  STAR_BENCHMARK_VECTOR(Vec, OneNorm, x.OneNorm());                    \
+  STAR_BENCHMARK_VECTOR(Vec, Normalize, x.Normalize());                \
+  STAR_BENCHMARK_VECTOR(Vec, NormalizeInPlace, x.NormalizeInPlace());  \
+  STAR_BENCHMARK_VECTOR(Vec, Dot, x.Dot(y));                           \
+  STAR_BENCHMARK_VECTOR(Vec, NormedDifference, x.NormedDifference(y)); \
+  STAR_BENCHMARK_VECTOR(Vec, Add, x.Add(y));                           \
+  STAR_BENCHMARK_VECTOR(Vec, Sub, x.Sub(y));                           \
+  STAR_BENCHMARK_VECTOR(Vec, Mul, x.Mul(y));                           \
+  STAR_BENCHMARK_VECTOR(Vec, Div, x.Div(y));                           \
+  STAR_BENCHMARK_VECTOR(Vec, AddInPlace, x.AddInPlace(y));             \
+  STAR_BENCHMARK_VECTOR(Vec, SubInPlace, x.SubInPlace(y));             \
+  STAR_BENCHMARK_VECTOR(Vec, MulInPlace, x.MulInPlace(y));             \
+  STAR_BENCHMARK_VECTOR(Vec, DivInPlace, x.DivInPlace(y));             \
+  STAR_BENCHMARK_VECTOR(Vec, UnaryMap, x.UnaryMap(Square));            \
+  STAR_BENCHMARK_VECTOR(Vec, BinaryMap, x.BinaryMap(y, Hypot));        \
+  STAR_BENCHMARK_VECTOR(Vec, AddExpression, Vec(x + 2.0 * y));         \
+  STAR_BENCHMARK_VECTOR(Vec, AddAssign, x += y)
+
+STAR_BENCHMARK_VECTOR_METHODS(Vec3);
+STAR_BENCHMARK_VECTOR(Vec3, Cross, x.Cross(y));
+
+STAR_BENCHMARK_VECTOR_METHODS(Vec4);
@@ -0,0 +1,57 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <vector>
+
+#include "bench_utils.hpp"
+
+#include "star/star.hpp"
+
+using namespace star;
+using star::bench::RandomObjects;
+
+/*
+ * One cycle of batch work on n quaternions, computing their attitude Jacobians and left
+ * multiplication matrices into scratch storage. Compares fresh std::vectors every cycle
+ * with a Workspace that is reset every cycle. Reports the quaternions per second.
+ */
+template <class Scratch>
+void BenchCycle(benchmark::State& state, Scratch scratch) {
+  const int n = state.range(0);
+  std::vector<Quaternion> qs = RandomObjects<Quaternion>(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scratch(qs));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_VectorScratch(benchmark::State& state) {
+  BenchCycle(state, [](const std::vector<Quaternion>& qs) {
+    std::vector<Mat43> G(qs.size());
+    std::vector<Mat4> L(qs.size());
+    for (size_t i = 0; i < qs.size(); ++i) {
+      G[i] = qs[i].AttitudeJacobian();
+      L[i] = qs[i].L();
+    }
+    return G.back()[0] + L.back()[0];
+  });
+}
+STAR_BENCHMARK(BM_VectorScratch);
+
+static void BM_WorkspaceScratch(benchmark::State& state) {
+  Workspace ws;
+  BenchCycle(state, [&ws](const std::vector<Quaternion>& qs) {
+    const int n = qs.size();
+    ws.Reset();
+    Mat43* G = ws.Allocate<Mat43>(n);
+    Mat4* L = ws.Allocate<Mat4>(n);
+    for (int i = 0; i < n; ++i) {
+      G[i] = qs[i].AttitudeJacobian();
+      L[i] = qs[i].L();
+    }
+    return G[n - 1][0] + L[n - 1][0];
+  });
+}
+STAR_BENCHMARK(BM_WorkspaceScratch);
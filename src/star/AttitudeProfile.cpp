@@ -0,0 +1,83 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "AttitudeProfile.hpp"
+
+extern "C" {
+#include "star/attitude.h"
+}
+
+namespace star {
+
+// The batched accumulation treats Vec3 arrays as interleaved x, y, z values
+static_assert(sizeof(Vec3) == 3 * sizeof(sfloat), "Vec3 must be 3 contiguous sfloats");
+
+STAR_INLINE AttitudeProfile::AttitudeProfile(const Vec3* body, const Vec3* reference,
+                                             const sfloat* weights, int n) {
+  Add(body, reference, weights, n);
+}
+
+/*-------------------------------------
+ * Accumulation
+ *-----------------------------------*/
+STAR_INLINE void AttitudeProfile::Add(const Vec3& body, const Vec3& reference,
+                                      sfloat weight) {
+  star_AttitudeProfile(B_.data(), &weight_sum_, &weight, body.data(), reference.data(), 1);
+}
+
+STAR_INLINE void AttitudeProfile::Add(const Vec3* body, const Vec3* reference,
+                                      const sfloat* weights, int n) {
+  star_AttitudeProfile(B_.data(), &weight_sum_, weights, body->data(), reference->data(),
+                       n);
+}
+
+STAR_INLINE void AttitudeProfile::Add(const Vec3Array& body, const Vec3Array& reference,
+                                      const sfloat* weights) {
+  star_AttitudeProfileBlocked(B_.data(), &weight_sum_, weights, body.data(),
+                              reference.data(), body.Size());
+}
+
+STAR_INLINE void AttitudeProfile::Add(const AttitudeProfile& other) {
+  B_ += other.B_;
+  weight_sum_ += other.weight_sum_;
+}
+
+STAR_INLINE void AttitudeProfile::Reset() {
+  B_.SetZero();
+  weight_sum_ = 0;
+}
+
+/*-------------------------------------
+ * Solvers
+ *-----------------------------------*/
+STAR_INLINE AttitudeEstimate AttitudeProfile::Quest() const {
+  Quaternion q;
+  const sfloat lambda = star_Quest(q.data(), B_.data(), weight_sum_);
+  return Estimate(q, lambda);
+}
+
+STAR_INLINE AttitudeEstimate AttitudeProfile::Esoq2() const {
+  Quaternion q;
+  const sfloat lambda = star_Esoq2(q.data(), B_.data(), weight_sum_);
+  return Estimate(q, lambda);
+}
+
+STAR_INLINE AttitudeEstimate AttitudeProfile::DavenportQ() const {
+  Quaternion q;
+  const sfloat lambda = star_DavenportQ(q.data(), B_.data());
+  return Estimate(q, lambda);
+}
+
+STAR_INLINE AttitudeEstimate AttitudeProfile::Estimate(const Quaternion& q,
+                                                       sfloat lambda) const {
+  AttitudeEstimate estimate;
+  estimate.attitude = q;
+  estimate.loss = weight_sum_ - lambda;
+  estimate.observable =
+      star_AttitudeCovariance(estimate.covariance.data(), B_.data(), q.data());
+  return estimate;
+}
+
+}  // namespace star
@@ -0,0 +1,82 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Mat3.hpp"
+#include "star/Quaternion.hpp"
+#include "star/QuaternionArray.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+// Solution of Wahba's problem for an AttitudeProfile
+struct AttitudeEstimate {
+  Quaternion attitude;  // Maps references to the body frame with RotatePassive
+  Mat3 covariance;      // Of the body-frame error, in rad^2 for weights 1 / sigma^2
+  sfloat loss;          // Wahba's loss, sum_i w_i - lambda
+  bool observable;      // False if the observations don't determine the covariance
+};
+
+/*
+ * @brief Attitude determination from weighted vector observations
+ *
+ * Accumulates the attitude profile matrix B = sum_i w_i b_i r_i^T of unit vectors b_i
+ * measured in the body frame, e.g. star tracker directions, and their known directions r_i
+ * in the reference frame, and solves Wahba's problem for the attitude mapping the
+ * references to the body frame. The solvers only need B and the sum of the weights, so
+ * large observation sets can be added in chunks, e.g. from Vec3Arrays in a single
+ * vectorized pass, and the profiles of separate chunks merged.
+ *
+ * See attitude.h for the trade-offs between the solvers.
+ */
+class AttitudeProfile {
+ public:
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  AttitudeProfile() = default;
+  AttitudeProfile(const Vec3* body, const Vec3* reference, const sfloat* weights, int n);
+
+  /*-------------------------------------
+   * Accumulation
+   *-----------------------------------*/
+  void Add(const Vec3& body, const Vec3& reference, sfloat weight = 1);
+  void Add(const Vec3* body, const Vec3* reference, const sfloat* weights, int n);
+
+  // Adds the observations of two arrays of the same size, with one weight per element
+  void Add(const Vec3Array& body, const Vec3Array& reference, const sfloat* weights);
+
+  // Merges the observations of another profile
+  void Add(const AttitudeProfile& other);
+
+  void Reset();
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  const Mat3& ProfileMatrix() const { return B_; }
+  sfloat WeightSum() const { return weight_sum_; }
+
+  /*-------------------------------------
+   * Solvers
+   *-----------------------------------*/
+  AttitudeEstimate Quest() const;
+  AttitudeEstimate Esoq2() const;
+  AttitudeEstimate DavenportQ() const;
+
+ private:
+  AttitudeEstimate Estimate(const Quaternion& q, sfloat lambda) const;
+
+  Mat3 B_ = Mat3::Zero();
+  sfloat weight_sum_ = 0;
+};
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/AttitudeProfile.cpp"
+#endif
@@ -0,0 +1,279 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * Packets of derivative lanes, built on the vector extensions of GCC and Clang like the
+ * vectors in simd.h. They are 256 bits wide when the translation unit targets AVX, and
+ * 128 bits otherwise, since GCC splits wider vectors into scalar code on SSE2. Without
+ * vector extensions every packet holds a single lane.
+ */
+#if defined(__GNUC__)
+
+#if defined(__AVX__)
+#define STAR_DUAL_BYTES 32
+#else
+#define STAR_DUAL_BYTES 16
+#endif
+
+typedef sfloat star_dual_packet __attribute__((vector_size(STAR_DUAL_BYTES)));
+#define STAR_DUAL_PACKET_LANES (STAR_DUAL_BYTES / static_cast<int>(sizeof(sfloat)))
+
+#else
+
+typedef sfloat star_dual_packet;
+#define STAR_DUAL_PACKET_LANES 1
+
+#endif
+
+/*
+ * @brief Forward-mode dual number with N derivative lanes
+ *
+ * Holds a value together with its derivatives with respect to N inputs, so a single
+ * evaluation of code templated on the scalar type returns the value and the exact gradient.
+ * The lanes are stored in SIMD packets, so every operation updates all N of them with
+ * ceil(N / kPacketLanes) vector instructions.
+ *
+ * Works with Vector<N, Dual<M>>, Matrix<R, C, Dual<M>>, Quat<Dual<M>> and RotMat, and the
+ * templated kernels in matrix_kernels.hpp and quaternion_kernels.hpp. Comparisons only
+ * look at the values, so branches take the same path they would for sfloat. Like sfloat, a
+ * default-constructed Dual is uninitialized.
+ */
+template <int N>
+class Dual {
+ public:
+  static constexpr int kLanes = N;
+  static constexpr int kPacketLanes = STAR_DUAL_PACKET_LANES;
+  static constexpr int kPackets = (N + kPacketLanes - 1) / kPacketLanes;
+  using Packet = star_dual_packet;
+
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  Dual() = default;
+  constexpr Dual(sfloat value) : value_(value), grad_{} {}  // NOLINT: Implicit
+
+  // The i-th input, whose derivative is 1 in lane i and 0 in the others. Every lane is set
+  // by value, which keeps the packets in registers.
+  static Dual Variable(sfloat value, int i) {
+    Dual x(value);
+    for (int p = 0; p < kPackets; ++p) {
+      Packet seed;
+      for (int l = 0; l < kPacketLanes; ++l) {
+        SetLane(seed, l, p * kPacketLanes + l == i);
+      }
+      x.grad_[p] = seed;
+    }
+    return x;
+  }
+
+  // f(x) for a scalar function f, given f(x.Value()) and f'(x.Value())
+  static Dual Chain(const Dual& x, sfloat value, sfloat derivative) {
+    Dual y(value);
+    for (int p = 0; p < kPackets; ++p) {
+      y.grad_[p] = derivative * x.grad_[p];
+    }
+    return y;
+  }
+
+  /*-------------------------------------
+   * Data Access
+   *-----------------------------------*/
+  constexpr sfloat Value() const { return value_; }
+  sfloat Grad(int i) const { return Lane(grad_[i / kPacketLanes], i % kPacketLanes); }
+
+  /*-------------------------------------
+   * Arithmetic
+   *-----------------------------------*/
+  Dual operator+() const { return *this; }
+  Dual operator-() const { return Chain(*this, -value_, -1); }
+
+  Dual& operator+=(const Dual& rhs) {
+    value_ += rhs.value_;
+    for (int p = 0; p < kPackets; ++p) {
+      grad_[p] += rhs.grad_[p];
+    }
+    return *this;
+  }
+  Dual& operator-=(const Dual& rhs) {
+    value_ -= rhs.value_;
+    for (int p = 0; p < kPackets; ++p) {
+      grad_[p] -= rhs.grad_[p];
+    }
+    return *this;
+  }
+  Dual& operator*=(const Dual& rhs) {
+    for (int p = 0; p < kPackets; ++p) {
+      grad_[p] = grad_[p] * rhs.value_ + value_ * rhs.grad_[p];
+    }
+    value_ *= rhs.value_;
+    return *this;
+  }
+  Dual& operator/=(const Dual& rhs) {
+    const sfloat inv = 1 / rhs.value_;
+    value_ *= inv;
+    for (int p = 0; p < kPackets; ++p) {
+      grad_[p] = (grad_[p] - value_ * rhs.grad_[p]) * inv;
+    }
+    return *this;
+  }
+
+  Dual& operator+=(sfloat rhs) {
+    value_ += rhs;
+    return *this;
+  }
+  Dual& operator-=(sfloat rhs) {
+    value_ -= rhs;
+    return *this;
+  }
+  Dual& operator*=(sfloat rhs) {
+    value_ *= rhs;
+    for (int p = 0; p < kPackets; ++p) {
+      grad_[p] *= rhs;
+    }
+    return *this;
+  }
+  Dual& operator/=(sfloat rhs) { return *this *= 1 / rhs; }
+
+  friend Dual operator+(Dual lhs, const Dual& rhs) { return lhs += rhs; }
+  friend Dual operator-(Dual lhs, const Dual& rhs) { return lhs -= rhs; }
+  friend Dual operator*(Dual lhs, const Dual& rhs) { return lhs *= rhs; }
+  friend Dual operator/(Dual lhs, const Dual& rhs) { return lhs /= rhs; }
+
+  friend Dual operator+(Dual lhs, sfloat rhs) { return lhs += rhs; }
+  friend Dual operator-(Dual lhs, sfloat rhs) { return lhs -= rhs; }
+  friend Dual operator*(Dual lhs, sfloat rhs) { return lhs *= rhs; }
+  friend Dual operator/(Dual lhs, sfloat rhs) { return lhs /= rhs; }
+
+  friend Dual operator+(sfloat lhs, Dual rhs) { return rhs += lhs; }
+  friend Dual operator-(sfloat lhs, const Dual& rhs) { return -rhs + lhs; }
+  friend Dual operator*(sfloat lhs, Dual rhs) { return rhs *= lhs; }
+  friend Dual operator/(sfloat lhs, const Dual& rhs) {
+    return Chain(rhs, lhs / rhs.value_, -lhs / (rhs.value_ * rhs.value_));
+  }
+
+  /*-------------------------------------
+   * Comparisons
+   *-----------------------------------*/
+  friend constexpr bool operator==(const Dual& a, const Dual& b) {
+    return a.value_ == b.value_;
+  }
+  friend constexpr bool operator!=(const Dual& a, const Dual& b) {
+    return a.value_ != b.value_;
+  }
+  friend constexpr bool operator<(const Dual& a, const Dual& b) {
+    return a.value_ < b.value_;
+  }
+  friend constexpr bool operator>(const Dual& a, const Dual& b) {
+    return a.value_ > b.value_;
+  }
+  friend constexpr bool operator<=(const Dual& a, const Dual& b) {
+    return a.value_ <= b.value_;
+  }
+  friend constexpr bool operator>=(const Dual& a, const Dual& b) {
+    return a.value_ >= b.value_;
+  }
+
+ private:
+#if defined(__GNUC__)
+  static sfloat Lane(const Packet& packet, int l) { return packet[l]; }
+  static void SetLane(Packet& packet, int l, sfloat value) { packet[l] = value; }
+#else
+  static sfloat Lane(const Packet& packet, int) { return packet; }
+  static void SetLane(Packet& packet, int, sfloat value) { packet = value; }
+#endif
+
+  sfloat value_;
+  Packet grad_[kPackets];
+};
+
+/*-------------------------------------
+ * Math Functions
+ *-----------------------------------*/
+// Found by argument-dependent lookup, so templated code calls them unqualified after
+// `using std::sqrt;` and so on.
+template <int N>
+Dual<N> sqrt(const Dual<N>& x) {
+  const sfloat r = std::sqrt(x.Value());
+  return Dual<N>::Chain(x, r, 1 / (2 * r));
+}
+
+template <int N>
+Dual<N> sin(const Dual<N>& x) {
+  return Dual<N>::Chain(x, std::sin(x.Value()), std::cos(x.Value()));
+}
+
+template <int N>
+Dual<N> cos(const Dual<N>& x) {
+  return Dual<N>::Chain(x, std::cos(x.Value()), -std::sin(x.Value()));
+}
+
+template <int N>
+Dual<N> tan(const Dual<N>& x) {
+  const sfloat t = std::tan(x.Value());
+  return Dual<N>::Chain(x, t, 1 + t * t);
+}
+
+template <int N>
+Dual<N> asin(const Dual<N>& x) {
+  const sfloat v = x.Value();
+  return Dual<N>::Chain(x, std::asin(v), 1 / std::sqrt(1 - v * v));
+}
+
+template <int N>
+Dual<N> acos(const Dual<N>& x) {
+  const sfloat v = x.Value();
+  return Dual<N>::Chain(x, std::acos(v), -1 / std::sqrt(1 - v * v));
+}
+
+template <int N>
+Dual<N> atan(const Dual<N>& x) {
+  const sfloat v = x.Value();
+  return Dual<N>::Chain(x, std::atan(v), 1 / (1 + v * v));
+}
+
+template <int N>
+Dual<N> atan2(const Dual<N>& y, const Dual<N>& x) {
+  // d atan2(y, x) = (x dy - y dx) / (x^2 + y^2)
+  const sfloat inv_r2 = 1 / (x.Value() * x.Value() + y.Value() * y.Value());
+  return Dual<N>::Chain(y, std::atan2(y.Value(), x.Value()), x.Value() * inv_r2) -
+         Dual<N>::Chain(x, 0, y.Value() * inv_r2);
+}
+
+template <int N>
+Dual<N> exp(const Dual<N>& x) {
+  const sfloat e = std::exp(x.Value());
+  return Dual<N>::Chain(x, e, e);
+}
+
+template <int N>
+Dual<N> log(const Dual<N>& x) {
+  return Dual<N>::Chain(x, std::log(x.Value()), 1 / x.Value());
+}
+
+template <int N>
+Dual<N> pow(const Dual<N>& x, sfloat p) {
+  const sfloat xp = std::pow(x.Value(), p - 1);
+  return Dual<N>::Chain(x, xp * x.Value(), p * xp);
+}
+
+template <int N>
+Dual<N> abs(const Dual<N>& x) {
+  return x.Value() < 0 ? -x : x;
+}
+
+template <int N>
+Dual<N> fabs(const Dual<N>& x) {
+  return abs(x);
+}
+
+}  // namespace star
@@ -0,0 +1,207 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <type_traits>
+
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * Lazy element-wise arithmetic.
+ *
+ * Vec3, Vec4, Mat3, Mat4 and Mat43 derive from Expression, and so do the nodes returned by
+ * the arithmetic operators below. A node only stores its operands, so an expression like
+ * `a + 2.0 * b - c / d` builds no temporaries and is evaluated element by element, in a
+ * single pass, when it is assigned to (or used to construct) a concrete type.
+ *
+ * Every expression provides
+ *  - `kSize`, the number of elements,
+ *  - `ResultType`, the concrete type it evaluates to, whose `Scalar` is the element type,
+ *  - `operator[](int)`, returning the k-th element in storage order.
+ *
+ * Element-wise products and quotients of two expressions are only defined for vectors;
+ * for matrices `operator*` is the matrix product (see matrix_multiplication.hpp).
+ */
+template <class Derived>
+class Expression {
+ public:
+  const Derived& Cast() const { return static_cast<const Derived&>(*this); }
+};
+
+/*-------------------------------------
+ * Operations
+ *-----------------------------------*/
+struct AddOp {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) { return a + b; }
+};
+struct SubOp {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) { return a - b; }
+};
+struct MulOp {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) { return a * b; }
+};
+struct DivOp {
+  template <class A, class B>
+  static auto Apply(const A& a, const B& b) { return a / b; }
+};
+
+/*-------------------------------------
+ * Expression Nodes
+ *-----------------------------------*/
+// A scalar broadcast to every element of the other operand
+template <class S>
+class ScalarExpression {
+ public:
+  explicit ScalarExpression(const S& value) : value_(value) {}
+  const S& operator[](int) const { return value_; }
+
+ private:
+  S value_;
+};
+
+template <class Op, class L, class R>
+class BinaryExpression;
+
+// Concrete types are stored by reference, nodes and scalars by value since they are
+// temporaries that would otherwise go out of scope before the expression is evaluated.
+template <class E>
+struct ExpressionOperand {
+  using type = const E&;
+};
+template <class Op, class L, class R>
+struct ExpressionOperand<BinaryExpression<Op, L, R>> {
+  using type = const BinaryExpression<Op, L, R>;
+};
+template <class S>
+struct ExpressionOperand<ScalarExpression<S>> {
+  using type = const ScalarExpression<S>;
+};
+
+template <class L, class R>
+struct ExpressionResult {
+  using type = typename L::ResultType;
+};
+template <class S, class R>
+struct ExpressionResult<ScalarExpression<S>, R> {
+  using type = typename R::ResultType;
+};
+
+template <class Op, class L, class R>
+class BinaryExpression : public Expression<BinaryExpression<Op, L, R>> {
+ public:
+  using ResultType = typename ExpressionResult<L, R>::type;
+  static constexpr int kSize = ResultType::kSize;
+
+  BinaryExpression(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+
+  auto operator[](int k) const { return Op::Apply(lhs_[k], rhs_[k]); }
+
+ private:
+  typename ExpressionOperand<L>::type lhs_;
+  typename ExpressionOperand<R>::type rhs_;
+};
+
+/*-------------------------------------
+ * Type Traits
+ *-----------------------------------*/
+template <class T, class = void>
+struct IsMatrix : std::false_type {};
+template <class T>
+struct IsMatrix<T, std::void_t<decltype(T::kCols)>> : std::true_type {};
+
+// Expression E evaluates to T
+template <class E, class T>
+using EnableIfResult = std::enable_if_t<std::is_same_v<typename E::ResultType, T>, int>;
+
+// Both operands evaluate to the same type
+template <class L, class R>
+using EnableIfSameResult =
+    std::enable_if_t<std::is_same_v<typename L::ResultType, typename R::ResultType>, int>;
+
+// Both operands evaluate to the same vector type
+template <class L, class R>
+using EnableIfSameVector =
+    std::enable_if_t<std::is_same_v<typename L::ResultType, typename R::ResultType> &&
+                         !IsMatrix<typename L::ResultType>::value,
+                     int>;
+
+/*-------------------------------------
+ * Operators
+ *-----------------------------------*/
+template <class L, class R, EnableIfSameResult<L, R> = 0>
+BinaryExpression<AddOp, L, R> operator+(const Expression<L>& lhs,
+                                        const Expression<R>& rhs) {
+  return {lhs.Cast(), rhs.Cast()};
+}
+template <class L, class R, EnableIfSameResult<L, R> = 0>
+BinaryExpression<SubOp, L, R> operator-(const Expression<L>& lhs,
+                                        const Expression<R>& rhs) {
+  return {lhs.Cast(), rhs.Cast()};
+}
+template <class L, class R, EnableIfSameVector<L, R> = 0>
+BinaryExpression<MulOp, L, R> operator*(const Expression<L>& lhs,
+                                        const Expression<R>& rhs) {
+  return {lhs.Cast(), rhs.Cast()};
+}
+template <class L, class R, EnableIfSameVector<L, R> = 0>
+BinaryExpression<DivOp, L, R> operator/(const Expression<L>& lhs,
+                                        const Expression<R>& rhs) {
+  return {lhs.Cast(), rhs.Cast()};
+}
+
+// Scalar operators, which take the scalar type of the expression, e.g. sfloat for Vec3 and
+// Dual<6> for Vector<3, Dual<6>>
+template <class E>
+using ScalarOf = typename E::ResultType::Scalar;
+
+template <class L>
+BinaryExpression<AddOp, L, ScalarExpression<ScalarOf<L>>> operator+(
+    const Expression<L>& lhs, const ScalarOf<L>& rhs) {
+  return {lhs.Cast(), ScalarExpression<ScalarOf<L>>(rhs)};
+}
+template <class L>
+BinaryExpression<SubOp, L, ScalarExpression<ScalarOf<L>>> operator-(
+    const Expression<L>& lhs, const ScalarOf<L>& rhs) {
+  return {lhs.Cast(), ScalarExpression<ScalarOf<L>>(rhs)};
+}
+template <class L>
+BinaryExpression<MulOp, L, ScalarExpression<ScalarOf<L>>> operator*(
+    const Expression<L>& lhs, const ScalarOf<L>& rhs) {
+  return {lhs.Cast(), ScalarExpression<ScalarOf<L>>(rhs)};
+}
+template <class L>
+BinaryExpression<DivOp, L, ScalarExpression<ScalarOf<L>>> operator/(
+    const Expression<L>& lhs, const ScalarOf<L>& rhs) {
+  return {lhs.Cast(), ScalarExpression<ScalarOf<L>>(rhs)};
+}
+
+template <class R>
+BinaryExpression<AddOp, ScalarExpression<ScalarOf<R>>, R> operator+(
+    const ScalarOf<R>& lhs, const Expression<R>& rhs) {
+  return {ScalarExpression<ScalarOf<R>>(lhs), rhs.Cast()};
+}
+template <class R>
+BinaryExpression<SubOp, ScalarExpression<ScalarOf<R>>, R> operator-(
+    const ScalarOf<R>& lhs, const Expression<R>& rhs) {
+  return {ScalarExpression<ScalarOf<R>>(lhs), rhs.Cast()};
+}
+template <class R>
+BinaryExpression<MulOp, ScalarExpression<ScalarOf<R>>, R> operator*(
+    const ScalarOf<R>& lhs, const Expression<R>& rhs) {
+  return {ScalarExpression<ScalarOf<R>>(lhs), rhs.Cast()};
+}
+template <class R>
+BinaryExpression<DivOp, ScalarExpression<ScalarOf<R>>, R> operator/(
+    const ScalarOf<R>& lhs, const Expression<R>& rhs) {
+  return {ScalarExpression<ScalarOf<R>>(lhs), rhs.Cast()};
+}
+
+}  // namespace star
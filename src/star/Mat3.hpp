@@ -5,96 +5,238 @@
 
 #pragma once
 
+#include "MatrixBase.hpp"
 #include "Vec3.hpp"
+#include "matrix_kernels.hpp"
 #include "typedefs.h"
 
 namespace star {
 
-class Mat3 {
+template <class T>
+class Matrix<3, 3, T> : public MatrixBase<3, 3, T> {
+  using Base = MatrixBase<3, 3, T>;
+
  public:
-  // Size information
-  static constexpr int kRows = 3;
-  static constexpr int kCols = 3;
-  static constexpr int kSize = 9;
-  constexpr int Rows() const { return kRows; }
-  constexpr int Cols() const { return kCols; }
-  constexpr int Size() const { return kSize; }
+  using Base::kRows;
+  using Base::kSize;
+  using Base::operator=;
 
   /*-------------------------------------
    * Constructors
    *-----------------------------------*/
-  Mat3() = default;
-  Mat3(sfloat x00, sfloat x10, sfloat x20, sfloat x01, sfloat x11, sfloat x21, sfloat x02,
-       sfloat x12, sfloat x22);
+  Matrix() = default;
+  constexpr Matrix(T x00, T x10, T x20, T x01, T x11, T x21, T x02, T x12, T x22)
+      : Base(x00, x10, x20, x01, x11, x21, x02, x12, x22) {}
 
-  template <class Vector>
-  explicit Mat3(Vector v) {
+  template <class V>
+  explicit Matrix(V v) {
     for (int i = 0; i < kSize; ++i) {
       data_[i] = v[i];
     }
   }
 
+  // Evaluate an element-wise expression, e.g. Mat3 C = A + 2.0 * B;
+  template <class E, EnableIfResult<E, Matrix> = 0>
+  Matrix(const Expression<E>& expr) {  // NOLINT: Allow implicit conversion
+    *this = expr;
+  }
+
   /*-------------------------------------
    * Static Methods
    *-----------------------------------*/
-  static Mat3 ByRows(sfloat x00, sfloat x01, sfloat x02, sfloat x10, sfloat x11, sfloat x12,
-                     sfloat x20, sfloat x21, sfloat x22);
-  static Mat3 Zero();
-  static Mat3 Identity();
-  static Mat3 Const(sfloat value);
-  static Mat3 Diagonal(sfloat value);
-  static Mat3 Diagonal(const Mat3& m);
-  static Mat3 Diagonal(sfloat x, sfloat y, sfloat z);
-
-  template <class Vector>
-  static Mat3 Diagonal(Vector v) {
-    return Mat3::Diagonal(v[0], v[1], v[2]);
+  static constexpr Matrix ByRows(T x00, T x01, T x02, T x10, T x11, T x12, T x20, T x21,
+                                 T x22) {
+    return {x00, x10, x20, x01, x11, x21, x02, x12, x22};
+  }
+  static constexpr Matrix Zero() { return Const(0); }
+  static constexpr Matrix Identity() { return Diagonal(T(1)); }
+  static constexpr Matrix Const(T value) {
+    return {value, value, value, value, value, value, value, value, value};
+  }
+  static constexpr Matrix Diagonal(T value) { return Diagonal(value, value, value); }
+  static constexpr Matrix Diagonal(const Matrix& m) { return Diagonal(m[0], m[4], m[8]); }
+  static constexpr Matrix Diagonal(T x, T y, T z) { return {x, 0, 0, 0, y, 0, 0, 0, z}; }
+
+  template <class V>
+  static constexpr Matrix Diagonal(V v) {
+    return Matrix::Diagonal(v[0], v[1], v[2]);
   }
 
   /*-------------------------------------
    * Getters
    *-----------------------------------*/
-  Vec3 GetRow(int row) const;
-  Vec3 GetCol(int col) const;
-  Vec3 GetDiagonal() const;
+  constexpr Vector<3, T> GetRow(int row) const {
+    return {data_[row], data_[row + 3], data_[row + 6]};
+  }
+  constexpr Vector<3, T> GetCol(int col) const {
+    return {data_[col * 3], data_[col * 3 + 1], data_[col * 3 + 2]};
+  }
+  constexpr Vector<3, T> GetDiagonal() const { return {data_[0], data_[4], data_[8]}; }
 
   /*-------------------------------------
    * Setters
    *-----------------------------------*/
-  void SetRow(int row, const Vec3& v);
-  void SetCol(int col, const Vec3& v);
+  void SetRow(int row, const Vector<3, T>& v);
+  void SetCol(int col, const Vector<3, T>& v);
   void SetZero();
   void SetIdentity();
-  void SetConst(sfloat value);
-  void SetDiagonal(sfloat value);
-  void SetDiagonal(const Mat3& m);
-  void SetDiagonal(sfloat x, sfloat y, sfloat z);
-  void SetDiagonal(const Vec3& v);
+  void SetConst(T value);
+  void SetDiagonal(T value);
+  void SetDiagonal(const Matrix& m);
+  void SetDiagonal(T x, T y, T z);
+  void SetDiagonal(const Vector<3, T>& v);
 
   /*-------------------------------------
    * Data Access
    *-----------------------------------*/
-  sfloat& operator[](int i) { return data_[i]; }
-  const sfloat& operator[](int i) const { return data_[i]; }
-  sfloat& operator[](IndexPair ij) { return data_[std::get<0>(ij) + kRows * std::get<1>(ij)]; }
-  const sfloat& operator[](IndexPair ij) const {
-    return data_[std::get<0>(ij) + kRows * std::get<1>(ij)];
-  }
-
-  sfloat& operator()(int i, int j) { return data_[i * kCols + j]; }
-  const sfloat& operator()(int i, int j) const { return data_[i * kCols + j]; }
-  sfloat* data() { return data_; }
-  const sfloat* data() const { return data_; }
+  constexpr T& operator()(int i, int j) { return data_[i + kRows * j]; }
+  constexpr const T& operator()(int i, int j) const { return data_[i + kRows * j]; }
 
   /*-------------------------------------
    * Linear Algebra
    *-----------------------------------*/
-  Mat3 Transpose() const;
-  Mat3& TransposeInPlace();
-  // TODO: Add linear algebra
+  constexpr Matrix Transpose() const {
+    return ByRows(data_[0], data_[1], data_[2], data_[3], data_[4], data_[5], data_[6],
+                  data_[7], data_[8]);
+  }
+  Matrix& TransposeInPlace();
+  T Determinant() const;
+
+  // Decompositions, see matrix3.h for their conventions
+  bool Cholesky(Matrix& U) const;
+  void QR(Matrix& Q, Matrix& R) const;
+  void LU(Matrix& L, Matrix& U, int perm[3]) const;
+  void Eigen(Vector<3, T>& eigenvalues, Matrix& eigenvectors) const;
+  void SVD(Matrix& U, Vector<3, T>& S, Matrix& V) const;
+
+  // Solves and inverses. The PSD variants return false if the matrix isn't positive
+  // definite
+  bool CholSolve(Vector<3, T>& x, const Vector<3, T>& b) const;
+  Matrix Inverse() const;
+  Matrix& InverseInPlace();
+  bool InversePSDInPlace();
 
- private:
-  sfloat data_[kSize];
+ protected:
+  using Base::data_;
 };
 
+/*-------------------------------------
+ * Setters
+ *-----------------------------------*/
+template <class T>
+void Matrix<3, 3, T>::SetRow(int row, const Vector<3, T>& v) {
+  data_[row] = v[0];
+  data_[row + 3] = v[1];
+  data_[row + 6] = v[2];
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetCol(int col, const Vector<3, T>& v) {
+  data_[col * 3] = v[0];
+  data_[col * 3 + 1] = v[1];
+  data_[col * 3 + 2] = v[2];
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetZero() {
+  *this = Zero();
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetIdentity() {
+  SetDiagonal(T(1));
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetConst(T value) {
+  *this = Const(value);
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetDiagonal(T value) {
+  *this = Diagonal(value);
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetDiagonal(const Matrix& m) {
+  SetDiagonal(m.GetDiagonal());
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetDiagonal(T x, T y, T z) {
+  SetDiagonal(Vector<3, T>(x, y, z));
+}
+
+template <class T>
+void Matrix<3, 3, T>::SetDiagonal(const Vector<3, T>& v) {
+  data_[0] = v[0];
+  data_[4] = v[1];
+  data_[8] = v[2];
+}
+
+/*-------------------------------------
+ * Linear Algebra
+ *-----------------------------------*/
+template <class T>
+Matrix<3, 3, T>& Matrix<3, 3, T>::TransposeInPlace() {
+  *this = Transpose();
+  return *this;
+}
+
+template <class T>
+T Matrix<3, 3, T>::Determinant() const {
+  return Det33(data_);
+}
+
+template <class T>
+bool Matrix<3, 3, T>::Cholesky(Matrix& U) const {
+  return Chol33(U.data(), data_);
+}
+
+template <class T>
+void Matrix<3, 3, T>::QR(Matrix& Q, Matrix& R) const {
+  QR33(Q.data(), R.data(), data_);
+}
+
+template <class T>
+void Matrix<3, 3, T>::LU(Matrix& L, Matrix& U, int perm[3]) const {
+  LU33(L.data(), U.data(), perm, data_);
+}
+
+template <class T>
+void Matrix<3, 3, T>::Eigen(Vector<3, T>& eigenvalues, Matrix& eigenvectors) const {
+  Eigen33(eigenvalues.data(), eigenvectors.data(), data_);
+}
+
+template <class T>
+void Matrix<3, 3, T>::SVD(Matrix& U, Vector<3, T>& S, Matrix& V) const {
+  SVD33(U.data(), S.data(), V.data(), data_);
+}
+
+template <class T>
+bool Matrix<3, 3, T>::CholSolve(Vector<3, T>& x, const Vector<3, T>& b) const {
+  return CholSolve33(x.data(), data_, b.data());
+}
+
+template <class T>
+Matrix<3, 3, T> Matrix<3, 3, T>::Inverse() const {
+  Matrix mat = *this;
+  return mat.InverseInPlace();
+}
+
+template <class T>
+Matrix<3, 3, T>& Matrix<3, 3, T>::InverseInPlace() {
+  Inverse33(data_);
+  return *this;
+}
+
+template <class T>
+bool Matrix<3, 3, T>::InversePSDInPlace() {
+  return InversePSD33(data_);
+}
+
+#ifndef STAR_HEADER_ONLY
+extern template class Matrix<3, 3>;
+#endif
+
 }  // namespace star
@@ -5,75 +5,82 @@
 
 #pragma once
 
+#include "star/MatrixBase.hpp"
 #include "star/Vec4.hpp"
+#include "star/matrix_kernels.hpp"
 #include "typedefs.h"
 
 namespace star {
 
-class Mat4 {
+template <class T>
+class Matrix<4, 4, T> : public MatrixBase<4, 4, T> {
+  using Base = MatrixBase<4, 4, T>;
+
  public:
-  // Size Info
-  static constexpr int kRows = 4;
-  static constexpr int kCols = 4;
-  static constexpr int kSize = 16;
-  constexpr int Rows() const { return kRows; }
-  constexpr int Cols() const { return kCols; }
-  constexpr int Size() const { return kSize; }
+  using Base::kRows;
+  using Base::kSize;
+  using Base::operator=;
 
   /*-------------------------------------
    * Constructors
    *-----------------------------------*/
-  Mat4() = default;
-  Mat4(sfloat x00, sfloat x10, sfloat x20, sfloat x30, sfloat x01, sfloat x11, sfloat x21,
-       sfloat x31, sfloat x02, sfloat x12, sfloat x22, sfloat x32, sfloat x03, sfloat x13,
-       sfloat x23, sfloat x33);
+  Matrix() = default;
+  constexpr Matrix(T x00, T x10, T x20, T x30, T x01, T x11, T x21, T x31, T x02, T x12,
+                   T x22, T x32, T x03, T x13, T x23, T x33)
+      : Base(x00, x10, x20, x30, x01, x11, x21, x31, x02, x12, x22, x32, x03, x13, x23,
+             x33) {}
 
-  template <class Vector>
-  explicit Mat4(Vector v) {
+  template <class V>
+  explicit Matrix(V v) {
     for (int i = 0; i < kSize; ++i) {
       data_[i] = v[i];
     }
   }
 
+  // Evaluate an element-wise expression, e.g. Mat4 C = A + 2.0 * B;
+  template <class E, EnableIfResult<E, Matrix> = 0>
+  Matrix(const Expression<E>& expr) {  // NOLINT: Allow implicit conversion
+    *this = expr;
+  }
+
   /*-------------------------------------
    * Static Methods
    *-----------------------------------*/
-  static Mat4 ByRows(sfloat x00, sfloat x01, sfloat x02, sfloat x03, sfloat x10, sfloat x11,
-                     sfloat x12, sfloat x13, sfloat x20, sfloat x21, sfloat x22, sfloat x23,
-                     sfloat x30, sfloat x31, sfloat x32, sfloat x33);
-  static Mat4 Zero();
-  static Mat4 Identity();
-  static Mat4 Const(sfloat value);
-  static Mat4 Diagonal(sfloat value);
-  static Mat4 Diagonal(sfloat x, sfloat y, sfloat z, sfloat w);
-  static Mat4 Diagonal(const Mat4& m);
-
-  template <class Vector>
-  static Mat4 Diagonal(Vector v) {
-    return Mat4::Diagonal(v[0], v[1], v[2], v[3]);
+  static Matrix ByRows(T x00, T x01, T x02, T x03, T x10, T x11, T x12, T x13, T x20, T x21,
+                       T x22, T x23, T x30, T x31, T x32, T x33);
+  static Matrix Zero();
+  static Matrix Identity();
+  static Matrix Const(T value);
+  static Matrix Diagonal(T value);
+  static Matrix Diagonal(T x, T y, T z, T w);
+  static Matrix Diagonal(const Matrix& m);
+
+  template <class V>
+  static Matrix Diagonal(V v) {
+    return Matrix::Diagonal(v[0], v[1], v[2], v[3]);
   }
 
   /*-------------------------------------
    * Getters
    *-----------------------------------*/
-  Vec4 GetRow(int row) const;
-  Vec4 GetCol(int col) const;
-  Vec4 GetDiagonal() const;
+  Vector<4, T> GetRow(int row) const;
+  Vector<4, T> GetCol(int col) const;
+  Vector<4, T> GetDiagonal() const;
 
   /*-------------------------------------
    * Setters
    *-----------------------------------*/
-  void SetRow(int row, const Vec4& v);
-  void SetCol(int col, const Vec4& v);
+  void SetRow(int row, const Vector<4, T>& v);
+  void SetCol(int col, const Vector<4, T>& v);
   void SetZero();
   void SetIdentity();
-  void SetConst(sfloat value);
-  void SetDiagonal(sfloat value);
-  void SetDiagonal(const Mat4& m);
-  void SetDiagonal(sfloat x, sfloat y, sfloat z, sfloat w);
+  void SetConst(T value);
+  void SetDiagonal(T value);
+  void SetDiagonal(const Matrix& m);
+  void SetDiagonal(T x, T y, T z, T w);
 
-  template <class Vector>
-  void SetDiagonal(Vector v) {
+  template <class V>
+  void SetDiagonal(V v) {
     SetDiagonal(v[0], v[1], v[2], v[3]);
   }
 
@@ -81,26 +88,175 @@ class Mat4 {
    * Linear Algebra
    *-----------------------------------*/
   // TODO: Add linear algebra
-  Mat4 Transpose() const;
-  Mat4& TransposeInPlace();
+  Matrix Transpose() const;
+  Matrix& TransposeInPlace();
+
+  // Eigendecomposition of a symmetric matrix, see matrix4.h for its conventions
+  void Eigen(Vector<4, T>& eigenvalues, Matrix& eigenvectors) const;
 
   /*-------------------------------------
    * Data Access
    *-----------------------------------*/
-  sfloat& operator[](int index) { return data_[index]; }
-  const sfloat& operator[](int index) const { return data_[index]; }
-  sfloat& operator[](IndexPair ij) { return data_[std::get<0>(ij) + kRows * std::get<1>(ij)]; }
-  const sfloat& operator[](IndexPair ij) const {
-    return data_[std::get<0>(ij) + kRows * std::get<1>(ij)];
+  T& operator()(int row, int col) { return data_[row + col * kRows]; }
+  const T& operator()(int row, int col) const { return data_[row + col * kRows]; }
+
+ protected:
+  using Base::data_;
+};
+
+/*-------------------------------------
+ * Static Methods
+ * -----------------------------------*/
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::ByRows(T x00, T x01, T x02, T x03, T x10, T x11, T x12,
+                                        T x13, T x20, T x21, T x22, T x23, T x30, T x31,
+                                        T x32, T x33) {
+  return {x00, x10, x20, x30, x01, x11, x21, x31, x02, x12, x22, x32, x03, x13, x23, x33};
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Zero() {
+  Matrix mat;
+  mat.SetZero();
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Identity() {
+  Matrix mat;
+  mat.SetIdentity();
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Const(T value) {
+  Matrix mat;
+  mat.SetConst(value);
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Diagonal(T value) {
+  Matrix mat;
+  mat.SetDiagonal(value);
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Diagonal(T x, T y, T z, T w) {
+  Matrix mat = Zero();
+  mat.SetDiagonal(x, y, z, w);
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Diagonal(const Matrix& m) {
+  return Diagonal(m[0], m[5], m[10], m[15]);
+}
+
+/*-------------------------------------
+ * Getters
+ *-----------------------------------*/
+template <class T>
+Vector<4, T> Matrix<4, 4, T>::GetRow(int row) const {
+  return {data_[row], data_[row + 4], data_[row + 8], data_[row + 12]};
+}
+
+template <class T>
+Vector<4, T> Matrix<4, 4, T>::GetCol(int col) const {
+  return {data_[col * 4], data_[col * 4 + 1], data_[col * 4 + 2], data_[col * 4 + 3]};
+}
+
+template <class T>
+Vector<4, T> Matrix<4, 4, T>::GetDiagonal() const {
+  return {data_[0], data_[5], data_[10], data_[15]};
+}
+
+/*-------------------------------------
+ * Setters
+ *-----------------------------------*/
+
+template <class T>
+void Matrix<4, 4, T>::SetRow(int row, const Vector<4, T>& v) {
+  data_[row] = v[0];
+  data_[row + 4] = v[1];
+  data_[row + 8] = v[2];
+  data_[row + 12] = v[3];
+}
+
+template <class T>
+void Matrix<4, 4, T>::SetCol(int col, const Vector<4, T>& v) {
+  data_[col * 4] = v[0];
+  data_[col * 4 + 1] = v[1];
+  data_[col * 4 + 2] = v[2];
+  data_[col * 4 + 3] = v[3];
+}
+
+template <class T>
+void Matrix<4, 4, T>::SetZero() {
+  SetConst(0);
+}
+
+template <class T>
+void Matrix<4, 4, T>::SetIdentity() {
+  SetDiagonal(T(1));
+}
+
+template <class T>
+void Matrix<4, 4, T>::SetConst(T value) {
+  for (int k = 0; k < kSize; ++k) {
+    data_[k] = value;
   }
+}
 
-  sfloat& operator()(int row, int col) { return data_[row + col * kRows]; }
-  const sfloat& operator()(int row, int col) const { return data_[row + col * kRows]; }
-  sfloat* data() { return data_; }
-  const sfloat* data() const { return data_; }
+template <class T>
+void Matrix<4, 4, T>::SetDiagonal(T value) {
+  SetZero();
+  SetDiagonal(value, value, value, value);
+}
 
- private:
-  sfloat data_[kSize];
-};
+template <class T>
+void Matrix<4, 4, T>::SetDiagonal(T x, T y, T z, T w) {
+  data_[0] = x;
+  data_[5] = y;
+  data_[10] = z;
+  data_[15] = w;
+}
+
+template <class T>
+void Matrix<4, 4, T>::SetDiagonal(const Matrix& m) {
+  SetDiagonal(m[0], m[5], m[10], m[15]);
+}
+
+/*-------------------------------------
+ * Linear Algebra
+ *-----------------------------------*/
+
+template <class T>
+Matrix<4, 4, T> Matrix<4, 4, T>::Transpose() const {
+  Matrix mat;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      mat(j, i) = (*this)(i, j);
+    }
+  }
+  return mat;
+}
+
+template <class T>
+Matrix<4, 4, T>& Matrix<4, 4, T>::TransposeInPlace() {
+  *this = Transpose();
+  return *this;
+}
+
+template <class T>
+void Matrix<4, 4, T>::Eigen(Vector<4, T>& eigenvalues, Matrix& eigenvectors) const {
+  Eigen44(eigenvalues.data(), eigenvectors.data(), data_);
+}
+
+#ifndef STAR_HEADER_ONLY
+extern template class Matrix<4, 4>;
+#endif
 
-}  // namespace star
\ No newline at end of file
+}  // namespace star
@@ -5,77 +5,125 @@
 
 #pragma once
 
+#include "star/MatrixBase.hpp"
 #include "star/Vec3.hpp"
 #include "star/Vec4.hpp"
 #include "star/typedefs.h"
 
 namespace star {
 
-class Mat43 {
+template <class T>
+class Matrix<4, 3, T> : public MatrixBase<4, 3, T> {
+  using Base = MatrixBase<4, 3, T>;
+
  public:
-  // Size information
-  static constexpr int kRows = 4;
-  static constexpr int kCols = 3;
-  static constexpr int kSize = 12;
-  constexpr int Rows() const { return kRows; }
-  constexpr int Cols() const { return kCols; }
-  constexpr int Size() const { return kSize; }
+  using Base::kSize;
+  using Base::operator=;
 
   /*-------------------------------------
    * Constructors
    *-----------------------------------*/
-  Mat43() = default;
-  Mat43(sfloat x00, sfloat x10, sfloat x20, sfloat x30, sfloat x01, sfloat x11, sfloat x21,
-        sfloat x31, sfloat x02, sfloat x12, sfloat x22, sfloat x32)
-      : data_{x00, x10, x20, x30, x01, x11, x21, x31, x02, x12, x22, x32} {}
+  constexpr Matrix() : Base(0) {}  // Zero-initialized
+  constexpr Matrix(T x00, T x10, T x20, T x30, T x01, T x11, T x21, T x31, T x02, T x12,
+                   T x22, T x32)
+      : Base(x00, x10, x20, x30, x01, x11, x21, x31, x02, x12, x22, x32) {}
 
-  template <class Vector>
-  explicit Mat43(Vector v) {
+  template <class V>
+  explicit Matrix(V v) {
     for (int i = 0; i < kSize; ++i) {
       data_[i] = v[i];
     }
   }
 
+  // Evaluate an element-wise expression, e.g. Mat43 C = A + 2.0 * B;
+  template <class E, EnableIfResult<E, Matrix> = 0>
+  Matrix(const Expression<E>& expr) {  // NOLINT: Allow implicit conversion
+    *this = expr;
+  }
+
   /*-------------------------------------
    * Static Methods
    *-----------------------------------*/
-  static Mat43 ByRows(sfloat x00, sfloat x01, sfloat x02, sfloat x10, sfloat x11,
-                      sfloat x12, sfloat x20, sfloat x21, sfloat x22, sfloat x30,
-                      sfloat x31, sfloat x32);
-  static Mat43 Zero();
-  static Mat43 Const(sfloat value);
+  static constexpr Matrix ByRows(T x00, T x01, T x02, T x10, T x11, T x12, T x20, T x21,
+                                 T x22, T x30, T x31, T x32) {
+    return {x00, x10, x20, x30, x01, x11, x21, x31, x02, x12, x22, x32};
+  }
+  static Matrix Zero();
+  static Matrix Const(T value);
 
   /*-------------------------------------
    * Getters
    *-----------------------------------*/
-  Vec3 GetRow(int i) const { return {data_[i * 3], data_[i * 3 + 1], data_[i * 3 + 2]}; }
-  Vec4 GetCol(int j) const { return {data_[j], data_[j + 3], data_[j + 6], data_[j + 9]}; }
+  Vector<3, T> GetRow(int i) const { return {data_[i], data_[i + 4], data_[i + 8]}; }
+  Vector<4, T> GetCol(int j) const {
+    return {data_[4 * j], data_[4 * j + 1], data_[4 * j + 2], data_[4 * j + 3]};
+  }
 
   /*-------------------------------------
    * Setters
    *-----------------------------------*/
-  void SetRow(int i, const Vec3& v);
-  void SetCol(int j, const Vec4& v);
+  void SetRow(int i, const Vector<3, T>& v);
+  void SetCol(int j, const Vector<4, T>& v);
   void SetZero();
-  void SetConst(sfloat value);
+  void SetConst(T value);
 
   /*-------------------------------------
    * Data Access
    * -----------------------------------*/
-  sfloat& operator[](int k) { return data_[k]; }
-  const sfloat& operator[](int k) const { return data_[k]; }
-  sfloat& operator[](IndexPair ij) { return data_[std::get<0>(ij) + kRows * std::get<1>(ij)]; }
-  const sfloat& operator[](IndexPair ij) const {
-    return data_[std::get<0>(ij) + kRows * std::get<1>(ij)];
-  }
+  constexpr T& operator()(int i, int j) { return data_[i + 4 * j]; }
+  constexpr const T& operator()(int i, int j) const { return data_[i + 4 * j]; }
 
-  sfloat& operator()(int i, int j) { return data_[i + 4 * j]; }
-  const sfloat& operator()(int i, int j) const { return data_[i + 4 * j]; }
-  sfloat* data() { return data_; }
-  const sfloat* data() const { return data_; }
-
- private:
-  sfloat data_[kSize] = {0};
+ protected:
+  using Base::data_;
 };
 
-}  // namespace star
\ No newline at end of file
+template <class T>
+Matrix<4, 3, T> Matrix<4, 3, T>::Zero() {
+  Matrix mat;
+  mat.SetZero();
+  return mat;
+}
+
+template <class T>
+Matrix<4, 3, T> Matrix<4, 3, T>::Const(T value) {
+  Matrix mat;
+  mat.SetConst(value);
+  return mat;
+}
+
+/*-------------------------------------
+ * Setters
+ *-----------------------------------*/
+
+template <class T>
+void Matrix<4, 3, T>::SetRow(int i, const Vector<3, T>& v) {
+  data_[i] = v[0];
+  data_[i + 4] = v[1];
+  data_[i + 8] = v[2];
+}
+
+template <class T>
+void Matrix<4, 3, T>::SetCol(int j, const Vector<4, T>& v) {
+  data_[j * 4] = v[0];
+  data_[j * 4 + 1] = v[1];
+  data_[j * 4 + 2] = v[2];
+  data_[j * 4 + 3] = v[3];
+}
+
+template <class T>
+void Matrix<4, 3, T>::SetZero() {
+  SetConst(0);
+}
+
+template <class T>
+void Matrix<4, 3, T>::SetConst(T value) {
+  for (int k = 0; k < kSize; ++k) {
+    data_[k] = value;
+  }
+}
+
+#ifndef STAR_HEADER_ONLY
+extern template class Matrix<4, 3>;
+#endif
+
+}  // namespace star
@@ -0,0 +1,149 @@
+//
+// Created by Brian Jackson on 5/16/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <type_traits>
+
+#include "star/Mat3.hpp"
+#include "star/Mat4.hpp"
+#include "star/Mat43.hpp"
+#include "star/MatrixBase.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief Fixed-size R x C matrix of any shape and scalar type
+ *
+ * Used for shapes without hand-written kernels, e.g. 3x4, 6x6 or 12x12 Jacobians, of any
+ * scalar type, e.g. Matrix<6, 6, Dual<6>> to differentiate through products and solves. All
+ * storage lives in the object, so nothing is allocated on the heap. The 3x3, 4x4 and 4x3
+ * shapes are the partial specializations in Mat3.hpp, Mat4.hpp and Mat43.hpp.
+ */
+template <int R, int C, class T>
+class Matrix : public MatrixBase<R, C, T> {
+  using Base = MatrixBase<R, C, T>;
+
+ public:
+  using Base::kCols;
+  using Base::kRows;
+  using Base::kSize;
+  using Base::operator=;
+
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  Matrix() = default;
+
+  // Elements in column-major order, e.g. Matrix<2, 2> A = {a00, a10, a01, a11};
+  template <class... U,
+            std::enable_if_t<sizeof...(U) == R * C &&
+                                 ((std::is_arithmetic_v<U> || std::is_same_v<U, T>) && ...),
+                             int> = 0>
+  constexpr Matrix(U... values) : Base(values...) {}  // NOLINT: Allow brace initialization
+
+  // Evaluate an element-wise expression, e.g. Matrix<6, 6> C = A + 2.0 * B;
+  template <class E, EnableIfResult<E, Matrix> = 0>
+  Matrix(const Expression<E>& expr) {  // NOLINT: Allow implicit conversion
+    *this = expr;
+  }
+
+  /*-------------------------------------
+   * Static Methods
+   *-----------------------------------*/
+  // Elements in row-major order
+  template <class... U, std::enable_if_t<sizeof...(U) == R * C, int> = 0>
+  static constexpr Matrix ByRows(U... values) {
+    const T rows[] = {static_cast<T>(values)...};
+    Matrix mat{};
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        mat(i, j) = rows[j + C * i];
+      }
+    }
+    return mat;
+  }
+  static constexpr Matrix Zero() { return Matrix{}; }
+  static constexpr Matrix Const(T value) {
+    Matrix mat{};
+    for (int k = 0; k < kSize; ++k) {
+      mat[k] = value;
+    }
+    return mat;
+  }
+  static constexpr Matrix Identity() {
+    Matrix mat{};
+    for (int i = 0; i < R && i < C; ++i) {
+      mat(i, i) = 1;
+    }
+    return mat;
+  }
+
+  /*-------------------------------------
+   * Blocks
+   *-----------------------------------*/
+  // The BR x BC block starting at row i and column j
+  template <int BR, int BC>
+  Matrix<BR, BC, T> GetBlock(int i, int j) const {
+    Matrix<BR, BC, T> block;
+    for (int bj = 0; bj < BC; ++bj) {
+      for (int bi = 0; bi < BR; ++bi) {
+        block[bi + BR * bj] = (*this)(i + bi, j + bj);
+      }
+    }
+    return block;
+  }
+
+  template <int BR, int BC>
+  void SetBlock(int i, int j, const Matrix<BR, BC, T>& block) {
+    for (int bj = 0; bj < BC; ++bj) {
+      for (int bi = 0; bi < BR; ++bi) {
+        (*this)(i + bi, j + bj) = block[bi + BR * bj];
+      }
+    }
+  }
+
+  /*-------------------------------------
+   * Data Access
+   *-----------------------------------*/
+  constexpr T& operator()(int i, int j) { return this->data_[i + R * j]; }
+  constexpr const T& operator()(int i, int j) const { return this->data_[i + R * j]; }
+
+  /*-------------------------------------
+   * Linear Algebra
+   *-----------------------------------*/
+  constexpr Matrix<C, R, T> Transpose() const {
+    Matrix<C, R, T> mat{};
+    for (int j = 0; j < C; ++j) {
+      for (int i = 0; i < R; ++i) {
+        mat[j + C * i] = this->data_[i + R * j];
+      }
+    }
+    return mat;
+  }
+
+  // Square matrices only, see matrix_kernels.hpp for their conventions. The solves return
+  // false if the matrix is singular, or for CholSolve, not positive definite.
+  bool Cholesky(Matrix& U) const {
+    static_assert(R == C, "Cholesky requires a square matrix");
+    return CholFactor<R>(U.data(), this->data());
+  }
+
+  template <int N>
+  bool CholSolve(Matrix<R, N, T>& X, const Matrix<R, N, T>& B) const {
+    static_assert(R == C, "CholSolve requires a square matrix");
+    return star::CholSolve<R, N>(X.data(), this->data(), B.data());
+  }
+
+  template <int N>
+  bool Solve(Matrix<R, N, T>& X, const Matrix<R, N, T>& B) const {
+    static_assert(R == C, "Solve requires a square matrix");
+    return LUSolve<R, N>(X.data(), this->data(), B.data());
+  }
+};
+
+}  // namespace star
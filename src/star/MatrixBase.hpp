@@ -0,0 +1,120 @@
+//
+// Created by Brian Jackson on 5/16/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <tuple>
+
+#include "star/Expression.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief Fixed-size R x C matrix of scalars T stored in column-major order
+ *
+ * The generic template is defined in Matrix.hpp. The 3x3, 4x4 and 4x3 shapes are partial
+ * specializations, defined in Mat3.hpp, Mat4.hpp and Mat43.hpp, with the methods of the
+ * hand-written C kernels. For every scalar type, e.g. sfloat or the dual numbers in
+ * Dual.hpp, they call the templated counterparts of those kernels in matrix_kernels.hpp.
+ */
+template <int R, int C, class T = sfloat>
+class Matrix;
+
+template <class T>
+class Matrix<3, 3, T>;
+template <class T>
+class Matrix<4, 4, T>;
+template <class T>
+class Matrix<4, 3, T>;
+
+using Mat3 = Matrix<3, 3>;
+using Mat4 = Matrix<4, 4>;
+using Mat43 = Matrix<4, 3>;
+
+/*
+ * @brief Storage, size information, data access and element-wise operations shared by
+ * every Matrix<R, C, T>
+ */
+template <int R, int C, class T = sfloat>
+class MatrixBase : public Expression<Matrix<R, C, T>> {
+ public:
+  // Size information
+  static constexpr int kRows = R;
+  static constexpr int kCols = C;
+  static constexpr int kSize = R * C;
+  using Scalar = T;
+  using ResultType = Matrix<R, C, T>;
+  constexpr int Rows() const { return kRows; }
+  constexpr int Cols() const { return kCols; }
+  constexpr int Size() const { return kSize; }
+
+  /*-------------------------------------
+   * Element-wise Operations
+   *-----------------------------------*/
+  template <class E, EnableIfResult<E, Matrix<R, C, T>> = 0>
+  Matrix<R, C, T>& operator=(const Expression<E>& expr) {
+    const E& e = expr.Cast();
+    for (int k = 0; k < kSize; ++k) {
+      data_[k] = e[k];
+    }
+    return Derived();
+  }
+  template <class E, EnableIfResult<E, Matrix<R, C, T>> = 0>
+  Matrix<R, C, T>& operator+=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    for (int k = 0; k < kSize; ++k) {
+      data_[k] += e[k];
+    }
+    return Derived();
+  }
+  template <class E, EnableIfResult<E, Matrix<R, C, T>> = 0>
+  Matrix<R, C, T>& operator-=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    for (int k = 0; k < kSize; ++k) {
+      data_[k] -= e[k];
+    }
+    return Derived();
+  }
+  Matrix<R, C, T>& operator*=(const T& alpha) {
+    for (int k = 0; k < kSize; ++k) {
+      data_[k] *= alpha;
+    }
+    return Derived();
+  }
+  Matrix<R, C, T>& operator/=(const T& alpha) {
+    for (int k = 0; k < kSize; ++k) {
+      data_[k] /= alpha;
+    }
+    return Derived();
+  }
+
+  /*-------------------------------------
+   * Data Access
+   *-----------------------------------*/
+  constexpr T& operator[](int k) { return data_[k]; }
+  constexpr const T& operator[](int k) const { return data_[k]; }
+  constexpr T& operator[](IndexPair ij) {
+    return data_[std::get<0>(ij) + kRows * std::get<1>(ij)];
+  }
+  constexpr const T& operator[](IndexPair ij) const {
+    return data_[std::get<0>(ij) + kRows * std::get<1>(ij)];
+  }
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+ protected:
+  MatrixBase() = default;
+
+  // Initializes the elements in column-major order
+  template <class... Args>
+  constexpr explicit MatrixBase(Args... values) : data_{static_cast<T>(values)...} {}
+
+  Matrix<R, C, T>& Derived() { return static_cast<Matrix<R, C, T>&>(*this); }
+
+  T data_[kSize];
+};
+
+}  // namespace star
@@ -0,0 +1,249 @@
+//
+// Created by Brian Jackson on 5/22/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Mat3.hpp"
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+#include "star/Transpose.hpp"
+#include "star/Vec3.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/matrix_multiplication.hpp"
+#include "star/typedefs.h"
+
+extern "C" {
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+namespace star {
+
+/*
+ * @brief Multiplicative extended Kalman filter for the attitude
+ *
+ * Estimates the attitude q of the body frame, and for N = 6 the gyroscope bias, from
+ * gyroscope rates and measurements. The error state is [dtheta] for N = 3 and
+ * [dtheta; dbias] for N = 6, where the true attitude is q.AddError(dtheta), i.e. a
+ * body-frame error through the Cayley map. Each update estimates the error state and
+ * immediately folds it into q and the bias (the reset step), so the error state is always
+ * zero in between.
+ *
+ * The noise covariances are continuous-time densities, e.g. sigma^2 I for a gyroscope noise
+ * density of sigma rad/s/sqrt(Hz), and the bias is a random walk driven by bias_noise. The
+ * covariance is stored in 3x3 blocks.
+ *
+ * See MekfBank for many independent filters run in lock-step.
+ */
+template <int N>
+class Mekf {
+  static_assert(N == 3 || N == 6, "Mekf estimates the attitude, and optionally gyro bias");
+
+ public:
+  static constexpr int kStates = N;
+  static constexpr int kBlocks = N / 3;
+
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  // Starts at the identity attitude with zero bias and zero covariance
+  explicit Mekf(const Mat3& gyro_noise, const Mat3& bias_noise = Mat3::Zero())
+      : gyro_noise_(gyro_noise), bias_noise_(bias_noise) {
+    Reset(Quaternion::Identity(), Matrix<N, N>::Zero());
+  }
+
+  void Reset(const Quaternion& q, const Matrix<N, N>& cov,
+             const Vec3& gyro_bias = Vec3::Zero()) {
+    q_ = q;
+    bias_ = N == 6 ? gyro_bias : Vec3::Zero();
+    for (int bj = 0; bj < kBlocks; ++bj) {
+      for (int bi = 0; bi < kBlocks; ++bi) {
+        for (int j = 0; j < 3; ++j) {
+          for (int i = 0; i < 3; ++i) {
+            P_[bi][bj](i, j) = cov(3 * bi + i, 3 * bj + j);
+          }
+        }
+      }
+    }
+  }
+
+  /*-------------------------------------
+   * Filter
+   *-----------------------------------*/
+  /*
+   * Integrates a gyroscope sample over dt. The error state transition is
+   *
+   *   F = [dR^T   -Jr dt]
+   *       [0       I    ]
+   *
+   * with dR the rotation and Jr the right Jacobian of (gyro - bias) dt.
+   */
+  void Propagate(const Vec3& gyro, sfloat dt) {
+    Vec3 phi = gyro - bias_;
+    phi *= dt;
+    Quaternion dq;
+    Mat3 dR;
+    star_QuatExpm(dq.data(), phi.data());
+    star_QuatToRotMatActive(dR.data(), dq.data());
+    if constexpr (N == 3) {
+      P_[0][0] = CongruenceTransform(dR.Transpose(), P_[0][0]);
+      P_[0][0] += dt * gyro_noise_;
+    } else {
+      Mat3 B;
+      star_SO3RightJacobian(B.data(), phi.data());
+      B *= -dt;
+      const Mat3 T0 = Transpose(dR) * P_[0][0] + B * P_[1][0];
+      const Mat3 T1 = Transpose(dR) * P_[0][1] + B * P_[1][1];
+      P_[0][0] = T0 * dR + T1 * Transpose(B);
+      P_[0][1] = T1;
+
+      // Discrete noise of the rate and bias random walks
+      P_[0][0] += dt * gyro_noise_ + (dt * dt * dt / 3) * bias_noise_;
+      P_[0][1] -= (dt * dt / 2) * bias_noise_;
+      P_[1][1] += dt * bias_noise_;
+      P_[1][0] = P_[0][1].Transpose();
+    }
+    q_ = q_.Compose(dq);
+    star_QuatNormalize(q_.data(), q_.data());
+  }
+
+  /*
+   * Update with a unit vector measured in the body frame, e.g. a sun or star direction,
+   * whose direction in the reference frame is known. The residual is
+   * body - R(q)^T reference with Jacobian [[R(q)^T reference]x, 0]. Returns false, leaving
+   * the filter unchanged, if the innovation covariance isn't positive definite.
+   */
+  bool UpdateVector(const Vec3& body, const Vec3& reference, const Mat3& noise) {
+    const Vec3 predicted = q_.RotatePassive(reference);
+    Mat3 H;
+    star_SkewSymmetricMatrix(H.data(), predicted.data());
+
+    // U = P H^T by blocks, and the inverse of the innovation covariance H P H^T + noise
+    Mat3 U[kBlocks];
+    for (int k = 0; k < kBlocks; ++k) {
+      U[k] = P_[k][0] * Transpose(H);
+    }
+    Mat3 S_inv = H * U[0];
+    S_inv += noise;
+    if (!S_inv.InversePSDInPlace()) {
+      return false;
+    }
+
+    const Vec3 y = body - predicted;
+    Mat3 K[kBlocks];
+    Vec3 dx[2] = {Vec3::Zero(), Vec3::Zero()};
+    for (int k = 0; k < kBlocks; ++k) {
+      K[k] = U[k] * S_inv;
+      dx[k] = K[k] * y;
+    }
+
+    // Joseph form (I - K H) P (I - K H)^T + K noise K^T, which keeps the covariance
+    // positive definite in single precision. With M = (I - K H) P and
+    // W_i = K_i noise - M_i0 H^T, its blocks are M_ij + W_i K_j^T.
+    Mat3 M[kBlocks][kBlocks];
+    Mat3 W[kBlocks];
+    for (int i = 0; i < kBlocks; ++i) {
+      for (int j = 0; j < kBlocks; ++j) {
+        M[i][j] = P_[i][j] - K[i] * Transpose(U[j]);
+      }
+      W[i] = K[i] * noise - M[i][0] * Transpose(H);
+    }
+    for (int j = 0; j < kBlocks; ++j) {
+      for (int i = 0; i <= j; ++i) {
+        P_[i][j] = M[i][j] + W[i] * Transpose(K[j]);
+      }
+    }
+    if constexpr (N == 6) {
+      P_[1][0] = P_[0][1].Transpose();
+    }
+    Correct(dx[0], dx[1]);
+    return true;
+  }
+
+  /*
+   * Update with a general measurement, given its residual y = z - h(q, bias), Jacobian H
+   * with respect to the error state and noise covariance. Returns false, leaving the filter
+   * unchanged, if the innovation covariance isn't positive definite.
+   */
+  template <int M>
+  bool Update(const Matrix<M, 1>& y, const Matrix<M, N>& H, const Matrix<M, M>& noise) {
+    const Matrix<N, N> P = Covariance();
+    Matrix<M, N> HP;
+    Matrix<M, M> S;
+    MatMul<M, N, N>(HP.data(), H.data(), P.data());
+    MatMulTransposed<M, N, M>(S.data(), HP.data(), H.data());
+    for (int k = 0; k < M * M; ++k) {
+      S[k] += noise[k];
+    }
+
+    // K^T = S^-1 H P, since P and S are symmetric
+    Matrix<M, N> Kt;
+    if (!CholSolve<M, N>(Kt.data(), S.data(), HP.data())) {
+      return false;
+    }
+    Matrix<N, 1> dx;
+    TransposedMatMul<N, M, 1>(dx.data(), Kt.data(), y.data());
+
+    // Joseph form (I - K H) P (I - K H)^T + K noise K^T, as in UpdateVector
+    Matrix<N, N> A = Matrix<N, N>::Identity();
+    Matrix<N, N> AP;
+    Matrix<N, N> cov;
+    Matrix<M, N> noise_Kt;
+    TransposedMatMul<N, M, N>(AP.data(), Kt.data(), H.data());
+    for (int k = 0; k < N * N; ++k) {
+      A[k] -= AP[k];
+    }
+    MatMul<N, N, N>(AP.data(), A.data(), P.data());
+    MatMulTransposed<N, N, N>(cov.data(), AP.data(), A.data());
+    MatMul<M, M, N>(noise_Kt.data(), noise.data(), Kt.data());
+    TransposedMatMul<N, M, N>(AP.data(), Kt.data(), noise_Kt.data());
+    for (int k = 0; k < N * N; ++k) {
+      cov[k] += AP[k];
+    }
+    Reset(q_, cov, bias_);
+    Correct(Vec3(dx[0], dx[1], dx[2]),
+            N == 6 ? Vec3(dx[N - 3], dx[N - 2], dx[N - 1]) : Vec3::Zero());
+    return true;
+  }
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  const Quaternion& Attitude() const { return q_; }
+  const Vec3& GyroBias() const { return bias_; }
+
+  Matrix<N, N> Covariance() const {
+    Matrix<N, N> cov;
+    for (int bj = 0; bj < kBlocks; ++bj) {
+      for (int bi = 0; bi < kBlocks; ++bi) {
+        for (int j = 0; j < 3; ++j) {
+          for (int i = 0; i < 3; ++i) {
+            cov(3 * bi + i, 3 * bj + j) = P_[bi][bj](i, j);
+          }
+        }
+      }
+    }
+    return cov;
+  }
+
+ private:
+  // Reset step: moves the estimated error state into the attitude and bias
+  void Correct(const Vec3& dtheta, const Vec3& dbias) {
+    q_ = q_.AddError(dtheta);
+    star_QuatNormalize(q_.data(), q_.data());
+    if constexpr (N == 6) {
+      bias_ += dbias;
+    }
+  }
+
+  Mat3 gyro_noise_;
+  Mat3 bias_noise_;
+
+  Quaternion q_;
+  Vec3 bias_;
+  Mat3 P_[kBlocks][kBlocks];
+};
+
+}  // namespace star
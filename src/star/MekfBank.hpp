@@ -0,0 +1,425 @@
+//
+// Created by Brian Jackson on 5/22/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "star/Mat3.hpp"
+#include "star/Matrix.hpp"
+#include "star/Mekf.hpp"
+#include "star/Quaternion.hpp"
+#include "star/QuaternionArray.hpp"
+#include "star/Vec3.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/quaternion_kernels.hpp"
+#include "star/typedefs.h"
+
+extern "C" {
+#include "star/fastmath.h"
+#include "star/lie.h"
+#include "star/quaternion_array.h"
+}
+
+namespace star {
+
+/*
+ * @brief Many independent Mekf<N> filters run in lock-step
+ *
+ * Holds n filters sharing the same noise densities, e.g. one per tracked object, and
+ * propagates or updates all of them in a single call. The states are stored in the blocked
+ * layout of quaternion_array.h: a block of STAR_BLOCK_SIZE filters stores each component of
+ * their states contiguously, i.e. the w components of their attitudes, then the x
+ * components and so on. The steps run as branch-free loops over the filters of a block,
+ * which vectorize, and the discrete noise is computed once for all filters.
+ *
+ * The components of a state are the attitude, the gyroscope bias for N = 6, and the 3x3
+ * blocks (0, 0), (0, 1) and (1, 1) of the covariance, the diagonal blocks by their upper
+ * triangles. Inputs are blocked vector arrays of the same size as the bank, with any
+ * allocator. Filters in the padding of the last block are updated like the others with
+ * zero inputs and ignored.
+ *
+ * The steps follow Mekf<N> up to rounding, except that the updates can't fail, so the
+ * innovation covariances must be positive definite, e.g. with a positive definite noise.
+ * The states are stored with an allocator of sfloat like the one of BlockedArray.
+ */
+template <int N, class Allocator = BlockAllocator>
+class MekfBank {
+  static_assert(N == 3 || N == 6, "Mekf estimates the attitude, and optionally gyro bias");
+
+ public:
+  static constexpr int kStates = N;
+  static constexpr int kBlockSize = STAR_BLOCK_SIZE;
+
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  // Every filter starts at the identity attitude with zero bias and zero covariance
+  MekfBank(int n, const Mat3& gyro_noise, const Mat3& bias_noise = Mat3::Zero(),
+           const Allocator& allocator = Allocator())
+      : size_(n),
+        gyro_noise_(gyro_noise),
+        bias_noise_(bias_noise),
+        data_(kComponents * kBlockSize * star_NumBlocks(n), allocator) {
+    for (int i = 0; i < kBlockSize * NumBlocks(); ++i) {
+      Reset(i, Quaternion::Identity(), Matrix<N, N>::Zero());
+    }
+  }
+
+  int Size() const { return size_; }
+  int NumBlocks() const { return star_NumBlocks(size_); }
+
+  void Reset(int i, const Quaternion& q, const Matrix<N, N>& cov,
+             const Vec3& gyro_bias = Vec3::Zero()) {
+    sfloat* x = data_.data() + Offset(i);
+    for (int k = 0; k < 4; ++k) {
+      x[(kAttitude + k) * B] = q[k];
+    }
+    for (int k = 0; k < kBias; ++k) {
+      x[(kGyroBias + k) * B] = gyro_bias[k];
+    }
+    for (int blk = 0; blk < kCovBlocks; ++blk) {
+      const int bi = blk == 2;
+      const int bj = blk > 0;
+      Mat3 P;
+      for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+          P(row, col) = cov(3 * bi + row, 3 * bj + col);
+        }
+      }
+      StoreBlock(x + CovOffset(blk) * B, P.data(), bi == bj, 0);
+    }
+  }
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  Quaternion Attitude(int i) const {
+    const sfloat* x = data_.data() + Offset(i);
+    return {x[kAttitude * B], x[(kAttitude + 1) * B], x[(kAttitude + 2) * B],
+            x[(kAttitude + 3) * B]};
+  }
+
+  Vec3 GyroBias(int i) const {
+    if constexpr (N == 3) {
+      return Vec3::Zero();
+    } else {
+      const sfloat* x = data_.data() + Offset(i);
+      return {x[kGyroBias * B], x[(kGyroBias + 1) * B], x[(kGyroBias + 2) * B]};
+    }
+  }
+
+  Matrix<N, N> Covariance(int i) const {
+    const sfloat* x = data_.data() + Offset(i);
+    Matrix<N, N> cov;
+    for (int blk = 0; blk < kCovBlocks; ++blk) {
+      const int bi = blk == 2;
+      const int bj = blk > 0;
+      sfloat P[9];
+      LoadBlock(P, x + CovOffset(blk) * B, bi == bj, 0);
+      for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+          cov(3 * bi + row, 3 * bj + col) = P[row + 3 * col];
+          cov(3 * bj + col, 3 * bi + row) = P[row + 3 * col];
+        }
+      }
+    }
+    return cov;
+  }
+
+  /*-------------------------------------
+   * Filter
+   *-----------------------------------*/
+  // Mekf<N>::Propagate for every filter, with the gyroscope sample of filter i at gyro[i]
+  template <class InputAllocator>
+  void Propagate(const BasicVec3Array<InputAllocator>& gyro, sfloat dt) {
+    const Mat3 Q00 = dt * gyro_noise_ + (dt * dt * dt / 3) * bias_noise_;
+    const Mat3 Q01 = (-dt * dt / 2) * bias_noise_;
+    const Mat3 Q11 = dt * bias_noise_;
+    for (int blk = 0; blk < NumBlocks(); ++blk) {
+      sfloat* x = data_.data() + kComponents * B * blk;
+      const sfloat* w = gyro.data() + 3 * B * blk;
+      for (int l = 0; l < B; ++l) {
+        sfloat q[4];
+        sfloat bias[3] = {0, 0, 0};
+        Load(q, x + kAttitude * B, 4, l);
+        Load(bias, x + kGyroBias * B, kBias, l);
+        sfloat phi[3];
+        for (int k = 0; k < 3; ++k) {
+          phi[k] = (w[k * B + l] - bias[k]) * dt;
+        }
+
+        // Coefficients of the exponential and the right Jacobian, selecting the series
+        // below STAR_LIE_SERIES_THETA2 without branching
+        const sfloat theta2 = phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+        const sfloat theta = std::sqrt(theta2);
+        sfloat s_half;
+        sfloat c_half;
+        star_SinCos(theta / 2, &s_half, &c_half);
+        const bool series = theta2 < STAR_LIE_SERIES_THETA2;
+        const sfloat inv_theta = 1 / (series ? 1 : theta);
+        const sfloat sinc_half =
+            series ? (sfloat)0.5 - theta2 / 48 * (1 - theta2 / 80) : s_half * inv_theta;
+        const sfloat dq[4] = {c_half, phi[0] * sinc_half, phi[1] * sinc_half,
+                              phi[2] * sinc_half};
+        sfloat dR[9];
+        QuatToRotMatActive(dR, dq);
+
+        sfloat P00[9];
+        LoadBlock(P00, x + CovOffset(0) * B, true, l);
+        sfloat T0[9];
+        TransposedMatMul<3, 3, 3>(T0, dR, P00);
+        if constexpr (N == 3) {
+          MatMul<3, 3, 3>(P00, T0, dR);
+          AddBlock(P00, Q00.data());
+        } else {
+          // B = -Jr dt with Jr = I - a S + b S^2, S the skew-symmetric matrix of phi
+          const sfloat a = 2 * sinc_half * sinc_half;
+          const sfloat b = series ? (sfloat)1 / 6 - theta2 / 120 * (1 - theta2 / 42)
+                                  : (theta - 2 * s_half * c_half) * inv_theta * inv_theta *
+                                        inv_theta;
+          sfloat Bm[9];
+          for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 3; ++i) {
+              Bm[i + 3 * j] = -dt * b * phi[i] * phi[j];
+            }
+            Bm[j + 3 * j] -= dt * (1 - b * theta2);
+          }
+          Bm[1] += dt * a * phi[2];
+          Bm[2] -= dt * a * phi[1];
+          Bm[3] -= dt * a * phi[2];
+          Bm[5] += dt * a * phi[0];
+          Bm[6] += dt * a * phi[1];
+          Bm[7] -= dt * a * phi[0];
+
+          sfloat P01[9];
+          sfloat P11[9];
+          sfloat T1[9];
+          sfloat tmp[9];
+          LoadBlock(P01, x + CovOffset(1) * B, false, l);
+          LoadBlock(P11, x + CovOffset(2) * B, true, l);
+          MatMulTransposed<3, 3, 3>(tmp, Bm, P01);
+          AddBlock(T0, tmp);
+          TransposedMatMul<3, 3, 3>(T1, dR, P01);
+          MatMul<3, 3, 3>(tmp, Bm, P11);
+          AddBlock(T1, tmp);
+
+          MatMul<3, 3, 3>(P00, T0, dR);
+          MatMulTransposed<3, 3, 3>(tmp, T1, Bm);
+          AddBlock(P00, tmp);
+          AddBlock(P00, Q00.data());
+          AddBlock(T1, Q01.data());
+          AddBlock(P11, Q11.data());
+          StoreBlock(x + CovOffset(1) * B, T1, false, l);
+          StoreBlock(x + CovOffset(2) * B, P11, true, l);
+        }
+        StoreBlock(x + CovOffset(0) * B, P00, true, l);
+
+        QuatCompose(q, q, dq);
+        QuatNormalize(q, q);
+        Store(x + kAttitude * B, q, 4, l);
+      }
+    }
+  }
+
+  // Mekf<N>::UpdateVector for every filter, with the vectors of filter i at body[i] and
+  // reference[i]
+  template <class InputAllocator>
+  void UpdateVector(const BasicVec3Array<InputAllocator>& body,
+                    const BasicVec3Array<InputAllocator>& reference, const Mat3& noise) {
+    for (int blk = 0; blk < NumBlocks(); ++blk) {
+      sfloat* x = data_.data() + kComponents * B * blk;
+      const sfloat* z = body.data() + 3 * B * blk;
+      const sfloat* r = reference.data() + 3 * B * blk;
+      for (int l = 0; l < B; ++l) {
+        sfloat q[4];
+        sfloat ref[3];
+        sfloat predicted[3];
+        Load(q, x + kAttitude * B, 4, l);
+        Load(ref, r, 3, l);
+        QuatRotatePassive(predicted, q, ref);
+        sfloat y[3];
+        for (int k = 0; k < 3; ++k) {
+          y[k] = z[k * B + l] - predicted[k];
+        }
+        // Skew-symmetric matrix of the prediction
+        const sfloat H[9] = {0, predicted[2], -predicted[1], -predicted[2], 0, predicted[0],
+                             predicted[1], -predicted[0], 0};
+
+        // U = P H^T by blocks, and the inverse of the innovation covariance H P H^T + noise
+        sfloat P00[9];
+        sfloat U0[9];
+        sfloat S[9];
+        LoadBlock(P00, x + CovOffset(0) * B, true, l);
+        MatMulTransposed<3, 3, 3>(U0, P00, H);
+        MatMul<3, 3, 3>(S, H, U0);
+        AddBlock(S, noise.data());
+        sfloat S_inv[9];
+        InverseSymmetric33(S_inv, S);
+
+        // Joseph form of the update, as in Mekf<N>::UpdateVector
+        sfloat K0[9];
+        sfloat M00[9];
+        sfloat W0[9];
+        sfloat dtheta[3];
+        sfloat tmp[9];
+        MatMul<3, 3, 3>(K0, U0, S_inv);
+        MatMul<3, 3, 1>(dtheta, K0, y);
+        MatMulTransposed<3, 3, 3>(tmp, K0, U0);
+        for (int k = 0; k < 9; ++k) {
+          M00[k] = P00[k] - tmp[k];
+        }
+        MatMul<3, 3, 3>(W0, K0, noise.data());
+        MatMulTransposed<3, 3, 3>(tmp, M00, H);
+        SubtractBlock(W0, tmp);
+        MatMulTransposed<3, 3, 3>(P00, W0, K0);
+        AddBlock(P00, M00);
+        StoreBlock(x + CovOffset(0) * B, P00, true, l);
+
+        if constexpr (N == 6) {
+          sfloat P01[9];
+          sfloat P11[9];
+          sfloat U1[9];
+          sfloat K1[9];
+          sfloat M10[9];
+          sfloat W1[9];
+          sfloat dbias[3];
+          LoadBlock(P01, x + CovOffset(1) * B, false, l);
+          LoadBlock(P11, x + CovOffset(2) * B, true, l);
+          TransposedMatMulTransposed<3, 3, 3>(U1, P01, H);
+          MatMul<3, 3, 3>(K1, U1, S_inv);
+          MatMul<3, 3, 1>(dbias, K1, y);
+
+          // M_10 = P_01^T - K_1 U_0^T, and W_1 = K_1 noise - M_10 H^T
+          MatMulTransposed<3, 3, 3>(tmp, K1, U0);
+          for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 3; ++i) {
+              M10[i + 3 * j] = P01[j + 3 * i] - tmp[i + 3 * j];
+            }
+          }
+          MatMul<3, 3, 3>(W1, K1, noise.data());
+          MatMulTransposed<3, 3, 3>(tmp, M10, H);
+          SubtractBlock(W1, tmp);
+
+          // P_01 = M_01 + W_0 K_1^T and P_11 = M_11 + W_1 K_1^T
+          MatMulTransposed<3, 3, 3>(tmp, K0, U1);
+          SubtractBlock(P01, tmp);
+          MatMulTransposed<3, 3, 3>(tmp, W0, K1);
+          AddBlock(P01, tmp);
+          MatMulTransposed<3, 3, 3>(tmp, K1, U1);
+          SubtractBlock(P11, tmp);
+          MatMulTransposed<3, 3, 3>(tmp, W1, K1);
+          AddBlock(P11, tmp);
+          StoreBlock(x + CovOffset(1) * B, P01, false, l);
+          StoreBlock(x + CovOffset(2) * B, P11, true, l);
+          for (int k = 0; k < 3; ++k) {
+            x[(kGyroBias + k) * B + l] += dbias[k];
+          }
+        }
+
+        // Reset step through the Cayley map, as in Quaternion::AddError
+        const sfloat dq[4] = {1, dtheta[0] / 2, dtheta[1] / 2, dtheta[2] / 2};
+        QuatCompose(q, q, dq);
+        QuatNormalize(q, q);
+        Store(x + kAttitude * B, q, 4, l);
+      }
+    }
+  }
+
+ private:
+  static constexpr int B = kBlockSize;
+  static constexpr int kAttitude = 0;
+  static constexpr int kGyroBias = 4;
+  static constexpr int kBias = N == 6 ? 3 : 0;
+  static constexpr int kCovBlocks = N == 6 ? 3 : 1;
+  static constexpr int kComponents = 4 + kBias + N * (N + 1) / 2;
+
+  // First component of the covariance blocks (0, 0), (0, 1) and (1, 1)
+  static constexpr int CovOffset(int blk) {
+    return 4 + kBias + 6 * (blk > 0) + 9 * (blk > 1);
+  }
+
+  static int Offset(int i) { return kComponents * B * (i / B) + i % B; }
+
+  static void Load(sfloat* v, const sfloat* x, int size, int l) {
+    for (int k = 0; k < size; ++k) {
+      v[k] = x[k * B + l];
+    }
+  }
+
+  static void Store(sfloat* x, const sfloat* v, int size, int l) {
+    for (int k = 0; k < size; ++k) {
+      x[k * B + l] = v[k];
+    }
+  }
+
+  // A 3x3 block, or a symmetric one from its upper triangle
+  static void LoadBlock(sfloat P[9], const sfloat* x, bool symmetric, int l) {
+    if (!symmetric) {
+      Load(P, x, 9, l);
+      return;
+    }
+    int k = 0;
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i <= j; ++i, ++k) {
+        P[i + 3 * j] = x[k * B + l];
+        P[j + 3 * i] = x[k * B + l];
+      }
+    }
+  }
+
+  static void StoreBlock(sfloat* x, const sfloat P[9], bool symmetric, int l) {
+    if (!symmetric) {
+      Store(x, P, 9, l);
+      return;
+    }
+    int k = 0;
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i <= j; ++i, ++k) {
+        x[k * B + l] = P[i + 3 * j];
+      }
+    }
+  }
+
+  static void AddBlock(sfloat A[9], const sfloat rhs[9]) {
+    for (int k = 0; k < 9; ++k) {
+      A[k] += rhs[k];
+    }
+  }
+
+  static void SubtractBlock(sfloat A[9], const sfloat rhs[9]) {
+    for (int k = 0; k < 9; ++k) {
+      A[k] -= rhs[k];
+    }
+  }
+
+  // Inverse of a symmetric 3x3 matrix through its adjugate, without pivoting or branches
+  static void InverseSymmetric33(sfloat A_inv[9], const sfloat A[9]) {
+    const sfloat c00 = A[4] * A[8] - A[5] * A[5];
+    const sfloat c01 = A[5] * A[2] - A[1] * A[8];
+    const sfloat c02 = A[1] * A[5] - A[4] * A[2];
+    const sfloat c11 = A[0] * A[8] - A[2] * A[2];
+    const sfloat c12 = A[1] * A[2] - A[0] * A[5];
+    const sfloat c22 = A[0] * A[4] - A[1] * A[1];
+    const sfloat inv_det = 1 / (A[0] * c00 + A[1] * c01 + A[2] * c02);
+    A_inv[0] = c00 * inv_det;
+    A_inv[1] = c01 * inv_det;
+    A_inv[2] = c02 * inv_det;
+    A_inv[3] = c01 * inv_det;
+    A_inv[4] = c11 * inv_det;
+    A_inv[5] = c12 * inv_det;
+    A_inv[6] = c02 * inv_det;
+    A_inv[7] = c12 * inv_det;
+    A_inv[8] = c22 * inv_det;
+  }
+
+  int size_;
+  Mat3 gyro_noise_;
+  Mat3 bias_noise_;
+  std::vector<sfloat, Allocator> data_;
+};
+
+}  // namespace star
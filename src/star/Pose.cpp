@@ -0,0 +1,111 @@
+//
+// Created by Brian Jackson on 5/19/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "Pose.hpp"
+
+extern "C" {
+#include "star/lie.h"
+#include "star/matrix3.h"
+#include "star/quaternion.h"
+}
+
+namespace star {
+
+// The batched transforms of Vec3 arrays treat them as interleaved x, y, z values
+static_assert(sizeof(Vec3) == 3 * sizeof(sfloat), "Vec3 must be 3 contiguous sfloats");
+
+STAR_INLINE Pose Pose::Expm(const Matrix<6, 1>& xi) {
+  Pose T;
+  star_SE3Expm(T.q_.data(), T.t_.data(), xi.data());
+  return T;
+}
+
+STAR_INLINE RotMat<Active> Pose::RotationMatrix() const {
+  RotMat<Active> R;
+  star_QuatToRotMatActive(R.data(), q_.data());
+  return R;
+}
+
+/*-------------------------------------
+ * Group Operations
+ *-----------------------------------*/
+STAR_INLINE Pose Pose::Compose(const Pose& rhs) const {
+  return {q_.Compose(rhs.q_), q_.RotateActive(rhs.t_) + t_};
+}
+
+STAR_INLINE Pose Pose::Inverse() const {
+  Vec3 t_inv = q_.RotatePassive(t_);
+  t_inv *= -1;
+  return {q_.Conjugate(), t_inv};
+}
+
+STAR_INLINE Pose Pose::Between(const Pose& other) const {
+  return {q_.Conjugate().Compose(other.q_), q_.RotatePassive(other.t_ - t_)};
+}
+
+STAR_INLINE Matrix<6, 1> Pose::Logm() const {
+  Matrix<6, 1> xi;
+  star_SE3Logm(xi.data(), q_.data(), t_.data());
+  return xi;
+}
+
+/*-------------------------------------
+ * Transforms
+ *-----------------------------------*/
+STAR_INLINE Vec3 Pose::Transform(const Vec3& p) const { return q_.RotateActive(p) + t_; }
+
+STAR_INLINE Vec3 Pose::InverseTransform(const Vec3& p) const {
+  return q_.RotatePassive(p - t_);
+}
+
+STAR_INLINE void Pose::Transform(sfloat* x_out, sfloat* y_out, sfloat* z_out,
+                                 const sfloat* x, const sfloat* y, const sfloat* z,
+                                 int n) const {
+  sfloat R[9];
+  star_QuatToRotMatActive(R, q_.data());
+  star_AffineMulBatch33(x_out, y_out, z_out, R, t_.data(), x, y, z, n);
+}
+
+STAR_INLINE void Pose::InverseTransform(sfloat* x_out, sfloat* y_out, sfloat* z_out,
+                                        const sfloat* x, const sfloat* y, const sfloat* z,
+                                        int n) const {
+  sfloat Rt[9];
+  sfloat b[3];
+  InverseAffine(Rt, b);
+  star_AffineMulBatch33(x_out, y_out, z_out, Rt, b, x, y, z, n);
+}
+
+STAR_INLINE void Pose::Transform(Vec3* out, const Vec3* points, int n) const {
+  sfloat R[9];
+  star_QuatToRotMatActive(R, q_.data());
+  star_AffineMulInterleaved33(out->data(), R, t_.data(), points->data(), n);
+}
+
+STAR_INLINE void Pose::InverseTransform(Vec3* out, const Vec3* points, int n) const {
+  sfloat Rt[9];
+  sfloat b[3];
+  InverseAffine(Rt, b);
+  star_AffineMulInterleaved33(out->data(), Rt, b, points->data(), n);
+}
+
+STAR_INLINE void Pose::InverseAffine(sfloat Rt[9], sfloat b[3]) const {
+  // R^T (p - t) = R^T p - R^T t
+  sfloat R[9];
+  star_QuatToRotMatActive(R, q_.data());
+  star_Transpose33(Rt, R);
+  star_VecMul33(b, Rt, t_.data());
+  b[0] = -b[0];
+  b[1] = -b[1];
+  b[2] = -b[2];
+}
+
+/*-------------------------------------
+ * Comparison
+ *-----------------------------------*/
+STAR_INLINE bool Pose::IsApprox(const Pose& rhs, sfloat tol) const {
+  return q_.IsApprox(rhs.q_, tol) && t_.NormedDifference(rhs.t_) < tol;
+}
+
+}  // namespace star
@@ -0,0 +1,86 @@
+//
+// Created by Brian Jackson on 5/19/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+#include "star/RotMat.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief Rigid-body pose, a unit quaternion and a translation
+ *
+ * Maps a point p in the body frame to R(q) p + t in the world frame. Composition follows
+ * Quaternion::Compose, so `a.Compose(b)` applies b first and then a.
+ *
+ * The batched transforms build the rotation matrix once per call and apply R p + t to all
+ * the points with fused multiply-adds. See pose_bench.cpp for the comparison with rotating
+ * each point by the quaternion.
+ */
+class Pose {
+ public:
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  constexpr Pose() : q_(Quaternion::Identity()), t_(Vec3::Zero()) {}
+  constexpr Pose(const Quaternion& q, const Vec3& t) : q_(q), t_(t) {}
+  static constexpr Pose Identity() { return {}; }
+
+  // Exponential map of SE(3), for tangent vectors xi = [rho; phi]. See lie_groups.hpp.
+  static Pose Expm(const Matrix<6, 1>& xi);
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  constexpr const Quaternion& Rotation() const { return q_; }
+  constexpr const Vec3& Translation() const { return t_; }
+  RotMat<Active> RotationMatrix() const;
+
+  /*-------------------------------------
+   * Group Operations
+   *-----------------------------------*/
+  Pose Compose(const Pose& rhs) const;
+  Pose Inverse() const;
+  Pose Between(const Pose& other) const;  // Inverse().Compose(other)
+  Matrix<6, 1> Logm() const;              // Inverse of Expm, with an angle of at most pi
+
+  /*-------------------------------------
+   * Transforms
+   *-----------------------------------*/
+  Vec3 Transform(const Vec3& p) const;         // R(q) p + t
+  Vec3 InverseTransform(const Vec3& p) const;  // R(q)^T (p - t)
+
+  // Transform n points stored as separate x, y, z arrays. Outputs may alias the inputs.
+  void Transform(sfloat* x_out, sfloat* y_out, sfloat* z_out, const sfloat* x,
+                 const sfloat* y, const sfloat* z, int n) const;
+  void InverseTransform(sfloat* x_out, sfloat* y_out, sfloat* z_out, const sfloat* x,
+                        const sfloat* y, const sfloat* z, int n) const;
+
+  // Transform n contiguous points. The output may alias the input.
+  void Transform(Vec3* out, const Vec3* points, int n) const;
+  void InverseTransform(Vec3* out, const Vec3* points, int n) const;
+
+  /*-------------------------------------
+   * Comparison
+   *-----------------------------------*/
+  bool IsApprox(const Pose& rhs, sfloat tol = 1e-6) const;
+
+ private:
+  // R and b of the affine map R p + b applied by InverseTransform
+  void InverseAffine(sfloat R[9], sfloat b[3]) const;
+
+  Quaternion q_;
+  Vec3 t_;
+};
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/Pose.cpp"
+#endif
@@ -0,0 +1,186 @@
+//
+// Created by Brian Jackson on 5/21/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "Preintegrator.hpp"
+
+#include "star/Transpose.hpp"
+#include "star/matrix_multiplication.hpp"
+
+extern "C" {
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+namespace star {
+
+STAR_INLINE Preintegrator::Preintegrator(const Mat3& gyro_noise, const Mat3& accel_noise,
+                                         const Vec3& gyro_bias, const Vec3& accel_bias)
+    : gyro_noise_(gyro_noise), accel_noise_(accel_noise) {
+  Reset(gyro_bias, accel_bias);
+}
+
+STAR_INLINE void Preintegrator::Reset() {
+  dt_ = 0;
+  q_ = Quaternion::Identity();
+  R_ = Mat3::Identity();
+  v_ = Vec3::Zero();
+  p_ = Vec3::Zero();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      cov_[i][j] = Mat3::Zero();
+    }
+  }
+  dR_dbg_ = Mat3::Zero();
+  dv_dbg_ = Mat3::Zero();
+  dv_dba_ = Mat3::Zero();
+  dp_dbg_ = Mat3::Zero();
+  dp_dba_ = Mat3::Zero();
+}
+
+STAR_INLINE void Preintegrator::Reset(const Vec3& gyro_bias, const Vec3& accel_bias) {
+  gyro_bias_ = gyro_bias;
+  accel_bias_ = accel_bias;
+  Reset();
+}
+
+/*-------------------------------------
+ * Integration
+ *-----------------------------------*/
+STAR_INLINE void Preintegrator::Integrate(const Vec3& gyro, const Vec3& accel, sfloat dt) {
+  // Rotation vector of the sample and the bias-corrected acceleration
+  Vec3 phi = gyro - gyro_bias_;
+  phi *= dt;
+  const Vec3 a = accel - accel_bias_;
+
+  Quaternion dq;
+  Mat3 dR;
+  Mat3 Jr;
+  Mat3 A;
+  star_QuatExpm(dq.data(), phi.data());
+  star_QuatToRotMatActive(dR.data(), dq.data());
+  star_SO3RightJacobian(Jr.data(), phi.data());
+  star_SkewSymmetricMatrix(A.data(), a.data());
+  const Vec3 Ra = R_ * a;
+  const Mat3 RA = R_ * A;
+
+  PropagateCovariance(dR, RA, Jr, dt);
+
+  // Bias Jacobians, each update using the Jacobians before the sample
+  const sfloat dt2 = dt * dt;
+  const Mat3 RAJ = RA * dR_dbg_;
+  dp_dba_ += dt * dv_dba_ - (dt2 / 2) * R_;
+  dp_dbg_ += dt * dv_dbg_ - (dt2 / 2) * RAJ;
+  dv_dba_ -= dt * R_;
+  dv_dbg_ -= dt * RAJ;
+  dR_dbg_ = Transpose(dR) * dR_dbg_;
+  dR_dbg_ -= dt * Jr;
+
+  // Deltas
+  p_ += dt * v_ + (dt2 / 2) * Ra;
+  v_ += dt * Ra;
+  q_ = q_.Compose(dq);
+  star_QuatNormalize(q_.data(), q_.data());
+  star_QuatToRotMatActive(R_.data(), q_.data());
+  dt_ += dt;
+}
+
+STAR_INLINE void Preintegrator::Integrate(const Vec3* gyro, const Vec3* accel, sfloat dt,
+                                          int n) {
+  for (int i = 0; i < n; ++i) {
+    Integrate(gyro[i], accel[i], dt);
+  }
+}
+
+STAR_INLINE void Preintegrator::Integrate(const Vec3* gyro, const Vec3* accel,
+                                          const sfloat* dt, int n) {
+  for (int i = 0; i < n; ++i) {
+    Integrate(gyro[i], accel[i], dt[i]);
+  }
+}
+
+/*
+ * Sigma' = F Sigma F^T + noise, with the transition matrix
+ *
+ *   F = [dR^T                0     0]
+ *       [-R [a] dt           I     0]
+ *       [-R [a] dt^2 / 2     I dt  I]
+ *
+ * applied block by block to the upper blocks, which takes 10 3x3 products instead of two
+ * 9x9 products.
+ */
+STAR_INLINE void Preintegrator::PropagateCovariance(const Mat3& dR, const Mat3& RA,
+                                                    const Mat3& Jr, sfloat dt) {
+  auto& S = cov_;
+  const Mat3 Av = -dt * RA;
+  const Mat3 AvT = Av.Transpose();
+
+  // T = F Sigma, by rows of blocks. Only the blocks needed below are formed.
+  Mat3 T[3][3];
+  for (int l = 0; l < 3; ++l) {
+    const Mat3 M = Av * S[0][l];
+    T[0][l] = Transpose(dR) * S[0][l];
+    T[1][l] = M + S[1][l];
+    T[2][l] = (dt / 2) * M + dt * S[1][l] + S[2][l];
+  }
+
+  // Sigma' = T F^T, upper blocks
+  const Mat3 T0Av = T[0][0] * AvT;
+  S[0][0] = T[0][0] * dR;
+  S[0][1] = T0Av + T[0][1];
+  S[0][2] = (dt / 2) * T0Av + dt * T[0][1] + T[0][2];
+  const Mat3 T1Av = T[1][0] * AvT;
+  S[1][1] = T1Av + T[1][1];
+  S[1][2] = (dt / 2) * T1Av + dt * T[1][1] + T[1][2];
+  S[2][2] = (dt / 2) * (T[2][0] * AvT) + dt * T[2][1] + T[2][2];
+
+  // Noise of the sample. The discrete-time covariances are the densities divided by dt.
+  const Mat3 gyro_noise = CongruenceTransform(Jr, gyro_noise_);
+  const Mat3 accel_noise = CongruenceTransform(R_, accel_noise_);
+  S[0][0] += dt * gyro_noise;
+  S[1][1] += dt * accel_noise;
+  S[1][2] += (dt * dt / 2) * accel_noise;
+  S[2][2] += (dt * dt * dt / 4) * accel_noise;
+
+  S[1][0] = S[0][1].Transpose();
+  S[2][0] = S[0][2].Transpose();
+  S[2][1] = S[1][2].Transpose();
+}
+
+/*-------------------------------------
+ * Getters
+ *-----------------------------------*/
+STAR_INLINE Matrix<9, 9> Preintegrator::Covariance() const {
+  Matrix<9, 9> cov;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      cov.SetBlock(3 * i, 3 * j, cov_[i][j]);
+    }
+  }
+  return cov;
+}
+
+/*-------------------------------------
+ * Bias Correction
+ *-----------------------------------*/
+STAR_INLINE Quaternion Preintegrator::CorrectedDeltaRotation(const Vec3& gyro_bias) const {
+  const Vec3 dbg = gyro_bias - gyro_bias_;
+  return q_.Compose(Quaternion::Expm(dR_dbg_ * dbg));
+}
+
+STAR_INLINE Vec3 Preintegrator::CorrectedDeltaVelocity(const Vec3& gyro_bias,
+                                                       const Vec3& accel_bias) const {
+  const Vec3 dbg = gyro_bias - gyro_bias_;
+  const Vec3 dba = accel_bias - accel_bias_;
+  return v_ + dv_dbg_ * dbg + dv_dba_ * dba;
+}
+
+STAR_INLINE Vec3 Preintegrator::CorrectedDeltaPosition(const Vec3& gyro_bias,
+                                                       const Vec3& accel_bias) const {
+  const Vec3 dbg = gyro_bias - gyro_bias_;
+  const Vec3 dba = accel_bias - accel_bias_;
+  return p_ + dp_dbg_ * dbg + dp_dba_ * dba;
+}
+
+}  // namespace star
@@ -0,0 +1,112 @@
+//
+// Created by Brian Jackson on 5/21/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Mat3.hpp"
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief IMU preintegration between two keyframes
+ *
+ * Accumulates the delta rotation, velocity and position of the body frame from gyroscope
+ * and accelerometer samples, following the on-manifold preintegration of Forster et al.
+ * Gravity is not included, so the deltas only depend on the measurements and the biases.
+ *
+ * Along with the deltas, every sample updates the 9x9 covariance of the errors in
+ * [rotation, velocity, position] and the Jacobians of the deltas with respect to the
+ * biases. The Corrected* methods use the Jacobians to update the deltas to first order for
+ * a new bias estimate, without integrating the samples again.
+ *
+ * The noise covariances are continuous-time densities, e.g. sigma^2 I for a gyroscope
+ * noise density of sigma rad/s/sqrt(Hz).
+ */
+class Preintegrator {
+ public:
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  Preintegrator(const Mat3& gyro_noise, const Mat3& accel_noise,
+                const Vec3& gyro_bias = Vec3::Zero(),
+                const Vec3& accel_bias = Vec3::Zero());
+
+  // Restart from the identity, e.g. at a new keyframe, optionally with new biases
+  void Reset();
+  void Reset(const Vec3& gyro_bias, const Vec3& accel_bias);
+
+  /*-------------------------------------
+   * Integration
+   *-----------------------------------*/
+  void Integrate(const Vec3& gyro, const Vec3& accel, sfloat dt);
+
+  // Integrate n samples of a buffer, with a fixed or a per-sample time step
+  void Integrate(const Vec3* gyro, const Vec3* accel, sfloat dt, int n);
+  void Integrate(const Vec3* gyro, const Vec3* accel, const sfloat* dt, int n);
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  sfloat DeltaTime() const { return dt_; }
+  const Quaternion& DeltaRotation() const { return q_; }
+  const Vec3& DeltaVelocity() const { return v_; }
+  const Vec3& DeltaPosition() const { return p_; }
+  const Vec3& GyroBias() const { return gyro_bias_; }
+  const Vec3& AccelBias() const { return accel_bias_; }
+
+  // Covariance of the errors in [rotation, velocity, position]
+  Matrix<9, 9> Covariance() const;
+
+  // Jacobians of the deltas with respect to the biases. The delta rotation only depends on
+  // the gyroscope bias, through a right perturbation.
+  const Mat3& RotationGyroBiasJacobian() const { return dR_dbg_; }
+  const Mat3& VelocityGyroBiasJacobian() const { return dv_dbg_; }
+  const Mat3& VelocityAccelBiasJacobian() const { return dv_dba_; }
+  const Mat3& PositionGyroBiasJacobian() const { return dp_dbg_; }
+  const Mat3& PositionAccelBiasJacobian() const { return dp_dba_; }
+
+  /*-------------------------------------
+   * Bias Correction
+   *-----------------------------------*/
+  Quaternion CorrectedDeltaRotation(const Vec3& gyro_bias) const;
+  Vec3 CorrectedDeltaVelocity(const Vec3& gyro_bias, const Vec3& accel_bias) const;
+  Vec3 CorrectedDeltaPosition(const Vec3& gyro_bias, const Vec3& accel_bias) const;
+
+ private:
+  void PropagateCovariance(const Mat3& dR, const Mat3& RA, const Mat3& Jr, sfloat dt);
+
+  // Noise densities and the biases the samples are integrated with
+  Mat3 gyro_noise_;
+  Mat3 accel_noise_;
+  Vec3 gyro_bias_;
+  Vec3 accel_bias_;
+
+  // Deltas, with the rotation matrix of q_ cached for the updates
+  sfloat dt_;
+  Quaternion q_;
+  Mat3 R_;
+  Vec3 v_;
+  Vec3 p_;
+
+  // Blocks of the covariance. Only the upper blocks are propagated.
+  Mat3 cov_[3][3];
+
+  // Bias Jacobians
+  Mat3 dR_dbg_;
+  Mat3 dv_dbg_;
+  Mat3 dv_dba_;
+  Mat3 dp_dbg_;
+  Mat3 dp_dba_;
+};
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/Preintegrator.cpp"
+#endif
@@ -11,162 +11,18 @@ extern "C" {
 
 namespace star {
 
-Quaternion::Quaternion(Vec4 v) : Vec4(std::move(v)) {}
-
-/*---------------------------------*/
-/* Static Methods                  */
-/*---------------------------------*/
-Quaternion Quaternion::Expm(sfloat x, sfloat y, sfloat z) {
-  Quaternion q;
-  sfloat phi[3] = {x, y, z};
-  star_QuatExpm(q.data(), phi);
-  return q;
-}
-
-Quaternion Quaternion::Expm(const Vec3& v) { return Expm(v[0], v[1], v[2]); }
-
-Quaternion Quaternion::FromAxisAngle(sfloat angle, sfloat x, sfloat y, sfloat z) {
-  Quaternion q;
-  sfloat phi[3] = {angle * x, angle * y, angle * z};
-  star_QuatExpm(q.data(), phi);
-  return q;
-}
-
-Quaternion Quaternion::FromAxisAngle(sfloat angle, const Vec3& axis) {
-  Quaternion q;
-  Vec3 phi = angle * axis;
-  star_QuatExpm(q.data(), phi.data());
-  return q;
-}
-
-Quaternion Quaternion::RotX(sfloat angle) {
-  Quaternion q;
-  star_QuatRotX(q.data(), angle);
-  return q;
-}
-
-Quaternion Quaternion::RotY(sfloat angle) {
-  Quaternion q;
-  star_QuatRotY(q.data(), angle);
-  return q;
-}
-
-Quaternion Quaternion::RotZ(sfloat angle) {
-  Quaternion q;
-  star_QuatRotZ(q.data(), angle);
-  return q;
-}
-
-/*---------------------------------*/
-/* Scalar Values                   */
-/*---------------------------------*/
-sfloat Quaternion::VecNorm() const { return star_QuatVecNorm(data()); }
-sfloat Quaternion::VecNormSquared() const { return star_QuatVecNormSquared(data()); }
-sfloat Quaternion::AngleBetween(const Quaternion rhs) const {
-  return star_QuatAngleBetween(data(), rhs.data());
-}
-
-/*---------------------------------*/
-/* Mathematical operators          */
-/*---------------------------------*/
-Quaternion Quaternion::Exp() const {
-  Quaternion q;
-  star_QuatExp(q.data(), data());
-  return q;
-}
-
-Quaternion Quaternion::Log() const {
-  Quaternion q;
-  star_QuatLog(q.data(), data());
-  return q;
-}
-
-Quaternion Quaternion::Flip() const {
-  Quaternion q;
-  star_QuatFlip(q.data(), data());
-  return q;
-}
-
-Quaternion Quaternion::Conjugate() const {
-  Quaternion q;
-  star_QuatConjugate(q.data(), data());
-  return q;
-}
-
-Quaternion Quaternion::Inverse() const {
-  Quaternion q;
-  star_QuatInverse(q.data(), data());
-  return q;
-}
-
-Quaternion Quaternion::Compose(const Quaternion rhs) const {
-  Quaternion q;
-  star_QuatCompose(q.data(), data(), rhs.data());
-  return q;
-}
-
-Quaternion Quaternion::ComposeLeft(const Quaternion lhs) const {
-  Quaternion q;
-  star_QuatComposeLeft(q.data(), lhs.data(), data());
-  return q;
-}
-
-/*---------------------------------*/
-/* Vector operations               */
-/*---------------------------------*/
-
-Vec3 Quaternion::RotateActive(const Vec3& v) const {
-  Vec3 out;
-  star_QuatRotateActive(out.data(), data(), v.data());
-  return out;
-}
-
-Vec3 Quaternion::RotatePassive(const Vec3& v) const {
-  Vec3 out;
-  star_QuatRotatePassive(out.data(), data(), v.data());
-  return out;
-}
-
-Quaternion Quaternion::ComposePure(const Vec3& v) const {
-  Quaternion q;
-  star_QuatComposePure(q.data(), data(), v.data());
-  return q;
-}
-
-/*---------------------------------*/
-/* Comparison                      */
-/*---------------------------------*/
-
-bool Quaternion::IsApprox(const Quaternion& rhs, sfloat tol) const {
-  return star_QuatAngleBetween(data(), rhs.data()) < tol;
-}
-
-Mat4 Quaternion::L() const {
-  Mat4 L;
-  star_LMat(L.data(), data());
-  return L;
-}
-
-Mat4 Quaternion::R() const {
-  Mat4 R;
-  star_RMat(R.data(), data());
-  return R;
-}
-
-Mat43 Quaternion::AttitudeJacobian() const {
-  Mat43 G;
-  star_GMat(G.data(), data());
-  return G;
-}
-Mat43 Quaternion::H() const {
-  // clang-format off
-  return Mat43::ByRows(
-      0, 0, 0,
-      1, 0, 0,
-      0, 1, 0,
-      0, 0, 1
-  );
-  // clang-format on
+#ifndef STAR_HEADER_ONLY
+// The methods of Quaternion are compiled once here instead of in every translation unit
+template class Quat<sfloat>;
+#endif
+
+STAR_INLINE void AttitudeProjectHessian(Mat3* P, const Quaternion* q, const Mat4* H,
+                                        int n) {
+  static_assert(sizeof(Quaternion) == 4 * sizeof(sfloat) &&
+                    sizeof(Mat4) == Mat4::kSize * sizeof(sfloat) &&
+                    sizeof(Mat3) == Mat3::kSize * sizeof(sfloat),
+                "Quaternion and matrix arrays must be contiguous arrays of sfloat");
+  star_AttitudeProjectHessianBatch(P->data(), q->data(), H->data(), n);
 }
 
 }  // namespace star
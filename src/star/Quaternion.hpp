@@ -8,89 +8,547 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 
 #include "star/Mat3.hpp"
 #include "star/Mat4.hpp"
 #include "star/Mat43.hpp"
+#include "star/Matrix.hpp"
 #include "star/Vec3.hpp"
 #include "star/Vec4.hpp"
+#include "star/quaternion_kernels.hpp"
 #include "star/typedefs.h"
 
+extern "C" {
+#include "star/quaternion.h"
+}
+
 namespace star {
 
-class Quaternion : public Vec4 {
+/*
+ * @brief Quaternion [w, x, y, z] of scalars T
+ *
+ * Quaternion is the quaternion of sfloat. The methods call the templated kernels in
+ * quaternion_kernels.hpp for every scalar type, so e.g. Quat<Dual<4>> differentiates
+ * exactly the code that Quaternion runs. The batched rotations call the SIMD kernels of
+ * quaternion.h and only exist for sfloat.
+ */
+template <class T = sfloat>
+class Quat : public Vector<4, T> {
+  using Base = Vector<4, T>;
+
  public:
-  using Vec4::Vec4;
+  using Base::Base;
+  using Base::Dot;
+  using Base::data;
+  using Base::w;
+  using Base::x;
+  using Base::y;
+  using Base::z;
 
   /*---------------------------------*/
   /* Constructors                    */
   /*---------------------------------*/
-  Quaternion() : Vec4(1,0,0,0) {}
-  Quaternion(sfloat w, sfloat i, sfloat j, sfloat k) : Vec4(w, i, j, k) {}
-  Quaternion(sfloat w, const Vec3& v) : Vec4(w, v[0], v[1], v[2]) {}
-  Quaternion(Vec4 v);  // NOLINT: Allow implicit conversion
-
-//  template <class Vector>
-//  explicit Quaternion(const Vector& v) : Vec4(v) {}
+  constexpr Quat() : Base(1, 0, 0, 0) {}
+  constexpr Quat(T w, T i, T j, T k) : Base(w, i, j, k) {}
+  constexpr Quat(T w, const Vector<3, T>& v) : Base(w, v.x, v.y, v.z) {}
+  constexpr Quat(const Base& v) : Base(v.w, v.x, v.y, v.z) {}  // NOLINT: Implicit
 
   /*---------------------------------*/
   /* Static Methods                  */
   /*---------------------------------*/
-  static Quaternion Identity() { return {1, 0, 0, 0}; };
-  static Quaternion Pure(sfloat x, sfloat y, sfloat z) { return {0, x, y, z}; };
-  static Quaternion Pure(const Vec3& v) { return {0, v[0], v[1], v[2]}; };
-  static Quaternion Expm(sfloat x, sfloat y, sfloat z);
-  static Quaternion Expm(const Vec3& v);
-  static Quaternion FromAxisAngle(sfloat angle, sfloat x, sfloat y, sfloat z);
-  static Quaternion FromAxisAngle(sfloat angle, const Vec3& axis);
-  static Quaternion RotX(sfloat angle);
-  static Quaternion RotY(sfloat angle);
-  static Quaternion RotZ(sfloat angle);
+  static constexpr Quat Identity() { return {1, 0, 0, 0}; };
+  static constexpr Quat Pure(T x, T y, T z) { return {0, x, y, z}; };
+  static constexpr Quat Pure(const Vector<3, T>& v) { return {0, v.x, v.y, v.z}; };
+  static Quat Expm(T x, T y, T z);
+  static Quat Expm(const Vector<3, T>& v);
+  static Quat FromAxisAngle(T angle, T x, T y, T z);
+  static Quat FromAxisAngle(T angle, const Vector<3, T>& axis);
+  static Quat RotX(T angle);
+  static Quat RotY(T angle);
+  static Quat RotZ(T angle);
+
+  // Inverses of Logm(), InvCayley(), ToRodriguesParam() and ToMRP()
+  static Quat Cayley(const Vector<3, T>& phi);
+  static Quat FromRodriguesParam(const Vector<3, T>& g);
+  static Quat FromMRP(const Vector<3, T>& p);
 
   /*---------------------------------*/
   /* Scalar Values                   */
   /*---------------------------------*/
-  sfloat VecNorm() const;
-  sfloat VecNormSquared() const;
-  sfloat AngleBetween(const Quaternion rhs) const;
+  T VecNorm() const;
+  T VecNormSquared() const;
+  T AngleBetween(const Quat rhs) const;
 
   /*---------------------------------*/
   /* Mathematical operators          */
   /*---------------------------------*/
-  Quaternion Exp() const;
-  Quaternion Log() const;
-  Quaternion Flip() const;
-  Quaternion Conjugate() const;
-  Quaternion Inverse() const;
-  Quaternion Compose(const Quaternion rhs) const;
-  Quaternion ComposeLeft(const Quaternion lhs) const;
+  Quat Exp() const;
+  Quat Log() const;
+  Vector<3, T> Logm() const;  // Rotation vector, 2 Log().Vec() for unit quaternions
+  constexpr Quat Flip() const { return {-w, -x, -y, -z}; }
+  constexpr Quat Conjugate() const { return {w, -x, -y, -z}; }
+  constexpr Quat Inverse() const {
+    T n = 1 / Dot(*this);
+    return {w * n, -x * n, -y * n, -z * n};
+  }
+  constexpr Quat Compose(const Quat& rhs) const {
+    if (STAR_IS_CONSTANT_EVALUATED()) {
+      return {w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z,
+              x * rhs.w + w * rhs.x + y * rhs.z - z * rhs.y,
+              y * rhs.w + z * rhs.x + w * rhs.y - x * rhs.z,
+              z * rhs.w + w * rhs.z + x * rhs.y - y * rhs.x};
+    }
+    Quat q;
+    QuatCompose(q.data(), data(), rhs.data());
+    return q;
+  }
+  Quat ComposeLeft(const Quat lhs) const;
+
+  /*---------------------------------*/
+  /* Three-parameter representations */
+  /*---------------------------------*/
+  Vector<3, T> InvCayley() const;
+  Vector<3, T> ToRodriguesParam() const;
+  Vector<3, T> ToMRP() const;
+
+  // Attitude error relative to q_ref through the Cayley map, and its inverse:
+  // q.Error(q_ref) = InvCayley(q_ref^* q) and q_ref.AddError(q.Error(q_ref)) = q
+  Vector<3, T> Error(const Quat& q_ref) const;
+  Quat AddError(const Vector<3, T>& phi) const;
+
+  /*---------------------------------*/
+  /* Interpolation                   */
+  /*---------------------------------*/
+  // Interpolate from this quaternion (t = 0) to q1 (t = 1) along the shorter arc
+  Quat Slerp(const Quat& q1, T t) const;
+  Quat Nlerp(const Quat& q1, T t) const;
+
+  // Spherical cubic interpolation from q0 to q1 with the control points s0 and s1
+  static Quat Squad(const Quat& q0, const Quat& q1, const Quat& s0, const Quat& s1, T t);
+  static Quat SquadControlPoint(const Quat& q_prev, const Quat& q, const Quat& q_next);
 
   /*---------------------------------*/
   /* Vector operations               */
   /*---------------------------------*/
-  Vec3 Vec() const { return { i, j, k }; };
-  Vec3 RotateActive(const Vec3& v) const;
-  Vec3 RotatePassive(const Vec3& v) const;
-  Quaternion ComposePure(const Vec3& v) const;
+  constexpr Vector<3, T> Vec() const { return {x, y, z}; };
+  Vector<3, T> RotateActive(const Vector<3, T>& v) const;
+  Vector<3, T> RotatePassive(const Vector<3, T>& v) const;
+
+  // Rotate n vectors stored as separate x, y, z arrays. Outputs may alias the inputs.
+  void RotateActive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                    const sfloat* y, const sfloat* z, int n) const;
+  void RotatePassive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                     const sfloat* y, const sfloat* z, int n) const;
+  Quat ComposePure(const Vector<3, T>& v) const;
 
   /*---------------------------------*/
   /* Jacobians                       */
   /*---------------------------------*/
-//  Matrix34 RotActiveJacobian(const Vec3&) const;
-//  Matrix34 RotPassiveJacobian(const Vec3&) const;
-  Mat43 AttitudeJacobian() const;
+  Matrix<4, 3, T> AttitudeJacobian() const;
+
+  // Jacobians with respect to this quaternion
+  Matrix<3, 4, T> RotateActiveJacobian(const Vector<3, T>& v) const;
+  Matrix<3, 4, T> RotatePassiveJacobian(const Vector<3, T>& v) const;
+  Matrix<4, 4, T> ComposeJacobian(const Quat& rhs) const;      // R(rhs)
+  Matrix<4, 4, T> ComposeLeftJacobian(const Quat& lhs) const;  // L(lhs)
+  Matrix<3, 4, T> LogmJacobian() const;
+  Matrix<3, 4, T> InvCayleyJacobian() const;
+  Matrix<3, 4, T> ToRodriguesParamJacobian() const;
+  Matrix<3, 4, T> ToMRPJacobian() const;
+
+  // Jacobians of the maps from three-parameter representations to quaternions
+  static Matrix<4, 3, T> ExpmJacobian(const Vector<3, T>& phi);
+  static Matrix<4, 3, T> CayleyJacobian(const Vector<3, T>& phi);
+  static Matrix<4, 3, T> FromRodriguesParamJacobian(const Vector<3, T>& g);
+  static Matrix<4, 3, T> FromMRPJacobian(const Vector<3, T>& p);
+
+  // Project a symmetric Hessian onto the attitude tangent space, G(q)^T H G(q), without
+  // forming G. Only the upper triangle of H is read.
+  Matrix<3, 3, T> AttitudeProjectHessian(const Matrix<4, 4, T>& H) const;
 
   /*---------------------------------*/
   /* Matrices                       */
   /*---------------------------------*/
-  Mat4 L() const;
-  Mat4 R() const;
-  Mat43 H() const;
+  Matrix<4, 4, T> L() const;
+  Matrix<4, 4, T> R() const;
+  constexpr Matrix<4, 3, T> H() const {
+    // clang-format off
+    return Matrix<4, 3, T>::ByRows(
+        0, 0, 0,
+        1, 0, 0,
+        0, 1, 0,
+        0, 0, 1
+    );
+    // clang-format on
+  }
 
   /*---------------------------------*/
   /* Comparison                      */
   /*---------------------------------*/
-  bool IsApprox(const Quaternion& rhs, sfloat tol = 1e-6) const;
+  bool IsApprox(const Quat& rhs, sfloat tol = 1e-6) const;
 };
 
+using Quaternion = Quat<>;
+
+// Batched Quaternion::AttitudeProjectHessian, P[i] = G(q[i])^T H[i] G(q[i]), over n
+// contiguous quaternions and Hessians, e.g. the knot points of a trajectory
+void AttitudeProjectHessian(Mat3* P, const Quaternion* q, const Mat4* H, int n);
+
+/*---------------------------------*/
+/* Static Methods                  */
+/*---------------------------------*/
+template <class T>
+Quat<T> Quat<T>::Expm(T x, T y, T z) {
+  return Expm(Vector<3, T>(x, y, z));
+}
+
+template <class T>
+Quat<T> Quat<T>::Expm(const Vector<3, T>& v) {
+  Quat q;
+  QuatExpm(q.data(), v.data());
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::FromAxisAngle(T angle, T x, T y, T z) {
+  return Expm(angle * x, angle * y, angle * z);
+}
+
+template <class T>
+Quat<T> Quat<T>::FromAxisAngle(T angle, const Vector<3, T>& axis) {
+  return Expm(axis.x * angle, axis.y * angle, axis.z * angle);
+}
+
+template <class T>
+Quat<T> Quat<T>::RotX(T angle) {
+  Quat q;
+  QuatRotAxis(q.data(), angle, 1);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::RotY(T angle) {
+  Quat q;
+  QuatRotAxis(q.data(), angle, 2);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::RotZ(T angle) {
+  Quat q;
+  QuatRotAxis(q.data(), angle, 3);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::Cayley(const Vector<3, T>& phi) {
+  Quat q;
+  QuatCayley(q.data(), phi.data());
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::FromRodriguesParam(const Vector<3, T>& g) {
+  Quat q;
+  RodriguesParamToQuat(q.data(), g.data());
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::FromMRP(const Vector<3, T>& p) {
+  Quat q;
+  MRPToQuat(q.data(), p.data());
+  return q;
+}
+
+/*---------------------------------*/
+/* Scalar Values                   */
+/*---------------------------------*/
+template <class T>
+T Quat<T>::VecNorm() const {
+  return QuatVecNorm(data());
+}
+
+template <class T>
+T Quat<T>::VecNormSquared() const {
+  return QuatVecNormSquared(data());
+}
+
+template <class T>
+T Quat<T>::AngleBetween(const Quat rhs) const {
+  return QuatAngleBetween(data(), rhs.data());
+}
+
+/*---------------------------------*/
+/* Mathematical operators          */
+/*---------------------------------*/
+template <class T>
+Quat<T> Quat<T>::Exp() const {
+  Quat q;
+  QuatExp(q.data(), data());
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::Log() const {
+  Quat q;
+  QuatLog(q.data(), data());
+  return q;
+}
+
+template <class T>
+Vector<3, T> Quat<T>::Logm() const {
+  Vector<3, T> phi;
+  QuatLogm(phi.data(), data());
+  return phi;
+}
+
+template <class T>
+Quat<T> Quat<T>::ComposeLeft(const Quat lhs) const {
+  Quat q;
+  QuatComposeLeft(q.data(), data(), lhs.data());
+  return q;
+}
+
+/*---------------------------------*/
+/* Three-parameter representations */
+/*---------------------------------*/
+template <class T>
+Vector<3, T> Quat<T>::InvCayley() const {
+  Vector<3, T> phi;
+  QuatInvCayley(phi.data(), data());
+  return phi;
+}
+
+template <class T>
+Vector<3, T> Quat<T>::ToRodriguesParam() const {
+  Vector<3, T> g;
+  QuatToRodriguesParam(g.data(), data());
+  return g;
+}
+
+template <class T>
+Vector<3, T> Quat<T>::ToMRP() const {
+  Vector<3, T> p;
+  QuatToMRP(p.data(), data());
+  return p;
+}
+
+template <class T>
+Vector<3, T> Quat<T>::Error(const Quat& q_ref) const {
+  Vector<3, T> phi;
+  QuatError(phi.data(), data(), q_ref.data());
+  return phi;
+}
+
+template <class T>
+Quat<T> Quat<T>::AddError(const Vector<3, T>& phi) const {
+  Quat q;
+  QuatAddError(q.data(), data(), phi.data());
+  return q;
+}
+
+/*---------------------------------*/
+/* Interpolation                   */
+/*---------------------------------*/
+template <class T>
+Quat<T> Quat<T>::Slerp(const Quat& q1, T t) const {
+  Quat q;
+  QuatSlerp(q.data(), data(), q1.data(), t);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::Nlerp(const Quat& q1, T t) const {
+  Quat q;
+  QuatNlerp(q.data(), data(), q1.data(), t);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::Squad(const Quat& q0, const Quat& q1, const Quat& s0, const Quat& s1,
+                       T t) {
+  Quat q;
+  QuatSquad(q.data(), q0.data(), q1.data(), s0.data(), s1.data(), t);
+  return q;
+}
+
+template <class T>
+Quat<T> Quat<T>::SquadControlPoint(const Quat& q_prev, const Quat& q, const Quat& q_next) {
+  Quat s;
+  QuatSquadControlPoint(s.data(), q_prev.data(), q.data(), q_next.data());
+  return s;
+}
+
+/*---------------------------------*/
+/* Vector operations               */
+/*---------------------------------*/
+template <class T>
+Vector<3, T> Quat<T>::RotateActive(const Vector<3, T>& v) const {
+  Vector<3, T> out;
+  QuatRotateActive(out.data(), data(), v.data());
+  return out;
+}
+
+template <class T>
+Vector<3, T> Quat<T>::RotatePassive(const Vector<3, T>& v) const {
+  Vector<3, T> out;
+  QuatRotatePassive(out.data(), data(), v.data());
+  return out;
+}
+
+template <class T>
+void Quat<T>::RotateActive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                           const sfloat* y, const sfloat* z, int n) const {
+  static_assert(std::is_same<T, sfloat>::value,
+                "The batched rotations require a quaternion of sfloat");
+  star_QuatRotateActiveBatch(x_rot, y_rot, z_rot, data(), x, y, z, n);
+}
+
+template <class T>
+void Quat<T>::RotatePassive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                            const sfloat* y, const sfloat* z, int n) const {
+  static_assert(std::is_same<T, sfloat>::value,
+                "The batched rotations require a quaternion of sfloat");
+  star_QuatRotatePassiveBatch(x_rot, y_rot, z_rot, data(), x, y, z, n);
+}
+
+template <class T>
+Quat<T> Quat<T>::ComposePure(const Vector<3, T>& v) const {
+  Quat q;
+  QuatComposePure(q.data(), data(), v.data());
+  return q;
+}
+
+/*---------------------------------*/
+/* Comparison                      */
+/*---------------------------------*/
+template <class T>
+bool Quat<T>::IsApprox(const Quat& rhs, sfloat tol) const {
+  return AngleBetween(rhs) < tol;
+}
+
+/*---------------------------------*/
+/* Matrices                        */
+/*---------------------------------*/
+template <class T>
+Matrix<4, 4, T> Quat<T>::L() const {
+  Matrix<4, 4, T> L;
+  LMat(L.data(), data());
+  return L;
+}
+
+template <class T>
+Matrix<4, 4, T> Quat<T>::R() const {
+  Matrix<4, 4, T> R;
+  RMat(R.data(), data());
+  return R;
+}
+
+/*---------------------------------*/
+/* Jacobians                       */
+/*---------------------------------*/
+template <class T>
+Matrix<4, 3, T> Quat<T>::AttitudeJacobian() const {
+  Matrix<4, 3, T> G;
+  GMat(G.data(), data());
+  return G;
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::RotateActiveJacobian(const Vector<3, T>& v) const {
+  Matrix<3, 4, T> D;
+  QuatRotateActiveJacobian(D.data(), data(), v.data());
+  return D;
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::RotatePassiveJacobian(const Vector<3, T>& v) const {
+  Matrix<3, 4, T> D;
+  QuatRotatePassiveJacobian(D.data(), data(), v.data());
+  return D;
+}
+
+template <class T>
+Matrix<4, 4, T> Quat<T>::ComposeJacobian(const Quat& rhs) const {
+  return rhs.R();
+}
+
+template <class T>
+Matrix<4, 4, T> Quat<T>::ComposeLeftJacobian(const Quat& lhs) const {
+  return lhs.L();
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::LogmJacobian() const {
+  Matrix<3, 4, T> D;
+  QuatLogmJacobian(D.data(), data());
+  return D;
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::InvCayleyJacobian() const {
+  Matrix<3, 4, T> D;
+  QuatInvCayleyJacobian(D.data(), data());
+  return D;
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::ToRodriguesParamJacobian() const {
+  Matrix<3, 4, T> D;
+  QuatToRodriguesParamJacobian(D.data(), data());
+  return D;
+}
+
+template <class T>
+Matrix<3, 4, T> Quat<T>::ToMRPJacobian() const {
+  Matrix<3, 4, T> D;
+  QuatToMRPJacobian(D.data(), data());
+  return D;
+}
+
+template <class T>
+Matrix<4, 3, T> Quat<T>::ExpmJacobian(const Vector<3, T>& phi) {
+  Matrix<4, 3, T> D;
+  QuatExpmJacobian(D.data(), phi.data());
+  return D;
+}
+
+template <class T>
+Matrix<4, 3, T> Quat<T>::CayleyJacobian(const Vector<3, T>& phi) {
+  Matrix<4, 3, T> D;
+  QuatCayleyJacobian(D.data(), phi.data());
+  return D;
+}
+
+template <class T>
+Matrix<4, 3, T> Quat<T>::FromRodriguesParamJacobian(const Vector<3, T>& g) {
+  Matrix<4, 3, T> D;
+  RodriguesParamToQuatJacobian(D.data(), g.data());
+  return D;
+}
+
+template <class T>
+Matrix<4, 3, T> Quat<T>::FromMRPJacobian(const Vector<3, T>& p) {
+  Matrix<4, 3, T> D;
+  MRPToQuatJacobian(D.data(), p.data());
+  return D;
+}
+
+template <class T>
+Matrix<3, 3, T> Quat<T>::AttitudeProjectHessian(const Matrix<4, 4, T>& H) const {
+  Matrix<3, 3, T> P;
+  star::AttitudeProjectHessian(P.data(), data(), H.data());
+  return P;
+}
+
+#ifndef STAR_HEADER_ONLY
+extern template class Quat<sfloat>;
+#endif
+
 }  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/Quaternion.cpp"
+#endif
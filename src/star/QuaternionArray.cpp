@@ -0,0 +1,17 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "QuaternionArray.hpp"
+
+namespace star {
+
+#ifndef STAR_HEADER_ONLY
+// The default arrays are compiled once here instead of in every translation unit
+template class BlockedArray<Vec3>;
+template class BlockedArray<Quaternion>;
+template class BasicQuaternionArray<>;
+#endif
+
+}  // namespace star
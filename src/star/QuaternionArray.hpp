@@ -0,0 +1,286 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "star/Quaternion.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+extern "C" {
+#include "star/quaternion_array.h"
+}
+
+namespace star {
+
+// Allocates storage aligned to the given number of bytes
+template <class T, std::size_t Alignment>
+struct AlignedAllocator {
+  using value_type = T;
+  template <class U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <class U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}  // NOLINT
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+  template <class U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+  template <class U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Default storage of the blocked arrays
+using BlockAllocator = AlignedAllocator<sfloat, STAR_BLOCK_ALIGNMENT>;
+
+/*
+ * @brief Array of n vectors of type T stored in the blocked layout of quaternion_array.h
+ *
+ * The storage holds a whole number of 64-byte aligned blocks. Elements past the end of the
+ * array in the last block are kept equal to the padding value, e.g. the identity
+ * quaternion, so the kernels never operate on garbage.
+ *
+ * The storage comes from an allocator of sfloat returning STAR_BLOCK_ALIGNMENT aligned
+ * blocks, e.g. a WorkspaceAllocator<sfloat> for arrays living for a single control cycle.
+ */
+template <class T, class Allocator = BlockAllocator>
+class BlockedArray {
+  static_assert(std::is_same_v<typename Allocator::value_type, sfloat>,
+                "Blocked arrays store sfloat");
+
+ public:
+  static constexpr int kRows = T::kSize;
+  static constexpr int kBlockSize = STAR_BLOCK_SIZE;
+
+  explicit BlockedArray(int n = 0, const T& value = T(), const T& padding = T(),
+                        const Allocator& allocator = Allocator())
+      : padding_(padding), data_(allocator) {
+    Resize(n, value);
+  }
+
+  int Size() const { return size_; }
+  int NumBlocks() const { return star_NumBlocks(size_); }
+  Allocator GetAllocator() const { return data_.get_allocator(); }
+
+  // Resizes the array, filling any new elements with value
+  void Resize(int n, const T& value = T()) {
+    data_.resize(kRows * kBlockSize * star_NumBlocks(n));
+    for (int i = size_; i < n; ++i) {
+      Set(i, value);
+    }
+    size_ = n;
+    for (int i = n; i < kBlockSize * NumBlocks(); ++i) {
+      Set(i, padding_);
+    }
+  }
+
+  T Get(int i) const {
+    T v;
+    const sfloat* x = data_.data() + Offset(i);
+    for (int k = 0; k < kRows; ++k) {
+      v[k] = x[k * kBlockSize];
+    }
+    return v;
+  }
+
+  void Set(int i, const T& v) {
+    sfloat* x = data_.data() + Offset(i);
+    for (int k = 0; k < kRows; ++k) {
+      x[k * kBlockSize] = v[k];
+    }
+  }
+
+  sfloat* data() { return data_.data(); }
+  const sfloat* data() const { return data_.data(); }
+
+ private:
+  static int Offset(int i) {
+    return kRows * kBlockSize * (i / kBlockSize) + i % kBlockSize;
+  }
+
+  int size_ = 0;
+  T padding_;
+  std::vector<sfloat, Allocator> data_;
+};
+
+template <class Allocator = BlockAllocator>
+class BasicVec3Array : public BlockedArray<Vec3, Allocator> {
+ public:
+  explicit BasicVec3Array(int n = 0, const Vec3& value = Vec3::Zero(),
+                          const Allocator& allocator = Allocator())
+      : BlockedArray<Vec3, Allocator>(n, value, Vec3::Zero(), allocator) {}
+};
+
+using Vec3Array = BasicVec3Array<>;
+
+/*
+ * @brief Trajectory of quaternions with bulk operations
+ *
+ * The quaternions are stored in 64-byte aligned blocks of their components (AoSoA), so the
+ * bulk operations run as vectorized loops over the whole trajectory instead of one
+ * quaternion at a time. Binary operations require arrays of the same size. The arrays
+ * they return draw from the allocator of this array.
+ */
+template <class Allocator = BlockAllocator>
+class BasicQuaternionArray : public BlockedArray<Quaternion, Allocator> {
+  using Base = BlockedArray<Quaternion, Allocator>;
+
+ public:
+  using Vec3ArrayType = BasicVec3Array<Allocator>;
+
+  explicit BasicQuaternionArray(int n = 0, const Quaternion& value = Quaternion::Identity(),
+                                const Allocator& allocator = Allocator())
+      : Base(n, value, Quaternion::Identity(), allocator) {}
+
+  using Base::data;
+  using Base::GetAllocator;
+  using Base::Size;
+
+  static BasicQuaternionArray Expm(const Vec3ArrayType& phi);
+
+  /*---------------------------------*/
+  /* Bulk operations                 */
+  /*---------------------------------*/
+  BasicQuaternionArray Normalize() const;
+  BasicQuaternionArray& NormalizeInPlace();
+  BasicQuaternionArray Inverse() const;
+  BasicQuaternionArray Compose(const BasicQuaternionArray& rhs) const;
+  BasicQuaternionArray& ComposeInPlace(const BasicQuaternionArray& rhs);
+  BasicQuaternionArray Diff(const BasicQuaternionArray& rhs) const;
+  Vec3ArrayType Logm() const;
+  Vec3ArrayType RotateActive(const Vec3ArrayType& v) const;
+
+  /*
+   * Interpolates the trajectory, sampled at the increasing times `times`, to the m
+   * increasing times `query_times`. Queries outside the sampled times are clamped.
+   */
+  BasicQuaternionArray Resample(const sfloat* times, const sfloat* query_times,
+                                int m) const;
+
+  // Versions writing to preallocated outputs of the same size, which may alias the inputs
+  void Logm(Vec3ArrayType& phi) const;
+  void RotateActive(Vec3ArrayType& v_rot, const Vec3ArrayType& v) const;
+};
+
+using QuaternionArray = BasicQuaternionArray<>;
+
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Expm(
+    const Vec3ArrayType& phi) {
+  BasicQuaternionArray q(phi.Size(), Quaternion::Identity(), phi.GetAllocator());
+  star_QuatExpmBlocked(q.data(), phi.data(), phi.Size());
+  return q;
+}
+
+/*---------------------------------*/
+/* Bulk operations                 */
+/*---------------------------------*/
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Normalize() const {
+  BasicQuaternionArray q_normalized(Size(), Quaternion::Identity(), GetAllocator());
+  star_QuatNormalizeBlocked(q_normalized.data(), data(), Size());
+  return q_normalized;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator>& BasicQuaternionArray<Allocator>::NormalizeInPlace() {
+  star_QuatNormalizeBlocked(data(), data(), Size());
+  return *this;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Inverse() const {
+  BasicQuaternionArray q_inv(Size(), Quaternion::Identity(), GetAllocator());
+  star_QuatInverseBlocked(q_inv.data(), data(), Size());
+  return q_inv;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Compose(
+    const BasicQuaternionArray& rhs) const {
+  assert(rhs.Size() == Size());
+  BasicQuaternionArray q12(Size(), Quaternion::Identity(), GetAllocator());
+  star_QuatComposeBlocked(q12.data(), data(), rhs.data(), Size());
+  return q12;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator>& BasicQuaternionArray<Allocator>::ComposeInPlace(
+    const BasicQuaternionArray& rhs) {
+  assert(rhs.Size() == Size());
+  star_QuatComposeBlocked(data(), data(), rhs.data(), Size());
+  return *this;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Diff(
+    const BasicQuaternionArray& rhs) const {
+  assert(rhs.Size() == Size());
+  BasicQuaternionArray dq(Size(), Quaternion::Identity(), GetAllocator());
+  star_QuatDiffBlocked(dq.data(), data(), rhs.data(), Size());
+  return dq;
+}
+
+template <class Allocator>
+BasicVec3Array<Allocator> BasicQuaternionArray<Allocator>::Logm() const {
+  Vec3ArrayType phi(Size(), Vec3::Zero(), GetAllocator());
+  Logm(phi);
+  return phi;
+}
+
+template <class Allocator>
+BasicVec3Array<Allocator> BasicQuaternionArray<Allocator>::RotateActive(
+    const Vec3ArrayType& v) const {
+  Vec3ArrayType v_rot(Size(), Vec3::Zero(), GetAllocator());
+  RotateActive(v_rot, v);
+  return v_rot;
+}
+
+template <class Allocator>
+BasicQuaternionArray<Allocator> BasicQuaternionArray<Allocator>::Resample(
+    const sfloat* times, const sfloat* query_times, int m) const {
+  assert(Size() > 0);
+  BasicQuaternionArray q_out(m, Quaternion::Identity(), GetAllocator());
+  star_QuatResampleBlocked(q_out.data(), query_times, m, data(), times, Size());
+  return q_out;
+}
+
+template <class Allocator>
+void BasicQuaternionArray<Allocator>::Logm(Vec3ArrayType& phi) const {
+  assert(phi.Size() == Size());
+  star_QuatLogmBlocked(phi.data(), data(), Size());
+}
+
+template <class Allocator>
+void BasicQuaternionArray<Allocator>::RotateActive(Vec3ArrayType& v_rot,
+                                                   const Vec3ArrayType& v) const {
+  assert(v_rot.Size() == Size() && v.Size() == Size());
+  star_QuatRotateActiveBlocked(v_rot.data(), data(), v.data(), Size());
+}
+
+#ifndef STAR_HEADER_ONLY
+extern template class BlockedArray<Vec3>;
+extern template class BlockedArray<Quaternion>;
+extern template class BasicQuaternionArray<>;
+#endif
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/QuaternionArray.cpp"
+#endif
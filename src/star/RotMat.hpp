@@ -5,8 +5,11 @@
 
 #pragma once
 
-#include <cmath>
 #include "star/Mat3.hpp"
+#include "star/fastmath.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/matrix_multiplication.hpp"
+#include "star/quaternion_kernels.hpp"
 #include "star/typedefs.h"
 
 namespace star {
@@ -14,91 +17,155 @@ namespace star {
 constexpr bool Active = true;
 constexpr bool Passive = false;
 
-template <bool Sense>
-class RotMat : public Mat3 {
+/*
+ * @brief Orthonormal 3x3 rotation matrix
+ *
+ * The sense is part of the type: an active matrix rotates vectors, a passive matrix
+ * changes the frame they are expressed in, and is the transpose of the active matrix of the
+ * same rotation. Every constructor assumes an orthonormal matrix, so the inverse is the
+ * transpose. Products of rotation matrices are rotation matrices in the sense of the left
+ * operand, with the other sense converted at compile time (see Multiply below).
+ * Orthonormalize() removes the round-off accumulated over long compositions. Like Mat3, it
+ * may hold any scalar type, e.g. RotMat<Active, Dual<3>> to differentiate through it.
+ */
+template <bool Sense, class T = sfloat>
+class RotMat : public Matrix<3, 3, T> {
+  using Base = Matrix<3, 3, T>;
+
  public:
+  using Base::data;
+
   /*-------------------------------------
    * Constructors
    *-----------------------------------*/
   // NOTE: RotMat does NOT inherit the constructors of Mat3
-  RotMat() : Mat3(Identity()) {}
-  explicit RotMat(const Mat3& mat) : Mat3(mat) {}
-  RotMat(sfloat R00, sfloat R01, sfloat R02, sfloat R10, sfloat R11, sfloat R12, sfloat R20,
-         sfloat R21, sfloat R22)
-      : Mat3(R00, R01, R02, R10, R11, R12, R20, R21, R22) {}
+  constexpr RotMat() : Base(Base::Identity()) {}
+  constexpr explicit RotMat(const Base& mat) : Base(mat) {}
+
+  // Elements in column-major order, like Mat3
+  constexpr RotMat(T x00, T x10, T x20, T x01, T x11, T x21, T x02, T x12, T x22)
+      : Base(x00, x10, x20, x01, x11, x21, x02, x12, x22) {}
+
+  // The same rotation in the other sense
+  constexpr explicit RotMat(const RotMat<!Sense, T>& R)
+      : Base(static_cast<const Base&>(R).Transpose()) {}
 
   /*-------------------------------------
    * Static Methods
    *-----------------------------------*/
-  static RotMat ByRows(sfloat R00, sfloat R01, sfloat R02, sfloat R10, sfloat R11,
-                       sfloat R12, sfloat R20, sfloat R21, sfloat R22) {
-    return RotMat(R00, R01, R02, R10, R11, R12, R20, R21, R22);
+  static constexpr RotMat ByRows(T R00, T R01, T R02, T R10, T R11, T R12, T R20, T R21,
+                                 T R22) {
+    return RotMat(R00, R10, R20, R01, R11, R21, R02, R12, R22);
   }
 
-  static RotMat RotX(sfloat angle);
-  static RotMat RotY(sfloat angle);
-  static RotMat RotZ(sfloat angle);
-  static RotMat FromAxisAngle(sfloat angle, sfloat x, sfloat y, sfloat z);
-  static RotMat FromAxisAngle(sfloat angle, const Vec3& axis);
-  static RotMat FromQuaternion(sfloat w, sfloat i, sfloat j, sfloat k);
+  static RotMat RotX(T angle);
+  static RotMat RotY(T angle);
+  static RotMat RotZ(T angle);
 
+  // The axis must have unit length
+  static RotMat FromAxisAngle(T angle, T x, T y, T z);
+  static RotMat FromAxisAngle(T angle, const Vector<3, T>& axis) {
+    return FromAxisAngle(angle, axis.x, axis.y, axis.z);
+  }
+
+  // The quaternion must have unit norm
+  static RotMat FromQuaternion(T w, T i, T j, T k);
 
   /*-------------------------------------
    * Linear Algebra
    *-----------------------------------*/
-  RotMat Transpose() const { return RotMat(Mat3::Transpose()); }
+  constexpr RotMat Transpose() const { return RotMat(Base::Transpose()); }
   RotMat& TransposeInPlace() {
-    Mat3::TransposeInPlace();
+    Base::TransposeInPlace();
+    return *this;
+  }
+  constexpr RotMat Inverse() const { return Transpose(); }
+  RotMat& InverseInPlace() { return TransposeInPlace(); }
+
+  RotMat& Orthonormalize() {
+    Orthonormalize33(data_);
     return *this;
   }
+
+ private:
+  using Base::data_;
+
+  // Sine and cosine of the rotations about the axes, negated for passive rotations
+  static void SinCos(T angle, T& s, T& c) {
+    star::SinCos(angle, s, c);
+    s = Sense == Active ? s : -s;
+  }
 };
 
 /*-------------------------------------
- * Active Rotations
+ * Composition
  *-----------------------------------*/
-template <>
-RotMat<Active> RotMat<Active>::RotX(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Active>(1, 0, 0, 0, c, -s, 0, s, c);
+template <bool Sense, class T>
+constexpr RotMat<Sense, T> Multiply(const RotMat<Sense, T>& A, const RotMat<Sense, T>& B) {
+  using Mat = Matrix<3, 3, T>;
+  return RotMat<Sense, T>(Multiply(static_cast<const Mat&>(A), static_cast<const Mat&>(B)));
+}
+
+// B is converted to the sense of A by multiplying with its transpose
+template <bool Sense, class T>
+RotMat<Sense, T> Multiply(const RotMat<Sense, T>& A, const RotMat<!Sense, T>& B) {
+  RotMat<Sense, T> C;
+  MatMulTransposed<3, 3, 3>(C.data(), A.data(), B.data());
+  return C;
 }
 
-template <>
-RotMat<Active> RotMat<Active>::RotY(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Active>(c, 0, s, 0, 1, 0, -s, 0, c);
+/*-------------------------------------
+ * Conversions
+ *-----------------------------------*/
+template <bool Sense, class T>
+inline RotMat<Sense, T> RotMat<Sense, T>::FromAxisAngle(T angle, T x, T y, T z) {
+  T c;
+  T s;
+  SinCos(angle, s, c);
+  // Rodrigues' formula, R = c I + s [u]x + (1 - c) u u^T for active rotations
+  const T v = 1 - c;
+  return ByRows(c + v * x * x, v * x * y - s * z, v * x * z + s * y,  //
+                v * x * y + s * z, c + v * y * y, v * y * z - s * x,  //
+                v * x * z - s * y, v * y * z + s * x, c + v * z * z);
 }
 
-template <>
-RotMat<Active> RotMat<Active>::RotZ(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Active>(c, -s, 0, s, c, 0, 0, 0, 1);
+template <bool Sense, class T>
+inline RotMat<Sense, T> RotMat<Sense, T>::FromQuaternion(T w, T i, T j, T k) {
+  const T q[4] = {w, i, j, k};
+  RotMat R;
+  if (Sense == Active) {
+    QuatToRotMatActive(R.data(), q);
+  } else {
+    QuatToRotMatPassive(R.data(), q);
+  }
+  return R;
 }
 
 /*-------------------------------------
- * Passive Rotations
+ * Elementary Rotations
  *-----------------------------------*/
-template <>
-RotMat<Passive> RotMat<Passive>::RotX(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Passive>(1, 0, 0, 0, c, s, 0, -s, c);
+template <bool Sense, class T>
+inline RotMat<Sense, T> RotMat<Sense, T>::RotX(T angle) {
+  T c;
+  T s;
+  SinCos(angle, s, c);
+  return ByRows(1, 0, 0, 0, c, -s, 0, s, c);
 }
 
-template <>
-RotMat<Passive> RotMat<Passive>::RotY(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Passive>(c, 0, -s, 0, 1, 0, s, 0, c);
+template <bool Sense, class T>
+inline RotMat<Sense, T> RotMat<Sense, T>::RotY(T angle) {
+  T c;
+  T s;
+  SinCos(angle, s, c);
+  return ByRows(c, 0, s, 0, 1, 0, -s, 0, c);
 }
 
-template <>
-RotMat<Passive> RotMat<Passive>::RotZ(sfloat angle) {
-  sfloat c = std::cos(angle);
-  sfloat s = std::sin(angle);
-  return RotMat<Passive>(c, s, 0, -s, c, 0, 0, 0, 1);
+template <bool Sense, class T>
+inline RotMat<Sense, T> RotMat<Sense, T>::RotZ(T angle) {
+  T c;
+  T s;
+  SinCos(angle, s, c);
+  return ByRows(c, -s, 0, s, c, 0, 0, 0, 1);
 }
 
-}  // namespace star
\ No newline at end of file
+}  // namespace star
@@ -0,0 +1,49 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "RotationOperator.hpp"
+
+extern "C" {
+#include "star/matrix3.h"
+#include "star/quaternion.h"
+}
+
+namespace star {
+
+STAR_INLINE RotationOperator::RotationOperator(const Quaternion& q) {
+  star_QuatToRotMatActive(R_.data(), q.data());
+}
+
+/*-------------------------------------
+ * Rotations
+ *-----------------------------------*/
+STAR_INLINE Vec3 RotationOperator::RotateActive(const Vec3& v) const {
+  Vec3 out;
+  star_VecMul33(out.data(), R_.data(), v.data());
+  return out;
+}
+
+STAR_INLINE Vec3 RotationOperator::RotatePassive(const Vec3& v) const {
+  Vec3 out;
+  star_TransposedVecMul33(out.data(), R_.data(), v.data());
+  return out;
+}
+
+STAR_INLINE void RotationOperator::RotateActive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot,
+                                                const sfloat* x, const sfloat* y,
+                                                const sfloat* z, int n) const {
+  star_VecMulBatch33(x_rot, y_rot, z_rot, R_.data(), x, y, z, n);
+}
+
+STAR_INLINE void RotationOperator::RotatePassive(sfloat* x_rot, sfloat* y_rot,
+                                                 sfloat* z_rot, const sfloat* x,
+                                                 const sfloat* y, const sfloat* z,
+                                                 int n) const {
+  sfloat Rt[9];
+  star_Transpose33(Rt, R_.data());
+  star_VecMulBatch33(x_rot, y_rot, z_rot, Rt, x, y, z, n);
+}
+
+}  // namespace star
@@ -0,0 +1,59 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Quaternion.hpp"
+#include "star/RotMat.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief A rotation applied to many vectors
+ *
+ * Built from a unit quaternion or a rotation matrix, and always rotates vectors by the
+ * cached active rotation matrix. star_QuatRotateActive forms the same matrix internally
+ * for every call, so building the matrix once and multiplying by it is faster from the
+ * first vector on, and the batched multiply vectorizes over the vectors. See
+ * rotation_operator_bench.cpp for the comparison with rotating each vector by the
+ * quaternion.
+ */
+class RotationOperator {
+ public:
+  /*-------------------------------------
+   * Constructors
+   *-----------------------------------*/
+  explicit RotationOperator(const Quaternion& q);
+  explicit RotationOperator(const RotMat<Active>& R) : R_(R) {}
+  explicit RotationOperator(const RotMat<Passive>& R) : R_(R) {}
+
+  /*-------------------------------------
+   * Getters
+   *-----------------------------------*/
+  const RotMat<Active>& Matrix() const { return R_; }
+
+  /*-------------------------------------
+   * Rotations
+   *-----------------------------------*/
+  Vec3 RotateActive(const Vec3& v) const;
+  Vec3 RotatePassive(const Vec3& v) const;
+
+  // Rotate n vectors stored as separate x, y, z arrays. Outputs may alias the inputs.
+  void RotateActive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                    const sfloat* y, const sfloat* z, int n) const;
+  void RotatePassive(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot, const sfloat* x,
+                     const sfloat* y, const sfloat* z, int n) const;
+
+ private:
+  RotMat<Active> R_;
+};
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/RotationOperator.cpp"
+#endif
@@ -5,22 +5,38 @@
 
 #pragma once
 
-#include "Mat3.hpp"
-#include "Vec3.hpp"
-#include "typedefs.h"
+#include "star/Expression.hpp"
+#include "star/Matrix.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/typedefs.h"
 
 namespace star {
 
+/*
+ * @brief Lazy transpose of a matrix of any shape
+ *
+ * Only stores a reference to the matrix, so creating one is free. Products with a
+ * transposed operand call the TransposedMatMul and MatMulTransposed kernels directly (see
+ * matrix_multiplication.hpp). Sums, differences and solves read the elements in transposed
+ * order. None of these ever form the transpose. Like the expression nodes in
+ * Expression.hpp, a view must not outlive the matrix it refers to, so views of temporaries
+ * and expressions are not allowed. Evaluate those into a named matrix first.
+ *
+ * A view refers to the type its matrix evaluates to, so `Transpose(R)` of a RotMat is a
+ * `Transpose<Mat3>`. The mutable accessors may only be used on views of non-const matrices,
+ * e.g. as the output of MultiplyInPlace.
+ */
 template <class Mat>
-class Transpose {
-  // Static assert that Mat is a matrix
-  static_assert(Mat::kCols > 1, "Must be a matrix");
+class Transpose : public Expression<Transpose<Mat>> {
+  static_assert(IsMatrix<Mat>::value, "Must be a matrix");
 
  public:
   // Size information
   static constexpr int kRows = Mat::kCols;
   static constexpr int kCols = Mat::kRows;
   static constexpr int kSize = Mat::kSize;
+  using Scalar = typename Mat::Scalar;
+  using ResultType = Matrix<kRows, kCols, Scalar>;
   constexpr int Rows() const { return kRows; }
   constexpr int Cols() const { return kCols; }
   constexpr int Size() const { return kSize; }
@@ -28,32 +44,55 @@ class Transpose {
   /*-------------------------------------
    * Constructors
    *-----------------------------------*/
-  Transpose(Mat& mat) : mat_(mat) {};
+  constexpr explicit Transpose(const Mat& mat) : mat_(mat) {}
+  // Would refer to a temporary, including the matrix an expression converts to
+  Transpose(const Mat&&) = delete;
 
   /*-------------------------------------
    * Getters
    *-----------------------------------*/
-  auto GetRow(int row) const {
-    return mat_.GetCol(row);
-  }
+  auto GetRow(int row) const { return mat_.GetCol(row); }
+  auto GetCol(int col) const { return mat_.GetRow(col); }
 
-  auto GetCol(int col) const {
-    return mat_.GetRow(col);
+  /*-------------------------------------
+   * Data Access
+   *-----------------------------------*/
+  // k-th element of the transpose in column-major order
+  constexpr const Scalar& operator[](int k) const {
+    return mat_[k / kRows + kCols * (k % kRows)];
   }
+  constexpr const Scalar& operator()(int i, int j) const { return mat_[j + kCols * i]; }
+  Scalar& operator[](int k) { return data()[k / kRows + kCols * (k % kRows)]; }
+  Scalar& operator()(int i, int j) { return data()[j + kCols * i]; }
+
+  // Data of the underlying matrix, i.e. the transpose in row-major order
+  Scalar* data() { return const_cast<Scalar*>(mat_.data()); }
+  const Scalar* data() const { return mat_.data(); }
 
   /*-------------------------------------
-   * Data Access
+   * Linear Algebra
    *-----------------------------------*/
-  sfloat& operator[](int k) { return mat_(k % 3, k / 3); }
-  const sfloat& operator[](int k) const { return mat_(k % 3, k / 3); }
-  sfloat& operator()(int i, int j) { return mat_(j, i); }
-  const sfloat& operator()(int i, int j) const { return mat_(j, i); }
-  sfloat* data() { return mat_.data(); }
-  const sfloat* data() const { return mat_.data(); }
+  // Solve A^T X = B. Returns false if A is singular.
+  template <int N>
+  bool Solve(Matrix<kRows, N, Scalar>& X, const Matrix<kRows, N, Scalar>& B) const {
+    static_assert(kRows == kCols, "Solve requires a square matrix");
+    return LUSolve<kRows, N, true>(X.data(), mat_.data(), B.data());
+  }
 
  private:
-  Mat& mat_;
+  const Mat& mat_;
 };
 
+// Views of derived types refer to the matrix type they evaluate to
+template <class Mat>
+Transpose(const Mat&) -> Transpose<typename Mat::ResultType>;
+template <class Mat>
+Transpose(const Mat&&) -> Transpose<typename Mat::ResultType>;
+
+// Views are stored by value in expressions, like the expression nodes
+template <class Mat>
+struct ExpressionOperand<Transpose<Mat>> {
+  using type = const Transpose<Mat>;
+};
 
-}  // namespace star
\ No newline at end of file
+}  // namespace star
@@ -5,106 +5,153 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstddef>
+#include <type_traits>
 
+#include "star/Expression.hpp"
+#include "star/Vector.hpp"
 #include "star/typedefs.h"
 
 namespace star {
 
-class Vec3 {
+template <class T>
+class Vector<3, T> : public Expression<Vector<3, T>> {
  public:
+  // Size information
+  static constexpr int kSize = 3;
+  using Scalar = T;
+  using ResultType = Vector;
+
   /*---------------------------------*/
   /* Constructors                    */
   /*---------------------------------*/
-  Vec3() = default;
-  Vec3(sfloat x, sfloat y, sfloat z) : x(x), y(y), z(z) {}
+  Vector() = default;
+  constexpr Vector(T x, T y, T z) : x(x), y(y), z(z) {}
+
+  template <class V>
+  explicit Vector(V v) : x(v[0]), y(v[1]), z(v[2]) {}
+
+  // Evaluate an element-wise expression, e.g. Vec3 c = a + 2.0 * b;
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector(const Expression<E>& expr)  // NOLINT: Allow implicit conversion
+      : x(expr.Cast()[0]), y(expr.Cast()[1]), z(expr.Cast()[2]) {}
 
-  template <class Vector>
-  explicit Vec3(Vector v) : x(v[0]), y(v[1]), z(v[2]) {}
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator=(const Expression<E>& expr) {
+    const E& e = expr.Cast();
+    x = e[0];
+    y = e[1];
+    z = e[2];
+    return *this;
+  }
 
   /*---------------------------------*/
   /* Static Methods                  */
   /*---------------------------------*/
-  static Vec3 Zero() { return {0, 0, 0}; }
-  static Vec3 Const(sfloat value) { return {value, value, value}; }
-  static Vec3 XAxis() { return {1, 0, 0}; }
-  static Vec3 YAxis() { return {0, 1, 0}; }
-  static Vec3 ZAxis() { return {0, 0, 1}; }
+  static constexpr Vector Zero() { return {0, 0, 0}; }
+  static constexpr Vector Const(T value) { return {value, value, value}; }
+  static constexpr Vector XAxis() { return {1, 0, 0}; }
+  static constexpr Vector YAxis() { return {0, 1, 0}; }
+  static constexpr Vector ZAxis() { return {0, 0, 1}; }
 
   /*---------------------------------*/
   /* Setters                         */
   /*---------------------------------*/
-  void SetConst(sfloat value);
+  void SetConst(T value);
   void SetZero();
 
   /*---------------------------------*/
   /* Norms and Related               */
   /*---------------------------------*/
-  sfloat Norm() const;
-  sfloat NormSquared() const;
-  sfloat InfNorm() const;
-  sfloat OneNorm() const;
-  Vec3 Normalize() const;
-  Vec3& NormalizeInPlace();
-  sfloat Dot(const Vec3& y) const;
-  sfloat NormedDifference(const Vec3& other) const;
+  T Norm() const;
+  T NormSquared() const;
+  T InfNorm() const;
+  T OneNorm() const;
+  Vector Normalize() const;
+  Vector& NormalizeInPlace();
+  T NormedDifference(const Vector& other) const;
 
-  Vec3 Cross(const Vec3& y) const;
+  constexpr T Dot(const Vector& other) const {
+    return x * other.x + y * other.y + z * other.z;
+  }
+  constexpr Vector Cross(const Vector& other) const {
+    return {y * other.z - z * other.y, z * other.x - x * other.z,
+            x * other.y - y * other.x};
+  }
 
   /*---------------------------------*/
   /* Element-wise operations         */
   /*---------------------------------*/
-  Vec3 Add(const Vec3& y) const;
-  Vec3 Sub(const Vec3& y) const;
-  Vec3 Mul(const Vec3& y) const;
-  Vec3 Div(const Vec3& y) const;
-
-  Vec3& AddInPlace(const Vec3& y);
-  Vec3& SubInPlace(const Vec3& y);
-  Vec3& MulInPlace(const Vec3& y);
-  Vec3& DivInPlace(const Vec3& y);
-
-  Vec3 UnaryMap(sfloat (*function)(sfloat)) const;
-  Vec3 BinaryMap(const Vec3& y, sfloat (*function)(sfloat, sfloat)) const;
-
-  Vec3 operator+(const Vec3& rhs) const { return this->Add(rhs); }
-  Vec3 operator-(const Vec3& rhs) const { return this->Sub(rhs); }
-  Vec3 operator*(const Vec3& rhs) const { return this->Mul(rhs); }
-  Vec3 operator/(const Vec3& rhs) const { return this->Div(rhs); }
-
-  Vec3& operator+=(const Vec3& rhs) { return this->AddInPlace(rhs); };
-  Vec3& operator-=(const Vec3& rhs) { return this->SubInPlace(rhs); };
-  Vec3& operator*=(const Vec3& rhs) { return this->MulInPlace(rhs); };
-  Vec3& operator/=(const Vec3& rhs) { return this->DivInPlace(rhs); };
-
-  Vec3 operator+(sfloat alpha) const { return this->Add({alpha, alpha, alpha}); }
-  Vec3 operator-(sfloat alpha) const { return this->Sub({alpha, alpha, alpha}); }
-  Vec3 operator*(sfloat alpha) const { return this->Mul({alpha, alpha, alpha}); }
-  Vec3 operator/(sfloat alpha) const { return this->Div({alpha, alpha, alpha}); }
-
-  template <class T>
-  Vec3& operator+=(T alpha) {
+  Vector Add(const Vector& y) const;
+  Vector Sub(const Vector& y) const;
+  Vector Mul(const Vector& y) const;
+  Vector Div(const Vector& y) const;
+
+  Vector& AddInPlace(const Vector& y);
+  Vector& SubInPlace(const Vector& y);
+  Vector& MulInPlace(const Vector& y);
+  Vector& DivInPlace(const Vector& y);
+
+  Vector UnaryMap(T (*function)(T)) const;
+  Vector BinaryMap(const Vector& y, T (*function)(T, T)) const;
+
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator+=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    x += e[0];
+    y += e[1];
+    z += e[2];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator-=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    x -= e[0];
+    y -= e[1];
+    z -= e[2];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator*=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    x *= e[0];
+    y *= e[1];
+    z *= e[2];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator/=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    x /= e[0];
+    y /= e[1];
+    z /= e[2];
+    return *this;
+  }
+
+  template <class U, std::enable_if_t<std::is_convertible_v<U, T>, int> = 0>
+  Vector& operator+=(const U& alpha) {
     x += alpha;
     y += alpha;
     z += alpha;
     return *this;
   }
-  template <class T>
-  Vec3& operator-=(T alpha) {
+  template <class U, std::enable_if_t<std::is_convertible_v<U, T>, int> = 0>
+  Vector& operator-=(const U& alpha) {
     x -= alpha;
     y -= alpha;
     z -= alpha;
     return *this;
   }
-  template <class T>
-  Vec3& operator*=(T alpha) {
+  template <class U, std::enable_if_t<std::is_convertible_v<U, T>, int> = 0>
+  Vector& operator*=(const U& alpha) {
     x *= alpha;
     y *= alpha;
     z *= alpha;
     return *this;
   }
-  template <class T>
-  Vec3& operator/=(T alpha) {
+  template <class U, std::enable_if_t<std::is_convertible_v<U, T>, int> = 0>
+  Vector& operator/=(const U& alpha) {
     x /= alpha;
     y /= alpha;
     z /= alpha;
@@ -114,20 +161,145 @@ class Vec3 {
   /*---------------------------------*/
   /* Data Access                     */
   /*---------------------------------*/
-  sfloat* data() { return &x; }
-  const sfloat* data() const { return &x; }
-  sfloat& operator[](size_t index) { return (&x)[index]; }
-  const sfloat& operator[](size_t index) const { return (&x)[index]; }
-
-  sfloat x;
-  sfloat y;
-  sfloat z;
+  T* data() { return &x; }
+  const T* data() const { return &x; }
+  T& operator[](size_t index) { return (&x)[index]; }
+  const T& operator[](size_t index) const { return (&x)[index]; }
+
+  T x;
+  T y;
+  T z;
 };
 
-static inline Vec3 operator+(sfloat alpha, const Vec3& rhs) { return rhs + alpha; }
-static inline Vec3 operator-(sfloat alpha, const Vec3& rhs) { return rhs - alpha; }
-static inline Vec3 operator*(sfloat alpha, const Vec3& rhs) { return rhs * alpha; }
-static inline Vec3 operator/(sfloat alpha, const Vec3& rhs) { return rhs / alpha; }
+/*---------------------------------*/
+/* Setters                         */
+/*---------------------------------*/
+template <class T>
+void Vector<3, T>::SetConst(T value) {
+  *this = Const(value);
+}
+
+template <class T>
+void Vector<3, T>::SetZero() {
+  *this = Zero();
+}
+
+/*---------------------------------*/
+/* Norms and Related               */
+/*---------------------------------*/
+template <class T>
+T Vector<3, T>::Norm() const {
+  using std::sqrt;
+  return sqrt(NormSquared());
+}
+
+template <class T>
+T Vector<3, T>::NormSquared() const {
+  return Dot(*this);
+}
+
+template <class T>
+T Vector<3, T>::InfNorm() const {
+  using std::abs;
+  const T ax = abs(x);
+  const T ay = abs(y);
+  const T az = abs(z);
+  T norm = ay > ax ? ay : ax;
+  norm = az > norm ? az : norm;
+  return norm;
+}
+
+template <class T>
+T Vector<3, T>::OneNorm() const {
+  using std::abs;
+  return abs(x) + abs(y) + abs(z);
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::Normalize() const {
+  Vector out(x, y, z);
+  return out.NormalizeInPlace();
+}
+
+template <class T>
+Vector<3, T>& Vector<3, T>::NormalizeInPlace() {
+  const T inv_norm = 1 / Norm();
+  *this *= inv_norm;
+  return *this;
+}
+
+template <class T>
+T Vector<3, T>::NormedDifference(const Vector& other) const {
+  return Sub(other).Norm();
+}
+
+/*---------------------------------*/
+/* Element-wise operations         */
+/*---------------------------------*/
+template <class T>
+Vector<3, T> Vector<3, T>::Add(const Vector& y) const {
+  Vector out(*this);
+  return out.AddInPlace(y);
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::Sub(const Vector& y) const {
+  Vector out(*this);
+  return out.SubInPlace(y);
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::Mul(const Vector& y) const {
+  Vector out(*this);
+  return out.MulInPlace(y);
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::Div(const Vector& y) const {
+  Vector out(*this);
+  return out.DivInPlace(y);
+}
+
+template <class T>
+Vector<3, T>& Vector<3, T>::AddInPlace(const Vector& y) {
+  return *this += y;
+}
+
+template <class T>
+Vector<3, T>& Vector<3, T>::SubInPlace(const Vector& y) {
+  return *this -= y;
+}
+
+template <class T>
+Vector<3, T>& Vector<3, T>::MulInPlace(const Vector& y) {
+  return *this *= y;
+}
+
+template <class T>
+Vector<3, T>& Vector<3, T>::DivInPlace(const Vector& y) {
+  return *this /= y;
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::UnaryMap(T (*function)(T)) const {
+  Vector out;
+  for (int i = 0; i < kSize; ++i) {
+    out[i] = function((*this)[i]);
+  }
+  return out;
+}
+
+template <class T>
+Vector<3, T> Vector<3, T>::BinaryMap(const Vector& y, T (*function)(T, T)) const {
+  Vector out;
+  for (int i = 0; i < kSize; ++i) {
+    out[i] = function((*this)[i], y[i]);
+  }
+  return out;
+}
 
+#ifndef STAR_HEADER_ONLY
+extern template class Vector<3>;
+#endif
 
-}  // namespace star
\ No newline at end of file
+}  // namespace star
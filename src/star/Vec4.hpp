@@ -5,114 +5,310 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstddef>
 
+#include "star/Expression.hpp"
+#include "star/Vector.hpp"
 #include "star/typedefs.h"
 
 namespace star {
 
-class Vec4 {
+template <class T>
+class Vector<4, T> : public Expression<Vector<4, T>> {
  public:
+  // Size information
+  static constexpr int kSize = 4;
+  using Scalar = T;
+  using ResultType = Vector;
+
   /*---------------------------------*/
   /* Constructors                    */
   /*---------------------------------*/
-  Vec4() = default;
-  Vec4(sfloat w, sfloat x, sfloat y, sfloat z) : w(w), x(x), y(y), z(z) {}
+  Vector() = default;
+  constexpr Vector(T w, T x, T y, T z) : w(w), x(x), y(y), z(z) {}
+
+  // Also evaluates element-wise expressions, e.g. Vec4 c = a + 2.0 * b;
+  template <class V>
+  Vector(V v) : w(v[0]), x(v[1]), y(v[2]), z(v[3]) {}
 
-  template <class Vector>
-  Vec4(Vector v) : w(v[0]), x(v[1]), y(v[2]), z(v[3]) {}
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator=(const Expression<E>& expr) {
+    const E& e = expr.Cast();
+    w = e[0];
+    x = e[1];
+    y = e[2];
+    z = e[3];
+    return *this;
+  }
 
   /*---------------------------------*/
   /* Static Methods                  */
   /*---------------------------------*/
-  static Vec4 Zero() { return {0, 0, 0, 0}; }
-  static Vec4 Const(sfloat value) { return {value, value, value, value}; }
+  static constexpr Vector Zero() { return {0, 0, 0, 0}; }
+  static constexpr Vector Const(T value) { return {value, value, value, value}; }
 
   /*---------------------------------*/
   /* Setters                         */
   /*---------------------------------*/
-  void SetConst(sfloat value);
+  void SetConst(T value);
   void SetZero();
 
   /*---------------------------------*/
   /* Norms and Related               */
   /*---------------------------------*/
-  sfloat Norm() const;
-  sfloat NormSquared() const;
-  sfloat InfNorm() const;
-  sfloat OneNorm() const;
-  Vec4 Normalize() const;
-  Vec4& NormalizeInPlace();
-  sfloat Dot(const Vec4& y) const;
-  sfloat NormedDifference(const Vec4& other) const;
+  T Norm() const;
+  T NormSquared() const;
+  T InfNorm() const;
+  T OneNorm() const;
+  Vector Normalize() const;
+  Vector& NormalizeInPlace();
+  constexpr T Dot(const Vector& other) const {
+    return w * other.w + x * other.x + y * other.y + z * other.z;
+  }
+  T NormedDifference(const Vector& other) const;
 
   /*---------------------------------*/
   /* Element-wise operations         */
   /*---------------------------------*/
-  Vec4 Add(const Vec4& y) const;
-  Vec4 Sub(const Vec4& y) const;
-  Vec4 Mul(const Vec4& y) const;
-  Vec4 Div(const Vec4& y) const;
-
-  Vec4& AddInPlace(const Vec4& y);
-  Vec4& SubInPlace(const Vec4& y);
-  Vec4& MulInPlace(const Vec4& y);
-  Vec4& DivInPlace(const Vec4& y);
+  Vector Add(const Vector& y) const;
+  Vector Sub(const Vector& y) const;
+  Vector Mul(const Vector& y) const;
+  Vector Div(const Vector& y) const;
 
-  Vec4 UnaryMap(sfloat (*function)(sfloat)) const;
-  Vec4 BinaryMap(const Vec4& y, sfloat (*function)(sfloat, sfloat)) const;
+  Vector& AddInPlace(const Vector& y);
+  Vector& SubInPlace(const Vector& y);
+  Vector& MulInPlace(const Vector& y);
+  Vector& DivInPlace(const Vector& y);
 
-  Vec4 operator+(const Vec4& rhs) const { return this->Add(rhs); }
-  Vec4 operator-(const Vec4& rhs) const { return this->Sub(rhs); }
-  Vec4 operator*(const Vec4& rhs) const { return this->Mul(rhs); }
-  Vec4 operator/(const Vec4& rhs) const { return this->Div(rhs); }
+  Vector UnaryMap(T (*function)(T)) const;
+  Vector BinaryMap(const Vector& y, T (*function)(T, T)) const;
 
-  Vec4& operator+=(const Vec4& rhs) { return this->AddInPlace(rhs); };
-  Vec4& operator-=(const Vec4& rhs) { return this->SubInPlace(rhs); };
-  Vec4& operator*=(const Vec4& rhs) { return this->MulInPlace(rhs); };
-  Vec4& operator/=(const Vec4& rhs) { return this->DivInPlace(rhs); };
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator+=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    w += e[0];
+    x += e[1];
+    y += e[2];
+    z += e[3];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator-=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    w -= e[0];
+    x -= e[1];
+    y -= e[2];
+    z -= e[3];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator*=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    w *= e[0];
+    x *= e[1];
+    y *= e[2];
+    z *= e[3];
+    return *this;
+  }
+  template <class E, EnableIfResult<E, Vector> = 0>
+  Vector& operator/=(const Expression<E>& rhs) {
+    const E& e = rhs.Cast();
+    w /= e[0];
+    x /= e[1];
+    y /= e[2];
+    z /= e[3];
+    return *this;
+  }
 
   // Scalar operators
-  Vec4 operator+(sfloat rhs) const { return this->Add(Const(rhs)); }
-  Vec4 operator-(sfloat rhs) const { return this->Sub(Const(rhs)); }
-  Vec4 operator*(sfloat rhs) const { return this->Mul(Const(rhs)); }
-  Vec4 operator/(sfloat rhs) const { return this->Div(Const(rhs)); }
-
-  Vec4& operator+=(sfloat rhs) { return this->AddInPlace(Const(rhs)); };
-  Vec4& operator-=(sfloat rhs) { return this->SubInPlace(Const(rhs)); };
-  Vec4& operator*=(sfloat rhs) { return this->MulInPlace(Const(rhs)); };
-  Vec4& operator/=(sfloat rhs) { return this->DivInPlace(Const(rhs)); };
+  Vector& operator+=(const T& rhs) {
+    w += rhs;
+    x += rhs;
+    y += rhs;
+    z += rhs;
+    return *this;
+  }
+  Vector& operator-=(const T& rhs) {
+    w -= rhs;
+    x -= rhs;
+    y -= rhs;
+    z -= rhs;
+    return *this;
+  }
+  Vector& operator*=(const T& rhs) {
+    w *= rhs;
+    x *= rhs;
+    y *= rhs;
+    z *= rhs;
+    return *this;
+  }
+  Vector& operator/=(const T& rhs) {
+    w /= rhs;
+    x /= rhs;
+    y /= rhs;
+    z /= rhs;
+    return *this;
+  }
 
   /*---------------------------------*/
   /* Data Access                     */
   /*---------------------------------*/
-  sfloat* data() { return &w; }
-  const sfloat* data() const { return &w; }
-  sfloat& operator[](size_t index) { return (&w)[index]; }
-  const sfloat& operator[](size_t index) const { return (&w)[index]; }
+  T* data() { return &w; }
+  const T* data() const { return &w; }
+  T& operator[](size_t index) { return (&w)[index]; }
+  const T& operator[](size_t index) const { return (&w)[index]; }
 
+  // The constructors set w, x, y and z, so only these can be read in constant expressions
   union {
-    sfloat w;
-    sfloat s;
+    T w;
+    T s;
   };
   union {
-    sfloat i;
-    sfloat x;
+    T i;
+    T x;
   };
   union {
-    sfloat j;
-    sfloat y;
+    T j;
+    T y;
   };
   union {
-    sfloat k;
-    sfloat z;
+    T k;
+    T z;
   };
 };
 
-static inline Vec4 operator+(sfloat lhs, const Vec4& rhs) { return rhs + lhs; }
-static inline Vec4 operator-(sfloat lhs, const Vec4& rhs) { return rhs - lhs; }
-static inline Vec4 operator*(sfloat lhs, const Vec4& rhs) { return rhs * lhs; }
-static inline Vec4 operator/(sfloat lhs, const Vec4& rhs) { return rhs / lhs; }
+/*---------------------------------*/
+/* Setters                         */
+/*---------------------------------*/
+template <class T>
+void Vector<4, T>::SetConst(T value) {
+  *this = Const(value);
+}
+
+template <class T>
+void Vector<4, T>::SetZero() {
+  *this = Zero();
+}
+
+/*---------------------------------*/
+/* Norms and Related               */
+/*---------------------------------*/
+template <class T>
+T Vector<4, T>::Norm() const {
+  using std::sqrt;
+  return sqrt(NormSquared());
+}
+
+template <class T>
+T Vector<4, T>::NormSquared() const {
+  return Dot(*this);
+}
+
+template <class T>
+T Vector<4, T>::InfNorm() const {
+  using std::abs;
+  const T aw = abs(w);
+  const T ax = abs(x);
+  const T ay = abs(y);
+  const T az = abs(z);
+  T norm = ax > aw ? ax : aw;
+  norm = ay > norm ? ay : norm;
+  norm = az > norm ? az : norm;
+  return norm;
+}
+
+template <class T>
+T Vector<4, T>::OneNorm() const {
+  using std::abs;
+  return abs(w) + abs(x) + abs(y) + abs(z);
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::Normalize() const {
+  Vector out(w, x, y, z);
+  return out.NormalizeInPlace();
+}
+
+template <class T>
+Vector<4, T>& Vector<4, T>::NormalizeInPlace() {
+  const T inv_norm = 1 / Norm();
+  *this *= inv_norm;
+  return *this;
+}
+
+template <class T>
+T Vector<4, T>::NormedDifference(const Vector& other) const {
+  return Sub(other).Norm();
+}
+
+/*---------------------------------*/
+/* Element-wise operations         */
+/*---------------------------------*/
+template <class T>
+Vector<4, T> Vector<4, T>::Add(const Vector& y) const {
+  Vector out(*this);
+  return out.AddInPlace(y);
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::Sub(const Vector& y) const {
+  Vector out(*this);
+  return out.SubInPlace(y);
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::Mul(const Vector& y) const {
+  Vector out(*this);
+  return out.MulInPlace(y);
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::Div(const Vector& y) const {
+  Vector out(*this);
+  return out.DivInPlace(y);
+}
+
+template <class T>
+Vector<4, T>& Vector<4, T>::AddInPlace(const Vector& y) {
+  return *this += y;
+}
+
+template <class T>
+Vector<4, T>& Vector<4, T>::SubInPlace(const Vector& y) {
+  return *this -= y;
+}
+
+template <class T>
+Vector<4, T>& Vector<4, T>::MulInPlace(const Vector& y) {
+  return *this *= y;
+}
+
+template <class T>
+Vector<4, T>& Vector<4, T>::DivInPlace(const Vector& y) {
+  return *this /= y;
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::UnaryMap(T (*function)(T)) const {
+  Vector out;
+  for (int i = 0; i < kSize; ++i) {
+    out[i] = function((*this)[i]);
+  }
+  return out;
+}
+
+template <class T>
+Vector<4, T> Vector<4, T>::BinaryMap(const Vector& y, T (*function)(T, T)) const {
+  Vector out;
+  for (int i = 0; i < kSize; ++i) {
+    out[i] = function((*this)[i], y[i]);
+  }
+  return out;
+}
 
+#ifndef STAR_HEADER_ONLY
+extern template class Vector<4>;
+#endif
 
-}  // namespace star
\ No newline at end of file
+}  // namespace star
@@ -0,0 +1,30 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief Fixed-size vector of N scalars T
+ *
+ * Only the 3- and 4-element vectors are defined, in Vec3.hpp and Vec4.hpp. Vec3 and Vec4
+ * are the vectors of sfloat. Other scalar types, e.g. Vector<3, Dual<6>>, run the same
+ * code.
+ */
+template <int N, class T = sfloat>
+class Vector;
+
+template <class T>
+class Vector<3, T>;
+template <class T>
+class Vector<4, T>;
+
+using Vec3 = Vector<3>;
+using Vec4 = Vector<4>;
+
+}  // namespace star
@@ -0,0 +1,68 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "Workspace.hpp"
+
+namespace star {
+
+STAR_INLINE Workspace::Workspace(std::size_t capacity) : capacity_(AlignUp(capacity)) {
+  if (capacity_ > 0) {
+    data_ = NewBlock(capacity_);
+  }
+}
+
+STAR_INLINE Workspace::~Workspace() {
+  for (char* block : overflow_) {
+    DeleteBlock(block);
+  }
+  if (data_ != nullptr) {
+    DeleteBlock(data_);
+  }
+}
+
+STAR_INLINE void* Workspace::AllocateBytes(std::size_t bytes) {
+  bytes = AlignUp(bytes);
+  if (used_ + bytes <= capacity_) {
+    void* ptr = data_ + used_;
+    used_ += bytes;
+    return ptr;
+  }
+  char* block = NewBlock(bytes);
+  overflow_.push_back(block);
+  overflow_bytes_ += bytes;
+  return block;
+}
+
+STAR_INLINE void Workspace::Reset() {
+  if (!overflow_.empty()) {
+    for (char* block : overflow_) {
+      DeleteBlock(block);
+    }
+    overflow_.clear();
+
+    // Grow the buffer to fit everything allocated in the last cycle
+    if (data_ != nullptr) {
+      DeleteBlock(data_);
+    }
+    capacity_ = used_ + overflow_bytes_;
+    data_ = NewBlock(capacity_);
+    overflow_bytes_ = 0;
+  }
+  used_ = 0;
+}
+
+STAR_INLINE std::size_t Workspace::AlignUp(std::size_t bytes) {
+  return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+STAR_INLINE char* Workspace::NewBlock(std::size_t bytes) {
+  return static_cast<char*>(::operator new(bytes, std::align_val_t(kAlignment)));
+}
+
+STAR_INLINE void Workspace::DeleteBlock(char* block) {
+  ::operator delete(block, std::align_val_t(kAlignment));
+}
+
+}  // namespace star
@@ -0,0 +1,116 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * @brief Arena of reusable scratch storage for batch operations and intermediate results
+ *
+ * Allocations bump a pointer into a single buffer and are only released all at once by
+ * Reset(), e.g. at the start of every control cycle. Allocations that don't fit in the
+ * buffer get their own heap block until the next Reset(), which replaces the buffer with
+ * one large enough for all of them. Once it has been reset after a cycle at its peak
+ * usage, a workspace makes no more heap allocations.
+ *
+ * Every allocation is aligned to kAlignment bytes, like the blocked arrays in
+ * quaternion_array.h. Only trivially destructible types can be allocated, since Reset()
+ * doesn't call destructors.
+ */
+class Workspace {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  explicit Workspace(std::size_t capacity = 0);
+  ~Workspace();
+  Workspace(const Workspace&) = delete;
+  Workspace& operator=(const Workspace&) = delete;
+
+  // Uninitialized storage for the given number of bytes
+  void* AllocateBytes(std::size_t bytes);
+
+  // n default-constructed objects of type T
+  template <class T>
+  T* Allocate(int n) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Workspace objects must be trivially destructible");
+    T* data = static_cast<T*>(AllocateBytes(n * sizeof(T)));
+    for (int i = 0; i < n; ++i) {
+      new (data + i) T();
+    }
+    return data;
+  }
+
+  // Releases every allocation
+  void Reset();
+
+  // Size of the buffer, and the bytes allocated from it or in overflow blocks since the
+  // last reset
+  std::size_t Capacity() const { return capacity_; }
+  std::size_t Used() const { return used_ + overflow_bytes_; }
+
+ private:
+  static std::size_t AlignUp(std::size_t bytes);
+  static char* NewBlock(std::size_t bytes);
+  static void DeleteBlock(char* block);
+
+  char* data_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t used_ = 0;
+  std::vector<char*> overflow_;
+  std::size_t overflow_bytes_ = 0;
+};
+
+/*
+ * @brief Standard allocator drawing from a Workspace
+ *
+ * Lets standard containers use the workspace, e.g.
+ * `std::vector<Mat43, WorkspaceAllocator<Mat43>> G(n, WorkspaceAllocator<Mat43>(ws))`.
+ * Deallocation is a no-op, so a container should reserve its final size up front instead
+ * of growing, and must not be used after the workspace is reset.
+ */
+template <class T>
+class WorkspaceAllocator {
+ public:
+  using value_type = T;
+
+  explicit WorkspaceAllocator(Workspace& workspace) : workspace_(&workspace) {}
+  template <class U>
+  WorkspaceAllocator(const WorkspaceAllocator<U>& other)  // NOLINT: Allow rebinding
+      : workspace_(other.GetWorkspace()) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(workspace_->AllocateBytes(n * sizeof(T)));
+  }
+  void deallocate(T*, std::size_t) {}
+
+  Workspace* GetWorkspace() const { return workspace_; }
+
+  template <class U>
+  bool operator==(const WorkspaceAllocator<U>& other) const {
+    return workspace_ == other.GetWorkspace();
+  }
+  template <class U>
+  bool operator!=(const WorkspaceAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  Workspace* workspace_;
+};
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/Workspace.cpp"
+#endif
@@ -0,0 +1,371 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "attitude.h"
+#include "dispatch.h"
+
+#include <math.h>
+
+#include "matrix3.h"
+#include "matrix4.h"
+#include "quaternion.h"
+#include "quaternion_array.h"
+#include "vector3.h"
+
+#define IDX(i, j) ((i) + 3 * (j))
+#define BS STAR_BLOCK_SIZE
+
+// Maximum number of Newton iterations for the largest eigenvalue of the Davenport matrix
+#define STAR_QUEST_ITERATIONS 20
+
+/*---------------------------------*/
+/* Attitude profile matrix         */
+/*---------------------------------*/
+
+STAR_KERNEL void star_AttitudeProfile(sfloat B[9], sfloat* weight_sum,
+                                      const sfloat* weights, const sfloat* body,
+                                      const sfloat* reference, int n) {
+  sfloat sum[10] = {0};
+  for (int i = 0; i < n; ++i) {
+    const sfloat* b = body + 3 * i;
+    const sfloat* r = reference + 3 * i;
+    for (int j = 0; j < 3; ++j) {
+      const sfloat wr = weights[i] * r[j];
+      sum[IDX(0, j)] += b[0] * wr;
+      sum[IDX(1, j)] += b[1] * wr;
+      sum[IDX(2, j)] += b[2] * wr;
+    }
+    sum[9] += weights[i];
+  }
+  for (int k = 0; k < 9; ++k) {
+    B[k] += sum[k];
+  }
+  *weight_sum += sum[9];
+}
+
+static inline void star_AttitudeProfileBlocked_Generic(sfloat B[9], sfloat* weight_sum,
+                                                       const sfloat* weights,
+                                                       const sfloat* body,
+                                                       const sfloat* reference, int n) {
+  // Sums of the elements of B and of the weights, per lane
+  sfloat sum[10][BS] = {{0}};
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* b = body + 3 * BS * blk;
+    const sfloat* r = reference + 3 * BS * blk;
+    const sfloat* w = weights + BS * blk;
+
+    // The padding of the last block gets zero weights
+    sfloat w_last[BS];
+    if (BS * (blk + 1) > n) {
+      for (int l = 0; l < BS; ++l) {
+        w_last[l] = BS * blk + l < n ? w[l] : 0;
+      }
+      w = w_last;
+    }
+    for (int l = 0; l < BS; ++l) {
+      const sfloat wb0 = w[l] * b[l];
+      const sfloat wb1 = w[l] * b[BS + l];
+      const sfloat wb2 = w[l] * b[2 * BS + l];
+      const sfloat r0 = r[l];
+      const sfloat r1 = r[BS + l];
+      const sfloat r2 = r[2 * BS + l];
+      sum[0][l] += wb0 * r0;
+      sum[1][l] += wb1 * r0;
+      sum[2][l] += wb2 * r0;
+      sum[3][l] += wb0 * r1;
+      sum[4][l] += wb1 * r1;
+      sum[5][l] += wb2 * r1;
+      sum[6][l] += wb0 * r2;
+      sum[7][l] += wb1 * r2;
+      sum[8][l] += wb2 * r2;
+      sum[9][l] += w[l];
+    }
+  }
+  for (int k = 0; k < 10; ++k) {
+    sfloat total = 0;
+    for (int l = 0; l < BS; ++l) {
+      total += sum[k][l];
+    }
+    if (k < 9) {
+      B[k] += total;
+    } else {
+      *weight_sum += total;
+    }
+  }
+}
+STAR_DISPATCH(star_AttitudeProfileBlocked,
+              (sfloat B[9], sfloat* weight_sum, const sfloat* weights, const sfloat* body,
+               const sfloat* reference, int n),
+              (B, weight_sum, weights, body, reference, n))
+
+/*---------------------------------*/
+/* Solvers                         */
+/*---------------------------------*/
+
+// Terms of the Davenport matrix K of B and of its characteristic polynomial
+typedef struct {
+  sfloat sigma;  // tr(B)
+  sfloat S[9];   // B + B^T
+  sfloat z[3];
+  sfloat Sz[3];  // S z
+  sfloat kappa;  // tr(adj(S))
+  sfloat delta;  // det(S)
+} star_Davenport;
+
+static inline void star_DavenportTerms(star_Davenport* K, const sfloat B[9]) {
+  K->sigma = B[IDX(0, 0)] + B[IDX(1, 1)] + B[IDX(2, 2)];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      K->S[IDX(i, j)] = B[IDX(i, j)] + B[IDX(j, i)];
+    }
+  }
+  K->z[0] = B[IDX(1, 2)] - B[IDX(2, 1)];
+  K->z[1] = B[IDX(2, 0)] - B[IDX(0, 2)];
+  K->z[2] = B[IDX(0, 1)] - B[IDX(1, 0)];
+  star_VecMul33(K->Sz, K->S, K->z);
+  const sfloat* S = K->S;
+  K->kappa = S[IDX(1, 1)] * S[IDX(2, 2)] - S[IDX(1, 2)] * S[IDX(1, 2)] +
+             S[IDX(0, 0)] * S[IDX(2, 2)] - S[IDX(0, 2)] * S[IDX(0, 2)] +
+             S[IDX(0, 0)] * S[IDX(1, 1)] - S[IDX(0, 1)] * S[IDX(0, 1)];
+  K->delta = star_Det33(S);
+}
+
+/*
+ * Largest root of the characteristic polynomial of K,
+ *
+ *   lambda^4 - (a + b) lambda^2 - c lambda + (a b + c sigma - d)
+ *
+ * with a = sigma^2 - kappa, b = sigma^2 + z^T z, c = delta + z^T S z and d = z^T S^2 z.
+ * The polynomial is convex and increasing right of its largest root, so Newton's method
+ * from lambda0 >= lambda decreases monotonically until rounding stops it.
+ */
+static inline sfloat star_DavenportLambda(const star_Davenport* K, sfloat lambda0) {
+  const sfloat* z = K->z;
+  const sfloat* Sz = K->Sz;
+  const sfloat sigma2 = K->sigma * K->sigma;
+  const sfloat a = sigma2 - K->kappa;
+  const sfloat b = sigma2 + z[0] * z[0] + z[1] * z[1] + z[2] * z[2];
+  const sfloat c = K->delta + z[0] * Sz[0] + z[1] * Sz[1] + z[2] * Sz[2];
+  const sfloat d = Sz[0] * Sz[0] + Sz[1] * Sz[1] + Sz[2] * Sz[2];
+  const sfloat ab = a + b;
+  const sfloat constant = a * b + c * K->sigma - d;
+  sfloat lambda = lambda0;
+  for (int iter = 0; iter < STAR_QUEST_ITERATIONS; ++iter) {
+    const sfloat lambda2 = lambda * lambda;
+    const sfloat f = (lambda2 - ab) * lambda2 - c * lambda + constant;
+    const sfloat df = 2 * lambda * (2 * lambda2 - ab) - c;
+    if (!(df > 0)) {
+      break;
+    }
+    const sfloat next = lambda - f / df;
+    if (!(next < lambda)) {
+      break;
+    }
+    lambda = next;
+  }
+  return lambda;
+}
+
+// Davenport matrix K in the order [scalar, vector] of the quaternions
+static inline void star_DavenportMatrix(sfloat K4[16], const star_Davenport* K) {
+  K4[0] = K->sigma;
+  for (int i = 0; i < 3; ++i) {
+    K4[i + 1] = K->z[i];
+    K4[4 * (i + 1)] = K->z[i];
+    for (int j = 0; j < 3; ++j) {
+      K4[(i + 1) + 4 * (j + 1)] = K->S[IDX(i, j)] - (i == j ? K->sigma : 0);
+    }
+  }
+}
+
+// Index k of the smallest diagonal element of K
+static inline int star_SmallestDiagonalIndex(const sfloat B[9]) {
+  const sfloat sigma = B[IDX(0, 0)] + B[IDX(1, 1)] + B[IDX(2, 2)];
+  sfloat smallest = sigma;
+  int k = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const sfloat diag = 2 * B[IDX(axis, axis)] - sigma;
+    if (diag < smallest) {
+      smallest = diag;
+      k = axis + 1;
+    }
+  }
+  return k;
+}
+
+/*
+ * Index k of the largest component of the solution q, from the diagonal of
+ * adj(lambda I - K), which is proportional to q q^T. Its elements are the determinants of
+ * lambda I - K without row and column k.
+ */
+static inline int star_LargestComponentIndex(const star_Davenport* K, sfloat lambda) {
+  sfloat L[16];
+  star_DavenportMatrix(L, K);
+  for (int i = 0; i < 16; ++i) {
+    L[i] = (i % 5 == 0 ? lambda : 0) - L[i];
+  }
+  static const int others[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+  sfloat best = -1;
+  int k = 0;
+  for (int m = 0; m < 4; ++m) {
+    const int* o = others[m];
+    sfloat minor[9];
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i < 3; ++i) {
+        minor[IDX(i, j)] = L[o[i] + 4 * o[j]];
+      }
+    }
+    const sfloat det = star_Det33(minor);
+    if (det > best) {
+      best = det;
+      k = m;
+    }
+  }
+  return k;
+}
+
+/*
+ * Scales B by `scale` and rotates its reference frame by 180 degrees about axis k - 1, i.e.
+ * negates the other two columns. The rotated problem has the solution q_k^-1 q, with q_k
+ * the unit quaternion along axis k - 1, so component k of q becomes its scalar part. k = 0
+ * only scales B.
+ */
+static inline void star_RotateProfile(sfloat B_rot[9], const sfloat B[9], sfloat scale,
+                                      int k) {
+  for (int j = 0; j < 3; ++j) {
+    const sfloat s = k == 0 || j == k - 1 ? scale : -scale;
+    for (int i = 0; i < 3; ++i) {
+      B_rot[IDX(i, j)] = s * B[IDX(i, j)];
+    }
+  }
+}
+
+// Normalizes the solution to a unit quaternion with a non-negative scalar part, and undoes
+// the rotation k of the reference frame
+static inline void star_FinishAttitude(sfloat q[4], int k) {
+  const sfloat norm2 = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+  if (norm2 == 0) {
+    star_QuatIdentity(q);
+    return;
+  }
+  if (k > 0) {
+    sfloat qk[4] = {0, 0, 0, 0};
+    qk[k] = 1;
+    star_QuatCompose(q, qk, q);
+  }
+  const sfloat scale = copysign(1 / sqrt(norm2), q[0]);
+  for (int i = 0; i < 4; ++i) {
+    q[i] *= scale;
+  }
+}
+
+STAR_KERNEL sfloat star_Quest(sfloat q[4], const sfloat B[9], sfloat weight_sum) {
+  // Solve with normalized weights, which keeps the polynomial within range
+  sfloat B_rot[9];
+  star_RotateProfile(B_rot, B, 1 / weight_sum, 0);
+  star_Davenport K;
+  star_DavenportTerms(&K, B_rot);
+  const sfloat lambda = star_DavenportLambda(&K, 1);
+
+  // Rotate the frame so that the scalar part of the solution is its largest component
+  const int k = star_LargestComponentIndex(&K, lambda);
+  if (k > 0) {
+    star_RotateProfile(B_rot, B, 1 / weight_sum, k);
+    star_DavenportTerms(&K, B_rot);
+  }
+
+  // q = [gamma, (alpha I + beta S + S^2) z], the adjugate of (lambda + sigma) I - S times z
+  const sfloat alpha = lambda * lambda - K.sigma * K.sigma + K.kappa;
+  const sfloat beta = lambda - K.sigma;
+  sfloat S2z[3];
+  star_VecMul33(S2z, K.S, K.Sz);
+  q[0] = (lambda + K.sigma) * alpha - K.delta;
+  for (int i = 0; i < 3; ++i) {
+    q[i + 1] = alpha * K.z[i] + beta * K.Sz[i] + S2z[i];
+  }
+  star_FinishAttitude(q, k);
+  return lambda * weight_sum;
+}
+
+STAR_KERNEL sfloat star_Esoq2(sfloat q[4], const sfloat B[9], sfloat weight_sum) {
+  // Rotate the frame away from the identity, which maximizes lambda - sigma
+  sfloat B_rot[9];
+  const int k = star_SmallestDiagonalIndex(B);
+  star_RotateProfile(B_rot, B, 1 / weight_sum, k);
+  star_Davenport K;
+  star_DavenportTerms(&K, B_rot);
+  const sfloat lambda = star_DavenportLambda(&K, 1);
+
+  // The rotation axis e spans the null space of the symmetric
+  // M = beta ((lambda + sigma) I - S) - z z^T, and q = [z^T e, beta e]
+  const sfloat beta = lambda - K.sigma;
+  sfloat M[9];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      M[IDX(i, j)] = beta * ((i == j ? lambda + K.sigma : 0) - K.S[IDX(i, j)]) -
+                     K.z[i] * K.z[j];
+    }
+  }
+
+  // Most accurate cross product of two columns of M
+  sfloat e[3] = {0, 0, 0};
+  sfloat e_norm2 = 0;
+  for (int i = 0; i < 3; ++i) {
+    sfloat y[3];
+    star_Cross(y, M + 3 * ((i + 1) % 3), M + 3 * ((i + 2) % 3));
+    const sfloat y_norm2 = y[0] * y[0] + y[1] * y[1] + y[2] * y[2];
+    if (y_norm2 > e_norm2) {
+      e[0] = y[0];
+      e[1] = y[1];
+      e[2] = y[2];
+      e_norm2 = y_norm2;
+    }
+  }
+  q[0] = K.z[0] * e[0] + K.z[1] * e[1] + K.z[2] * e[2];
+  for (int i = 0; i < 3; ++i) {
+    q[i + 1] = beta * e[i];
+  }
+  star_FinishAttitude(q, k);
+  return lambda * weight_sum;
+}
+
+STAR_KERNEL sfloat star_DavenportQ(sfloat q[4], const sfloat B[9]) {
+  star_Davenport K;
+  star_DavenportTerms(&K, B);
+  sfloat K4[16];
+  star_DavenportMatrix(K4, &K);
+  sfloat lambda[4];
+  sfloat V[16];
+  star_Eigen44(lambda, V, K4);
+  for (int i = 0; i < 4; ++i) {
+    q[i] = V[12 + i];
+  }
+  star_FinishAttitude(q, 0);
+  return lambda[3];
+}
+
+/*---------------------------------*/
+/* Covariance                      */
+/*---------------------------------*/
+
+STAR_KERNEL bool star_AttitudeCovariance(sfloat P[9], const sfloat B[9],
+                                         const sfloat q[4]) {
+  // B R(q) = sum_i w_i b_i (R(q)^T r_i)^T, which is symmetric at the optimum
+  sfloat R[9];
+  sfloat BR[9];
+  star_QuatToRotMatActive(R, q);
+  star_MatMul33(BR, B, R);
+  const sfloat trace = BR[IDX(0, 0)] + BR[IDX(1, 1)] + BR[IDX(2, 2)];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      P[IDX(i, j)] = (i == j ? trace : 0) - (BR[IDX(i, j)] + BR[IDX(j, i)]) / 2;
+    }
+  }
+  return star_InversePSD33(P);
+}
+
+#undef STAR_QUEST_ITERATIONS
+#undef BS
+#undef IDX
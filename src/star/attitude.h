@@ -0,0 +1,92 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <stdbool.h>
+
+#include "typedefs.h"
+
+/*
+ * Attitude determination from vector observations, i.e. Wahba's problem: find the attitude
+ * q minimizing
+ *
+ *   L(q) = 1/2 sum_i w_i |b_i - R(q)^T r_i|^2
+ *
+ * for unit vectors b_i measured in the body frame and their known directions r_i in the
+ * reference frame, e.g. star catalog entries. All observations enter through the attitude
+ * profile matrix B = sum_i w_i b_i r_i^T and the sum of the weights. With unit vectors,
+ * L(q) = sum_i w_i - lambda, where lambda is the largest eigenvalue of the Davenport matrix
+ * of B at the optimum.
+ *
+ * The solvers return the unit quaternion with a non-negative scalar part, so that
+ * star_QuatRotatePassive(b, q, r) maps references to the body frame. Matrices are
+ * column-major.
+ */
+
+/*
+ * @brief Adds n weighted observations to the attitude profile matrix
+ *
+ * Adds sum_i w_i b_i r_i^T to B and the sum of the weights to `weight_sum`, so that large
+ * observation sets can be accumulated in chunks. `body` and `reference` hold n interleaved
+ * x, y, z vectors.
+ */
+STAR_KERNEL void star_AttitudeProfile(sfloat B[9], sfloat* weight_sum,
+                                      const sfloat* weights, const sfloat* body,
+                                      const sfloat* reference, int n);
+
+/*
+ * @brief Adds n weighted observations stored in the blocked layout of quaternion_array.h
+ *
+ * Same as star_AttitudeProfile, with `body` and `reference` in blocks of STAR_BLOCK_SIZE
+ * vectors. Each lane of a block keeps its own sums, so the pass vectorizes. `weights` is a
+ * plain array of n weights.
+ */
+STAR_KERNEL void star_AttitudeProfileBlocked(sfloat B[9], sfloat* weight_sum,
+                                             const sfloat* weights, const sfloat* body,
+                                             const sfloat* reference, int n);
+
+/*
+ * Solvers. Each returns the largest eigenvalue lambda of the Davenport matrix
+ *
+ *   K = [sigma   z^T          ]
+ *       [z       S - sigma I  ]
+ *
+ * where sigma = tr(B), S = B + B^T and z = [B23 - B32, B31 - B13, B12 - B21], and writes
+ * its unit eigenvector to q.
+ *
+ * QUEST and ESOQ2 find lambda by Newton's method on the characteristic polynomial of K,
+ * starting from the sum of the weights, and the eigenvector in closed form. Both closed
+ * forms lose accuracy for some attitudes, QUEST for rotations near 180 degrees and ESOQ2
+ * for rotations near 0, so they first rotate the reference frame by 180 degrees about the
+ * axis that keeps the rotation far from their singularity (Shuster's method of sequential
+ * rotations). The q-method computes the full eigendecomposition of K, which costs more but
+ * has no singularities. It is also more accurate when the two largest eigenvalues of K are
+ * close, i.e. the observations are nearly parallel, where the polynomial determines lambda
+ * poorly.
+ */
+STAR_KERNEL sfloat star_Quest(sfloat q[4], const sfloat B[9], sfloat weight_sum);
+STAR_KERNEL sfloat star_Esoq2(sfloat q[4], const sfloat B[9], sfloat weight_sum);
+STAR_KERNEL sfloat star_DavenportQ(sfloat q[4], const sfloat B[9]);
+
+/*
+ * @brief Covariance of the attitude error at the solution q
+ *
+ * The error is the rotation vector dtheta of the body-frame error, i.e. the true attitude
+ * is q * exp(dtheta), and its covariance is the inverse of
+ *
+ *   F = tr(B R(q)) I - (B R(q) + R(q)^T B^T) / 2 = sum_i w_i (I - b_i b_i^T)
+ *
+ * to first order. It is in rad^2 for weights w_i = 1 / sigma_i^2, with sigma_i the
+ * standard deviation of the angular error of observation i. Returns false if F isn't
+ * positive definite, e.g. for fewer than two non-parallel observations, in which case P
+ * is not valid.
+ */
+STAR_KERNEL bool star_AttitudeCovariance(sfloat P[9], const sfloat B[9],
+                                         const sfloat q[4]);
+
+#ifdef STAR_HEADER_ONLY
+#include "attitude.c"
+#endif
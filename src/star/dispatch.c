@@ -0,0 +1,63 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "dispatch.h"
+
+#ifdef STAR_DISPATCH_ENABLED
+atomic_int star_active_isa = -1;
+#endif
+
+STAR_KERNEL star_Isa star_DetectIsa(void) {
+#ifdef STAR_DISPATCH_ENABLED
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return STAR_ISA_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return STAR_ISA_AVX2;
+  }
+#endif
+  return STAR_ISA_BASELINE;
+}
+
+STAR_KERNEL star_Isa star_GetIsa(void) {
+#ifdef STAR_DISPATCH_ENABLED
+  int isa = atomic_load_explicit(&star_active_isa, memory_order_relaxed);
+  if (isa < 0) {
+    isa = star_DetectIsa();
+    atomic_store_explicit(&star_active_isa, isa, memory_order_relaxed);
+  }
+  return (star_Isa)isa;
+#else
+  return STAR_ISA_BASELINE;
+#endif
+}
+
+STAR_KERNEL star_Isa star_SetIsa(star_Isa isa) {
+#ifdef STAR_DISPATCH_ENABLED
+  star_Isa host = star_DetectIsa();
+  if ((int)isa < 0 || isa > host) {
+    isa = host;
+  }
+  atomic_store_explicit(&star_active_isa, isa, memory_order_relaxed);
+  return isa;
+#else
+  (void)isa;
+  return STAR_ISA_BASELINE;
+#endif
+}
+
+STAR_KERNEL const char* star_IsaName(star_Isa isa) {
+  switch (isa) {
+    case STAR_ISA_BASELINE:
+      return "baseline";
+    case STAR_ISA_AVX2:
+      return "avx2";
+    case STAR_ISA_AVX512:
+      return "avx512";
+    default:
+      return "unknown";
+  }
+}
@@ -0,0 +1,96 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/typedefs.h"
+
+/*
+ * Runtime CPU dispatch of the hot kernels.
+ *
+ * With STAR_RUNTIME_DISPATCH, each kernel defined with STAR_DISPATCH is compiled once per
+ * instruction set below, and every call goes through a table indexed by the instruction set
+ * of the host, which is detected with CPUID on first use. A single binary built for the
+ * baseline architecture therefore still runs the fastest variant each host supports.
+ *
+ * Dispatch is only available for x86 with GCC or Clang, and never in header-only builds,
+ * which are compiled for the target of the including translation unit instead.
+ */
+
+#if defined(STAR_RUNTIME_DISPATCH) && !defined(STAR_HEADER_ONLY) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define STAR_DISPATCH_ENABLED
+#endif
+
+// Instruction sets with a dispatched variant, in order of preference
+typedef enum {
+  STAR_ISA_BASELINE = 0,  // Target of the build, i.e. SSE2 on x86-64
+  STAR_ISA_AVX2 = 1,      // AVX2 and FMA
+  STAR_ISA_AVX512 = 2,    // AVX-512F
+  STAR_ISA_COUNT = 3,
+} star_Isa;
+
+/*
+ * @brief Widest instruction set supported by both the host and the build
+ *
+ * Always STAR_ISA_BASELINE if runtime dispatch is disabled.
+ */
+STAR_KERNEL star_Isa star_DetectIsa(void);
+
+// Instruction set currently used by the dispatched kernels
+STAR_KERNEL star_Isa star_GetIsa(void);
+
+/*
+ * @brief Forces the dispatched kernels to use an instruction set, e.g. to test or benchmark
+ * every variant
+ *
+ * Requests for an instruction set the host doesn't support fall back to the widest one it
+ * does. Not thread safe with respect to concurrent calls of the dispatched kernels.
+ *
+ * @return The instruction set that was selected
+ */
+STAR_KERNEL star_Isa star_SetIsa(star_Isa isa);
+
+STAR_KERNEL const char* star_IsaName(star_Isa isa);
+
+#ifdef STAR_DISPATCH_ENABLED
+#include <stdatomic.h>
+
+// Index into the dispatch tables, or -1 before the host has been queried
+extern atomic_int star_active_isa;
+
+static inline int star_ActiveIsa(void) {
+  int isa = atomic_load_explicit(&star_active_isa, memory_order_relaxed);
+  return isa >= 0 ? isa : (int)star_GetIsa();
+}
+
+/*
+ * Defines the void kernel `name` with parameter list `params` from the static inline
+ * function name##_Generic, forwarding the argument list `args`. The generic body is inlined
+ * into one copy per instruction set, so the compiler can vectorize and contract it for each.
+ * Generic bodies should compute into a local buffer before writing their outputs, since
+ * possible aliasing of the arguments otherwise prevents vectorization.
+ */
+#define STAR_DISPATCH(name, params, args)                                                \
+  __attribute__((target("avx512f,avx2,fma"), flatten)) static void name##_Avx512 params { \
+    name##_Generic args;                                                                 \
+  }                                                                                      \
+  __attribute__((target("avx2,fma"), flatten)) static void name##_Avx2 params {         \
+    name##_Generic args;                                                                 \
+  }                                                                                      \
+  static void(*const name##_Table[STAR_ISA_COUNT]) params = {name##_Generic, name##_Avx2, \
+                                                             name##_Avx512};             \
+  void name params { name##_Table[star_ActiveIsa()] args; }
+
+#else
+
+#define STAR_DISPATCH(name, params, args) \
+  STAR_KERNEL void name params { name##_Generic args; }
+
+#endif
+
+#ifdef STAR_HEADER_ONLY
+#include "dispatch.c"
+#endif
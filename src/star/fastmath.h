@@ -0,0 +1,171 @@
+//
+// Created by Brian Jackson on 5/15/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "star/typedefs.h"
+
+/*
+ * Transcendental functions used by the rotation kernels, with an accuracy tier selected at
+ * compile time by STAR_FASTMATH:
+ *
+ *   STAR_FASTMATH_LIBM (0, default): libm
+ *   STAR_FASTMATH_HIGH (1): polynomials with an absolute error below 1e-12
+ *   STAR_FASTMATH_LOW  (2): polynomials with an absolute error below 1e-7
+ *
+ * The reciprocal square root has a relative instead of an absolute error bound. In single
+ * precision the error is bounded by the tier or a few ULP of sfloat, whichever is larger.
+ * Sines and cosines are accurate for |x| < 1e6, beyond which the argument reduction
+ * loses precision.
+ *
+ * The polynomials contain no calls or branches, so loops over them vectorize. Each
+ * function also has a *Tier variant taking the tier as an argument, which is folded when
+ * the tier is a constant, so the tests can check every tier in a single build.
+ */
+
+#define STAR_FASTMATH_LIBM 0
+#define STAR_FASTMATH_HIGH 1
+#define STAR_FASTMATH_LOW 2
+
+#ifndef STAR_FASTMATH
+#define STAR_FASTMATH STAR_FASTMATH_LIBM
+#endif
+
+// Error bound of the configured tier, 0 for libm
+#if STAR_FASTMATH == STAR_FASTMATH_HIGH
+#define STAR_FASTMATH_TOL 1e-12
+#elif STAR_FASTMATH == STAR_FASTMATH_LOW
+#define STAR_FASTMATH_TOL 1e-7
+#else
+#define STAR_FASTMATH_TOL 0
+#endif
+
+/*
+ * @brief Sine and cosine of x
+ *
+ * Reduces x to r = x - k pi / 2 in [-pi / 4, pi / 4], subtracting pi / 2 in two parts so
+ * the reduction is exact in double precision, and evaluates the Taylor series of sin(r)
+ * and cos(r).
+ */
+static inline void star_SinCosTier(sfloat x, sfloat* s, sfloat* c, int tier) {
+  if (tier == STAR_FASTMATH_LIBM) {
+    *s = sin(x);
+    *c = cos(x);
+    return;
+  }
+  const double kTwoOverPi = 0.63661977236758134308;
+  const double kPiOver2Hi = 1.57079632673412561417e+00;  // 33 leading bits of pi / 2
+  const double kPiOver2Lo = 6.07710050650619224932e-11;  // pi / 2 - kPiOver2Hi
+  const double kRound = 6755399441055744.0;              // 1.5 * 2^52 rounds to integers
+  double k = (x * kTwoOverPi + kRound) - kRound;
+  sfloat r = (x - k * kPiOver2Hi) - k * kPiOver2Lo;
+  int64_t quadrant = (int64_t)k;
+
+  // Coefficients of r^3, r^5, ... of sin(r) and r^2, r^4, ... of cos(r)
+  static const sfloat kSin[6] = {-1.0 / 6,      1.0 / 120,        -1.0 / 5040,
+                                 1.0 / 362880, -1.0 / 39916800, 1.0 / 6227020800};
+  static const sfloat kCos[6] = {-1.0 / 2,      1.0 / 24,        -1.0 / 720,
+                                 1.0 / 40320,  -1.0 / 3628800,  1.0 / 479001600};
+  const int n = tier == STAR_FASTMATH_HIGH ? 6 : 4;
+  sfloat r2 = r * r;
+  sfloat sin_r = kSin[n - 1];
+  sfloat cos_r = kCos[n - 1];
+  for (int i = n - 2; i >= 0; --i) {
+    sin_r = kSin[i] + r2 * sin_r;
+    cos_r = kCos[i] + r2 * cos_r;
+  }
+  sin_r = r + r * r2 * sin_r;
+  cos_r = 1 + r2 * cos_r;
+
+  // Rotate (cos(r), sin(r)) by the quadrant
+  int swap = quadrant & 1;
+  sfloat sin_sign = (quadrant & 2) ? -1 : 1;
+  sfloat cos_sign = ((quadrant + 1) & 2) ? -1 : 1;
+  *s = sin_sign * (swap ? cos_r : sin_r);
+  *c = cos_sign * (swap ? sin_r : cos_r);
+}
+
+/*
+ * @brief Four-quadrant arctangent of y / x
+ *
+ * Reduces atan(z) for z = min(|x|, |y|) / max(|x|, |y|) with the identities
+ * atan(z) = pi / 4 + atan((z - 1) / (z + 1)) and atan(z) = 2 atan(z / (1 + sqrt(1 + z^2))),
+ * so its Taylor series is evaluated for |z| <= tan(pi / 16).
+ */
+static inline sfloat star_Atan2Tier(sfloat y, sfloat x, int tier) {
+  if (tier == STAR_FASTMATH_LIBM) {
+    return atan2(y, x);
+  }
+  const sfloat kPi = 3.14159265358979323846;
+  const sfloat kTanPiOver8 = 0.41421356237309504880;
+  sfloat ax = fabs(x);
+  sfloat ay = fabs(y);
+  sfloat hi = ax > ay ? ax : ay;
+  sfloat lo = ax > ay ? ay : ax;
+  sfloat z = hi > 0 ? lo / hi : 0;
+  int upper = z > kTanPiOver8;
+  z = upper ? (z - 1) / (z + 1) : z;
+  z = z / (1 + sqrt(1 + z * z));
+
+  // Coefficients of z^3, z^5, ... of atan(z)
+  static const sfloat kAtan[7] = {-1.0 / 3, 1.0 / 5,  -1.0 / 7, 1.0 / 9,
+                                  -1.0 / 11, 1.0 / 13, -1.0 / 15};
+  const int n = tier == STAR_FASTMATH_HIGH ? 7 : 4;
+  sfloat z2 = z * z;
+  sfloat p = kAtan[n - 1];
+  for (int i = n - 2; i >= 0; --i) {
+    p = kAtan[i] + z2 * p;
+  }
+  p = z + z * z2 * p;
+
+  sfloat a = (upper ? kPi / 4 : 0) + 2 * p;
+  a = ay > ax ? kPi / 2 - a : a;
+  a = x < 0 ? kPi - a : a;
+  return y < 0 ? -a : a;
+}
+
+/*
+ * @brief 1 / sqrt(x) for x > 0
+ *
+ * The low tier refines the classic bit-level estimate with three Newton steps. The high
+ * tier needs so many steps that a hardware square root and division is faster, so it
+ * computes 1 / sqrt(x) directly.
+ */
+static inline sfloat star_RSqrtTier(sfloat x, int tier) {
+  if (tier != STAR_FASTMATH_LOW) {
+    return 1 / sqrt(x);
+  }
+#ifdef STAR_SINGLE_PRECISION
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5F375A86u - (bits >> 1);
+#else
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5FE6EB50C7B537A9u - (bits >> 1);
+#endif
+  sfloat y;
+  memcpy(&y, &bits, sizeof(y));
+  const sfloat kThreeHalves = 1.5;
+  sfloat half_x = x / 2;
+  for (int i = 0; i < 3; ++i) {
+    y = y * (kThreeHalves - half_x * y * y);
+  }
+  return y;
+}
+
+static inline void star_SinCos(sfloat x, sfloat* s, sfloat* c) {
+  star_SinCosTier(x, s, c, STAR_FASTMATH);
+}
+
+static inline sfloat star_Atan2(sfloat y, sfloat x) {
+  return star_Atan2Tier(y, x, STAR_FASTMATH);
+}
+
+static inline sfloat star_RSqrt(sfloat x) { return star_RSqrtTier(x, STAR_FASTMATH); }
@@ -0,0 +1,50 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+
+#include "star/typedefs.h"
+
+extern "C" {
+#include "star/fastmath.h"
+}
+
+namespace star {
+
+/*
+ * Transcendental functions of the templated kernels. For sfloat they are the functions of
+ * fastmath.h, so the kernels agree with the C kernels in every STAR_FASTMATH tier. Other
+ * scalar types use the overloads of sin, cos, atan2 and sqrt found by argument-dependent
+ * lookup, e.g. the ones of Dual.hpp.
+ */
+template <class T>
+inline void SinCos(const T& x, T& s, T& c) {
+  using std::cos;
+  using std::sin;
+  s = sin(x);
+  c = cos(x);
+}
+
+inline void SinCos(sfloat x, sfloat& s, sfloat& c) { star_SinCos(x, &s, &c); }
+
+template <class T>
+inline T Atan2(const T& y, const T& x) {
+  using std::atan2;
+  return atan2(y, x);
+}
+
+inline sfloat Atan2(sfloat y, sfloat x) { return star_Atan2(y, x); }
+
+template <class T>
+inline T RSqrt(const T& x) {
+  using std::sqrt;
+  return 1 / sqrt(x);
+}
+
+inline sfloat RSqrt(sfloat x) { return star_RSqrt(x); }
+
+}  // namespace star
@@ -0,0 +1,300 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "lie.h"
+
+#include <math.h>
+
+#include "fastmath.h"
+#include "matrix3.h"
+#include "quaternion.h"
+
+/*
+ * Coefficients of the SO(3) maps as functions of the angle theta:
+ *
+ *   sinc = sin(theta) / theta
+ *   a = (1 - cos(theta)) / theta^2
+ *   b = (theta - sin(theta)) / theta^3
+ *   d = 1 / theta^2 - (1 + cos(theta)) / (2 theta sin(theta))
+ *
+ * so that Exp = I + sinc S + a S^2, J_l = I + a S + b S^2 and J_l^-1 = I - S / 2 + d S^2,
+ * with S the skew-symmetric matrix of phi.
+ */
+typedef struct {
+  sfloat sinc;
+  sfloat a;
+  sfloat b;
+  sfloat d;
+} star_SO3Coefficients;
+
+static inline star_SO3Coefficients star_SO3ComputeCoefficients(sfloat theta2) {
+  star_SO3Coefficients c;
+  if (theta2 < STAR_LIE_SERIES_THETA2) {
+    c.sinc = 1 - theta2 / 6 * (1 - theta2 / 20);
+    c.a = 0.5 - theta2 / 24 * (1 - theta2 / 30);
+    c.b = (sfloat)1 / 6 - theta2 / 120 * (1 - theta2 / 42);
+    c.d = (sfloat)1 / 12 + theta2 / 720 * (1 + theta2 / 42);
+  } else {
+    // Half-angle forms avoid the cancellation in 1 - cos(theta)
+    sfloat theta = sqrt(theta2);
+    sfloat s_half;
+    sfloat c_half;
+    star_SinCos(theta / 2, &s_half, &c_half);
+    sfloat s = 2 * s_half * c_half;
+    c.sinc = s / theta;
+    c.a = 2 * s_half * s_half / theta2;
+    c.b = (theta - s) / (theta2 * theta);
+    c.d = (1 - theta * c_half / (2 * s_half)) / theta2;
+  }
+  return c;
+}
+
+// M = diag I + skew S + outer phi phi^T, using S^2 = phi phi^T - theta^2 I
+static inline void star_SO3Combine(sfloat M[9], const sfloat phi[3], sfloat diag,
+                                   sfloat skew, sfloat outer) {
+  const sfloat x = phi[0];
+  const sfloat y = phi[1];
+  const sfloat z = phi[2];
+  M[0] = diag + outer * x * x;
+  M[1] = outer * x * y + skew * z;
+  M[2] = outer * x * z - skew * y;
+  M[3] = outer * x * y - skew * z;
+  M[4] = diag + outer * y * y;
+  M[5] = outer * y * z + skew * x;
+  M[6] = outer * x * z + skew * y;
+  M[7] = outer * y * z - skew * x;
+  M[8] = diag + outer * z * z;
+}
+
+static inline sfloat star_SO3Theta2(const sfloat phi[3]) {
+  return phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+}
+
+/*---------------------------------*/
+/* SO(3)                           */
+/*---------------------------------*/
+
+STAR_KERNEL void star_SO3Expm(sfloat R[9], const sfloat phi[3]) {
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  star_SO3Combine(R, phi, 1 - c.a * theta2, c.sinc, c.a);
+}
+
+STAR_KERNEL void star_SO3LeftJacobian(sfloat J[9], const sfloat phi[3]) {
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  star_SO3Combine(J, phi, 1 - c.b * theta2, c.a, c.b);
+}
+
+STAR_KERNEL void star_SO3RightJacobian(sfloat J[9], const sfloat phi[3]) {
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  star_SO3Combine(J, phi, 1 - c.b * theta2, -c.a, c.b);
+}
+
+STAR_KERNEL void star_SO3LeftJacobianInverse(sfloat J_inv[9], const sfloat phi[3]) {
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  star_SO3Combine(J_inv, phi, 1 - c.d * theta2, -0.5, c.d);
+}
+
+STAR_KERNEL void star_SO3RightJacobianInverse(sfloat J_inv[9], const sfloat phi[3]) {
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  star_SO3Combine(J_inv, phi, 1 - c.d * theta2, 0.5, c.d);
+}
+
+/*---------------------------------*/
+/* SE(3)                           */
+/*---------------------------------*/
+
+STAR_KERNEL void star_SE3Expm(sfloat q[4], sfloat t[3], const sfloat xi[6]) {
+  const sfloat* rho = xi;
+  const sfloat* phi = xi + 3;
+  sfloat J[9];
+  star_SO3LeftJacobian(J, phi);
+  star_VecMul33(t, J, rho);
+  star_QuatExpm(q, phi);
+}
+
+STAR_KERNEL void star_SE3Logm(sfloat xi[6], const sfloat q[4], const sfloat t[3]) {
+  // q and -q are the same rotation, and the one with w >= 0 has an angle of at most pi
+  sfloat q_pos[4] = {q[0], q[1], q[2], q[3]};
+  if (q[0] < 0) {
+    star_QuatFlip(q_pos, q);
+  }
+  sfloat phi[3];
+  sfloat J_inv[9];
+  star_QuatLogm(phi, q_pos);
+  star_SO3LeftJacobianInverse(J_inv, phi);
+  star_VecMul33(xi, J_inv, t);
+  xi[3] = phi[0];
+  xi[4] = phi[1];
+  xi[5] = phi[2];
+}
+
+/*
+ * The upper-right block of the SE(3) left Jacobian,
+ *
+ *   Q = P / 2 + b (S P + P S + S P S) + c2 (S S P + P S S - 3 S P S)
+ *       + c3 (S P S S + S S P S)
+ *
+ * with S and P the skew-symmetric matrices of phi and rho, b the coefficient of J_l,
+ * c2 = (theta^2 + 2 cos(theta) - 2) / (2 theta^4) and
+ * c3 = (2 theta - 3 sin(theta) + theta cos(theta)) / (2 theta^5).
+ *
+ * Expanding the products with [x] [y] = y x^T - (x . y) I reduces this to
+ *
+ *   Q = a P + (2 c2 - b) d S + b (rho phi^T + phi rho^T) - 2 c3 d phi phi^T
+ *       + 2 d (c3 theta^2 - b) I
+ *
+ * with d = phi . rho, which needs no matrix products.
+ */
+static inline void star_SE3QMatrix(sfloat Q[9], const sfloat xi[6], sfloat theta2,
+                                   star_SO3Coefficients c) {
+  const sfloat* rho = xi;
+  const sfloat* phi = xi + 3;
+  sfloat c2;
+  sfloat c3;
+  if (theta2 < STAR_LIE_SERIES_THETA2) {
+    c2 = (sfloat)1 / 24 - theta2 / 720 * (1 - theta2 / 56);
+    c3 = (sfloat)1 / 120 - theta2 / 2520 * (1 - theta2 / 48);
+  } else {
+    c2 = (0.5 - c.a) / theta2;
+    c3 = (3 * c.b - c.a) / (2 * theta2);
+  }
+
+  const sfloat d = phi[0] * rho[0] + phi[1] * rho[1] + phi[2] * rho[2];
+  const sfloat s = (2 * c2 - c.b) * d;
+  const sfloat outer = -2 * c3 * d;
+  const sfloat diag = 2 * d * (c3 * theta2 - c.b);
+
+  // Skew-symmetric part, a P + s S
+  const sfloat w0 = c.a * rho[0] + s * phi[0];
+  const sfloat w1 = c.a * rho[1] + s * phi[1];
+  const sfloat w2 = c.a * rho[2] + s * phi[2];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      Q[i + 3 * j] = c.b * (rho[i] * phi[j] + phi[i] * rho[j]) + outer * phi[i] * phi[j] +
+                     (i == j) * diag;
+    }
+  }
+  Q[1] += w2;
+  Q[2] -= w1;
+  Q[3] -= w2;
+  Q[5] += w0;
+  Q[6] += w1;
+  Q[7] -= w0;
+}
+
+// Copies the 3x3 matrix A into the 6x6 matrix J at block (row, col)
+static inline void star_SE3SetBlock(sfloat J[36], int row, int col, const sfloat A[9]) {
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      J[(row + i) + 6 * (col + j)] = A[i + 3 * j];
+    }
+  }
+}
+
+STAR_KERNEL void star_SE3LeftJacobian(sfloat J[36], const sfloat xi[6]) {
+  const sfloat* phi = xi + 3;
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  sfloat J_rot[9];
+  sfloat Q[9];
+  const sfloat zero[9] = {0};
+  star_SO3Combine(J_rot, phi, 1 - c.b * theta2, c.a, c.b);
+  star_SE3QMatrix(Q, xi, theta2, c);
+  star_SE3SetBlock(J, 0, 0, J_rot);
+  star_SE3SetBlock(J, 3, 0, zero);
+  star_SE3SetBlock(J, 0, 3, Q);
+  star_SE3SetBlock(J, 3, 3, J_rot);
+}
+
+STAR_KERNEL void star_SE3RightJacobian(sfloat J[36], const sfloat xi[6]) {
+  const sfloat xi_neg[6] = {-xi[0], -xi[1], -xi[2], -xi[3], -xi[4], -xi[5]};
+  star_SE3LeftJacobian(J, xi_neg);
+}
+
+STAR_KERNEL void star_SE3LeftJacobianInverse(sfloat J_inv[36], const sfloat xi[6]) {
+  // [J Q; 0 J]^-1 = [J^-1  -J^-1 Q J^-1; 0 J^-1]
+  const sfloat* phi = xi + 3;
+  sfloat theta2 = star_SO3Theta2(phi);
+  star_SO3Coefficients c = star_SO3ComputeCoefficients(theta2);
+  sfloat J_rot_inv[9];
+  sfloat Q[9];
+  sfloat JQ[9];
+  sfloat JQJ[9];
+  const sfloat zero[9] = {0};
+  star_SO3Combine(J_rot_inv, phi, 1 - c.d * theta2, -0.5, c.d);
+  star_SE3QMatrix(Q, xi, theta2, c);
+  star_MatMul33(JQ, J_rot_inv, Q);
+  star_MatMul33(JQJ, JQ, J_rot_inv);
+  for (int k = 0; k < 9; ++k) {
+    JQJ[k] = -JQJ[k];
+  }
+  star_SE3SetBlock(J_inv, 0, 0, J_rot_inv);
+  star_SE3SetBlock(J_inv, 3, 0, zero);
+  star_SE3SetBlock(J_inv, 0, 3, JQJ);
+  star_SE3SetBlock(J_inv, 3, 3, J_rot_inv);
+}
+
+STAR_KERNEL void star_SE3RightJacobianInverse(sfloat J_inv[36], const sfloat xi[6]) {
+  const sfloat xi_neg[6] = {-xi[0], -xi[1], -xi[2], -xi[3], -xi[4], -xi[5]};
+  star_SE3LeftJacobianInverse(J_inv, xi_neg);
+}
+
+/*---------------------------------*/
+/* Batched                         */
+/*---------------------------------*/
+
+STAR_KERNEL void star_SO3LeftJacobianBatch(sfloat* J, const sfloat* phi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SO3LeftJacobian(J + 9 * i, phi + 3 * i);
+  }
+}
+
+STAR_KERNEL void star_SO3RightJacobianBatch(sfloat* J, const sfloat* phi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SO3RightJacobian(J + 9 * i, phi + 3 * i);
+  }
+}
+
+STAR_KERNEL void star_SO3LeftJacobianInverseBatch(sfloat* J_inv, const sfloat* phi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SO3LeftJacobianInverse(J_inv + 9 * i, phi + 3 * i);
+  }
+}
+
+STAR_KERNEL void star_SO3RightJacobianInverseBatch(sfloat* J_inv, const sfloat* phi,
+                                                   int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SO3RightJacobianInverse(J_inv + 9 * i, phi + 3 * i);
+  }
+}
+
+STAR_KERNEL void star_SE3ExpmBatch(sfloat* q, sfloat* t, const sfloat* xi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SE3Expm(q + 4 * i, t + 3 * i, xi + 6 * i);
+  }
+}
+
+STAR_KERNEL void star_SE3LogmBatch(sfloat* xi, const sfloat* q, const sfloat* t, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SE3Logm(xi + 6 * i, q + 4 * i, t + 3 * i);
+  }
+}
+
+STAR_KERNEL void star_SE3LeftJacobianBatch(sfloat* J, const sfloat* xi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SE3LeftJacobian(J + 36 * i, xi + 6 * i);
+  }
+}
+
+STAR_KERNEL void star_SE3RightJacobianBatch(sfloat* J, const sfloat* xi, int n) {
+  for (int i = 0; i < n; ++i) {
+    star_SE3RightJacobian(J + 36 * i, xi + 6 * i);
+  }
+}
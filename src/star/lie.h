@@ -0,0 +1,58 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "typedefs.h"
+
+/*
+ * Exponential and logarithm maps of SO(3) and SE(3), and their left and right Jacobians.
+ *
+ * Rotations are rotation vectors phi, with Exp(phi) the active rotation matrix. Poses are
+ * a unit quaternion q and a translation t, mapping p to R(q) p + t like star::Pose, and
+ * their tangent vectors are xi = [rho; phi], the translational part first. The left
+ * Jacobian J_l satisfies Exp(x + dx) = Exp(J_l(x) dx) Exp(x) to first order, and the right
+ * Jacobian J_r(x) = J_l(-x) satisfies Exp(x + dx) = Exp(x) Exp(J_r(x) dx).
+ *
+ * Below a small angle, the coefficients are evaluated with Taylor series, so the kernels
+ * are accurate at and around the identity. The inverse Jacobians are singular at angles of
+ * 2 pi, which the logarithms never return. Matrices are column-major.
+ */
+
+// Squared angle below which the coefficients are evaluated with their Taylor series. The
+// closed forms lose about eps / theta^4 to cancellation, the truncated series theta^6.
+#define STAR_LIE_SERIES_THETA2 1e-3
+
+// SO(3)
+STAR_KERNEL void star_SO3Expm(sfloat R[9], const sfloat phi[3]);
+STAR_KERNEL void star_SO3LeftJacobian(sfloat J[9], const sfloat phi[3]);
+STAR_KERNEL void star_SO3RightJacobian(sfloat J[9], const sfloat phi[3]);
+STAR_KERNEL void star_SO3LeftJacobianInverse(sfloat J_inv[9], const sfloat phi[3]);
+STAR_KERNEL void star_SO3RightJacobianInverse(sfloat J_inv[9], const sfloat phi[3]);
+
+// SE(3). The logarithm returns a rotation angle of at most pi.
+STAR_KERNEL void star_SE3Expm(sfloat q[4], sfloat t[3], const sfloat xi[6]);
+STAR_KERNEL void star_SE3Logm(sfloat xi[6], const sfloat q[4], const sfloat t[3]);
+STAR_KERNEL void star_SE3LeftJacobian(sfloat J[36], const sfloat xi[6]);
+STAR_KERNEL void star_SE3RightJacobian(sfloat J[36], const sfloat xi[6]);
+STAR_KERNEL void star_SE3LeftJacobianInverse(sfloat J_inv[36], const sfloat xi[6]);
+STAR_KERNEL void star_SE3RightJacobianInverse(sfloat J_inv[36], const sfloat xi[6]);
+
+/*
+ * Batched versions over n contiguous inputs and outputs, e.g. the tangent vectors of a
+ * trajectory, with the same argument order as the kernels above.
+ */
+STAR_KERNEL void star_SO3LeftJacobianBatch(sfloat* J, const sfloat* phi, int n);
+STAR_KERNEL void star_SO3RightJacobianBatch(sfloat* J, const sfloat* phi, int n);
+STAR_KERNEL void star_SO3LeftJacobianInverseBatch(sfloat* J_inv, const sfloat* phi, int n);
+STAR_KERNEL void star_SO3RightJacobianInverseBatch(sfloat* J_inv, const sfloat* phi, int n);
+STAR_KERNEL void star_SE3ExpmBatch(sfloat* q, sfloat* t, const sfloat* xi, int n);
+STAR_KERNEL void star_SE3LogmBatch(sfloat* xi, const sfloat* q, const sfloat* t, int n);
+STAR_KERNEL void star_SE3LeftJacobianBatch(sfloat* J, const sfloat* xi, int n);
+STAR_KERNEL void star_SE3RightJacobianBatch(sfloat* J, const sfloat* xi, int n);
+
+#ifdef STAR_HEADER_ONLY
+#include "lie.c"
+#endif
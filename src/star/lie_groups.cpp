@@ -0,0 +1,74 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "lie_groups.hpp"
+
+extern "C" {
+#include "star/lie.h"
+}
+
+namespace star {
+
+/*-------------------------------------
+ * SO(3)
+ *-----------------------------------*/
+STAR_INLINE RotMat<Active> SO3Expm(const Vec3& phi) {
+  RotMat<Active> R;
+  star_SO3Expm(R.data(), phi.data());
+  return R;
+}
+
+STAR_INLINE Mat3 SO3LeftJacobian(const Vec3& phi) {
+  Mat3 J;
+  star_SO3LeftJacobian(J.data(), phi.data());
+  return J;
+}
+
+STAR_INLINE Mat3 SO3RightJacobian(const Vec3& phi) {
+  Mat3 J;
+  star_SO3RightJacobian(J.data(), phi.data());
+  return J;
+}
+
+STAR_INLINE Mat3 SO3LeftJacobianInverse(const Vec3& phi) {
+  Mat3 J_inv;
+  star_SO3LeftJacobianInverse(J_inv.data(), phi.data());
+  return J_inv;
+}
+
+STAR_INLINE Mat3 SO3RightJacobianInverse(const Vec3& phi) {
+  Mat3 J_inv;
+  star_SO3RightJacobianInverse(J_inv.data(), phi.data());
+  return J_inv;
+}
+
+/*-------------------------------------
+ * SE(3)
+ *-----------------------------------*/
+STAR_INLINE Matrix<6, 6> SE3LeftJacobian(const Matrix<6, 1>& xi) {
+  Matrix<6, 6> J;
+  star_SE3LeftJacobian(J.data(), xi.data());
+  return J;
+}
+
+STAR_INLINE Matrix<6, 6> SE3RightJacobian(const Matrix<6, 1>& xi) {
+  Matrix<6, 6> J;
+  star_SE3RightJacobian(J.data(), xi.data());
+  return J;
+}
+
+STAR_INLINE Matrix<6, 6> SE3LeftJacobianInverse(const Matrix<6, 1>& xi) {
+  Matrix<6, 6> J_inv;
+  star_SE3LeftJacobianInverse(J_inv.data(), xi.data());
+  return J_inv;
+}
+
+STAR_INLINE Matrix<6, 6> SE3RightJacobianInverse(const Matrix<6, 1>& xi) {
+  Matrix<6, 6> J_inv;
+  star_SE3RightJacobianInverse(J_inv.data(), xi.data());
+  return J_inv;
+}
+
+}  // namespace star
@@ -0,0 +1,44 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/Mat3.hpp"
+#include "star/Matrix.hpp"
+#include "star/RotMat.hpp"
+#include "star/Vec3.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * Exponential map and Jacobians of SO(3) and SE(3), wrapping the kernels in lie.h.
+ *
+ * SE(3) tangent vectors are xi = [rho; phi], with the translational part first. The
+ * exponential and logarithm of SE(3) are Pose::Expm and Pose::Logm.
+ */
+
+/*-------------------------------------
+ * SO(3)
+ *-----------------------------------*/
+RotMat<Active> SO3Expm(const Vec3& phi);
+Mat3 SO3LeftJacobian(const Vec3& phi);
+Mat3 SO3RightJacobian(const Vec3& phi);
+Mat3 SO3LeftJacobianInverse(const Vec3& phi);
+Mat3 SO3RightJacobianInverse(const Vec3& phi);
+
+/*-------------------------------------
+ * SE(3)
+ *-----------------------------------*/
+Matrix<6, 6> SE3LeftJacobian(const Matrix<6, 1>& xi);
+Matrix<6, 6> SE3RightJacobian(const Matrix<6, 1>& xi);
+Matrix<6, 6> SE3LeftJacobianInverse(const Matrix<6, 1>& xi);
+Matrix<6, 6> SE3RightJacobianInverse(const Matrix<6, 1>& xi);
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/lie_groups.cpp"
+#endif
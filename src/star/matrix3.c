@@ -3,11 +3,18 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include "dispatch.h"
 #include "matrix3.h"
 
+#include <math.h>
+
+#include "fastmath.h"
+#include "simd.h"
+#include "vector3.h"
+
 #define IDX(i, j) ((i) + 3 * (j))
 
-void star_SetZero33(sfloat mat[9]) {
+STAR_KERNEL void star_SetZero33(sfloat mat[9]) {
   mat[0] = 0;
   mat[1] = 0;
   mat[2] = 0;
@@ -19,7 +26,7 @@ void star_SetZero33(sfloat mat[9]) {
   mat[8] = 0;
 }
 
-void star_SetConst33(sfloat mat[9], sfloat value) {
+STAR_KERNEL void star_SetConst33(sfloat mat[9], sfloat value) {
   mat[0] = value;
   mat[1] = value;
   mat[2] = value;
@@ -31,7 +38,7 @@ void star_SetConst33(sfloat mat[9], sfloat value) {
   mat[8] = value;
 }
 
-void star_SetIdentity33(sfloat mat[9], sfloat value) {
+STAR_KERNEL void star_SetIdentity33(sfloat mat[9], sfloat value) {
   mat[0] = value;
   mat[1] = 0;
   mat[2] = 0;
@@ -43,25 +50,33 @@ void star_SetIdentity33(sfloat mat[9], sfloat value) {
   mat[8] = value;
 }
 
-void star_SetDiagonal33(sfloat mat[9], const sfloat diag[3]) {
+STAR_KERNEL void star_SetDiagonal33(sfloat mat[9], const sfloat diag[3]) {
   mat[0] = diag[0];
   mat[4] = diag[1];
   mat[8] = diag[2];
 }
 
-void star_MatMul33(sfloat C[9], const sfloat A[9], const sfloat B[9]) {
-  C[0] = A[0] * B[0] + A[3] * B[1] + A[6] * B[2];
-  C[1] = A[1] * B[0] + A[4] * B[1] + A[7] * B[2];
-  C[2] = A[2] * B[0] + A[5] * B[1] + A[8] * B[2];
-  C[3] = A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
-  C[4] = A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
-  C[5] = A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
-  C[6] = A[0] * B[6] + A[3] * B[7] + A[6] * B[8];
-  C[7] = A[1] * B[6] + A[4] * B[7] + A[7] * B[8];
-  C[8] = A[2] * B[6] + A[5] * B[7] + A[8] * B[8];
+static inline void star_MatMul33_Generic(sfloat C[9], const sfloat A[9],
+                                         const sfloat B[9]) {
+  sfloat out[9];
+  out[0] = A[0] * B[0] + A[3] * B[1] + A[6] * B[2];
+  out[1] = A[1] * B[0] + A[4] * B[1] + A[7] * B[2];
+  out[2] = A[2] * B[0] + A[5] * B[1] + A[8] * B[2];
+  out[3] = A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
+  out[4] = A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
+  out[5] = A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
+  out[6] = A[0] * B[6] + A[3] * B[7] + A[6] * B[8];
+  out[7] = A[1] * B[6] + A[4] * B[7] + A[7] * B[8];
+  out[8] = A[2] * B[6] + A[5] * B[7] + A[8] * B[8];
+  for (int i = 0; i < 9; ++i) {
+    C[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_MatMul33,
+              (sfloat C[9], const sfloat A[9], const sfloat B[9]), (C, A, B))
 
-void star_TransposedMatMul33(sfloat C[9], const sfloat At[9], const sfloat B[9]) {
+STAR_KERNEL void star_TransposedMatMul33(sfloat C[9], const sfloat At[9],
+                                         const sfloat B[9]) {
   C[0] = At[0] * B[0] + At[1] * B[1] + At[2] * B[2];
   C[1] = At[3] * B[0] + At[4] * B[1] + At[5] * B[2];
   C[2] = At[6] * B[0] + At[7] * B[1] + At[8] * B[2];
@@ -73,7 +88,8 @@ void star_TransposedMatMul33(sfloat C[9], const sfloat At[9], const sfloat B[9])
   C[8] = At[6] * B[6] + At[7] * B[7] + At[8] * B[8];
 }
 
-void star_MatMulTransposed33(sfloat C[9], const sfloat A[9], const sfloat Bt[9]) {
+STAR_KERNEL void star_MatMulTransposed33(sfloat C[9], const sfloat A[9],
+                                         const sfloat Bt[9]) {
   C[0] = A[0] * Bt[0] + A[3] * Bt[3] + A[6] * Bt[6];
   C[1] = A[1] * Bt[0] + A[4] * Bt[3] + A[7] * Bt[6];
   C[2] = A[2] * Bt[0] + A[5] * Bt[3] + A[8] * Bt[6];
@@ -85,7 +101,7 @@ void star_MatMulTransposed33(sfloat C[9], const sfloat A[9], const sfloat Bt[9])
   C[8] = A[2] * Bt[2] + A[5] * Bt[5] + A[8] * Bt[8];
 }
 
-void star_VecMul33(sfloat y[3], const sfloat A[9], const sfloat x[3]) {
+STAR_KERNEL void star_VecMul33(sfloat y[3], const sfloat A[9], const sfloat x[3]) {
   // Extract out x so that x and y can be aliased
   sfloat x0 = x[0];
   sfloat x1 = x[1];
@@ -96,7 +112,8 @@ void star_VecMul33(sfloat y[3], const sfloat A[9], const sfloat x[3]) {
   y[2] = A[2] * x0 + A[5] * x1 + A[8] * x2;
 }
 
-void star_TransposedVecMul33(sfloat y[3], const sfloat At[9], const sfloat x[3]) {
+STAR_KERNEL void star_TransposedVecMul33(sfloat y[3], const sfloat At[9],
+                                         const sfloat x[3]) {
   // Extract out x so that x and y can be aliased
   sfloat x0 = x[0];
   sfloat x1 = x[1];
@@ -107,7 +124,253 @@ void star_TransposedVecMul33(sfloat y[3], const sfloat At[9], const sfloat x[3])
   y[2] = At[6] * x0 + At[7] * x1 + At[8] * x2;
 }
 
-void star_UpperMatMul33(sfloat C[9], const sfloat U[9], const sfloat A[9]) {
+static inline void star_VecMulBatch33_Generic(sfloat* y0, sfloat* y1, sfloat* y2,
+                                              const sfloat A[9], const sfloat* x0,
+                                              const sfloat* x1, const sfloat* x2, int n) {
+  int i = 0;
+#if STAR_SIMD_LANES > 0
+  star_simd a0 = star_SimdSet1(A[0]);
+  star_simd a1 = star_SimdSet1(A[1]);
+  star_simd a2 = star_SimdSet1(A[2]);
+  star_simd a3 = star_SimdSet1(A[3]);
+  star_simd a4 = star_SimdSet1(A[4]);
+  star_simd a5 = star_SimdSet1(A[5]);
+  star_simd a6 = star_SimdSet1(A[6]);
+  star_simd a7 = star_SimdSet1(A[7]);
+  star_simd a8 = star_SimdSet1(A[8]);
+  for (; i + STAR_SIMD_LANES <= n; i += STAR_SIMD_LANES) {
+    star_simd v0 = star_SimdLoad(x0 + i);
+    star_simd v1 = star_SimdLoad(x1 + i);
+    star_simd v2 = star_SimdLoad(x2 + i);
+    star_simd r0 = star_SimdFmadd(a6, v2, star_SimdFmadd(a3, v1, star_SimdMul(a0, v0)));
+    star_simd r1 = star_SimdFmadd(a7, v2, star_SimdFmadd(a4, v1, star_SimdMul(a1, v0)));
+    star_simd r2 = star_SimdFmadd(a8, v2, star_SimdFmadd(a5, v1, star_SimdMul(a2, v0)));
+    star_SimdStore(y0 + i, r0);
+    star_SimdStore(y1 + i, r1);
+    star_SimdStore(y2 + i, r2);
+  }
+#endif
+  for (; i < n; ++i) {
+    sfloat v0 = x0[i];
+    sfloat v1 = x1[i];
+    sfloat v2 = x2[i];
+    y0[i] = A[0] * v0 + A[3] * v1 + A[6] * v2;
+    y1[i] = A[1] * v0 + A[4] * v1 + A[7] * v2;
+    y2[i] = A[2] * v0 + A[5] * v1 + A[8] * v2;
+  }
+}
+STAR_DISPATCH(star_VecMulBatch33,
+              (sfloat* y0, sfloat* y1, sfloat* y2, const sfloat A[9], const sfloat* x0,
+               const sfloat* x1, const sfloat* x2, int n),
+              (y0, y1, y2, A, x0, x1, x2, n))
+
+static inline void star_AffineMulBatch33_Generic(sfloat* y0, sfloat* y1, sfloat* y2,
+                                                 const sfloat A[9], const sfloat b[3],
+                                                 const sfloat* x0, const sfloat* x1,
+                                                 const sfloat* x2, int n) {
+  int i = 0;
+#if STAR_SIMD_LANES > 0
+  star_simd a0 = star_SimdSet1(A[0]);
+  star_simd a1 = star_SimdSet1(A[1]);
+  star_simd a2 = star_SimdSet1(A[2]);
+  star_simd a3 = star_SimdSet1(A[3]);
+  star_simd a4 = star_SimdSet1(A[4]);
+  star_simd a5 = star_SimdSet1(A[5]);
+  star_simd a6 = star_SimdSet1(A[6]);
+  star_simd a7 = star_SimdSet1(A[7]);
+  star_simd a8 = star_SimdSet1(A[8]);
+  star_simd b0 = star_SimdSet1(b[0]);
+  star_simd b1 = star_SimdSet1(b[1]);
+  star_simd b2 = star_SimdSet1(b[2]);
+  for (; i + STAR_SIMD_LANES <= n; i += STAR_SIMD_LANES) {
+    star_simd v0 = star_SimdLoad(x0 + i);
+    star_simd v1 = star_SimdLoad(x1 + i);
+    star_simd v2 = star_SimdLoad(x2 + i);
+    star_simd r0 = star_SimdFmadd(a0, v0, b0);
+    r0 = star_SimdFmadd(a3, v1, r0);
+    r0 = star_SimdFmadd(a6, v2, r0);
+    star_simd r1 = star_SimdFmadd(a1, v0, b1);
+    r1 = star_SimdFmadd(a4, v1, r1);
+    r1 = star_SimdFmadd(a7, v2, r1);
+    star_simd r2 = star_SimdFmadd(a2, v0, b2);
+    r2 = star_SimdFmadd(a5, v1, r2);
+    r2 = star_SimdFmadd(a8, v2, r2);
+    star_SimdStore(y0 + i, r0);
+    star_SimdStore(y1 + i, r1);
+    star_SimdStore(y2 + i, r2);
+  }
+#endif
+  for (; i < n; ++i) {
+    sfloat v0 = x0[i];
+    sfloat v1 = x1[i];
+    sfloat v2 = x2[i];
+    y0[i] = A[0] * v0 + A[3] * v1 + A[6] * v2 + b[0];
+    y1[i] = A[1] * v0 + A[4] * v1 + A[7] * v2 + b[1];
+    y2[i] = A[2] * v0 + A[5] * v1 + A[8] * v2 + b[2];
+  }
+}
+STAR_DISPATCH(star_AffineMulBatch33,
+              (sfloat* y0, sfloat* y1, sfloat* y2, const sfloat A[9], const sfloat b[3],
+               const sfloat* x0, const sfloat* x1, const sfloat* x2, int n),
+              (y0, y1, y2, A, b, x0, x1, x2, n))
+
+STAR_KERNEL void star_AffineMulInterleaved33(sfloat* y, const sfloat A[9],
+                                             const sfloat b[3], const sfloat* x, int n) {
+  // Local copies keep the coefficients in registers, since the stores to y may alias A or b
+  const sfloat a0 = A[0];
+  const sfloat a1 = A[1];
+  const sfloat a2 = A[2];
+  const sfloat a3 = A[3];
+  const sfloat a4 = A[4];
+  const sfloat a5 = A[5];
+  const sfloat a6 = A[6];
+  const sfloat a7 = A[7];
+  const sfloat a8 = A[8];
+  const sfloat b0 = b[0];
+  const sfloat b1 = b[1];
+  const sfloat b2 = b[2];
+  for (int i = 0; i < 3 * n; i += 3) {
+    sfloat v0 = x[i];
+    sfloat v1 = x[i + 1];
+    sfloat v2 = x[i + 2];
+    y[i] = a0 * v0 + a3 * v1 + a6 * v2 + b0;
+    y[i + 1] = a1 * v0 + a4 * v1 + a7 * v2 + b1;
+    y[i + 2] = a2 * v0 + a5 * v1 + a8 * v2 + b2;
+  }
+}
+
+STAR_KERNEL void star_CongruenceTransform33(sfloat C[9], const sfloat A[9],
+                                            const sfloat P[9]) {
+  const sfloat p00 = P[IDX(0, 0)];
+  const sfloat p01 = P[IDX(0, 1)];
+  const sfloat p02 = P[IDX(0, 2)];
+  const sfloat p11 = P[IDX(1, 1)];
+  const sfloat p12 = P[IDX(1, 2)];
+  const sfloat p22 = P[IDX(2, 2)];
+
+  // T = A P
+  sfloat T[9];
+  for (int i = 0; i < 3; ++i) {
+    const sfloat ai0 = A[IDX(i, 0)];
+    const sfloat ai1 = A[IDX(i, 1)];
+    const sfloat ai2 = A[IDX(i, 2)];
+    T[IDX(i, 0)] = ai0 * p00 + ai1 * p01 + ai2 * p02;
+    T[IDX(i, 1)] = ai0 * p01 + ai1 * p11 + ai2 * p12;
+    T[IDX(i, 2)] = ai0 * p02 + ai1 * p12 + ai2 * p22;
+  }
+
+  // Upper triangle of C = T A^T
+  const sfloat c00 = T[IDX(0, 0)] * A[IDX(0, 0)] + T[IDX(0, 1)] * A[IDX(0, 1)] +
+                     T[IDX(0, 2)] * A[IDX(0, 2)];
+  const sfloat c01 = T[IDX(0, 0)] * A[IDX(1, 0)] + T[IDX(0, 1)] * A[IDX(1, 1)] +
+                     T[IDX(0, 2)] * A[IDX(1, 2)];
+  const sfloat c02 = T[IDX(0, 0)] * A[IDX(2, 0)] + T[IDX(0, 1)] * A[IDX(2, 1)] +
+                     T[IDX(0, 2)] * A[IDX(2, 2)];
+  const sfloat c11 = T[IDX(1, 0)] * A[IDX(1, 0)] + T[IDX(1, 1)] * A[IDX(1, 1)] +
+                     T[IDX(1, 2)] * A[IDX(1, 2)];
+  const sfloat c12 = T[IDX(1, 0)] * A[IDX(2, 0)] + T[IDX(1, 1)] * A[IDX(2, 1)] +
+                     T[IDX(1, 2)] * A[IDX(2, 2)];
+  const sfloat c22 = T[IDX(2, 0)] * A[IDX(2, 0)] + T[IDX(2, 1)] * A[IDX(2, 1)] +
+                     T[IDX(2, 2)] * A[IDX(2, 2)];
+
+  C[IDX(0, 0)] = c00;
+  C[IDX(1, 0)] = c01;
+  C[IDX(2, 0)] = c02;
+  C[IDX(0, 1)] = c01;
+  C[IDX(1, 1)] = c11;
+  C[IDX(2, 1)] = c12;
+  C[IDX(0, 2)] = c02;
+  C[IDX(1, 2)] = c12;
+  C[IDX(2, 2)] = c22;
+}
+
+// Sum of the element-wise products x0 y0 + x1 y1 + x2 y2
+#define star_SimdDot3(x0, x1, x2, y0, y1, y2) \
+  star_SimdFmadd(x2, y2, star_SimdFmadd(x1, y1, star_SimdMul(x0, y0)))
+
+static inline void star_CongruenceTransformBatch33_Generic(sfloat* C, const sfloat* A,
+                                                           const sfloat* P, int n) {
+  int i = 0;
+#if STAR_SIMD_LANES > 0
+  // Blocks of matrices are transposed into these buffers, so that each register holds the
+  // same entry of STAR_SIMD_LANES consecutive matrices
+  sfloat a[9][STAR_SIMD_LANES];
+  sfloat p[6][STAR_SIMD_LANES];
+  sfloat c[6][STAR_SIMD_LANES];
+  for (; i + STAR_SIMD_LANES <= n; i += STAR_SIMD_LANES) {
+    for (int l = 0; l < STAR_SIMD_LANES; ++l) {
+      const sfloat* Al = A + 9 * (i + l);
+      const sfloat* Pl = P + 9 * (i + l);
+      for (int k = 0; k < 9; ++k) {
+        a[k][l] = Al[k];
+      }
+      p[0][l] = Pl[IDX(0, 0)];
+      p[1][l] = Pl[IDX(0, 1)];
+      p[2][l] = Pl[IDX(0, 2)];
+      p[3][l] = Pl[IDX(1, 1)];
+      p[4][l] = Pl[IDX(1, 2)];
+      p[5][l] = Pl[IDX(2, 2)];
+    }
+
+    const star_simd a00 = star_SimdLoad(a[IDX(0, 0)]);
+    const star_simd a10 = star_SimdLoad(a[IDX(1, 0)]);
+    const star_simd a20 = star_SimdLoad(a[IDX(2, 0)]);
+    const star_simd a01 = star_SimdLoad(a[IDX(0, 1)]);
+    const star_simd a11 = star_SimdLoad(a[IDX(1, 1)]);
+    const star_simd a21 = star_SimdLoad(a[IDX(2, 1)]);
+    const star_simd a02 = star_SimdLoad(a[IDX(0, 2)]);
+    const star_simd a12 = star_SimdLoad(a[IDX(1, 2)]);
+    const star_simd a22 = star_SimdLoad(a[IDX(2, 2)]);
+    const star_simd p00 = star_SimdLoad(p[0]);
+    const star_simd p01 = star_SimdLoad(p[1]);
+    const star_simd p02 = star_SimdLoad(p[2]);
+    const star_simd p11 = star_SimdLoad(p[3]);
+    const star_simd p12 = star_SimdLoad(p[4]);
+    const star_simd p22 = star_SimdLoad(p[5]);
+
+    // T = A P
+    const star_simd t00 = star_SimdDot3(a00, a01, a02, p00, p01, p02);
+    const star_simd t01 = star_SimdDot3(a00, a01, a02, p01, p11, p12);
+    const star_simd t02 = star_SimdDot3(a00, a01, a02, p02, p12, p22);
+    const star_simd t10 = star_SimdDot3(a10, a11, a12, p00, p01, p02);
+    const star_simd t11 = star_SimdDot3(a10, a11, a12, p01, p11, p12);
+    const star_simd t12 = star_SimdDot3(a10, a11, a12, p02, p12, p22);
+    const star_simd t20 = star_SimdDot3(a20, a21, a22, p00, p01, p02);
+    const star_simd t21 = star_SimdDot3(a20, a21, a22, p01, p11, p12);
+    const star_simd t22 = star_SimdDot3(a20, a21, a22, p02, p12, p22);
+
+    // Upper triangle of C = T A^T
+    star_SimdStore(c[0], star_SimdDot3(t00, t01, t02, a00, a01, a02));
+    star_SimdStore(c[1], star_SimdDot3(t00, t01, t02, a10, a11, a12));
+    star_SimdStore(c[2], star_SimdDot3(t00, t01, t02, a20, a21, a22));
+    star_SimdStore(c[3], star_SimdDot3(t10, t11, t12, a10, a11, a12));
+    star_SimdStore(c[4], star_SimdDot3(t10, t11, t12, a20, a21, a22));
+    star_SimdStore(c[5], star_SimdDot3(t20, t21, t22, a20, a21, a22));
+
+    for (int l = 0; l < STAR_SIMD_LANES; ++l) {
+      sfloat* Cl = C + 9 * (i + l);
+      Cl[IDX(0, 0)] = c[0][l];
+      Cl[IDX(1, 0)] = c[1][l];
+      Cl[IDX(2, 0)] = c[2][l];
+      Cl[IDX(0, 1)] = c[1][l];
+      Cl[IDX(1, 1)] = c[3][l];
+      Cl[IDX(2, 1)] = c[4][l];
+      Cl[IDX(0, 2)] = c[2][l];
+      Cl[IDX(1, 2)] = c[4][l];
+      Cl[IDX(2, 2)] = c[5][l];
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    star_CongruenceTransform33(C + 9 * i, A + 9 * i, P + 9 * i);
+  }
+}
+STAR_DISPATCH(star_CongruenceTransformBatch33,
+              (sfloat* C, const sfloat* A, const sfloat* P, int n), (C, A, P, n))
+
+#undef star_SimdDot3
+
+STAR_KERNEL void star_UpperMatMul33(sfloat C[9], const sfloat U[9], const sfloat A[9]) {
   C[0] = U[0] * A[0] + U[3] * A[1] + U[6] * A[2];
   C[1] = U[4] * A[1] + U[7] * A[2];
   C[2] = U[8] * A[2];
@@ -119,13 +382,13 @@ void star_UpperMatMul33(sfloat C[9], const sfloat U[9], const sfloat A[9]) {
   C[8] = U[8] * A[8];
 }
 
-void star_UpperVecMul33(sfloat y[3], const sfloat U[9], const sfloat x[3]) {
+STAR_KERNEL void star_UpperVecMul33(sfloat y[3], const sfloat U[9], const sfloat x[3]) {
   y[0] = U[0] * x[0] + U[3] * x[1] + U[6] * x[2];
   y[1] = U[4] * x[1] + U[7] * x[2];
   y[2] = U[8] * x[2];
 }
 
-void star_LowerMatMul33(sfloat C[9], const sfloat L[9], const sfloat A[9]) {
+STAR_KERNEL void star_LowerMatMul33(sfloat C[9], const sfloat L[9], const sfloat A[9]) {
   C[0] = L[0] * A[0];
   C[1] = L[1] * A[0] + L[4] * A[1];
   C[2] = L[2] * A[0] + L[5] * A[1] + L[8] * A[2];
@@ -137,30 +400,30 @@ void star_LowerMatMul33(sfloat C[9], const sfloat L[9], const sfloat A[9]) {
   C[8] = L[2] * A[6] + L[5] * A[7] + L[8] * A[8];
 }
 
-void star_LowerVecMul33(sfloat y[3], const sfloat L[9], const sfloat x[3]) {
+STAR_KERNEL void star_LowerVecMul33(sfloat y[3], const sfloat L[9], const sfloat x[3]) {
   y[0] = L[0] * x[0];
   y[1] = L[1] * x[0] + L[4] * x[1];
   y[2] = L[2] * x[0] + L[5] * x[1] + L[8] * x[2];
 }
 
-void star_UpperTriSolve33(sfloat x[3], const sfloat U[9], const sfloat b[3]) {
+STAR_KERNEL void star_UpperTriSolve33(sfloat x[3], const sfloat U[9], const sfloat b[3]) {
   x[2] = b[2] / U[8];
   x[1] = (b[1] - U[7] * x[2]) / U[4];
   x[0] = (b[0] - U[3] * x[1] - U[6] * x[2]) / U[0];
 }
 
-void star_LowerTriSolve33(sfloat x[3], const sfloat L[9], const sfloat b[3]) {
+STAR_KERNEL void star_LowerTriSolve33(sfloat x[3], const sfloat L[9], const sfloat b[3]) {
   x[0] = b[0] / L[0];
   x[1] = (b[1] - L[1] * x[0]) / L[4];
   x[2] = (b[2] - L[2] * x[0] - L[5] * x[1]) / L[8];
 }
 
-sfloat star_Det33(const sfloat mat[9]) {
+STAR_KERNEL sfloat star_Det33(const sfloat mat[9]) {
   return mat[0] * mat[4] * mat[8] + mat[3] * mat[7] * mat[2] + mat[6] * mat[1] * mat[5] -
          mat[6] * mat[4] * mat[2] - mat[0] * mat[7] * mat[5] - mat[3] * mat[1] * mat[8];
 }
 
-void star_Copy33(sfloat dst[9], const sfloat src[9]) {
+STAR_KERNEL void star_Copy33(sfloat dst[9], const sfloat src[9]) {
   dst[0] = src[0];
   dst[1] = src[1];
   dst[2] = src[2];
@@ -172,7 +435,7 @@ void star_Copy33(sfloat dst[9], const sfloat src[9]) {
   dst[8] = src[8];
 }
 
-void star_Transpose33(sfloat dst[9], const sfloat src[9]) {
+STAR_KERNEL void star_Transpose33(sfloat dst[9], const sfloat src[9]) {
   dst[IDX(0, 0)] = src[IDX(0, 0)];
   dst[IDX(0, 1)] = src[IDX(1, 0)];
   dst[IDX(0, 2)] = src[IDX(2, 0)];
@@ -184,7 +447,7 @@ void star_Transpose33(sfloat dst[9], const sfloat src[9]) {
   dst[IDX(2, 2)] = src[IDX(2, 2)];
 }
 
-void star_TransposeInPlace33(sfloat mat[9]) {
+STAR_KERNEL void star_TransposeInPlace33(sfloat mat[9]) {
   sfloat tmp = mat[IDX(0, 1)];
   mat[IDX(0, 1)] = mat[IDX(1, 0)];
   mat[IDX(1, 0)] = tmp;
@@ -197,3 +460,479 @@ void star_TransposeInPlace33(sfloat mat[9]) {
   mat[IDX(1, 2)] = mat[IDX(2, 1)];
   mat[IDX(2, 1)] = tmp;
 }
+
+/*---------------------------------*/
+/* Decompositions                  */
+/*---------------------------------*/
+
+// Number of one-sided Jacobi sweeps used by star_SVD33
+#define STAR_SVD33_SWEEPS 5
+
+STAR_KERNEL bool star_Chol33(sfloat U[9], const sfloat mat[9]) {
+  const sfloat a00 = mat[IDX(0, 0)];
+  const sfloat a01 = mat[IDX(0, 1)];
+  const sfloat a02 = mat[IDX(0, 2)];
+  const sfloat a11 = mat[IDX(1, 1)];
+  const sfloat a12 = mat[IDX(1, 2)];
+  const sfloat a22 = mat[IDX(2, 2)];
+
+  const sfloat u00 = sqrt(a00);
+  const sfloat u01 = a01 / u00;
+  const sfloat u02 = a02 / u00;
+  const sfloat d1 = a11 - u01 * u01;
+  const sfloat u11 = sqrt(d1);
+  const sfloat u12 = (a12 - u01 * u02) / u11;
+  const sfloat d2 = a22 - u02 * u02 - u12 * u12;
+  const sfloat u22 = sqrt(d2);
+
+  U[IDX(0, 0)] = u00;
+  U[IDX(1, 0)] = 0;
+  U[IDX(2, 0)] = 0;
+  U[IDX(0, 1)] = u01;
+  U[IDX(1, 1)] = u11;
+  U[IDX(2, 1)] = 0;
+  U[IDX(0, 2)] = u02;
+  U[IDX(1, 2)] = u12;
+  U[IDX(2, 2)] = u22;
+  return a00 > 0 && d1 > 0 && d2 > 0;
+}
+
+STAR_KERNEL void star_QR33(sfloat Q[9], sfloat R[9], const sfloat A[9]) {
+  sfloat v1[3] = {A[3], A[4], A[5]};
+  sfloat v2[3] = {A[6], A[7], A[8]};
+  sfloat* q0 = Q;
+  sfloat* q1 = Q + 3;
+  sfloat* q2 = Q + 6;
+
+  const sfloat r00 = sqrt(A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
+  q0[0] = A[0] / r00;
+  q0[1] = A[1] / r00;
+  q0[2] = A[2] / r00;
+
+  const sfloat r01 = star_Dot3(q0, v1);
+  const sfloat r02 = star_Dot3(q0, v2);
+  for (int i = 0; i < 3; ++i) {
+    v1[i] -= r01 * q0[i];
+    v2[i] -= r02 * q0[i];
+  }
+  const sfloat r11 = star_Norm3(v1);
+  for (int i = 0; i < 3; ++i) {
+    q1[i] = v1[i] / r11;
+  }
+
+  const sfloat r12 = star_Dot3(q1, v2);
+  for (int i = 0; i < 3; ++i) {
+    v2[i] -= r12 * q1[i];
+  }
+  const sfloat r22 = star_Norm3(v2);
+  for (int i = 0; i < 3; ++i) {
+    q2[i] = v2[i] / r22;
+  }
+
+  R[IDX(0, 0)] = r00;
+  R[IDX(1, 0)] = 0;
+  R[IDX(2, 0)] = 0;
+  R[IDX(0, 1)] = r01;
+  R[IDX(1, 1)] = r11;
+  R[IDX(2, 1)] = 0;
+  R[IDX(0, 2)] = r02;
+  R[IDX(1, 2)] = r12;
+  R[IDX(2, 2)] = r22;
+}
+
+STAR_KERNEL void star_LU33(sfloat L[9], sfloat U[9], int perm[3], const sfloat A[9]) {
+  sfloat B[9];
+  star_Copy33(B, A);
+  star_SetIdentity33(L, 1);
+  perm[0] = 0;
+  perm[1] = 1;
+  perm[2] = 2;
+
+  for (int k = 0; k < 2; ++k) {
+    // Swap the row with the largest pivot into place
+    int p = k;
+    for (int i = k + 1; i < 3; ++i) {
+      if (fabs(B[IDX(i, k)]) > fabs(B[IDX(p, k)])) {
+        p = i;
+      }
+    }
+    if (p != k) {
+      for (int j = 0; j < 3; ++j) {
+        sfloat tmp = B[IDX(k, j)];
+        B[IDX(k, j)] = B[IDX(p, j)];
+        B[IDX(p, j)] = tmp;
+      }
+      for (int j = 0; j < k; ++j) {
+        sfloat tmp = L[IDX(k, j)];
+        L[IDX(k, j)] = L[IDX(p, j)];
+        L[IDX(p, j)] = tmp;
+      }
+      int tmp = perm[k];
+      perm[k] = perm[p];
+      perm[p] = tmp;
+    }
+
+    // Eliminate the entries below the pivot
+    for (int i = k + 1; i < 3; ++i) {
+      sfloat l = B[IDX(i, k)] / B[IDX(k, k)];
+      L[IDX(i, k)] = l;
+      for (int j = k; j < 3; ++j) {
+        B[IDX(i, j)] -= l * B[IDX(k, j)];
+      }
+    }
+  }
+
+  U[IDX(0, 0)] = B[IDX(0, 0)];
+  U[IDX(1, 0)] = 0;
+  U[IDX(2, 0)] = 0;
+  U[IDX(0, 1)] = B[IDX(0, 1)];
+  U[IDX(1, 1)] = B[IDX(1, 1)];
+  U[IDX(2, 1)] = 0;
+  U[IDX(0, 2)] = B[IDX(0, 2)];
+  U[IDX(1, 2)] = B[IDX(1, 2)];
+  U[IDX(2, 2)] = B[IDX(2, 2)];
+}
+
+// Orthonormal vectors u and v such that (w, u, v) is a right-handed basis, for a unit w
+static inline void star_OrthogonalComplement3(sfloat u[3], sfloat v[3], const sfloat w[3]) {
+  if (fabs(w[0]) > fabs(w[1])) {
+    sfloat inv_norm = 1 / sqrt(w[0] * w[0] + w[2] * w[2]);
+    u[0] = -w[2] * inv_norm;
+    u[1] = 0;
+    u[2] = w[0] * inv_norm;
+  } else {
+    sfloat inv_norm = 1 / sqrt(w[1] * w[1] + w[2] * w[2]);
+    u[0] = 0;
+    u[1] = w[2] * inv_norm;
+    u[2] = -w[1] * inv_norm;
+  }
+  star_Cross(v, w, u);
+}
+
+// Unit eigenvector of the symmetric matrix A for an eigenvalue of multiplicity one.
+// The rows of A - lambda I span a plane, whose normal is the largest cross product of rows.
+static inline void star_EigenvectorSingle33(sfloat v[3], const sfloat A[9], sfloat lambda) {
+  const sfloat r0[3] = {A[0] - lambda, A[3], A[6]};
+  const sfloat r1[3] = {A[1], A[4] - lambda, A[7]};
+  const sfloat r2[3] = {A[2], A[5], A[8] - lambda};
+  sfloat c[9];
+  star_Cross(c + 0, r0, r1);
+  star_Cross(c + 3, r0, r2);
+  star_Cross(c + 6, r1, r2);
+  const sfloat d0 = star_NormSquared3(c + 0);
+  const sfloat d1 = star_NormSquared3(c + 3);
+  const sfloat d2 = star_NormSquared3(c + 6);
+
+  int imax = 0;
+  sfloat dmax = d0;
+  if (d1 > dmax) {
+    imax = 1;
+    dmax = d1;
+  }
+  if (d2 > dmax) {
+    imax = 2;
+    dmax = d2;
+  }
+  const sfloat inv_norm = 1 / sqrt(dmax);
+  v[0] = c[3 * imax + 0] * inv_norm;
+  v[1] = c[3 * imax + 1] * inv_norm;
+  v[2] = c[3 * imax + 2] * inv_norm;
+}
+
+// Remaining eigenpairs of the symmetric matrix A, given the unit eigenvector w of one of its
+// eigenvalues. The other two eigenvectors span the plane orthogonal to w, so they follow from
+// diagonalizing the projection of A onto that plane with a single Jacobi rotation. The
+// eigenvalues mu are returned in ascending order, with the eigenvectors v0 and v1.
+static inline void star_EigenPlane33(sfloat mu[2], sfloat v0[3], sfloat v1[3],
+                                     const sfloat A[9], const sfloat w[3]) {
+  sfloat u[3];
+  sfloat t[3];
+  sfloat Au[3];
+  sfloat At[3];
+  star_OrthogonalComplement3(u, t, w);
+  star_VecMul33(Au, A, u);
+  star_VecMul33(At, A, t);
+  const sfloat m00 = star_Dot3(u, Au);
+  const sfloat m01 = star_Dot3(u, At);
+  const sfloat m11 = star_Dot3(t, At);
+
+  sfloat tan = 0;
+  if (m01 != 0) {
+    const sfloat tau = (m11 - m00) / (2 * m01);
+    tan = copysign(1, tau) / (fabs(tau) + sqrt(1 + tau * tau));
+  }
+  const sfloat c = 1 / sqrt(1 + tan * tan);
+  const sfloat s = c * tan;
+  const sfloat mu0 = m00 - tan * m01;
+  const sfloat mu1 = m11 + tan * m01;
+  const int swap = mu0 > mu1;
+  mu[swap] = mu0;
+  mu[1 - swap] = mu1;
+  sfloat* e0 = swap ? v1 : v0;
+  sfloat* e1 = swap ? v0 : v1;
+  for (int i = 0; i < 3; ++i) {
+    e0[i] = c * u[i] - s * t[i];
+    e1[i] = s * u[i] + c * t[i];
+  }
+}
+
+STAR_KERNEL void star_Eigen33(sfloat eigenvalues[3], sfloat eigenvectors[9],
+                              const sfloat mat[9]) {
+  // Scale by the largest element to avoid overflow in the characteristic polynomial
+  const sfloat max_abs = fmax(fmax(fmax(fabs(mat[IDX(0, 0)]), fabs(mat[IDX(0, 1)])),
+                                   fmax(fabs(mat[IDX(0, 2)]), fabs(mat[IDX(1, 1)]))),
+                              fmax(fabs(mat[IDX(1, 2)]), fabs(mat[IDX(2, 2)])));
+  if (max_abs == 0) {
+    eigenvalues[0] = 0;
+    eigenvalues[1] = 0;
+    eigenvalues[2] = 0;
+    star_SetIdentity33(eigenvectors, 1);
+    return;
+  }
+  const sfloat scale = 1 / max_abs;
+  const sfloat a00 = mat[IDX(0, 0)] * scale;
+  const sfloat a01 = mat[IDX(0, 1)] * scale;
+  const sfloat a02 = mat[IDX(0, 2)] * scale;
+  const sfloat a11 = mat[IDX(1, 1)] * scale;
+  const sfloat a12 = mat[IDX(1, 2)] * scale;
+  const sfloat a22 = mat[IDX(2, 2)] * scale;
+
+  // Eigenvalues of A = q I + p B are q + p beta, where beta are the roots of
+  // beta^3 - 3 beta - det(B) = 0, given by the trigonometric solution of the cubic.
+  const sfloat q = (a00 + a11 + a22) / 3;
+  const sfloat b00 = a00 - q;
+  const sfloat b11 = a11 - q;
+  const sfloat b22 = a22 - q;
+  const sfloat p = sqrt(
+      (b00 * b00 + b11 * b11 + b22 * b22 + 2 * (a01 * a01 + a02 * a02 + a12 * a12)) / 6);
+  if (p == 0) {
+    // Multiple of the identity
+    eigenvalues[0] = q * max_abs;
+    eigenvalues[1] = q * max_abs;
+    eigenvalues[2] = q * max_abs;
+    star_SetIdentity33(eigenvectors, 1);
+    return;
+  }
+  const sfloat c00 = b11 * b22 - a12 * a12;
+  const sfloat c01 = a01 * b22 - a12 * a02;
+  const sfloat c02 = a01 * a12 - b11 * a02;
+  const sfloat det_b = (b00 * c00 - a01 * c01 + a02 * c02) / (p * p * p);
+  const sfloat half_det = fmin(fmax(det_b / 2, -1), 1);
+  const sfloat angle = acos(half_det) / 3;
+  const sfloat two_thirds_pi = 2.09439510239319549;
+
+  // Only the most isolated eigenvalue is computed in closed form: the largest if det(B) >= 0
+  // and the smallest otherwise. It and its eigenvector are accurate even if the other two
+  // eigenvalues are (nearly) repeated, in which case their closed-form values are not, so
+  // those are recomputed in the plane orthogonal to its eigenvector.
+  const bool largest = half_det >= 0;
+  const sfloat lambda = q + 2 * p * (largest ? cos(angle) : cos(angle + two_thirds_pi));
+  const sfloat A[9] = {a00, a01, a02, a01, a11, a12, a02, a12, a22};
+  sfloat* v0 = eigenvectors;
+  sfloat* v1 = eigenvectors + 3;
+  sfloat* v2 = eigenvectors + 6;
+  sfloat mu[2];
+  if (largest) {
+    star_EigenvectorSingle33(v2, A, lambda);
+    star_EigenPlane33(mu, v0, v1, A, v2);
+    star_Cross(v0, v1, v2);
+    eigenvalues[0] = mu[0] * max_abs;
+    eigenvalues[1] = mu[1] * max_abs;
+    eigenvalues[2] = lambda * max_abs;
+  } else {
+    star_EigenvectorSingle33(v0, A, lambda);
+    star_EigenPlane33(mu, v1, v2, A, v0);
+    star_Cross(v2, v0, v1);
+    eigenvalues[0] = lambda * max_abs;
+    eigenvalues[1] = mu[0] * max_abs;
+    eigenvalues[2] = mu[1] * max_abs;
+  }
+}
+
+// Jacobi rotation that orthogonalizes columns p and q of B, accumulated into V
+static inline void star_JacobiRotate33(sfloat B[9], sfloat V[9], int p, int q) {
+  sfloat* bp = B + 3 * p;
+  sfloat* bq = B + 3 * q;
+  sfloat* vp = V + 3 * p;
+  sfloat* vq = V + 3 * q;
+  const sfloat alpha = star_NormSquared3(bp);
+  const sfloat beta = star_NormSquared3(bq);
+  const sfloat gamma = star_Dot3(bp, bq);
+  if (gamma == 0) {
+    return;
+  }
+  const sfloat zeta = (beta - alpha) / (2 * gamma);
+  const sfloat t = copysign(1, zeta) / (fabs(zeta) + sqrt(1 + zeta * zeta));
+  const sfloat c = 1 / sqrt(1 + t * t);
+  const sfloat s = c * t;
+  for (int i = 0; i < 3; ++i) {
+    sfloat bpi = bp[i];
+    sfloat bqi = bq[i];
+    bp[i] = c * bpi - s * bqi;
+    bq[i] = s * bpi + c * bqi;
+    sfloat vpi = vp[i];
+    sfloat vqi = vq[i];
+    vp[i] = c * vpi - s * vqi;
+    vq[i] = s * vpi + c * vqi;
+  }
+}
+
+// Swap entry i and j of S, along with columns i and j of B and V
+static inline void star_SVDSwap33(sfloat B[9], sfloat S[3], sfloat V[9], int i, int j) {
+  sfloat tmp = S[i];
+  S[i] = S[j];
+  S[j] = tmp;
+  for (int k = 0; k < 3; ++k) {
+    tmp = B[3 * i + k];
+    B[3 * i + k] = B[3 * j + k];
+    B[3 * j + k] = tmp;
+    tmp = V[3 * i + k];
+    V[3 * i + k] = V[3 * j + k];
+    V[3 * j + k] = tmp;
+  }
+}
+
+STAR_KERNEL void star_SVD33(sfloat U[9], sfloat S[3], sfloat V[9], const sfloat A[9]) {
+  // Orthogonalize the columns of B = A V
+  sfloat B[9];
+  star_Copy33(B, A);
+  star_SetIdentity33(V, 1);
+  for (int sweep = 0; sweep < STAR_SVD33_SWEEPS; ++sweep) {
+    star_JacobiRotate33(B, V, 0, 1);
+    star_JacobiRotate33(B, V, 0, 2);
+    star_JacobiRotate33(B, V, 1, 2);
+  }
+
+  // The singular values are the column norms, sorted in descending order
+  S[0] = star_Norm3(B + 0);
+  S[1] = star_Norm3(B + 3);
+  S[2] = star_Norm3(B + 6);
+  if (S[0] < S[1]) star_SVDSwap33(B, S, V, 0, 1);
+  if (S[1] < S[2]) star_SVDSwap33(B, S, V, 1, 2);
+  if (S[0] < S[1]) star_SVDSwap33(B, S, V, 0, 1);
+
+  // Normalize the columns, completing the basis if the singular values are (numerically) zero
+  if (S[0] == 0) {
+    star_SetIdentity33(U, 1);
+    return;
+  }
+  const sfloat tol = STAR_EPS * S[0];
+  star_Scale3(U, 1 / S[0], B);
+  if (S[1] > tol) {
+    star_Scale3(U + 3, 1 / S[1], B + 3);
+  } else {
+    sfloat unused[3];
+    star_OrthogonalComplement3(U + 3, unused, U);
+  }
+
+  // The last column is orthogonal to the other two, with the sign of A v2
+  star_Cross(U + 6, U, U + 3);
+  if (star_Dot3(U + 6, B + 6) < 0) {
+    star_Scale3(U + 6, -1, U + 6);
+  }
+}
+
+/*---------------------------------*/
+/* Solves and Inverses             */
+/*---------------------------------*/
+
+STAR_KERNEL bool star_CholSolve33(sfloat x[3], const sfloat A[9], const sfloat b[3]) {
+  sfloat U[9];
+  bool is_pd = star_Chol33(U, A);
+
+  // Solve U^T y = b, then U x = y
+  sfloat y[3];
+  y[0] = b[0] / U[IDX(0, 0)];
+  y[1] = (b[1] - U[IDX(0, 1)] * y[0]) / U[IDX(1, 1)];
+  y[2] = (b[2] - U[IDX(0, 2)] * y[0] - U[IDX(1, 2)] * y[1]) / U[IDX(2, 2)];
+  star_UpperTriSolve33(x, U, y);
+  return is_pd;
+}
+
+STAR_KERNEL void star_Inverse33(sfloat mat[9]) {
+  const sfloat a00 = mat[IDX(0, 0)];
+  const sfloat a10 = mat[IDX(1, 0)];
+  const sfloat a20 = mat[IDX(2, 0)];
+  const sfloat a01 = mat[IDX(0, 1)];
+  const sfloat a11 = mat[IDX(1, 1)];
+  const sfloat a21 = mat[IDX(2, 1)];
+  const sfloat a02 = mat[IDX(0, 2)];
+  const sfloat a12 = mat[IDX(1, 2)];
+  const sfloat a22 = mat[IDX(2, 2)];
+
+  // Cofactors
+  const sfloat c00 = a11 * a22 - a12 * a21;
+  const sfloat c01 = a12 * a20 - a10 * a22;
+  const sfloat c02 = a10 * a21 - a11 * a20;
+  const sfloat c10 = a02 * a21 - a01 * a22;
+  const sfloat c11 = a00 * a22 - a02 * a20;
+  const sfloat c12 = a01 * a20 - a00 * a21;
+  const sfloat c20 = a01 * a12 - a02 * a11;
+  const sfloat c21 = a02 * a10 - a00 * a12;
+  const sfloat c22 = a00 * a11 - a01 * a10;
+  const sfloat inv_det = 1 / (a00 * c00 + a01 * c01 + a02 * c02);
+
+  // The inverse is the transposed cofactor matrix divided by the determinant
+  mat[IDX(0, 0)] = c00 * inv_det;
+  mat[IDX(1, 0)] = c01 * inv_det;
+  mat[IDX(2, 0)] = c02 * inv_det;
+  mat[IDX(0, 1)] = c10 * inv_det;
+  mat[IDX(1, 1)] = c11 * inv_det;
+  mat[IDX(2, 1)] = c12 * inv_det;
+  mat[IDX(0, 2)] = c20 * inv_det;
+  mat[IDX(1, 2)] = c21 * inv_det;
+  mat[IDX(2, 2)] = c22 * inv_det;
+}
+
+STAR_KERNEL bool star_InversePSD33(sfloat mat[9]) {
+  sfloat U[9];
+  if (!star_Chol33(U, mat)) {
+    return false;
+  }
+
+  // Inverse of the Cholesky factor, which is also upper triangular
+  const sfloat w00 = 1 / U[IDX(0, 0)];
+  const sfloat w11 = 1 / U[IDX(1, 1)];
+  const sfloat w22 = 1 / U[IDX(2, 2)];
+  const sfloat w01 = -U[IDX(0, 1)] * w00 * w11;
+  const sfloat w12 = -U[IDX(1, 2)] * w11 * w22;
+  const sfloat w02 = -(U[IDX(0, 1)] * w12 + U[IDX(0, 2)] * w22) * w00;
+
+  // A^-1 = U^-1 U^-T
+  mat[IDX(0, 0)] = w00 * w00 + w01 * w01 + w02 * w02;
+  mat[IDX(0, 1)] = w01 * w11 + w02 * w12;
+  mat[IDX(0, 2)] = w02 * w22;
+  mat[IDX(1, 1)] = w11 * w11 + w12 * w12;
+  mat[IDX(1, 2)] = w12 * w22;
+  mat[IDX(2, 2)] = w22 * w22;
+  mat[IDX(1, 0)] = mat[IDX(0, 1)];
+  mat[IDX(2, 0)] = mat[IDX(0, 2)];
+  mat[IDX(2, 1)] = mat[IDX(1, 2)];
+  return true;
+}
+
+STAR_KERNEL void star_Orthonormalize33(sfloat R[9]) {
+  sfloat* x = R;
+  sfloat* y = R + 3;
+  sfloat* z = R + 6;
+  const sfloat half_err = star_Dot3(x, y) / 2;
+  sfloat x_orth[3];
+  sfloat y_orth[3];
+  for (int i = 0; i < 3; ++i) {
+    x_orth[i] = x[i] - half_err * y[i];
+    y_orth[i] = y[i] - half_err * x[i];
+  }
+  star_Cross(z, x_orth, y_orth);
+
+  const sfloat x_scale = star_RSqrt(star_NormSquared3(x_orth));
+  const sfloat y_scale = star_RSqrt(star_NormSquared3(y_orth));
+  const sfloat z_scale = star_RSqrt(star_NormSquared3(z));
+  for (int i = 0; i < 3; ++i) {
+    x[i] = x_orth[i] * x_scale;
+    y[i] = y_orth[i] * y_scale;
+    z[i] *= z_scale;
+  }
+}
+
+#undef STAR_SVD33_SWEEPS
+#undef IDX
@@ -5,60 +5,171 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include "typedefs.h"
 
 /*---------------------------------*/
 /* Setters                         */
 /*---------------------------------*/
 
-void star_SetZero33(sfloat mat[9]);
-void star_SetConst33(sfloat mat[9], sfloat value);
-void star_SetIdentity33(sfloat mat[9], sfloat value);
-void star_SetDiagonal33(sfloat mat[9], const sfloat diag[3]);
-void star_Copy33(sfloat dst[9], const sfloat src[9]);
-void star_Transpose33(sfloat dst[9], const sfloat src[9]);
-void star_TransposeInPlace33(sfloat mat[9]);
+STAR_KERNEL void star_SetZero33(sfloat mat[9]);
+STAR_KERNEL void star_SetConst33(sfloat mat[9], sfloat value);
+STAR_KERNEL void star_SetIdentity33(sfloat mat[9], sfloat value);
+STAR_KERNEL void star_SetDiagonal33(sfloat mat[9], const sfloat diag[3]);
+STAR_KERNEL void star_Copy33(sfloat dst[9], const sfloat src[9]);
+STAR_KERNEL void star_Transpose33(sfloat dst[9], const sfloat src[9]);
+STAR_KERNEL void star_TransposeInPlace33(sfloat mat[9]);
 
 /*---------------------------------*/
 /* Multiplication                  */
 /*---------------------------------*/
 
-void star_MatMul33(sfloat C[9], const sfloat A[9], const sfloat B[9]);
-void star_VecMul33(sfloat C[3], const sfloat A[9], const sfloat x[3]);
-
-void star_TransposedMatMul33(sfloat C[9], const sfloat At[9], const sfloat B[9]);
-void star_MatMulTransposed33(sfloat C[9], const sfloat A[9], const sfloat Bt[9]);
-void star_TransposedVecMul33(sfloat y[3], const sfloat At[9], const sfloat x[3]);
+STAR_KERNEL void star_MatMul33(sfloat C[9], const sfloat A[9], const sfloat B[9]);
+STAR_KERNEL void star_VecMul33(sfloat C[3], const sfloat A[9], const sfloat x[3]);
+
+STAR_KERNEL void star_TransposedMatMul33(sfloat C[9], const sfloat At[9],
+                                         const sfloat B[9]);
+STAR_KERNEL void star_MatMulTransposed33(sfloat C[9], const sfloat A[9],
+                                         const sfloat Bt[9]);
+STAR_KERNEL void star_TransposedVecMul33(sfloat y[3], const sfloat At[9],
+                                         const sfloat x[3]);
+
+/*
+ * @brief Multiply n 3-vectors, stored as separate x, y, z arrays, by the same matrix
+ *
+ * The outputs may alias the inputs.
+ */
+STAR_KERNEL void star_VecMulBatch33(sfloat* y0, sfloat* y1, sfloat* y2, const sfloat A[9],
+                                    const sfloat* x0, const sfloat* x1, const sfloat* x2,
+                                    int n);
+
+/*
+ * @brief Affine transform y = A x + b of n 3-vectors stored as separate x, y, z arrays
+ *
+ * Vectorizes across vectors, with the translation folded into the fused multiply-adds. The
+ * outputs may alias the inputs.
+ */
+STAR_KERNEL void star_AffineMulBatch33(sfloat* y0, sfloat* y1, sfloat* y2,
+                                       const sfloat A[9], const sfloat b[3],
+                                       const sfloat* x0, const sfloat* x1, const sfloat* x2,
+                                       int n);
+
+/*
+ * @brief Affine transform y = A x + b of n 3-vectors stored interleaved, [x y z x y z ...]
+ *
+ * y may alias x.
+ */
+STAR_KERNEL void star_AffineMulInterleaved33(sfloat* y, const sfloat A[9],
+                                             const sfloat b[3], const sfloat* x, int n);
+
+/*
+ * @brief Congruence transform C = A P A^T of a symmetric matrix P
+ *
+ * Only the upper triangle of P is read, and only the 6 unique entries of C are computed.
+ * C may alias A or P, e.g. to propagate a covariance in place.
+ */
+STAR_KERNEL void star_CongruenceTransform33(sfloat C[9], const sfloat A[9],
+                                            const sfloat P[9]);
+
+/*
+ * @brief Congruence transform C[i] = A[i] P[i] A[i]^T of n contiguous 3x3 matrices
+ *
+ * Each of C, A and P points to n column-major matrices of 9 elements each. Vectorizes across
+ * matrices. Each C[i] may alias A[i] or P[i].
+ */
+STAR_KERNEL void star_CongruenceTransformBatch33(sfloat* C, const sfloat* A, const sfloat* P,
+                                                 int n);
 
 /*---------------------------------*/
 /* Triangular Matrices             */
 /*---------------------------------*/
 
-void star_UpperMatMul33(sfloat C[9], const sfloat U[9], const sfloat A[9]);
-void star_UpperVecMul33(sfloat C[3], const sfloat U[9], const sfloat x[3]);
-void star_LowerMatMul33(sfloat C[9], const sfloat L[9], const sfloat A[9]);
-void star_LowerVecMul33(sfloat C[3], const sfloat L[9], const sfloat x[3]);
+STAR_KERNEL void star_UpperMatMul33(sfloat C[9], const sfloat U[9], const sfloat A[9]);
+STAR_KERNEL void star_UpperVecMul33(sfloat C[3], const sfloat U[9], const sfloat x[3]);
+STAR_KERNEL void star_LowerMatMul33(sfloat C[9], const sfloat L[9], const sfloat A[9]);
+STAR_KERNEL void star_LowerVecMul33(sfloat C[3], const sfloat L[9], const sfloat x[3]);
 
-void star_UpperTriSolve33(sfloat x[3], const sfloat U[9], const sfloat b[3]);
-void star_LowerTriSolve33(sfloat x[3], const sfloat L[9], const sfloat b[3]);
+STAR_KERNEL void star_UpperTriSolve33(sfloat x[3], const sfloat U[9], const sfloat b[3]);
+STAR_KERNEL void star_LowerTriSolve33(sfloat x[3], const sfloat L[9], const sfloat b[3]);
 
 /*---------------------------------*/
 /* Linear Algebra                  */
 /*---------------------------------*/
 
-sfloat star_Det33(const sfloat mat[9]);
+STAR_KERNEL sfloat star_Det33(const sfloat mat[9]);
 
 // Decompositions
-void star_Chol33(sfloat U[9], const sfloat mat[9]);
-void star_QR33(sfloat Q[9], sfloat R[9], const sfloat A[9]);
-void star_LU33(sfloat Q[9], sfloat R[9], const sfloat A[9]);
-void star_Eigen33(sfloat eigenvalues[3], sfloat eigenvectors[9], const sfloat mat[9]);
-void star_SVD33(sfloat U[9], sfloat S[3], sfloat V[9], const sfloat A[9]);
+/*
+ * @brief Upper Cholesky factor U of a symmetric positive definite matrix, A = U^T U
+ *
+ * Only the upper triangle of `mat` is read. Returns false if `mat` is not positive definite,
+ * in which case U is not valid.
+ */
+STAR_KERNEL bool star_Chol33(sfloat U[9], const sfloat mat[9]);
+
+/*
+ * @brief QR decomposition A = Q R of a matrix with full column rank
+ *
+ * Uses unrolled modified Gram-Schmidt. R is upper triangular with a positive diagonal.
+ */
+STAR_KERNEL void star_QR33(sfloat Q[9], sfloat R[9], const sfloat A[9]);
+
+/*
+ * @brief LU decomposition with partial pivoting, P A = L U
+ *
+ * L is unit lower triangular and U is upper triangular. Row i of P A is row perm[i] of A.
+ */
+STAR_KERNEL void star_LU33(sfloat L[9], sfloat U[9], int perm[3], const sfloat A[9]);
+
+/*
+ * @brief Eigendecomposition of a symmetric matrix, A = V diag(eigenvalues) V^T
+ *
+ * Uses the closed-form solution of the characteristic polynomial, with eigenvectors
+ * computed from cross products. Eigenvalues are in ascending order and the eigenvectors are
+ * the orthonormal columns of V, with det(V) = 1. Only the upper triangle of `mat` is read.
+ */
+STAR_KERNEL void star_Eigen33(sfloat eigenvalues[3], sfloat eigenvectors[9],
+                              const sfloat mat[9]);
+
+/*
+ * @brief Singular value decomposition A = U diag(S) V^T
+ *
+ * Uses one-sided Jacobi rotations with a fixed number of sweeps. The singular values are
+ * non-negative and in descending order. U and V are orthogonal.
+ */
+STAR_KERNEL void star_SVD33(sfloat U[9], sfloat S[3], sfloat V[9], const sfloat A[9]);
 
 // Solves
-void star_CholSolve33(sfloat x[3], const sfloat A[9], const sfloat b[3]);
+/*
+ * @brief Solve A x = b for a symmetric positive definite A using its Cholesky factor
+ *
+ * Returns false if A is not positive definite.
+ */
+STAR_KERNEL bool star_CholSolve33(sfloat x[3], const sfloat A[9], const sfloat b[3]);
 
 // Inverses
-void star_Inverse33(sfloat mat[9]);
-void star_InversePSD33(sfloat mat[9]);
-
+STAR_KERNEL void star_Inverse33(sfloat mat[9]);
+
+/*
+ * @brief Invert a symmetric positive definite matrix in place using its Cholesky factor
+ *
+ * The result is exactly symmetric. Returns false, leaving `mat` unchanged, if it isn't
+ * positive definite.
+ */
+STAR_KERNEL bool star_InversePSD33(sfloat mat[9]);
+
+// Rotations
+/*
+ * @brief Restore the orthonormality of a rotation matrix in place
+ *
+ * Splits the non-orthogonality of the first two columns evenly between them, sets the
+ * third column to their cross product and normalizes all three. Cheap enough to call after
+ * every few compositions. The orthogonality error after a call is second order in the error
+ * before it.
+ */
+STAR_KERNEL void star_Orthonormalize33(sfloat R[9]);
+
+#ifdef STAR_HEADER_ONLY
+#include "matrix3.c"
+#endif
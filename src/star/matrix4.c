@@ -3,11 +3,15 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include "dispatch.h"
 #include "matrix4.h"
 
+#include <math.h>
+#include <stdbool.h>
+
 #define IDX(i, j) ((i) + (j)*4)
 
-void star_SetZero44(sfloat mat[16]) {
+STAR_KERNEL void star_SetZero44(sfloat mat[16]) {
   mat[0] = 0;
   mat[1] = 0;
   mat[2] = 0;
@@ -26,7 +30,7 @@ void star_SetZero44(sfloat mat[16]) {
   mat[15] = 0;
 }
 
-void star_SetConst44(sfloat mat[16], sfloat value) {
+STAR_KERNEL void star_SetConst44(sfloat mat[16], sfloat value) {
   mat[0] = value;
   mat[1] = value;
   mat[2] = value;
@@ -45,7 +49,7 @@ void star_SetConst44(sfloat mat[16], sfloat value) {
   mat[15] = value;
 }
 
-void star_SetIdentity44(sfloat mat[16], sfloat val) {
+STAR_KERNEL void star_SetIdentity44(sfloat mat[16], sfloat val) {
   mat[0] = val;
   mat[1] = 0;
   mat[2] = 0;
@@ -64,14 +68,14 @@ void star_SetIdentity44(sfloat mat[16], sfloat val) {
   mat[15] = val;
 }
 
-void star_SetDiagonal44(sfloat mat[16], const sfloat diag[4]) {
+STAR_KERNEL void star_SetDiagonal44(sfloat mat[16], const sfloat diag[4]) {
   mat[0] = diag[0];
   mat[5] = diag[1];
   mat[10] = diag[2];
   mat[15] = diag[3];
 }
 
-void star_Copy44(sfloat dst[16], const sfloat src[16]) {
+STAR_KERNEL void star_Copy44(sfloat dst[16], const sfloat src[16]) {
   dst[0] = src[0];
   dst[1] = src[1];
   dst[2] = src[2];
@@ -90,7 +94,7 @@ void star_Copy44(sfloat dst[16], const sfloat src[16]) {
   dst[15] = src[15];
 }
 
-void star_Transpose44(sfloat dst[16], const sfloat src[16]) {
+STAR_KERNEL void star_Transpose44(sfloat dst[16], const sfloat src[16]) {
   dst[IDX(0, 0)] = src[IDX(0, 0)];
   dst[IDX(0, 1)] = src[IDX(1, 0)];
   dst[IDX(0, 2)] = src[IDX(2, 0)];
@@ -109,7 +113,7 @@ void star_Transpose44(sfloat dst[16], const sfloat src[16]) {
   dst[IDX(3, 3)] = src[IDX(3, 3)];
 }
 
-void star_TransposeInPlace44(sfloat mat[16]) {
+STAR_KERNEL void star_TransposeInPlace44(sfloat mat[16]) {
   sfloat tmp;
   tmp = mat[IDX(1, 0)];
   mat[IDX(1, 0)] = mat[IDX(0, 1)];
@@ -131,27 +135,34 @@ void star_TransposeInPlace44(sfloat mat[16]) {
   mat[IDX(2, 3)] = tmp;
 }
 
-void star_MatMul44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
+static inline void star_MatMul44_Generic(sfloat C[16], const sfloat A[16],
+                                         const sfloat B[16]) {
   // C = A * B, where A, B, and C are 4x4 matrices stored column-major
-  C[0] = A[0] * B[0] + A[4] * B[1] + A[8] * B[2] + A[12] * B[3];
-  C[1] = A[1] * B[0] + A[5] * B[1] + A[9] * B[2] + A[13] * B[3];
-  C[2] = A[2] * B[0] + A[6] * B[1] + A[10] * B[2] + A[14] * B[3];
-  C[3] = A[3] * B[0] + A[7] * B[1] + A[11] * B[2] + A[15] * B[3];
-  C[4] = A[0] * B[4] + A[4] * B[5] + A[8] * B[6] + A[12] * B[7];
-  C[5] = A[1] * B[4] + A[5] * B[5] + A[9] * B[6] + A[13] * B[7];
-  C[6] = A[2] * B[4] + A[6] * B[5] + A[10] * B[6] + A[14] * B[7];
-  C[7] = A[3] * B[4] + A[7] * B[5] + A[11] * B[6] + A[15] * B[7];
-  C[8] = A[0] * B[8] + A[4] * B[9] + A[8] * B[10] + A[12] * B[11];
-  C[9] = A[1] * B[8] + A[5] * B[9] + A[9] * B[10] + A[13] * B[11];
-  C[10] = A[2] * B[8] + A[6] * B[9] + A[10] * B[10] + A[14] * B[11];
-  C[11] = A[3] * B[8] + A[7] * B[9] + A[11] * B[10] + A[15] * B[11];
-  C[12] = A[0] * B[12] + A[4] * B[13] + A[8] * B[14] + A[12] * B[15];
-  C[13] = A[1] * B[12] + A[5] * B[13] + A[9] * B[14] + A[13] * B[15];
-  C[14] = A[2] * B[12] + A[6] * B[13] + A[10] * B[14] + A[14] * B[15];
-  C[15] = A[3] * B[12] + A[7] * B[13] + A[11] * B[14] + A[15] * B[15];
+  sfloat out[16];
+  out[0] = A[0] * B[0] + A[4] * B[1] + A[8] * B[2] + A[12] * B[3];
+  out[1] = A[1] * B[0] + A[5] * B[1] + A[9] * B[2] + A[13] * B[3];
+  out[2] = A[2] * B[0] + A[6] * B[1] + A[10] * B[2] + A[14] * B[3];
+  out[3] = A[3] * B[0] + A[7] * B[1] + A[11] * B[2] + A[15] * B[3];
+  out[4] = A[0] * B[4] + A[4] * B[5] + A[8] * B[6] + A[12] * B[7];
+  out[5] = A[1] * B[4] + A[5] * B[5] + A[9] * B[6] + A[13] * B[7];
+  out[6] = A[2] * B[4] + A[6] * B[5] + A[10] * B[6] + A[14] * B[7];
+  out[7] = A[3] * B[4] + A[7] * B[5] + A[11] * B[6] + A[15] * B[7];
+  out[8] = A[0] * B[8] + A[4] * B[9] + A[8] * B[10] + A[12] * B[11];
+  out[9] = A[1] * B[8] + A[5] * B[9] + A[9] * B[10] + A[13] * B[11];
+  out[10] = A[2] * B[8] + A[6] * B[9] + A[10] * B[10] + A[14] * B[11];
+  out[11] = A[3] * B[8] + A[7] * B[9] + A[11] * B[10] + A[15] * B[11];
+  out[12] = A[0] * B[12] + A[4] * B[13] + A[8] * B[14] + A[12] * B[15];
+  out[13] = A[1] * B[12] + A[5] * B[13] + A[9] * B[14] + A[13] * B[15];
+  out[14] = A[2] * B[12] + A[6] * B[13] + A[10] * B[14] + A[14] * B[15];
+  out[15] = A[3] * B[12] + A[7] * B[13] + A[11] * B[14] + A[15] * B[15];
+  for (int i = 0; i < 16; ++i) {
+    C[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_MatMul44,
+              (sfloat C[16], const sfloat A[16], const sfloat B[16]), (C, A, B))
 
-void star_VecMul44(sfloat y[4], const sfloat A[16], const sfloat x[4]) {
+STAR_KERNEL void star_VecMul44(sfloat y[4], const sfloat A[16], const sfloat x[4]) {
   // Extract out x so that x and y can be aliased
   sfloat x0 = x[0];
   sfloat x1 = x[1];
@@ -163,7 +174,8 @@ void star_VecMul44(sfloat y[4], const sfloat A[16], const sfloat x[4]) {
   y[2] = A[2] * x0 + A[6] * x1 + A[10] * x2 + A[14] * x3;
   y[3] = A[3] * x0 + A[7] * x1 + A[11] * x2 + A[15] * x3;
 }
-void star_TransposedMatMul44(sfloat C[16], const sfloat At[16], const sfloat B[16]) {
+STAR_KERNEL void star_TransposedMatMul44(sfloat C[16], const sfloat At[16],
+                                         const sfloat B[16]) {
   // C = A^T * B, where A, B, and C are 4x4 matrices stored column-major
   C[0] = At[0] * B[0] + At[1] * B[1] + At[2] * B[2] + At[3] * B[3];
   C[1] = At[4] * B[0] + At[5] * B[1] + At[6] * B[2] + At[7] * B[3];
@@ -186,7 +198,8 @@ void star_TransposedMatMul44(sfloat C[16], const sfloat At[16], const sfloat B[1
   C[15] = At[12] * B[12] + At[13] * B[13] + At[14] * B[14] + At[15] * B[15];
 }
 
-void star_MatMulTransposed44(sfloat C[16], const sfloat A[16], const sfloat Bt[16]) {
+STAR_KERNEL void star_MatMulTransposed44(sfloat C[16], const sfloat A[16],
+                                         const sfloat Bt[16]) {
   // C = A * B^T, where A, B, and C are 4x4 matrices stored column-major
   C[0] = A[0] * Bt[0] + A[4] * Bt[4] + A[8] * Bt[8] + A[12] * Bt[12];
   C[1] = A[1] * Bt[0] + A[5] * Bt[4] + A[9] * Bt[8] + A[13] * Bt[12];
@@ -209,7 +222,8 @@ void star_MatMulTransposed44(sfloat C[16], const sfloat A[16], const sfloat Bt[1
   C[15] = A[3] * Bt[3] + A[7] * Bt[7] + A[11] * Bt[11] + A[15] * Bt[15];
 }
 
-void star_TransposedVecMul44(sfloat y[4], const sfloat At[16], const sfloat x[4]) {
+STAR_KERNEL void star_TransposedVecMul44(sfloat y[4], const sfloat At[16],
+                                         const sfloat x[4]) {
   // Extract out x so that x and y can be aliased
   sfloat x0 = x[0];
   sfloat x1 = x[1];
@@ -223,7 +237,7 @@ void star_TransposedVecMul44(sfloat y[4], const sfloat At[16], const sfloat x[4]
   y[3] = At[12] * x0 + At[13] * x1 + At[14] * x2 + At[15] * x3;
 }
 
-void star_Add44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
+STAR_KERNEL void star_Add44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[0] = A[0] + B[0];
   C[1] = A[1] + B[1];
   C[2] = A[2] + B[2];
@@ -242,7 +256,7 @@ void star_Add44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[15] = A[15] + B[15];
 }
 
-void star_Sub44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
+STAR_KERNEL void star_Sub44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[0] = A[0] - B[0];
   C[1] = A[1] - B[1];
   C[2] = A[2] - B[2];
@@ -261,7 +275,7 @@ void star_Sub44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[15] = A[15] - B[15];
 }
 
-void star_Mul44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
+STAR_KERNEL void star_Mul44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[0] = A[0] * B[0];
   C[1] = A[1] * B[1];
   C[2] = A[2] * B[2];
@@ -280,7 +294,7 @@ void star_Mul44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[15] = A[15] * B[15];
 }
 
-void star_Div44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
+STAR_KERNEL void star_Div44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[0] = A[0] / B[0];
   C[1] = A[1] / B[1];
   C[2] = A[2] / B[2];
@@ -299,7 +313,7 @@ void star_Div44(sfloat C[16], const sfloat A[16], const sfloat B[16]) {
   C[15] = A[15] / B[15];
 }
 
-void star_AddConst44(sfloat C[16], const sfloat A[16], sfloat b) {
+STAR_KERNEL void star_AddConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[0] = A[0] + b;
   C[1] = A[1] + b;
   C[2] = A[2] + b;
@@ -318,7 +332,7 @@ void star_AddConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[15] = A[15] + b;
 }
 
-void star_SubConst44(sfloat C[16], const sfloat A[16], sfloat b) {
+STAR_KERNEL void star_SubConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[0] = A[0] - b;
   C[1] = A[1] - b;
   C[2] = A[2] - b;
@@ -337,7 +351,7 @@ void star_SubConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[15] = A[15] - b;
 }
 
-void star_MulConst44(sfloat C[16], const sfloat A[16], sfloat b) {
+STAR_KERNEL void star_MulConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[0] = A[0] * b;
   C[1] = A[1] * b;
   C[2] = A[2] * b;
@@ -356,7 +370,7 @@ void star_MulConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[15] = A[15] * b;
 }
 
-void star_DivConst44(sfloat C[16], const sfloat A[16], sfloat b) {
+STAR_KERNEL void star_DivConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[0] = A[0] / b;
   C[1] = A[1] / b;
   C[2] = A[2] / b;
@@ -374,3 +388,103 @@ void star_DivConst44(sfloat C[16], const sfloat A[16], sfloat b) {
   C[14] = A[14] / b;
   C[15] = A[15] / b;
 }
+
+/*---------------------------------*/
+/* Linear Algebra                  */
+/*---------------------------------*/
+
+// Maximum number of cyclic Jacobi sweeps used by star_Eigen44
+#define STAR_EIGEN44_SWEEPS 10
+
+/*
+ * Jacobi rotation J in the (p, q) plane that zeros A(p, q), applied as A = J^T A J and
+ * accumulated into V = V J. Returns false if A(p, q) is already negligible next to the
+ * diagonal, in which case it is set to zero.
+ */
+static inline bool star_JacobiRotate44(sfloat A[16], sfloat V[16], int p, int q) {
+  const sfloat apq = A[IDX(p, q)];
+  const sfloat app = A[IDX(p, p)];
+  const sfloat aqq = A[IDX(q, q)];
+  const sfloat g = 100 * fabs(apq);
+  if (fabs(app) + g == fabs(app) && fabs(aqq) + g == fabs(aqq)) {
+    A[IDX(p, q)] = 0;
+    A[IDX(q, p)] = 0;
+    return false;
+  }
+  const sfloat theta = (aqq - app) / (2 * apq);
+  const sfloat t = copysign(1, theta) / (fabs(theta) + sqrt(1 + theta * theta));
+  const sfloat c = 1 / sqrt(1 + t * t);
+  const sfloat s = c * t;
+  for (int k = 0; k < 4; ++k) {
+    const sfloat akp = A[IDX(k, p)];
+    const sfloat akq = A[IDX(k, q)];
+    A[IDX(k, p)] = c * akp - s * akq;
+    A[IDX(k, q)] = s * akp + c * akq;
+  }
+  for (int k = 0; k < 4; ++k) {
+    const sfloat apk = A[IDX(p, k)];
+    const sfloat aqk = A[IDX(q, k)];
+    A[IDX(p, k)] = c * apk - s * aqk;
+    A[IDX(q, k)] = s * apk + c * aqk;
+    const sfloat vkp = V[IDX(k, p)];
+    const sfloat vkq = V[IDX(k, q)];
+    V[IDX(k, p)] = c * vkp - s * vkq;
+    V[IDX(k, q)] = s * vkp + c * vkq;
+  }
+  A[IDX(p, q)] = 0;
+  A[IDX(q, p)] = 0;
+  return true;
+}
+
+// Swap eigenvalues i and j, along with their eigenvectors
+static inline void star_EigenSwap44(sfloat lambda[4], sfloat V[16], int i, int j) {
+  sfloat tmp = lambda[i];
+  lambda[i] = lambda[j];
+  lambda[j] = tmp;
+  for (int k = 0; k < 4; ++k) {
+    tmp = V[IDX(k, i)];
+    V[IDX(k, i)] = V[IDX(k, j)];
+    V[IDX(k, j)] = tmp;
+  }
+}
+
+// The basic-block (SLP) vectorizer of GCC 12 miscompiles this kernel for AVX-512, which
+// returns wrong eigenpairs. Rewriting the loops only moves the bug around.
+#if defined(__GNUC__) && !defined(__clang__)
+__attribute__((optimize("no-tree-slp-vectorize")))
+#endif
+STAR_KERNEL void star_Eigen44(sfloat eigenvalues[4], sfloat eigenvectors[16],
+                              const sfloat mat[16]) {
+  sfloat A[16];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      A[IDX(i, j)] = mat[IDX(i, j)];
+      A[IDX(j, i)] = mat[IDX(i, j)];
+    }
+  }
+  star_SetIdentity44(eigenvectors, 1);
+  for (int sweep = 0; sweep < STAR_EIGEN44_SWEEPS; ++sweep) {
+    bool rotated = false;
+    for (int p = 0; p < 3; ++p) {
+      for (int q = p + 1; q < 4; ++q) {
+        rotated |= star_JacobiRotate44(A, eigenvectors, p, q);
+      }
+    }
+    if (!rotated) {
+      break;
+    }
+  }
+
+  // Sort in ascending order with a sorting network
+  for (int k = 0; k < 4; ++k) {
+    eigenvalues[k] = A[IDX(k, k)];
+  }
+  if (eigenvalues[0] > eigenvalues[1]) star_EigenSwap44(eigenvalues, eigenvectors, 0, 1);
+  if (eigenvalues[2] > eigenvalues[3]) star_EigenSwap44(eigenvalues, eigenvectors, 2, 3);
+  if (eigenvalues[0] > eigenvalues[2]) star_EigenSwap44(eigenvalues, eigenvectors, 0, 2);
+  if (eigenvalues[1] > eigenvalues[3]) star_EigenSwap44(eigenvalues, eigenvectors, 1, 3);
+  if (eigenvalues[1] > eigenvalues[2]) star_EigenSwap44(eigenvalues, eigenvectors, 1, 2);
+}
+
+#undef STAR_EIGEN44_SWEEPS
+#undef IDX
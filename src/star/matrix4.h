@@ -11,35 +11,57 @@
 /* Setters                         */
 /*---------------------------------*/
 
-void star_SetZero44(sfloat mat[16]);
-void star_SetConst44(sfloat mat[16], sfloat value);
-void star_SetIdentity44(sfloat mat[16], sfloat val);
-void star_SetDiagonal44(sfloat mat[16], const sfloat diag[4]);
-void star_Copy44(sfloat dst[16], const sfloat src[16]);
-void star_Transpose44(sfloat dst[16], const sfloat src[16]);
-void star_TransposeInPlace44(sfloat mat[16]);
+STAR_KERNEL void star_SetZero44(sfloat mat[16]);
+STAR_KERNEL void star_SetConst44(sfloat mat[16], sfloat value);
+STAR_KERNEL void star_SetIdentity44(sfloat mat[16], sfloat val);
+STAR_KERNEL void star_SetDiagonal44(sfloat mat[16], const sfloat diag[4]);
+STAR_KERNEL void star_Copy44(sfloat dst[16], const sfloat src[16]);
+STAR_KERNEL void star_Transpose44(sfloat dst[16], const sfloat src[16]);
+STAR_KERNEL void star_TransposeInPlace44(sfloat mat[16]);
 
 /*---------------------------------*/
 /* Multiplication                  */
 /*---------------------------------*/
 
-void star_MatMul44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
-void star_VecMul44(sfloat y[4], const sfloat A[16], const sfloat x[4]);
+STAR_KERNEL void star_MatMul44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
+STAR_KERNEL void star_VecMul44(sfloat y[4], const sfloat A[16], const sfloat x[4]);
 
-void star_TransposedMatMul44(sfloat C[16], const sfloat At[16], const sfloat B[16]);
-void star_MatMulTransposed44(sfloat C[16], const sfloat A[16], const sfloat Bt[16]);
-void star_TransposedVecMul44(sfloat y[4], const sfloat At[16], const sfloat x[4]);
+STAR_KERNEL void star_TransposedMatMul44(sfloat C[16], const sfloat At[16],
+                                         const sfloat B[16]);
+STAR_KERNEL void star_MatMulTransposed44(sfloat C[16], const sfloat A[16],
+                                         const sfloat Bt[16]);
+STAR_KERNEL void star_TransposedVecMul44(sfloat y[4], const sfloat At[16],
+                                         const sfloat x[4]);
 
 /*---------------------------------*/
 /* Element-wise Operations         */
 /*---------------------------------*/
 
-void star_Add44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
-void star_Sub44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
-void star_Mul44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
-void star_Div44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
+STAR_KERNEL void star_Add44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
+STAR_KERNEL void star_Sub44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
+STAR_KERNEL void star_Mul44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
+STAR_KERNEL void star_Div44(sfloat C[16], const sfloat A[16], const sfloat B[16]);
 
-void star_AddConst44(sfloat C[16], const sfloat A[16], sfloat b);
-void star_SubConst44(sfloat C[16], const sfloat A[16], sfloat b);
-void star_MulConst44(sfloat C[16], const sfloat A[16], sfloat b);
-void star_DivConst44(sfloat C[16], const sfloat A[16], sfloat b);
+STAR_KERNEL void star_AddConst44(sfloat C[16], const sfloat A[16], sfloat b);
+STAR_KERNEL void star_SubConst44(sfloat C[16], const sfloat A[16], sfloat b);
+STAR_KERNEL void star_MulConst44(sfloat C[16], const sfloat A[16], sfloat b);
+STAR_KERNEL void star_DivConst44(sfloat C[16], const sfloat A[16], sfloat b);
+
+/*---------------------------------*/
+/* Linear Algebra                  */
+/*---------------------------------*/
+
+/*
+ * @brief Eigendecomposition of a symmetric matrix, A = V diag(eigenvalues) V^T
+ *
+ * Uses cyclic Jacobi rotations until the off-diagonal elements are negligible next to the
+ * diagonal, which takes 3 or 4 sweeps for most matrices. Eigenvalues are in ascending
+ * order and the eigenvectors are the orthonormal columns of V. Only the upper triangle of
+ * `mat` is read.
+ */
+STAR_KERNEL void star_Eigen44(sfloat eigenvalues[4], sfloat eigenvectors[16],
+                              const sfloat mat[16]);
+
+#ifdef STAR_HEADER_ONLY
+#include "matrix4.c"
+#endif
@@ -3,11 +3,12 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include "dispatch.h"
 #include "matrix43.h"
 
 #define IDX(i, j) ((i) + 4 * (j))
 
-void star_SetZero43(sfloat mat[12]) {
+STAR_KERNEL void star_SetZero43(sfloat mat[12]) {
   mat[0] = 0;
   mat[1] = 0;
   mat[2] = 0;
@@ -22,7 +23,7 @@ void star_SetZero43(sfloat mat[12]) {
   mat[11] = 0;
 }
 
-void star_SetConst43(sfloat mat[12], sfloat value) {
+STAR_KERNEL void star_SetConst43(sfloat mat[12], sfloat value) {
   mat[0] = value;
   mat[1] = value;
   mat[2] = value;
@@ -37,7 +38,7 @@ void star_SetConst43(sfloat mat[12], sfloat value) {
   mat[11] = value;
 }
 
-void star_Copy43(sfloat dst[12], const sfloat src[12]) {
+STAR_KERNEL void star_Copy43(sfloat dst[12], const sfloat src[12]) {
   dst[0] = src[0];
   dst[1] = src[1];
   dst[2] = src[2];
@@ -71,99 +72,188 @@ void star_Copy43(sfloat dst[12], const sfloat src[12]) {
 /* Multiplication                  */
 /*---------------------------------*/
 
-void star_MatMul433(sfloat C43[12], const sfloat A43[12], const sfloat B33[9]) {
+static inline void star_MatMul433_Generic(sfloat C43[12], const sfloat A43[12],
+                                          const sfloat B33[9]) {
   // Multiply a 4x3 matrix by a 3x3 matrix
-  C43[0] = A43[0] * B33[0] + A43[4] * B33[1] + A43[8] * B33[2];
-  C43[1] = A43[1] * B33[0] + A43[5] * B33[1] + A43[9] * B33[2];
-  C43[2] = A43[2] * B33[0] + A43[6] * B33[1] + A43[10] * B33[2];
-  C43[3] = A43[3] * B33[0] + A43[7] * B33[1] + A43[11] * B33[2];
-
-  C43[4] = A43[0] * B33[3] + A43[4] * B33[4] + A43[8] * B33[5];
-  C43[5] = A43[1] * B33[3] + A43[5] * B33[4] + A43[9] * B33[5];
-  C43[6] = A43[2] * B33[3] + A43[6] * B33[4] + A43[10] * B33[5];
-  C43[7] = A43[3] * B33[3] + A43[7] * B33[4] + A43[11] * B33[5];
-
-  C43[8] = A43[0] * B33[6] + A43[4] * B33[7] + A43[8] * B33[8];
-  C43[9] = A43[1] * B33[6] + A43[5] * B33[7] + A43[9] * B33[8];
-  C43[10] = A43[2] * B33[6] + A43[6] * B33[7] + A43[10] * B33[8];
-  C43[11] = A43[3] * B33[6] + A43[7] * B33[7] + A43[11] * B33[8];
+  sfloat out[12];
+  out[0] = A43[0] * B33[0] + A43[4] * B33[1] + A43[8] * B33[2];
+  out[1] = A43[1] * B33[0] + A43[5] * B33[1] + A43[9] * B33[2];
+  out[2] = A43[2] * B33[0] + A43[6] * B33[1] + A43[10] * B33[2];
+  out[3] = A43[3] * B33[0] + A43[7] * B33[1] + A43[11] * B33[2];
+
+  out[4] = A43[0] * B33[3] + A43[4] * B33[4] + A43[8] * B33[5];
+  out[5] = A43[1] * B33[3] + A43[5] * B33[4] + A43[9] * B33[5];
+  out[6] = A43[2] * B33[3] + A43[6] * B33[4] + A43[10] * B33[5];
+  out[7] = A43[3] * B33[3] + A43[7] * B33[4] + A43[11] * B33[5];
+
+  out[8] = A43[0] * B33[6] + A43[4] * B33[7] + A43[8] * B33[8];
+  out[9] = A43[1] * B33[6] + A43[5] * B33[7] + A43[9] * B33[8];
+  out[10] = A43[2] * B33[6] + A43[6] * B33[7] + A43[10] * B33[8];
+  out[11] = A43[3] * B33[6] + A43[7] * B33[7] + A43[11] * B33[8];
+  for (int i = 0; i < 12; ++i) {
+    C43[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_MatMul433,
+              (sfloat C43[12], const sfloat A43[12], const sfloat B33[9]), (C43, A43, B33))
+
+static inline void star_MatMulTransposed433_Generic(sfloat C43[12], const sfloat A43[12],
+                                                    const sfloat B33t[9]) {
+  sfloat out[12];
+  out[0] = A43[0] * B33t[0] + A43[4] * B33t[3] + A43[8] * B33t[6];
+  out[1] = A43[1] * B33t[0] + A43[5] * B33t[3] + A43[9] * B33t[6];
+  out[2] = A43[2] * B33t[0] + A43[6] * B33t[3] + A43[10] * B33t[6];
+  out[3] = A43[3] * B33t[0] + A43[7] * B33t[3] + A43[11] * B33t[6];
+
+  out[4] = A43[0] * B33t[1] + A43[4] * B33t[4] + A43[8] * B33t[7];
+  out[5] = A43[1] * B33t[1] + A43[5] * B33t[4] + A43[9] * B33t[7];
+  out[6] = A43[2] * B33t[1] + A43[6] * B33t[4] + A43[10] * B33t[7];
+  out[7] = A43[3] * B33t[1] + A43[7] * B33t[4] + A43[11] * B33t[7];
 
-void star_MatMulTransposed433(sfloat C43[12], const sfloat A43[12], const sfloat B33t[9]) {
-  C43[0] = A43[0] * B33t[0] + A43[4] * B33t[3] + A43[8] * B33t[6];
-  C43[1] = A43[1] * B33t[0] + A43[5] * B33t[3] + A43[9] * B33t[6];
-  C43[2] = A43[2] * B33t[0] + A43[6] * B33t[3] + A43[10] * B33t[6];
-  C43[3] = A43[3] * B33t[0] + A43[7] * B33t[3] + A43[11] * B33t[6];
-
-  C43[4] = A43[0] * B33t[1] + A43[4] * B33t[4] + A43[8] * B33t[7];
-  C43[5] = A43[1] * B33t[1] + A43[5] * B33t[4] + A43[9] * B33t[7];
-  C43[6] = A43[2] * B33t[1] + A43[6] * B33t[4] + A43[10] * B33t[7];
-  C43[7] = A43[3] * B33t[1] + A43[7] * B33t[4] + A43[11] * B33t[7];
-
-  C43[8] = A43[0] * B33t[2] + A43[4] * B33t[5] + A43[8] * B33t[8];
-  C43[9] = A43[1] * B33t[2] + A43[5] * B33t[5] + A43[9] * B33t[8];
-  C43[10] = A43[2] * B33t[2] + A43[6] * B33t[5] + A43[10] * B33t[8];
-  C43[11] = A43[3] * B33t[2] + A43[7] * B33t[5] + A43[11] * B33t[8];
+  out[8] = A43[0] * B33t[2] + A43[4] * B33t[5] + A43[8] * B33t[8];
+  out[9] = A43[1] * B33t[2] + A43[5] * B33t[5] + A43[9] * B33t[8];
+  out[10] = A43[2] * B33t[2] + A43[6] * B33t[5] + A43[10] * B33t[8];
+  out[11] = A43[3] * B33t[2] + A43[7] * B33t[5] + A43[11] * B33t[8];
+  for (int i = 0; i < 12; ++i) {
+    C43[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_MatMulTransposed433,
+              (sfloat C43[12], const sfloat A43[12], const sfloat B33t[9]),
+              (C43, A43, B33t))
 
-void star_MatMul443(sfloat C43[12], const sfloat A44[16], const sfloat B43[12]) {
+static inline void star_MatMul443_Generic(sfloat C43[12], const sfloat A44[16],
+                                          const sfloat B43[12]) {
   // Multiply a 4x4 matrix by a 4x3 matrix
-  C43[0] = A44[0] * B43[0] + A44[4] * B43[1] + A44[8] * B43[2] + A44[12] * B43[3];
-  C43[1] = A44[1] * B43[0] + A44[5] * B43[1] + A44[9] * B43[2] + A44[13] * B43[3];
-  C43[2] = A44[2] * B43[0] + A44[6] * B43[1] + A44[10] * B43[2] + A44[14] * B43[3];
-  C43[3] = A44[3] * B43[0] + A44[7] * B43[1] + A44[11] * B43[2] + A44[15] * B43[3];
-
-  C43[4] = A44[0] * B43[4] + A44[4] * B43[5] + A44[8] * B43[6] + A44[12] * B43[7];
-  C43[5] = A44[1] * B43[4] + A44[5] * B43[5] + A44[9] * B43[6] + A44[13] * B43[7];
-  C43[6] = A44[2] * B43[4] + A44[6] * B43[5] + A44[10] * B43[6] + A44[14] * B43[7];
-  C43[7] = A44[3] * B43[4] + A44[7] * B43[5] + A44[11] * B43[6] + A44[15] * B43[7];
-
-  C43[8] = A44[0] * B43[8] + A44[4] * B43[9] + A44[8] * B43[10] + A44[12] * B43[11];
-  C43[9] = A44[1] * B43[8] + A44[5] * B43[9] + A44[9] * B43[10] + A44[13] * B43[11];
-  C43[10] = A44[2] * B43[8] + A44[6] * B43[9] + A44[10] * B43[10] + A44[14] * B43[11];
-  C43[11] = A44[3] * B43[8] + A44[7] * B43[9] + A44[11] * B43[10] + A44[15] * B43[11];
+  sfloat out[12];
+  out[0] = A44[0] * B43[0] + A44[4] * B43[1] + A44[8] * B43[2] + A44[12] * B43[3];
+  out[1] = A44[1] * B43[0] + A44[5] * B43[1] + A44[9] * B43[2] + A44[13] * B43[3];
+  out[2] = A44[2] * B43[0] + A44[6] * B43[1] + A44[10] * B43[2] + A44[14] * B43[3];
+  out[3] = A44[3] * B43[0] + A44[7] * B43[1] + A44[11] * B43[2] + A44[15] * B43[3];
+
+  out[4] = A44[0] * B43[4] + A44[4] * B43[5] + A44[8] * B43[6] + A44[12] * B43[7];
+  out[5] = A44[1] * B43[4] + A44[5] * B43[5] + A44[9] * B43[6] + A44[13] * B43[7];
+  out[6] = A44[2] * B43[4] + A44[6] * B43[5] + A44[10] * B43[6] + A44[14] * B43[7];
+  out[7] = A44[3] * B43[4] + A44[7] * B43[5] + A44[11] * B43[6] + A44[15] * B43[7];
+
+  out[8] = A44[0] * B43[8] + A44[4] * B43[9] + A44[8] * B43[10] + A44[12] * B43[11];
+  out[9] = A44[1] * B43[8] + A44[5] * B43[9] + A44[9] * B43[10] + A44[13] * B43[11];
+  out[10] = A44[2] * B43[8] + A44[6] * B43[9] + A44[10] * B43[10] + A44[14] * B43[11];
+  out[11] = A44[3] * B43[8] + A44[7] * B43[9] + A44[11] * B43[10] + A44[15] * B43[11];
+  for (int i = 0; i < 12; ++i) {
+    C43[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_MatMul443,
+              (sfloat C43[12], const sfloat A44[16], const sfloat B43[12]), (C43, A44, B43))
+
+static inline void star_TransposedMatMul443_Generic(sfloat C43[12], const sfloat A44t[16],
+                                                    const sfloat B43[12]) {
+  sfloat out[12];
+  out[0] = A44t[0] * B43[0] + A44t[1] * B43[1] + A44t[2] * B43[2] + A44t[3] * B43[3];
+  out[1] = A44t[4] * B43[0] + A44t[5] * B43[1] + A44t[6] * B43[2] + A44t[7] * B43[3];
+  out[2] = A44t[8] * B43[0] + A44t[9] * B43[1] + A44t[10] * B43[2] + A44t[11] * B43[3];
+  out[3] = A44t[12] * B43[0] + A44t[13] * B43[1] + A44t[14] * B43[2] + A44t[15] * B43[3];
 
-void star_TransposedMatMul443(sfloat C43[12], const sfloat A44t[16], const sfloat B43[12]) {
-  C43[0] = A44t[0] * B43[0] + A44t[1] * B43[1] + A44t[2] * B43[2] + A44t[3] * B43[3];
-  C43[1] = A44t[4] * B43[0] + A44t[5] * B43[1] + A44t[6] * B43[2] + A44t[7] * B43[3];
-  C43[2] = A44t[8] * B43[0] + A44t[9] * B43[1] + A44t[10] * B43[2] + A44t[11] * B43[3];
-  C43[3] = A44t[12] * B43[0] + A44t[13] * B43[1] + A44t[14] * B43[2] + A44t[15] * B43[3];
-
-  C43[4] = A44t[0] * B43[4] + A44t[1] * B43[5] + A44t[2] * B43[6] + A44t[3] * B43[7];
-  C43[5] = A44t[4] * B43[4] + A44t[5] * B43[5] + A44t[6] * B43[6] + A44t[7] * B43[7];
-  C43[6] = A44t[8] * B43[4] + A44t[9] * B43[5] + A44t[10] * B43[6] + A44t[11] * B43[7];
-  C43[7] = A44t[12] * B43[4] + A44t[13] * B43[5] + A44t[14] * B43[6] + A44t[15] * B43[7];
-
-  C43[8] = A44t[0] * B43[8] + A44t[1] * B43[9] + A44t[2] * B43[10] + A44t[3] * B43[11];
-  C43[9] = A44t[4] * B43[8] + A44t[5] * B43[9] + A44t[6] * B43[10] + A44t[7] * B43[11];
-  C43[10] = A44t[8] * B43[8] + A44t[9] * B43[9] + A44t[10] * B43[10] + A44t[11] * B43[11];
-  C43[11] = A44t[12] * B43[8] + A44t[13] * B43[9] + A44t[14] * B43[10] + A44t[15] * B43[11];
+  out[4] = A44t[0] * B43[4] + A44t[1] * B43[5] + A44t[2] * B43[6] + A44t[3] * B43[7];
+  out[5] = A44t[4] * B43[4] + A44t[5] * B43[5] + A44t[6] * B43[6] + A44t[7] * B43[7];
+  out[6] = A44t[8] * B43[4] + A44t[9] * B43[5] + A44t[10] * B43[6] + A44t[11] * B43[7];
+  out[7] = A44t[12] * B43[4] + A44t[13] * B43[5] + A44t[14] * B43[6] + A44t[15] * B43[7];
+
+  out[8] = A44t[0] * B43[8] + A44t[1] * B43[9] + A44t[2] * B43[10] + A44t[3] * B43[11];
+  out[9] = A44t[4] * B43[8] + A44t[5] * B43[9] + A44t[6] * B43[10] + A44t[7] * B43[11];
+  out[10] = A44t[8] * B43[8] + A44t[9] * B43[9] + A44t[10] * B43[10] + A44t[11] * B43[11];
+  out[11] = A44t[12] * B43[8] + A44t[13] * B43[9] + A44t[14] * B43[10] + A44t[15] * B43[11];
+  for (int i = 0; i < 12; ++i) {
+    C43[i] = out[i];
+  }
+}
+STAR_DISPATCH(star_TransposedMatMul443,
+              (sfloat C43[12], const sfloat A44t[16], const sfloat B43[12]),
+              (C43, A44t, B43))
+
+STAR_KERNEL void star_MatMul344(sfloat C34[12], const sfloat A34[12],
+                                const sfloat B44[16]) {
+  sfloat out[12];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      out[i + 3 * j] = A34[i] * B44[4 * j] + A34[i + 3] * B44[4 * j + 1] +
+                       A34[i + 6] * B44[4 * j + 2] + A34[i + 9] * B44[4 * j + 3];
+    }
+  }
+  for (int i = 0; i < 12; ++i) {
+    C34[i] = out[i];
+  }
 }
 
-void star_MatMul344(sfloat C34[12], const sfloat A34[12], const sfloat B44[16]) {
-  (void)C34;
-  (void)A34;
-  (void)B44;
+STAR_KERNEL void star_MatMulTransposed344(sfloat C34[12], const sfloat A34[12],
+                                          const sfloat B44t[16]) {
+  sfloat out[12];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      out[i + 3 * j] = A34[i] * B44t[j] + A34[i + 3] * B44t[j + 4] +
+                       A34[i + 6] * B44t[j + 8] + A34[i + 9] * B44t[j + 12];
+    }
+  }
+  for (int i = 0; i < 12; ++i) {
+    C34[i] = out[i];
+  }
 }
 
-void star_MatMulTransposed344(sfloat C34[12], const sfloat A34[12], const sfloat B44t[16]) {
-  (void)C34;
-  (void)A34;
-  (void)B44t;
+STAR_KERNEL void star_MatMul334(sfloat C34[12], const sfloat A33[9], const sfloat B34[12]) {
+  sfloat out[12];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      out[i + 3 * j] =
+          A33[i] * B34[3 * j] + A33[i + 3] * B34[3 * j + 1] + A33[i + 6] * B34[3 * j + 2];
+    }
+  }
+  for (int i = 0; i < 12; ++i) {
+    C34[i] = out[i];
+  }
 }
 
-void star_VecMul43(sfloat y[4], const sfloat A[12], const sfloat x[3]) {
+STAR_KERNEL void star_TransposedMatMul334(sfloat C34[12], const sfloat A33t[9],
+                                          const sfloat B34[12]) {
+  sfloat out[12];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      out[i + 3 * j] = A33t[3 * i] * B34[3 * j] + A33t[3 * i + 1] * B34[3 * j + 1] +
+                       A33t[3 * i + 2] * B34[3 * j + 2];
+    }
+  }
+  for (int i = 0; i < 12; ++i) {
+    C34[i] = out[i];
+  }
+}
+
+static inline void star_VecMul43_Generic(sfloat y[4], const sfloat A[12],
+                                         const sfloat x[3]) {
   // Multiply a 4x3 matrix by a 3-vector
-  y[0] = A[0] * x[0] + A[4] * x[1] + A[8] * x[2];
-  y[1] = A[1] * x[0] + A[5] * x[1] + A[9] * x[2];
-  y[2] = A[2] * x[0] + A[6] * x[1] + A[10] * x[2];
-  y[3] = A[3] * x[0] + A[7] * x[1] + A[11] * x[2];
+  sfloat out[4];
+  out[0] = A[0] * x[0] + A[4] * x[1] + A[8] * x[2];
+  out[1] = A[1] * x[0] + A[5] * x[1] + A[9] * x[2];
+  out[2] = A[2] * x[0] + A[6] * x[1] + A[10] * x[2];
+  out[3] = A[3] * x[0] + A[7] * x[1] + A[11] * x[2];
+  for (int i = 0; i < 4; ++i) {
+    y[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_VecMul43,
+              (sfloat y[4], const sfloat A[12], const sfloat x[3]), (y, A, x))
 
-void star_TransposedVecMul43(sfloat y[3], const sfloat At[12], const sfloat x[4]) {
+static inline void star_TransposedVecMul43_Generic(sfloat y[3], const sfloat At[12],
+                                                   const sfloat x[4]) {
   // Multiply a 3x4 matrix by a 4-vector
-  y[0] = At[0] * x[0] + At[1] * x[1] + At[2] * x[2] + At[3] * x[3];
-  y[1] = At[4] * x[0] + At[5] * x[1] + At[6] * x[2] + At[7] * x[3];
-  y[2] = At[8] * x[0] + At[9] * x[1] + At[10] * x[2] + At[11] * x[3];
+  sfloat out[3];
+  out[0] = At[0] * x[0] + At[1] * x[1] + At[2] * x[2] + At[3] * x[3];
+  out[1] = At[4] * x[0] + At[5] * x[1] + At[6] * x[2] + At[7] * x[3];
+  out[2] = At[8] * x[0] + At[9] * x[1] + At[10] * x[2] + At[11] * x[3];
+  for (int i = 0; i < 3; ++i) {
+    y[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_TransposedVecMul43,
+              (sfloat y[3], const sfloat At[12], const sfloat x[4]), (y, At, x))
+
+#undef IDX
@@ -0,0 +1,864 @@
+//
+// Created by Brian Jackson on 5/16/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+#include "star/fastmath.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * Kernels for fixed-size matrices of any shape, the templated counterparts of the
+ * hand-written kernels in matrix3.h, matrix4.h and matrix43.h.
+ *
+ * All matrices are stored in column-major order. Every loop bound is a template parameter,
+ * so the compiler fully unrolls the loops for small shapes. The innermost loops of the
+ * multiplies run down contiguous columns, which lets them vectorize for larger shapes.
+ * Like the C kernels, the outputs may alias the inputs.
+ *
+ * The scalar type T is deduced from the arguments. Besides sfloat it may be any type with
+ * the arithmetic operators and comparisons, e.g. the dual numbers in Dual.hpp.
+ */
+
+/*
+ * @brief C = A B for an M x K matrix A and a K x N matrix B
+ */
+template <int M, int K, int N, class T>
+inline void MatMul(T* C, const T* A, const T* B) {
+  T out[M * N] = {};
+  for (int j = 0; j < N; ++j) {
+    for (int k = 0; k < K; ++k) {
+      const T b = B[k + K * j];
+      for (int i = 0; i < M; ++i) {
+        out[i + M * j] += A[i + M * k] * b;
+      }
+    }
+  }
+  for (int i = 0; i < M * N; ++i) {
+    C[i] = out[i];
+  }
+}
+
+/*
+ * @brief C = A^T B for a K x M matrix A and a K x N matrix B
+ */
+template <int M, int K, int N, class T>
+inline void TransposedMatMul(T* C, const T* A, const T* B) {
+  T out[M * N];
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < M; ++i) {
+      T c = 0;
+      for (int k = 0; k < K; ++k) {
+        c += A[k + K * i] * B[k + K * j];
+      }
+      out[i + M * j] = c;
+    }
+  }
+  for (int i = 0; i < M * N; ++i) {
+    C[i] = out[i];
+  }
+}
+
+/*
+ * @brief C = A B^T for an M x K matrix A and an N x K matrix B
+ */
+template <int M, int K, int N, class T>
+inline void MatMulTransposed(T* C, const T* A, const T* B) {
+  T out[M * N] = {};
+  for (int j = 0; j < N; ++j) {
+    for (int k = 0; k < K; ++k) {
+      const T b = B[j + N * k];
+      for (int i = 0; i < M; ++i) {
+        out[i + M * j] += A[i + M * k] * b;
+      }
+    }
+  }
+  for (int i = 0; i < M * N; ++i) {
+    C[i] = out[i];
+  }
+}
+
+/*
+ * @brief C = A^T B^T for a K x M matrix A and an N x K matrix B
+ */
+template <int M, int K, int N, class T>
+inline void TransposedMatMulTransposed(T* C, const T* A, const T* B) {
+  T out[M * N] = {};
+  for (int k = 0; k < K; ++k) {
+    for (int j = 0; j < N; ++j) {
+      const T b = B[j + N * k];
+      for (int i = 0; i < M; ++i) {
+        out[i + M * j] += A[k + K * i] * b;
+      }
+    }
+  }
+  for (int i = 0; i < M * N; ++i) {
+    C[i] = out[i];
+  }
+}
+
+/*
+ * @brief Upper Cholesky factor U of an N x N symmetric positive definite matrix, A = U^T U
+ *
+ * Only the upper triangle of A is read. Returns false if A is not positive definite, in
+ * which case U is not valid.
+ */
+template <int N, class T>
+inline bool CholFactor(T* U, const T* A) {
+  using std::sqrt;
+  T out[N * N] = {};
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < j; ++i) {
+      T s = A[i + N * j];
+      for (int k = 0; k < i; ++k) {
+        s -= out[k + N * i] * out[k + N * j];
+      }
+      out[i + N * j] = s / out[i + N * i];
+    }
+    T d = A[j + N * j];
+    for (int k = 0; k < j; ++k) {
+      d -= out[k + N * j] * out[k + N * j];
+    }
+    if (!(d > 0)) {
+      return false;
+    }
+    out[j + N * j] = sqrt(d);
+  }
+  for (int i = 0; i < N * N; ++i) {
+    U[i] = out[i];
+  }
+  return true;
+}
+
+/*
+ * @brief Solve A X = B for an N x N symmetric positive definite A and an N x C matrix B
+ *
+ * Returns false if A is not positive definite.
+ */
+template <int N, int C, class T>
+inline bool CholSolve(T* X, const T* A, const T* B) {
+  T U[N * N];
+  if (!CholFactor<N>(U, A)) {
+    return false;
+  }
+  for (int j = 0; j < C; ++j) {
+    T x[N];
+    // Forward substitution with U^T, then back substitution with U
+    for (int i = 0; i < N; ++i) {
+      T s = B[i + N * j];
+      for (int k = 0; k < i; ++k) {
+        s -= U[k + N * i] * x[k];
+      }
+      x[i] = s / U[i + N * i];
+    }
+    for (int i = N - 1; i >= 0; --i) {
+      T s = x[i];
+      for (int k = i + 1; k < N; ++k) {
+        s -= U[i + N * k] * x[k];
+      }
+      x[i] = s / U[i + N * i];
+    }
+    for (int i = 0; i < N; ++i) {
+      X[i + N * j] = x[i];
+    }
+  }
+  return true;
+}
+
+/*
+ * @brief Solve A X = B for an N x N matrix A and an N x C matrix B
+ *
+ * Uses Gaussian elimination with partial pivoting. Returns false if A is singular. If
+ * TransposeA is true, solves A^T X = B instead, transposing A while it is copied into the
+ * factorization.
+ */
+template <int N, int C, bool TransposeA = false, class T>
+inline bool LUSolve(T* X, const T* A, const T* B) {
+  using std::abs;
+  T LU[N * N];
+  T Y[N * C];
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < N; ++i) {
+      LU[i + N * j] = TransposeA ? A[j + N * i] : A[i + N * j];
+    }
+  }
+  for (int i = 0; i < N * C; ++i) {
+    Y[i] = B[i];
+  }
+  for (int k = 0; k < N; ++k) {
+    int p = k;
+    for (int i = k + 1; i < N; ++i) {
+      if (abs(LU[i + N * k]) > abs(LU[p + N * k])) {
+        p = i;
+      }
+    }
+    if (LU[p + N * k] == 0) {
+      return false;
+    }
+    if (p != k) {
+      for (int j = 0; j < N; ++j) {
+        T t = LU[k + N * j];
+        LU[k + N * j] = LU[p + N * j];
+        LU[p + N * j] = t;
+      }
+      for (int j = 0; j < C; ++j) {
+        T t = Y[k + N * j];
+        Y[k + N * j] = Y[p + N * j];
+        Y[p + N * j] = t;
+      }
+    }
+    // Eliminate below the pivot, column by column
+    const T inv_pivot = 1 / LU[k + N * k];
+    for (int i = k + 1; i < N; ++i) {
+      LU[i + N * k] *= inv_pivot;
+    }
+    for (int j = k + 1; j < N; ++j) {
+      const T u = LU[k + N * j];
+      for (int i = k + 1; i < N; ++i) {
+        LU[i + N * j] -= LU[i + N * k] * u;
+      }
+    }
+    for (int j = 0; j < C; ++j) {
+      const T y = Y[k + N * j];
+      for (int i = k + 1; i < N; ++i) {
+        Y[i + N * j] -= LU[i + N * k] * y;
+      }
+    }
+  }
+  for (int j = 0; j < C; ++j) {
+    for (int i = N - 1; i >= 0; --i) {
+      T s = Y[i + N * j];
+      for (int k = i + 1; k < N; ++k) {
+        s -= LU[i + N * k] * Y[k + N * j];
+      }
+      Y[i + N * j] = s / LU[i + N * i];
+    }
+  }
+  for (int i = 0; i < N * C; ++i) {
+    X[i] = Y[i];
+  }
+  return true;
+}
+
+/*-------------------------------------
+ * 3x3 and 4x4 Kernels
+ *-----------------------------------*/
+/*
+ * Templated counterparts of the decompositions, solves and inverses in matrix3.h and
+ * matrix4.h, with the same algorithms and conventions. Matrix<3, 3, T> and Matrix<4, 4, T>
+ * call them for every scalar type.
+ */
+template <class T>
+inline T Dot3(const T x[3], const T y[3]) {
+  return x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
+}
+
+template <class T>
+inline void Cross3(T out[3], const T x[3], const T y[3]) {
+  const T c0 = x[1] * y[2] - x[2] * y[1];
+  const T c1 = x[2] * y[0] - x[0] * y[2];
+  const T c2 = x[0] * y[1] - x[1] * y[0];
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+}
+
+template <class T>
+inline T Det33(const T mat[9]) {
+  return mat[0] * mat[4] * mat[8] + mat[3] * mat[7] * mat[2] + mat[6] * mat[1] * mat[5] -
+         mat[6] * mat[4] * mat[2] - mat[0] * mat[7] * mat[5] - mat[3] * mat[1] * mat[8];
+}
+
+template <class T>
+inline bool Chol33(T U[9], const T mat[9]) {
+  using std::sqrt;
+  const T a00 = mat[0];
+  const T a01 = mat[3];
+  const T a02 = mat[6];
+  const T a11 = mat[4];
+  const T a12 = mat[7];
+  const T a22 = mat[8];
+
+  const T u00 = sqrt(a00);
+  const T u01 = a01 / u00;
+  const T u02 = a02 / u00;
+  const T d1 = a11 - u01 * u01;
+  const T u11 = sqrt(d1);
+  const T u12 = (a12 - u01 * u02) / u11;
+  const T d2 = a22 - u02 * u02 - u12 * u12;
+  const T u22 = sqrt(d2);
+
+  U[0] = u00;
+  U[1] = 0;
+  U[2] = 0;
+  U[3] = u01;
+  U[4] = u11;
+  U[5] = 0;
+  U[6] = u02;
+  U[7] = u12;
+  U[8] = u22;
+  return a00 > 0 && d1 > 0 && d2 > 0;
+}
+
+template <class T>
+inline void QR33(T Q[9], T R[9], const T A[9]) {
+  using std::sqrt;
+  T v1[3] = {A[3], A[4], A[5]};
+  T v2[3] = {A[6], A[7], A[8]};
+  T* q0 = Q;
+  T* q1 = Q + 3;
+  T* q2 = Q + 6;
+
+  const T r00 = sqrt(Dot3(A, A));
+  for (int i = 0; i < 3; ++i) {
+    q0[i] = A[i] / r00;
+  }
+
+  const T r01 = Dot3(q0, v1);
+  const T r02 = Dot3(q0, v2);
+  for (int i = 0; i < 3; ++i) {
+    v1[i] -= r01 * q0[i];
+    v2[i] -= r02 * q0[i];
+  }
+  const T r11 = sqrt(Dot3(v1, v1));
+  for (int i = 0; i < 3; ++i) {
+    q1[i] = v1[i] / r11;
+  }
+
+  const T r12 = Dot3(q1, v2);
+  for (int i = 0; i < 3; ++i) {
+    v2[i] -= r12 * q1[i];
+  }
+  const T r22 = sqrt(Dot3(v2, v2));
+  for (int i = 0; i < 3; ++i) {
+    q2[i] = v2[i] / r22;
+  }
+
+  R[0] = r00;
+  R[1] = 0;
+  R[2] = 0;
+  R[3] = r01;
+  R[4] = r11;
+  R[5] = 0;
+  R[6] = r02;
+  R[7] = r12;
+  R[8] = r22;
+}
+
+template <class T>
+inline void LU33(T L[9], T U[9], int perm[3], const T A[9]) {
+  using std::abs;
+  T B[9];
+  for (int k = 0; k < 9; ++k) {
+    B[k] = A[k];
+    L[k] = k % 4 == 0;
+  }
+  perm[0] = 0;
+  perm[1] = 1;
+  perm[2] = 2;
+
+  for (int k = 0; k < 2; ++k) {
+    // Swap the row with the largest pivot into place
+    int p = k;
+    for (int i = k + 1; i < 3; ++i) {
+      if (abs(B[i + 3 * k]) > abs(B[p + 3 * k])) {
+        p = i;
+      }
+    }
+    if (p != k) {
+      for (int j = 0; j < 3; ++j) {
+        const T tmp = B[k + 3 * j];
+        B[k + 3 * j] = B[p + 3 * j];
+        B[p + 3 * j] = tmp;
+      }
+      for (int j = 0; j < k; ++j) {
+        const T tmp = L[k + 3 * j];
+        L[k + 3 * j] = L[p + 3 * j];
+        L[p + 3 * j] = tmp;
+      }
+      const int tmp = perm[k];
+      perm[k] = perm[p];
+      perm[p] = tmp;
+    }
+
+    // Eliminate the entries below the pivot
+    for (int i = k + 1; i < 3; ++i) {
+      const T l = B[i + 3 * k] / B[k + 3 * k];
+      L[i + 3 * k] = l;
+      for (int j = k; j < 3; ++j) {
+        B[i + 3 * j] -= l * B[k + 3 * j];
+      }
+    }
+  }
+
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      U[i + 3 * j] = i <= j ? B[i + 3 * j] : T(0);
+    }
+  }
+}
+
+// Orthonormal vectors u and v such that (w, u, v) is a right-handed basis, for a unit w
+template <class T>
+inline void OrthogonalComplement3(T u[3], T v[3], const T w[3]) {
+  using std::abs;
+  using std::sqrt;
+  if (abs(w[0]) > abs(w[1])) {
+    const T inv_norm = 1 / sqrt(w[0] * w[0] + w[2] * w[2]);
+    u[0] = -w[2] * inv_norm;
+    u[1] = 0;
+    u[2] = w[0] * inv_norm;
+  } else {
+    const T inv_norm = 1 / sqrt(w[1] * w[1] + w[2] * w[2]);
+    u[0] = 0;
+    u[1] = w[2] * inv_norm;
+    u[2] = -w[1] * inv_norm;
+  }
+  Cross3(v, w, u);
+}
+
+// Unit eigenvector of the symmetric matrix A for an eigenvalue of multiplicity one, the
+// largest cross product of the rows of A - lambda I
+template <class T>
+inline void EigenvectorSingle33(T v[3], const T A[9], const T& lambda) {
+  using std::sqrt;
+  const T r0[3] = {A[0] - lambda, A[3], A[6]};
+  const T r1[3] = {A[1], A[4] - lambda, A[7]};
+  const T r2[3] = {A[2], A[5], A[8] - lambda};
+  T c[9];
+  Cross3(c + 0, r0, r1);
+  Cross3(c + 3, r0, r2);
+  Cross3(c + 6, r1, r2);
+
+  int imax = 0;
+  T dmax = Dot3(c, c);
+  for (int i = 1; i < 3; ++i) {
+    const T d = Dot3(c + 3 * i, c + 3 * i);
+    if (d > dmax) {
+      imax = i;
+      dmax = d;
+    }
+  }
+  const T inv_norm = 1 / sqrt(dmax);
+  for (int i = 0; i < 3; ++i) {
+    v[i] = c[3 * imax + i] * inv_norm;
+  }
+}
+
+// Remaining eigenpairs of the symmetric matrix A in the plane orthogonal to its unit
+// eigenvector w, in ascending order, from a single Jacobi rotation
+template <class T>
+inline void EigenPlane33(T mu[2], T v0[3], T v1[3], const T A[9], const T w[3]) {
+  using std::sqrt;
+  T u[3];
+  T t[3];
+  T Au[3];
+  T At[3];
+  OrthogonalComplement3(u, t, w);
+  MatMul<3, 3, 1>(Au, A, u);
+  MatMul<3, 3, 1>(At, A, t);
+  const T m00 = Dot3(u, Au);
+  const T m01 = Dot3(u, At);
+  const T m11 = Dot3(t, At);
+
+  T tan = 0;
+  if (m01 != 0) {
+    const T tau = (m11 - m00) / (2 * m01);
+    const T root = sqrt(1 + tau * tau);
+    tan = 1 / (tau < 0 ? tau - root : tau + root);
+  }
+  const T c = 1 / sqrt(1 + tan * tan);
+  const T s = c * tan;
+  const T mu0 = m00 - tan * m01;
+  const T mu1 = m11 + tan * m01;
+  const bool swap = mu0 > mu1;
+  mu[swap] = mu0;
+  mu[!swap] = mu1;
+  T* e0 = swap ? v1 : v0;
+  T* e1 = swap ? v0 : v1;
+  for (int i = 0; i < 3; ++i) {
+    e0[i] = c * u[i] - s * t[i];
+    e1[i] = s * u[i] + c * t[i];
+  }
+}
+
+template <class T>
+inline void Eigen33(T eigenvalues[3], T eigenvectors[9], const T mat[9]) {
+  using std::abs;
+  using std::acos;
+  using std::cos;
+  using std::sqrt;
+  // Scale by the largest element to avoid overflow in the characteristic polynomial
+  const int upper[6] = {0, 3, 6, 4, 7, 8};
+  T max_abs = 0;
+  for (int k : upper) {
+    if (abs(mat[k]) > max_abs) {
+      max_abs = abs(mat[k]);
+    }
+  }
+  for (int k = 0; k < 9; ++k) {
+    eigenvectors[k] = k % 4 == 0;
+  }
+  if (max_abs == 0) {
+    for (int i = 0; i < 3; ++i) {
+      eigenvalues[i] = 0;
+    }
+    return;
+  }
+  const T scale = 1 / max_abs;
+  const T a00 = mat[0] * scale;
+  const T a01 = mat[3] * scale;
+  const T a02 = mat[6] * scale;
+  const T a11 = mat[4] * scale;
+  const T a12 = mat[7] * scale;
+  const T a22 = mat[8] * scale;
+
+  // Trigonometric solution of the characteristic polynomial of B = (A - q I) / p
+  const T q = (a00 + a11 + a22) / 3;
+  const T b00 = a00 - q;
+  const T b11 = a11 - q;
+  const T b22 = a22 - q;
+  const T p = sqrt(
+      (b00 * b00 + b11 * b11 + b22 * b22 + 2 * (a01 * a01 + a02 * a02 + a12 * a12)) / 6);
+  if (p == 0) {
+    // Multiple of the identity
+    for (int i = 0; i < 3; ++i) {
+      eigenvalues[i] = q * max_abs;
+    }
+    return;
+  }
+  const T c00 = b11 * b22 - a12 * a12;
+  const T c01 = a01 * b22 - a12 * a02;
+  const T c02 = a01 * a12 - b11 * a02;
+  const T det_b = (b00 * c00 - a01 * c01 + a02 * c02) / (p * p * p);
+  T half_det = det_b / 2;
+  if (half_det < -1) {
+    half_det = -1;
+  } else if (half_det > 1) {
+    half_det = 1;
+  }
+  const T angle = acos(half_det) / 3;
+  const sfloat two_thirds_pi = 2.09439510239319549;
+
+  // Only the most isolated eigenvalue is computed in closed form, the others in the plane
+  // orthogonal to its eigenvector
+  const bool largest = half_det >= 0;
+  const T lambda = q + 2 * p * (largest ? cos(angle) : cos(angle + two_thirds_pi));
+  const T A[9] = {a00, a01, a02, a01, a11, a12, a02, a12, a22};
+  T* v0 = eigenvectors;
+  T* v1 = eigenvectors + 3;
+  T* v2 = eigenvectors + 6;
+  T mu[2];
+  if (largest) {
+    EigenvectorSingle33(v2, A, lambda);
+    EigenPlane33(mu, v0, v1, A, v2);
+    Cross3(v0, v1, v2);
+    eigenvalues[0] = mu[0] * max_abs;
+    eigenvalues[1] = mu[1] * max_abs;
+    eigenvalues[2] = lambda * max_abs;
+  } else {
+    EigenvectorSingle33(v0, A, lambda);
+    EigenPlane33(mu, v1, v2, A, v0);
+    Cross3(v2, v0, v1);
+    eigenvalues[0] = lambda * max_abs;
+    eigenvalues[1] = mu[0] * max_abs;
+    eigenvalues[2] = mu[1] * max_abs;
+  }
+}
+
+// Jacobi rotation that orthogonalizes columns p and q of B, accumulated into V
+template <class T>
+inline void JacobiRotate33(T B[9], T V[9], int p, int q) {
+  using std::sqrt;
+  T* bp = B + 3 * p;
+  T* bq = B + 3 * q;
+  T* vp = V + 3 * p;
+  T* vq = V + 3 * q;
+  const T alpha = Dot3(bp, bp);
+  const T beta = Dot3(bq, bq);
+  const T gamma = Dot3(bp, bq);
+  if (gamma == 0) {
+    return;
+  }
+  const T zeta = (beta - alpha) / (2 * gamma);
+  const T root = sqrt(1 + zeta * zeta);
+  const T t = 1 / (zeta < 0 ? zeta - root : zeta + root);
+  const T c = 1 / sqrt(1 + t * t);
+  const T s = c * t;
+  for (int i = 0; i < 3; ++i) {
+    const T bpi = bp[i];
+    const T bqi = bq[i];
+    bp[i] = c * bpi - s * bqi;
+    bq[i] = s * bpi + c * bqi;
+    const T vpi = vp[i];
+    const T vqi = vq[i];
+    vp[i] = c * vpi - s * vqi;
+    vq[i] = s * vpi + c * vqi;
+  }
+}
+
+// Swap entry i and j of S, along with columns i and j of B and V
+template <class T>
+inline void SVDSwap33(T B[9], T S[3], T V[9], int i, int j) {
+  std::swap(S[i], S[j]);
+  for (int k = 0; k < 3; ++k) {
+    std::swap(B[3 * i + k], B[3 * j + k]);
+    std::swap(V[3 * i + k], V[3 * j + k]);
+  }
+}
+
+template <class T>
+inline void SVD33(T U[9], T S[3], T V[9], const T A[9]) {
+  using std::sqrt;
+  // Orthogonalize the columns of B = A V with the same number of sweeps as star_SVD33
+  const int sweeps = 5;
+  T B[9];
+  for (int k = 0; k < 9; ++k) {
+    B[k] = A[k];
+    V[k] = k % 4 == 0;
+  }
+  for (int sweep = 0; sweep < sweeps; ++sweep) {
+    JacobiRotate33(B, V, 0, 1);
+    JacobiRotate33(B, V, 0, 2);
+    JacobiRotate33(B, V, 1, 2);
+  }
+
+  // The singular values are the column norms, sorted in descending order
+  for (int i = 0; i < 3; ++i) {
+    S[i] = sqrt(Dot3(B + 3 * i, B + 3 * i));
+  }
+  if (S[0] < S[1]) SVDSwap33(B, S, V, 0, 1);
+  if (S[1] < S[2]) SVDSwap33(B, S, V, 1, 2);
+  if (S[0] < S[1]) SVDSwap33(B, S, V, 0, 1);
+
+  // Normalize the columns, completing the basis if the singular values are numerically zero
+  if (S[0] == 0) {
+    for (int k = 0; k < 9; ++k) {
+      U[k] = k % 4 == 0;
+    }
+    return;
+  }
+  for (int i = 0; i < 3; ++i) {
+    U[i] = B[i] / S[0];
+  }
+  if (S[1] > STAR_EPS * S[0]) {
+    for (int i = 0; i < 3; ++i) {
+      U[3 + i] = B[3 + i] / S[1];
+    }
+  } else {
+    T unused[3];
+    OrthogonalComplement3(U + 3, unused, U);
+  }
+
+  // The last column is orthogonal to the other two, with the sign of A v2
+  Cross3(U + 6, U, U + 3);
+  if (Dot3(U + 6, B + 6) < 0) {
+    for (int i = 6; i < 9; ++i) {
+      U[i] = -U[i];
+    }
+  }
+}
+
+template <class T>
+inline bool CholSolve33(T x[3], const T A[9], const T b[3]) {
+  T U[9];
+  const bool is_pd = Chol33(U, A);
+
+  // Solve U^T y = b, then U x = y
+  T y[3];
+  y[0] = b[0] / U[0];
+  y[1] = (b[1] - U[3] * y[0]) / U[4];
+  y[2] = (b[2] - U[6] * y[0] - U[7] * y[1]) / U[8];
+  x[2] = y[2] / U[8];
+  x[1] = (y[1] - U[7] * x[2]) / U[4];
+  x[0] = (y[0] - U[3] * x[1] - U[6] * x[2]) / U[0];
+  return is_pd;
+}
+
+template <class T>
+inline void Inverse33(T mat[9]) {
+  const T a00 = mat[0];
+  const T a10 = mat[1];
+  const T a20 = mat[2];
+  const T a01 = mat[3];
+  const T a11 = mat[4];
+  const T a21 = mat[5];
+  const T a02 = mat[6];
+  const T a12 = mat[7];
+  const T a22 = mat[8];
+
+  // Cofactors
+  const T c00 = a11 * a22 - a12 * a21;
+  const T c01 = a12 * a20 - a10 * a22;
+  const T c02 = a10 * a21 - a11 * a20;
+  const T c10 = a02 * a21 - a01 * a22;
+  const T c11 = a00 * a22 - a02 * a20;
+  const T c12 = a01 * a20 - a00 * a21;
+  const T c20 = a01 * a12 - a02 * a11;
+  const T c21 = a02 * a10 - a00 * a12;
+  const T c22 = a00 * a11 - a01 * a10;
+  const T inv_det = 1 / (a00 * c00 + a01 * c01 + a02 * c02);
+
+  // The inverse is the transposed cofactor matrix divided by the determinant
+  mat[0] = c00 * inv_det;
+  mat[1] = c01 * inv_det;
+  mat[2] = c02 * inv_det;
+  mat[3] = c10 * inv_det;
+  mat[4] = c11 * inv_det;
+  mat[5] = c12 * inv_det;
+  mat[6] = c20 * inv_det;
+  mat[7] = c21 * inv_det;
+  mat[8] = c22 * inv_det;
+}
+
+template <class T>
+inline bool InversePSD33(T mat[9]) {
+  T U[9];
+  if (!Chol33(U, mat)) {
+    return false;
+  }
+
+  // Inverse of the Cholesky factor, which is also upper triangular
+  const T w00 = 1 / U[0];
+  const T w11 = 1 / U[4];
+  const T w22 = 1 / U[8];
+  const T w01 = -U[3] * w00 * w11;
+  const T w12 = -U[7] * w11 * w22;
+  const T w02 = -(U[3] * w12 + U[6] * w22) * w00;
+
+  // A^-1 = U^-1 U^-T
+  mat[0] = w00 * w00 + w01 * w01 + w02 * w02;
+  mat[3] = w01 * w11 + w02 * w12;
+  mat[6] = w02 * w22;
+  mat[4] = w11 * w11 + w12 * w12;
+  mat[7] = w12 * w22;
+  mat[8] = w22 * w22;
+  mat[1] = mat[3];
+  mat[2] = mat[6];
+  mat[5] = mat[7];
+  return true;
+}
+
+template <class T>
+inline void Orthonormalize33(T R[9]) {
+  T* x = R;
+  T* y = R + 3;
+  T* z = R + 6;
+  const T half_err = Dot3(x, y) / 2;
+  T x_orth[3];
+  T y_orth[3];
+  for (int i = 0; i < 3; ++i) {
+    x_orth[i] = x[i] - half_err * y[i];
+    y_orth[i] = y[i] - half_err * x[i];
+  }
+  Cross3(z, x_orth, y_orth);
+
+  const T x_scale = RSqrt(Dot3(x_orth, x_orth));
+  const T y_scale = RSqrt(Dot3(y_orth, y_orth));
+  const T z_scale = RSqrt(Dot3(z, z));
+  for (int i = 0; i < 3; ++i) {
+    x[i] = x_orth[i] * x_scale;
+    y[i] = y_orth[i] * y_scale;
+    z[i] *= z_scale;
+  }
+}
+
+/*
+ * Jacobi rotation in the (p, q) plane that zeros A(p, q), applied as A = J^T A J and
+ * accumulated into V = V J. Returns false if A(p, q) is already negligible next to the
+ * diagonal, in which case it is set to zero.
+ */
+template <class T>
+inline bool JacobiRotate44(T A[16], T V[16], int p, int q) {
+  using std::abs;
+  using std::sqrt;
+  const T apq = A[p + 4 * q];
+  const T app = A[p + 4 * p];
+  const T aqq = A[q + 4 * q];
+  const T g = 100 * abs(apq);
+  if (abs(app) + g == abs(app) && abs(aqq) + g == abs(aqq)) {
+    A[p + 4 * q] = 0;
+    A[q + 4 * p] = 0;
+    return false;
+  }
+  const T theta = (aqq - app) / (2 * apq);
+  const T root = sqrt(1 + theta * theta);
+  const T t = 1 / (theta < 0 ? theta - root : theta + root);
+  const T c = 1 / sqrt(1 + t * t);
+  const T s = c * t;
+  for (int k = 0; k < 4; ++k) {
+    const T akp = A[k + 4 * p];
+    const T akq = A[k + 4 * q];
+    A[k + 4 * p] = c * akp - s * akq;
+    A[k + 4 * q] = s * akp + c * akq;
+  }
+  for (int k = 0; k < 4; ++k) {
+    const T apk = A[p + 4 * k];
+    const T aqk = A[q + 4 * k];
+    A[p + 4 * k] = c * apk - s * aqk;
+    A[q + 4 * k] = s * apk + c * aqk;
+    const T vkp = V[k + 4 * p];
+    const T vkq = V[k + 4 * q];
+    V[k + 4 * p] = c * vkp - s * vkq;
+    V[k + 4 * q] = s * vkp + c * vkq;
+  }
+  A[p + 4 * q] = 0;
+  A[q + 4 * p] = 0;
+  return true;
+}
+
+// Compiled without SLP vectorization on GCC, like star_Eigen44, which GCC 12 miscompiles
+// for AVX-512
+template <class T>
+#if defined(__GNUC__) && !defined(__clang__)
+__attribute__((optimize("no-tree-slp-vectorize")))
+#endif
+inline void Eigen44(T eigenvalues[4], T eigenvectors[16], const T mat[16]) {
+  // Cyclic Jacobi sweeps, at most as many as star_Eigen44
+  const int max_sweeps = 10;
+  T A[16];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      A[i + 4 * j] = mat[i + 4 * j];
+      A[j + 4 * i] = mat[i + 4 * j];
+    }
+  }
+  for (int k = 0; k < 16; ++k) {
+    eigenvectors[k] = k % 5 == 0;
+  }
+  for (int sweep = 0; sweep < max_sweeps; ++sweep) {
+    bool rotated = false;
+    for (int p = 0; p < 3; ++p) {
+      for (int q = p + 1; q < 4; ++q) {
+        rotated |= JacobiRotate44(A, eigenvectors, p, q);
+      }
+    }
+    if (!rotated) {
+      break;
+    }
+  }
+
+  // Sort in ascending order with a sorting network
+  for (int k = 0; k < 4; ++k) {
+    eigenvalues[k] = A[5 * k];
+  }
+  const int pairs[5][2] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+  for (const auto& ij : pairs) {
+    const int i = ij[0];
+    const int j = ij[1];
+    if (eigenvalues[i] > eigenvalues[j]) {
+      std::swap(eigenvalues[i], eigenvalues[j]);
+      for (int k = 0; k < 4; ++k) {
+        std::swap(eigenvectors[k + 4 * i], eigenvectors[k + 4 * j]);
+      }
+    }
+  }
+}
+
+}  // namespace star
@@ -16,91 +16,91 @@ namespace star {
 /*-------------------------------------
  * 3x3 Matrices
  *-----------------------------------*/
-Mat3 Multiply(const Mat3& A, const Mat3& B) {
-  Mat3 C;
-  star_MatMul33(C.data(), A.data(), B.data());
-  return C;
-}
-
-Mat3 Multiply(const Transpose<Mat3>& At, const Mat3& B) {
+STAR_INLINE Mat3 Multiply(const Transpose<Mat3>& At, const Mat3& B) {
   Mat3 C;
   star_TransposedMatMul33(C.data(), At.data(), B.data());
   return C;
 }
 
-Mat3 Multiply(const Mat3& A, const Transpose<Mat3>& Bt) {
+STAR_INLINE Mat3 Multiply(const Mat3& A, const Transpose<Mat3>& Bt) {
   Mat3 C;
   star_MatMulTransposed33(C.data(), A.data(), Bt.data());
   return C;
 }
 
-Vec3 Multiply(const Mat3& A, const Vec3& x) {
-  Vec3 y;
-  star_VecMul33(y.data(), A.data(), x.data());
-  return y;
-}
-
-Vec3 Multiply(const Transpose<Mat3>& At, const Vec3& x) {
+STAR_INLINE Vec3 Multiply(const Transpose<Mat3>& At, const Vec3& x) {
   Vec3 y;
   star_TransposedVecMul33(y.data(), At.data(), x.data());
   return y;
 }
 
-void MultiplyInPlace(Mat3& C, const Mat3& A, const Mat3& B) {
+STAR_INLINE void MultiplyInPlace(Mat3& C, const Mat3& A, const Mat3& B) {
   star_MatMul33(C.data(), A.data(), B.data());
 }
 
-void MultiplyInPlace(Mat3& C, const Transpose<Mat3>& At, const Mat3& B) {
+STAR_INLINE void MultiplyInPlace(Mat3& C, const Transpose<Mat3>& At, const Mat3& B) {
   star_TransposedMatMul33(C.data(), At.data(), B.data());
 }
 
-void MultiplyInPlace(Mat3& C, const Mat3& A, const Transpose<Mat3>& B) {
+STAR_INLINE void MultiplyInPlace(Mat3& C, const Mat3& A, const Transpose<Mat3>& B) {
   star_MatMulTransposed33(C.data(), A.data(), B.data());
 }
 
+STAR_INLINE Mat3 CongruenceTransform(const Mat3& A, const Mat3& P) {
+  Mat3 C;
+  star_CongruenceTransform33(C.data(), A.data(), P.data());
+  return C;
+}
+
+STAR_INLINE void CongruenceTransform(Mat3* C, const Mat3* A, const Mat3* P, int n) {
+  static_assert(sizeof(Mat3) == Mat3::kSize * sizeof(sfloat),
+                "Mat3 arrays must be contiguous arrays of sfloat");
+  star_CongruenceTransformBatch33(C->data(), A->data(), P->data(), n);
+}
+
 /*-------------------------------------
  * 4x4 Matrices
  *-----------------------------------*/
 
-Mat4 Multiply(const Mat4& A, const Mat4& B) {
+STAR_INLINE Mat4 Multiply(const Mat4& A, const Mat4& B) {
   Mat4 C;
   star_MatMul44(C.data(), A.data(), B.data());
   return C;
 }
 
-Mat4 Multiply(const Transpose<Mat4>& At, const Mat4& B) {
+STAR_INLINE Mat4 Multiply(const Transpose<Mat4>& At, const Mat4& B) {
   Mat4 C;
   star_TransposedMatMul44(C.data(), At.data(), B.data());
   return C;
 }
 
-Mat4 Multiply(const Mat4& A, const Transpose<Mat4>& Bt) {
+STAR_INLINE Mat4 Multiply(const Mat4& A, const Transpose<Mat4>& Bt) {
   Mat4 C;
   star_MatMulTransposed44(C.data(), A.data(), Bt.data());
   return C;
 }
 
-Vec4 Multiply(const Mat4& A, const Vec4& x) {
+STAR_INLINE Vec4 Multiply(const Mat4& A, const Vec4& x) {
   Vec4 y;
   star_VecMul44(y.data(), A.data(), x.data());
   return y;
 }
 
-Vec4 Multiply(const Transpose<Mat4>& At, const Vec4& x) {
+STAR_INLINE Vec4 Multiply(const Transpose<Mat4>& At, const Vec4& x) {
   Vec4 y;
   star_TransposedVecMul44(y.data(), At.data(), x.data());
   return y;
 }
 
-void MultiplyInPlace(Mat4& C, const Mat4& A, const Mat4& B) {
+STAR_INLINE void MultiplyInPlace(Mat4& C, const Mat4& A, const Mat4& B) {
   star_MatMul44(C.data(), A.data(), B.data());
 }
 
-void MultiplyInPlace(Mat4& C, const Transpose<Mat4>& At, const Mat4& B) {
+STAR_INLINE void MultiplyInPlace(Mat4& C, const Transpose<Mat4>& At, const Mat4& B) {
   star_TransposedMatMul44(C.data(), At.data(), B.data());
 }
 
-void MultiplyInPlace(Mat4& C, const Mat4& A, const Transpose<Mat4>& B) {
+STAR_INLINE void MultiplyInPlace(Mat4& C, const Mat4& A, const Transpose<Mat4>& B) {
   star_MatMulTransposed44(C.data(), A.data(), B.data());
 }
 
@@ -108,68 +108,98 @@ void MultiplyInPlace(Mat4& C, const Mat4& A, const Transpose<Mat4>& B) {
  * 4x3 Matrices
  *-----------------------------------*/
 
-Mat43 Multiply(const Mat43& A, const Mat3& B) {
+STAR_INLINE Mat43 Multiply(const Mat43& A, const Mat3& B) {
   Mat43 C;
   star_MatMul433(C.data(), A.data(), B.data());
   return C;
 }
 
-Mat43 Multiply(const Mat4& A, const Mat43& B) {
+STAR_INLINE Mat43 Multiply(const Mat4& A, const Mat43& B) {
   Mat43 C;
   star_MatMul443(C.data(), A.data(), B.data());
   return C;
 }
 
-Mat43 Multiply(const Mat43& A, const Transpose<Mat3>& B) {
+STAR_INLINE Mat43 Multiply(const Mat43& A, const Transpose<Mat3>& B) {
   Mat43 C;
   star_MatMulTransposed433(C.data(), A.data(), B.data());
   return C;
 }
 
-Mat43 Multiply(const Transpose<Mat4>& A, const Mat43& B) {
+STAR_INLINE Mat43 Multiply(const Transpose<Mat4>& A, const Mat43& B) {
   Mat43 C;
   star_TransposedMatMul443(C.data(), A.data(), B.data());
   return C;
 }
 
-Vec4 Multiply(const Mat43& A, const Vec3& x) {
+STAR_INLINE Vec4 Multiply(const Mat43& A, const Vec3& x) {
   Vec4 y;
   star_VecMul43(y.data(), A.data(), x.data());
   return y;
 }
 
-Vec3 Multiply(const Transpose<Mat43>& A, const Vec4& x) {
+STAR_INLINE Vec3 Multiply(const Transpose<Mat43>& A, const Vec4& x) {
   Vec3 y;
   star_TransposedVecMul43(y.data(), A.data(), x.data());
   return y;
 }
 
-void MultiplyInPlace(Mat43& C, const Mat43& A, const Mat3& B) {
+STAR_INLINE void MultiplyInPlace(Mat43& C, const Mat43& A, const Mat3& B) {
   star_MatMul433(C.data(), A.data(), B.data());
 }
 
-void MultiplyInPlace(Mat43& C, const Mat4& A, const Mat43& B) {
+STAR_INLINE void MultiplyInPlace(Mat43& C, const Mat4& A, const Mat43& B) {
   star_MatMul443(C.data(), A.data(), B.data());
 }
 
-void MultiplyInPlace(Mat43& C, const Transpose<Mat4>& A, const Mat43& B) {
+STAR_INLINE void MultiplyInPlace(Mat43& C, const Transpose<Mat4>& A, const Mat43& B) {
   star_TransposedMatMul443(C.data(), A.data(), B.data());
 }
 
-void MultiplyInPlace(Vec4& y, const Mat43& A, const Vec3& x) {
+STAR_INLINE void MultiplyInPlace(Vec4& y, const Mat43& A, const Vec3& x) {
   star_VecMul43(y.data(), A.data(), x.data());
 }
 
-void MultiplyInPlace(Vec3& y, const Transpose<Mat43>& A, const Vec4& x) {
+STAR_INLINE void MultiplyInPlace(Vec3& y, const Transpose<Mat43>& A, const Vec4& x) {
   star_TransposedVecMul43(y.data(), A.data(), x.data());
 }
 
-//void MultiplyInPlace(Transpose<Mat43>& C, const Mat3& A, const Transpose<Mat43>& B) {
-//  star_MatMul334(C.data(), A.data(), B.data());
-//}
-//
-//void MultiplyInPlace(Transpose<Mat43>& C, const Transpose<Mat43>& A, const Mat4& B) {
-//  star_MatMul344(C.data(), A.data(), B.data());
-//}
+// A 3x4 matrix viewed as the transpose of a 4x3 matrix: C^T = B^T A^T
+STAR_INLINE void MultiplyInPlace(Transpose<Mat43>& C, const Mat3& A,
+                                 const Transpose<Mat43>& B) {
+  star_MatMulTransposed433(C.data(), B.data(), A.data());
+}
+
+STAR_INLINE void MultiplyInPlace(Transpose<Mat43>& C, const Transpose<Mat43>& A,
+                                 const Mat4& B) {
+  star_TransposedMatMul443(C.data(), B.data(), A.data());
+}
+
+/*-------------------------------------
+ * 3x4 Matrices
+ *-----------------------------------*/
+STAR_INLINE Matrix<3, 4> Multiply(const Mat3& A, const Matrix<3, 4>& B) {
+  Matrix<3, 4> C;
+  star_MatMul334(C.data(), A.data(), B.data());
+  return C;
+}
+
+STAR_INLINE Matrix<3, 4> Multiply(const Transpose<Mat3>& At, const Matrix<3, 4>& B) {
+  Matrix<3, 4> C;
+  star_TransposedMatMul334(C.data(), At.data(), B.data());
+  return C;
+}
+
+STAR_INLINE Matrix<3, 4> Multiply(const Matrix<3, 4>& A, const Mat4& B) {
+  Matrix<3, 4> C;
+  star_MatMul344(C.data(), A.data(), B.data());
+  return C;
+}
+
+STAR_INLINE Matrix<3, 4> Multiply(const Matrix<3, 4>& A, const Transpose<Mat4>& Bt) {
+  Matrix<3, 4> C;
+  star_MatMulTransposed344(C.data(), A.data(), Bt.data());
+  return C;
+}
 
 }  // namespace star
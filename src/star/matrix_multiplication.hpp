@@ -8,34 +8,70 @@
 #include "star/Mat3.hpp"
 #include "star/Mat4.hpp"
 #include "star/Mat43.hpp"
+#include "star/Matrix.hpp"
 #include "star/Transpose.hpp"
 #include "star/Vec3.hpp"
 #include "star/Vec4.hpp"
 
+extern "C" {
+#include "star/matrix3.h"
+}
+
+#include "star/matrix_kernels.hpp"
+
 namespace star {
 
 /*
  * Generic multiplication operator overload
+ *
+ * Only participates in overload resolution if there is a matching Multiply, so it doesn't
+ * shadow the element-wise operators in Expression.hpp.
  */
 template <class Atype, class Btype>
-auto operator*(const Atype& A, const Btype& B) {
+constexpr auto operator*(const Atype& A, const Btype& B) -> decltype(Multiply(A, B)) {
   return Multiply(A, B);
 }
 
 /*-------------------------------------
  * 3x3 Matrices
  *-----------------------------------*/
-Mat3 Multiply(const Mat3& A, const Mat3& B);
+constexpr Mat3 Multiply(const Mat3& A, const Mat3& B) {
+  Mat3 C = Mat3::Zero();
+  if (STAR_IS_CONSTANT_EVALUATED()) {
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        for (int i = 0; i < 3; ++i) {
+          C[i + 3 * j] += A[i + 3 * k] * B[k + 3 * j];
+        }
+      }
+    }
+  } else {
+    star_MatMul33(C.data(), A.data(), B.data());
+  }
+  return C;
+}
 Mat3 Multiply(const Transpose<Mat3>& At, const Mat3& B);
 Mat3 Multiply(const Mat3& A, const Transpose<Mat3>& Bt);
 
-Vec3 Multiply(const Mat3& A, const Vec3& x);
+constexpr Vec3 Multiply(const Mat3& A, const Vec3& x) {
+  return {A[0] * x.x + A[3] * x.y + A[6] * x.z, A[1] * x.x + A[4] * x.y + A[7] * x.z,
+          A[2] * x.x + A[5] * x.y + A[8] * x.z};
+}
 Vec3 Multiply(const Transpose<Mat3>& At, const Vec3& x);
 
 void MultiplyInPlace(Mat3& C, const Mat3& A, const Mat3& B);
 void MultiplyInPlace(Mat3& C, const Transpose<Mat3>& At, const Mat3& B);
 void MultiplyInPlace(Mat3& C, const Mat3& A, const Transpose<Mat3>& B);
 
+/*
+ * Congruence transform A P A^T of a symmetric matrix P, e.g. to propagate a covariance.
+ * Only the upper triangle of P is read.
+ */
+Mat3 CongruenceTransform(const Mat3& A, const Mat3& P);
+
+// Batched congruence transform C[i] = A[i] P[i] A[i]^T over n contiguous matrices
+void CongruenceTransform(Mat3* C, const Mat3* A, const Mat3* P, int n);
+
 /*-------------------------------------
  * 4x4 Matrices
  *-----------------------------------*/
@@ -74,4 +110,68 @@ void MultiplyInPlace(Transpose<Mat43>& C, const Transpose<Mat43>& A, const Mat4&
 void MultiplyInPlace(Vec4& y, const Mat43& A, const Vec3& x);
 void MultiplyInPlace(Vec3& y, const Transpose<Mat43>& A, const Vec4& x);
 
-}  // namespace star
\ No newline at end of file
+/*-------------------------------------
+ * 3x4 Matrices
+ *-----------------------------------*/
+Matrix<3, 4> Multiply(const Mat3& A, const Matrix<3, 4>& B);
+Matrix<3, 4> Multiply(const Transpose<Mat3>& At, const Matrix<3, 4>& B);
+Matrix<3, 4> Multiply(const Matrix<3, 4>& A, const Mat4& B);
+Matrix<3, 4> Multiply(const Matrix<3, 4>& A, const Transpose<Mat4>& Bt);
+
+/*-------------------------------------
+ * Other Shapes
+ *-----------------------------------*/
+// Uses the templated kernels in matrix_kernels.hpp for shapes and combinations of
+// transposes without overloads above
+template <int M, int K, int N, class T>
+Matrix<M, N, T> Multiply(const Matrix<M, K, T>& A, const Matrix<K, N, T>& B) {
+  Matrix<M, N, T> C;
+  MatMul<M, K, N>(C.data(), A.data(), B.data());
+  return C;
+}
+
+template <class Mat, int N>
+Matrix<Mat::kCols, N, typename Mat::Scalar> Multiply(
+    const Transpose<Mat>& At, const Matrix<Mat::kRows, N, typename Mat::Scalar>& B) {
+  Matrix<Mat::kCols, N, typename Mat::Scalar> C;
+  TransposedMatMul<Mat::kCols, Mat::kRows, N>(C.data(), At.data(), B.data());
+  return C;
+}
+
+template <int M, class Mat>
+Matrix<M, Mat::kRows, typename Mat::Scalar> Multiply(
+    const Matrix<M, Mat::kCols, typename Mat::Scalar>& A, const Transpose<Mat>& Bt) {
+  Matrix<M, Mat::kRows, typename Mat::Scalar> C;
+  MatMulTransposed<M, Mat::kCols, Mat::kRows>(C.data(), A.data(), Bt.data());
+  return C;
+}
+
+template <int M, int N, class T>
+Vector<M, T> Multiply(const Matrix<M, N, T>& A, const Vector<N, T>& x) {
+  Vector<M, T> y;
+  MatMul<M, N, 1>(y.data(), A.data(), x.data());
+  return y;
+}
+
+template <class Mat>
+Vector<Mat::kCols, typename Mat::Scalar> Multiply(
+    const Transpose<Mat>& At, const Vector<Mat::kRows, typename Mat::Scalar>& x) {
+  Vector<Mat::kCols, typename Mat::Scalar> y;
+  TransposedMatMul<Mat::kCols, Mat::kRows, 1>(y.data(), At.data(), x.data());
+  return y;
+}
+
+template <class MatA, class MatB, std::enable_if_t<MatA::kRows == MatB::kCols, int> = 0>
+Matrix<MatA::kCols, MatB::kRows, typename MatA::Scalar> Multiply(
+    const Transpose<MatA>& At, const Transpose<MatB>& Bt) {
+  Matrix<MatA::kCols, MatB::kRows, typename MatA::Scalar> C;
+  TransposedMatMulTransposed<MatA::kCols, MatA::kRows, MatB::kRows>(C.data(), At.data(),
+                                                                    Bt.data());
+  return C;
+}
+
+}  // namespace star
+
+#ifdef STAR_HEADER_ONLY
+#include "star/matrix_multiplication.cpp"
+#endif
@@ -3,87 +3,100 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include "dispatch.h"
+#include "fastmath.h"
 #include "quaternion.h"
 
 #include <stdio.h>
 
 #include "math.h"
+#include "matrix3.h"
+#include "simd.h"
 
-double star_QuatNorm(const double q[4]) {
+STAR_KERNEL sfloat star_QuatNorm(const sfloat q[4]) {
   return sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
 }
 
-double star_QuatNormSquared(const double q[4]) {
+STAR_KERNEL sfloat star_QuatNormSquared(const sfloat q[4]) {
   return q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
 }
 
-double star_QuatVecNorm(const double q[4]) {
+STAR_KERNEL sfloat star_QuatVecNorm(const sfloat q[4]) {
   return sqrt(q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
 }
 
-double star_QuatVecNormSquared(const double q[4]) {
+STAR_KERNEL sfloat star_QuatVecNormSquared(const sfloat q[4]) {
   return q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
 }
 
-double star_PrincipalAngle(const double q[4]) { return 2 * atan2(star_QuatVecNorm(q), q[0]); }
+STAR_KERNEL sfloat star_PrincipalAngle(const sfloat q[4]) {
+  return 2 * star_Atan2(star_QuatVecNorm(q), q[0]);
+}
 
-double star_QuatAngleBetween(const double q1[4], const double q2[4]) {
-  double dq[4];
+STAR_KERNEL sfloat star_QuatAngleBetween(const sfloat q1[4], const sfloat q2[4]) {
+  sfloat dq[4];
   star_QuatDiff(dq, q1, q2);
   return star_PrincipalAngle(dq);
 }
 
-void star_QuatIdentity(double q[4]) {
+STAR_KERNEL void star_QuatIdentity(sfloat q[4]) {
   q[0] = 1;
   q[1] = 0;
   q[2] = 0;
   q[3] = 0;
 }
 
-void star_QuatNormalize(double q_normalized[4], const double q[4]) {
-  double n = 1 / star_QuatNorm(q);
+STAR_KERNEL void star_QuatNormalize(sfloat q_normalized[4], const sfloat q[4]) {
+  sfloat n = star_RSqrt(star_QuatNormSquared(q));
   q_normalized[0] = q[0] * n;
   q_normalized[1] = q[1] * n;
   q_normalized[2] = q[2] * n;
   q_normalized[3] = q[3] * n;
 }
 
-void star_QuatFlip(double q_flip[4], const double q[4]) {
+STAR_KERNEL void star_QuatFlip(sfloat q_flip[4], const sfloat q[4]) {
   q_flip[0] = -q[0];
   q_flip[1] = -q[1];
   q_flip[2] = -q[2];
   q_flip[3] = -q[3];
 }
 
-void star_QuatVec(double vec[3], const double q[4]) {
+STAR_KERNEL void star_QuatVec(sfloat vec[3], const sfloat q[4]) {
   vec[0] = q[1];
   vec[1] = q[2];
   vec[2] = q[3];
 }
 
-void star_QuatConjugate(double q_conj[4], const double q[4]) {
+STAR_KERNEL void star_QuatConjugate(sfloat q_conj[4], const sfloat q[4]) {
   q_conj[0] = q[0];
   q_conj[1] = -q[1];
   q_conj[2] = -q[2];
   q_conj[3] = -q[3];
 }
 
-void star_QuatInverse(double qinv[4], const double q[4]) {
-  double n = 1 / star_QuatNormSquared(q);
+STAR_KERNEL void star_QuatInverse(sfloat qinv[4], const sfloat q[4]) {
+  sfloat n = 1 / star_QuatNormSquared(q);
   qinv[0] = q[0] * n;
   qinv[1] = -q[1] * n;
   qinv[2] = -q[2] * n;
   qinv[3] = -q[3] * n;
 }
 
-void star_QuatCompose(double q3[4], const double q1[4], const double q2[4]) {
-  q3[0] = q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2] - q1[3] * q2[3];
-  q3[1] = q1[1] * q2[0] + q1[0] * q2[1] + q1[2] * q2[3] - q1[3] * q2[2];
-  q3[2] = q1[2] * q2[0] + q1[3] * q2[1] + q1[0] * q2[2] - q1[1] * q2[3];
-  q3[3] = q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1];
+static inline void star_QuatCompose_Generic(sfloat q3[4], const sfloat q1[4],
+                                            const sfloat q2[4]) {
+  sfloat out[4];
+  out[0] = q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2] - q1[3] * q2[3];
+  out[1] = q1[1] * q2[0] + q1[0] * q2[1] + q1[2] * q2[3] - q1[3] * q2[2];
+  out[2] = q1[2] * q2[0] + q1[3] * q2[1] + q1[0] * q2[2] - q1[1] * q2[3];
+  out[3] = q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1];
+  for (int i = 0; i < 4; ++i) {
+    q3[i] = out[i];
+  }
 }
+STAR_DISPATCH(star_QuatCompose,
+              (sfloat q3[4], const sfloat q1[4], const sfloat q2[4]), (q3, q1, q2))
 
-void star_QuatDiff(double dq[4], const double q1[4], const double q2[4]) {
+STAR_KERNEL void star_QuatDiff(sfloat dq[4], const sfloat q1[4], const sfloat q2[4]) {
   // NOTE: This is conjugate(q2) * q1, the quaternion equivalent of q1 - q2
   dq[0] = +q2[0] * q1[0] + q2[1] * q1[1] + q2[2] * q1[2] + q2[3] * q1[3];
   dq[1] = -q2[1] * q1[0] + q2[0] * q1[1] - q2[2] * q1[3] + q2[3] * q1[2];
@@ -91,17 +104,18 @@ void star_QuatDiff(double dq[4], const double q1[4], const double q2[4]) {
   dq[3] = -q2[3] * q1[0] + q2[0] * q1[3] - q2[1] * q1[2] + q2[2] * q1[1];
 }
 
-void star_QuatComposeLeft(double q3[4], const double q1[4], const double q2[4]) {
+STAR_KERNEL void star_QuatComposeLeft(sfloat q3[4], const sfloat q1[4],
+                                      const sfloat q2[4]) {
   q3[0] = q2[0] * q1[0] - q2[1] * q1[1] - q2[2] * q1[2] - q2[3] * q1[3];
   q3[1] = q2[1] * q1[0] + q2[0] * q1[1] + q2[2] * q1[3] - q2[3] * q1[2];
   q3[2] = q2[2] * q1[0] + q2[3] * q1[1] + q2[0] * q1[2] - q2[1] * q1[3];
   q3[3] = q2[3] * q1[0] + q2[0] * q1[3] + q2[1] * q1[2] - q2[2] * q1[1];
 }
 
-void star_QuatLogm(double phi[3], const double q[4]) {
-  double s = q[0];
-  double theta = star_QuatVecNorm(q);
-  double M;
+STAR_KERNEL void star_QuatLogm(sfloat phi[3], const sfloat q[4]) {
+  sfloat s = q[0];
+  sfloat theta = star_QuatVecNorm(q);
+  sfloat M;
   if (theta < 1e-6) {
     if (fabs(s) < STAR_EPS) {
       phi[0] = 0;
@@ -111,14 +125,14 @@ void star_QuatLogm(double phi[3], const double q[4]) {
     }
     M = (1 - theta * theta / (3 * s * s)) / s;
   } else {
-    M = atan2(theta, s) / theta;
+    M = star_Atan2(theta, s) / theta;
   }
   phi[0] = q[1] * M * 2;
   phi[1] = q[2] * M * 2;
   phi[2] = q[3] * M * 2;
 }
 
-void star_QuatLog(double q_log[4], const double q[4]) {
+STAR_KERNEL void star_QuatLog(sfloat q_log[4], const sfloat q[4]) {
   star_QuatLogm(q_log + 1, q);
   q_log[0] = log(star_QuatNorm(q));
   q_log[1] *= 0.5;
@@ -126,17 +140,17 @@ void star_QuatLog(double q_log[4], const double q[4]) {
   q_log[3] *= 0.5;
 }
 
-void star_QuatExpm(double q[4], const double phi[3]) {
-  double theta = sqrt(phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2]);
-  double s_theta;
-  double c_theta;
+STAR_KERNEL void star_QuatExpm(sfloat q[4], const sfloat phi[3]) {
+  sfloat theta = sqrt(phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2]);
+  sfloat s_theta;
+  sfloat c_theta;
   if (theta < sqrt(STAR_EPS)) {
-    theta /= 2;
-    s_theta = (1 - theta * theta / 6.0);
-    c_theta = (1 - theta * theta / 2.0);
+    // Second-order expansions of sin(theta / 2) / theta and cos(theta / 2)
+    s_theta = 0.5 - theta * theta / 48;
+    c_theta = 1 - theta * theta / 8;
   } else {
-    s_theta = sin(theta / 2) / theta;
-    c_theta = cos(theta / 2);
+    star_SinCos(theta / 2, &s_theta, &c_theta);
+    s_theta /= theta;
   }
   q[0] = c_theta;
   q[1] = phi[0] * s_theta;
@@ -144,85 +158,96 @@ void star_QuatExpm(double q[4], const double phi[3]) {
   q[3] = phi[2] * s_theta;
 }
 
-void star_QuatRotX(double q[4], double theta) {
-  double s = sin(theta / 2);
-  double c = cos(theta / 2);
+STAR_KERNEL void star_QuatRotX(sfloat q[4], sfloat theta) {
+  sfloat s;
+  sfloat c;
+  star_SinCos(theta / 2, &s, &c);
   q[0] = c;
   q[1] = s;
   q[2] = 0;
   q[3] = 0;
 }
 
-void star_QuatRotY(double q[4], double theta) {
-  double s = sin(theta / 2);
-  double c = cos(theta / 2);
+STAR_KERNEL void star_QuatRotY(sfloat q[4], sfloat theta) {
+  sfloat s;
+  sfloat c;
+  star_SinCos(theta / 2, &s, &c);
   q[0] = c;
   q[1] = 0;
   q[2] = s;
   q[3] = 0;
 }
 
-void star_QuatRotZ(double q[4], double theta) {
-  double s = sin(theta / 2);
-  double c = cos(theta / 2);
+STAR_KERNEL void star_QuatRotZ(sfloat q[4], sfloat theta) {
+  sfloat s;
+  sfloat c;
+  star_SinCos(theta / 2, &s, &c);
   q[0] = c;
   q[1] = 0;
   q[2] = 0;
   q[3] = s;
 }
 
-void star_QuatExp(double q_exp[4], const double q[4]) {
-  double phi[3] = {2 * q[1], 2 * q[2], 2 * q[3]};
+STAR_KERNEL void star_QuatExp(sfloat q_exp[4], const sfloat q[4]) {
+  sfloat phi[3] = {2 * q[1], 2 * q[2], 2 * q[3]};
   star_QuatExpm(q_exp, phi);
-  double s = exp(q[0]);
+  sfloat s = exp(q[0]);
   q_exp[0] *= s;
   q_exp[1] *= s;
   q_exp[2] *= s;
   q_exp[3] *= s;
 }
 
-void star_QuatRotateActive(double v_rot[3], const double q[4], const double v[3]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
-
-  v_rot[0] = (ww + xx - yy - zz) * v[0];
-  v_rot[1] = 2 * (xy + zw) * v[0];
-  v_rot[2] = 2 * (xz - yw) * v[0];
-  v_rot[0] += 2 * (xy - zw) * v[1];
-  v_rot[1] += (ww - xx + yy - zz) * v[1];
-  v_rot[2] += 2 * (yz + xw) * v[1];
-  v_rot[0] += 2 * (xz + yw) * v[2];
-  v_rot[1] += 2 * (yz - xw) * v[2];
-  v_rot[2] += (ww - xx - yy + zz) * v[2];
+static inline void star_QuatRotateActive_Generic(sfloat v_rot[3], const sfloat q[4],
+                                                 const sfloat v[3]) {
+  sfloat out[3];
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
+
+  out[0] = (ww + xx - yy - zz) * v[0];
+  out[1] = 2 * (xy + zw) * v[0];
+  out[2] = 2 * (xz - yw) * v[0];
+  out[0] += 2 * (xy - zw) * v[1];
+  out[1] += (ww - xx + yy - zz) * v[1];
+  out[2] += 2 * (yz + xw) * v[1];
+  out[0] += 2 * (xz + yw) * v[2];
+  out[1] += 2 * (yz - xw) * v[2];
+  out[2] += (ww - xx - yy + zz) * v[2];
+  for (int i = 0; i < 3; ++i) {
+    v_rot[i] = out[i];
+  }
 }
-
-void star_QuatRotatePassive(double v_rot[3], const double q[4], const double v[3]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
+STAR_DISPATCH(star_QuatRotateActive,
+              (sfloat v_rot[3], const sfloat q[4], const sfloat v[3]), (v_rot, q, v))
+
+STAR_KERNEL void star_QuatRotatePassive(sfloat v_rot[3], const sfloat q[4],
+                                        const sfloat v[3]) {
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
 
   v_rot[0] = (ww + xx - yy - zz) * v[0];
   v_rot[0] += 2 * (xy + zw) * v[1];
@@ -235,39 +260,167 @@ void star_QuatRotatePassive(double v_rot[3], const double q[4], const double v[3
   v_rot[2] += (ww - xx - yy + zz) * v[2];
 }
 
-void star_QuatPure(double q[4], const double x[3]) {
+STAR_KERNEL void star_QuatRotateActiveBatch(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot,
+                                            const sfloat q[4], const sfloat* x,
+                                            const sfloat* y, const sfloat* z, int n) {
+  sfloat Q[9];
+  star_QuatToRotMatActive(Q, q);
+  star_VecMulBatch33(x_rot, y_rot, z_rot, Q, x, y, z, n);
+}
+
+STAR_KERNEL void star_QuatRotatePassiveBatch(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot,
+                                             const sfloat q[4], const sfloat* x,
+                                             const sfloat* y, const sfloat* z, int n) {
+  sfloat Q[9];
+  star_QuatToRotMatPassive(Q, q);
+  star_VecMulBatch33(x_rot, y_rot, z_rot, Q, x, y, z, n);
+}
+
+STAR_KERNEL void star_QuatPure(sfloat q[4], const sfloat x[3]) {
   q[0] = 0;
   q[1] = x[0];
   q[2] = x[1];
   q[3] = x[2];
 }
 
-void star_QuatComposePure(double qv[4], const double q1[4], const double v[3]) {
+STAR_KERNEL void star_QuatComposePure(sfloat qv[4], const sfloat q1[4], const sfloat v[3]) {
   qv[0] = -q1[1] * v[0] - q1[2] * v[1] - q1[3] * v[2];
   qv[1] = +q1[0] * v[0] + q1[2] * v[2] - q1[3] * v[1];
   qv[2] = +q1[3] * v[0] + q1[0] * v[1] - q1[1] * v[2];
   qv[3] = +q1[0] * v[2] + q1[1] * v[1] - q1[2] * v[0];
 }
 
+/////////////////////////////////////////////
+// Interpolation
+/////////////////////////////////////////////
+
+// Terms of the series of the slerp weights, which reach full precision for
+// cos(theta) >= STAR_SLERP_MIN_COS
+#ifdef STAR_SINGLE_PRECISION
+#define STAR_SLERP_TERMS 5
+#else
+#define STAR_SLERP_TERMS 10
+#endif
+#define STAR_SLERP_MIN_COS 0.9
+
+// 1 / (i * (2i + 1))
+static const sfloat star_kSlerpCoeffs[10] = {
+    1.0 / 3, 1.0 / 10, 1.0 / 21, 1.0 / 36, 1.0 / 55,
+    1.0 / 78, 1.0 / 105, 1.0 / 136, 1.0 / 171, 1.0 / 210,
+};
+
+/*
+ * Slerp weight sin(t * theta) / sin(theta) given x = cos(theta), from the series
+ * sum_i b_i (x - 1)^i with b_0 = t and b_i = b_{i-1} (t^2 - i^2) / (i (2i + 1)), see
+ * D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP".
+ */
+static inline sfloat star_SlerpWeight(sfloat t, sfloat x) {
+  sfloat y = x - 1;
+  sfloat t2 = t * t;
+  sfloat b = t;
+  sfloat f = t;
+  for (int i = 1; i <= STAR_SLERP_TERMS; ++i) {
+    b *= (t2 - i * i) * star_kSlerpCoeffs[i - 1] * y;
+    f += b;
+  }
+  return f;
+}
+
+STAR_KERNEL void star_QuatSlerp(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                sfloat t) {
+  sfloat x = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+  sfloat sign = x < 0 ? -1 : 1;
+  sfloat a[4] = {q0[0], q0[1], q0[2], q0[3]};
+  sfloat b[4] = {sign * q1[0], sign * q1[1], sign * q1[2], sign * q1[3]};
+  x *= sign;
+
+  // Bisect the arc until the series converges. Two steps suffice since x >= 0.
+  for (int k = 0; k < 2; ++k) {
+    if (x < STAR_SLERP_MIN_COS) {
+      sfloat s = 1 / sqrt(2 + 2 * x);
+      sfloat* end = t < 0.5 ? b : a;
+      for (int i = 0; i < 4; ++i) {
+        end[i] = (a[i] + b[i]) * s;
+      }
+      t = t < 0.5 ? 2 * t : 2 * t - 1;
+      x = (1 + x) * s;
+    }
+  }
+  sfloat w0 = star_SlerpWeight(1 - t, x);
+  sfloat w1 = star_SlerpWeight(t, x);
+  for (int i = 0; i < 4; ++i) {
+    q[i] = w0 * a[i] + w1 * b[i];
+  }
+}
+
+STAR_KERNEL void star_QuatNlerp(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                sfloat t) {
+  sfloat x = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+  sfloat w1 = x < 0 ? -t : t;
+  sfloat out[4];
+  for (int i = 0; i < 4; ++i) {
+    out[i] = (1 - t) * q0[i] + w1 * q1[i];
+  }
+  star_QuatNormalize(q, out);
+}
+
+STAR_KERNEL void star_QuatSquad(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                const sfloat s0[4], const sfloat s1[4], sfloat t) {
+  sfloat q01[4];
+  sfloat s01[4];
+  star_QuatSlerp(q01, q0, q1, t);
+  star_QuatSlerp(s01, s0, s1, t);
+  star_QuatSlerp(q, q01, s01, 2 * t * (1 - t));
+}
+
+STAR_KERNEL void star_QuatSquadControlPoint(sfloat s[4], const sfloat q_prev[4],
+                                            const sfloat q[4], const sfloat q_next[4]) {
+  // s = q * exp(-(log(q^* q_next) + log(q^* q_prev)) / 4), along the shorter arcs
+  sfloat dq[4];
+  sfloat phi_next[3];
+  sfloat phi_prev[3];
+  star_QuatDiff(dq, q_next, q);
+  if (dq[0] < 0) {
+    star_QuatFlip(dq, dq);
+  }
+  star_QuatLogm(phi_next, dq);
+  star_QuatDiff(dq, q_prev, q);
+  if (dq[0] < 0) {
+    star_QuatFlip(dq, dq);
+  }
+  star_QuatLogm(phi_prev, dq);
+
+  // Logm and Expm use phi = 2 log(q), so the factor of 2 cancels
+  sfloat phi[3];
+  for (int i = 0; i < 3; ++i) {
+    phi[i] = -(phi_next[i] + phi_prev[i]) / 4;
+  }
+  star_QuatExpm(dq, phi);
+  star_QuatCompose(s, q, dq);
+}
+
+#undef STAR_SLERP_TERMS
+#undef STAR_SLERP_MIN_COS
+
 /////////////////////////////////////////////
 // Conversions
 /////////////////////////////////////////////
 
-void star_QuatToRotMatActive(double Q[9], const double q[4]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
+STAR_KERNEL void star_QuatToRotMatActive(sfloat Q[9], const sfloat q[4]) {
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
 
   Q[0 + 0] = ww + xx - yy - zz;
   Q[0 + 1] = 2 * (xy + zw);
@@ -280,21 +433,21 @@ void star_QuatToRotMatActive(double Q[9], const double q[4]) {
   Q[6 + 2] = ww - xx - yy + zz;
 }
 
-void star_QuatToRotMatPassive(double Q[9], const double q[4]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
+STAR_KERNEL void star_QuatToRotMatPassive(sfloat Q[9], const sfloat q[4]) {
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
 
   Q[0 + 0] = ww + xx - yy - zz;
   Q[3 + 0] = 2 * (xy + zw);
@@ -314,7 +467,8 @@ void star_QuatToRotMatPassive(double Q[9], const double q[4]) {
 /////////////////////////////////////////////
 
 
-void star_QuatRotateActiveJacobian(double* D, const double q[4], const double x[3]) {
+STAR_KERNEL void star_QuatRotateActiveJacobian(sfloat* D, const sfloat q[4],
+                                               const sfloat x[3]) {
   D[0] = 2 * q[0] * x[0] + 2 * q[2] * x[2] - 2 * q[3] * x[1];
   D[1] = 2 * q[3] * x[0] + 2 * q[0] * x[1] - 2 * q[1] * x[2];
   D[2] = 2 * q[0] * x[2] + 2 * q[1] * x[1] - 2 * q[2] * x[0];
@@ -332,8 +486,151 @@ void star_QuatRotateActiveJacobian(double* D, const double q[4], const double x[
   D[11] = 2 * q[1] * x[0] + 2 * q[2] * x[1] + 2 * q[3] * x[2];
 }
 
-void star_QuatToRodriguesParam(double g[3], const double q[4]) {
-  double s = q[0];
+STAR_KERNEL void star_QuatRotatePassiveJacobian(sfloat* D, const sfloat q[4],
+                                                const sfloat x[3]) {
+  // A passive rotation is the active rotation by the conjugate
+  const sfloat q_conj[4] = {q[0], -q[1], -q[2], -q[3]};
+  star_QuatRotateActiveJacobian(D, q_conj, x);
+  for (int i = 3; i < 12; ++i) {
+    D[i] = -D[i];
+  }
+}
+
+STAR_KERNEL void star_QuatExpmJacobian(sfloat D[12], const sfloat phi[3]) {
+  // q = [c; s_theta phi] with c = cos(theta / 2) and s_theta = sin(theta / 2) / theta, so
+  // dq/dphi = [-s_theta / 2 phi^T; s_theta I + k phi phi^T] with
+  // k = d(s_theta)/dtheta / theta
+  sfloat theta2 = phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+  sfloat theta = sqrt(theta2);
+  sfloat s_theta;
+  sfloat k;
+  if (theta < sqrt(STAR_EPS)) {
+    s_theta = 0.5 - theta2 / 48;
+    k = -1.0 / 24 + theta2 / 960;
+  } else {
+    sfloat c;
+    star_SinCos(theta / 2, &s_theta, &c);
+    s_theta /= theta;
+    k = (c / 2 - s_theta) / theta2;
+  }
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -s_theta / 2 * phi[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = k * phi[i] * phi[j];
+    }
+    D[1 + j + 4 * j] += s_theta;
+  }
+}
+
+STAR_KERNEL void star_QuatLogmJacobian(sfloat D[12], const sfloat q[4]) {
+  // phi = 2 M(s, theta) v with theta = |v|, see star_QuatLogm. The columns are
+  // dphi/ds = 2 v dM/ds and dphi/dv = 2 M I + 2 k v v^T with k = dM/dtheta / theta.
+  sfloat s = q[0];
+  const sfloat* v = q + 1;
+  sfloat theta2 = star_QuatVecNormSquared(q);
+  sfloat theta = sqrt(theta2);
+  sfloat M;
+  sfloat dM_ds;
+  sfloat k;
+  if (theta < 1e-6) {
+    if (fabs(s) < STAR_EPS) {
+      for (int i = 0; i < 12; ++i) {
+        D[i] = 0;
+      }
+      return;
+    }
+    // Derivatives of the series used by star_QuatLogm
+    sfloat s2 = s * s;
+    M = (1 - theta2 / (3 * s2)) / s;
+    dM_ds = (theta2 / s2 - 1) / s2;
+    k = -2 / (3 * s2 * s);
+  } else {
+    sfloat n2 = s * s + theta2;
+    M = star_Atan2(theta, s) / theta;
+    dM_ds = -1 / n2;
+    k = (s / n2 - M) / theta2;
+  }
+  for (int i = 0; i < 3; ++i) {
+    D[i] = 2 * dM_ds * v[i];
+  }
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      D[i + 3 * (j + 1)] = 2 * k * v[i] * v[j];
+    }
+    D[j + 3 * (j + 1)] += 2 * M;
+  }
+}
+
+STAR_KERNEL void star_QuatToRodriguesParamJacobian(sfloat D[12], const sfloat q[4]) {
+  // g = v / s
+  sfloat s_inv = 1 / q[0];
+  for (int i = 0; i < 3; ++i) {
+    D[i] = -q[i + 1] * s_inv * s_inv;
+  }
+  for (int i = 3; i < 12; ++i) {
+    D[i] = 0;
+  }
+  D[3] = s_inv;
+  D[7] = s_inv;
+  D[11] = s_inv;
+}
+
+STAR_KERNEL void star_RodriguesParamToQuatJacobian(sfloat D[12], const sfloat g[3]) {
+  // q = M [1; g] with M = (1 + g^T g)^(-1/2), so dM/dg = -M^3 g^T
+  sfloat M = 1.0 / sqrt(1 + g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+  sfloat M3 = M * M * M;
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -M3 * g[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = -M3 * g[i] * g[j];
+    }
+    D[1 + j + 4 * j] += M;
+  }
+}
+
+STAR_KERNEL void star_QuatToMRPJacobian(sfloat D[12], const sfloat q[4]) {
+  // p = v / (1 + s)
+  sfloat a = 1 / (1 + q[0]);
+  for (int i = 0; i < 3; ++i) {
+    D[i] = -q[i + 1] * a * a;
+  }
+  for (int i = 3; i < 12; ++i) {
+    D[i] = 0;
+  }
+  D[3] = a;
+  D[7] = a;
+  D[11] = a;
+}
+
+STAR_KERNEL void star_MRPToQuatJacobian(sfloat D[12], const sfloat p[3]) {
+  // q = [(1 - n) / (1 + n); 2 p / (1 + n)] with n = p^T p
+  sfloat a = 1 / (1 + p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -4 * a * a * p[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = -4 * a * a * p[i] * p[j];
+    }
+    D[1 + j + 4 * j] += 2 * a;
+  }
+}
+
+STAR_KERNEL void star_QuatCayleyJacobian(sfloat D[12], const sfloat phi[3]) {
+  const sfloat g[3] = {phi[0] / 2, phi[1] / 2, phi[2] / 2};
+  star_RodriguesParamToQuatJacobian(D, g);
+  for (int i = 0; i < 12; ++i) {
+    D[i] /= 2;
+  }
+}
+
+STAR_KERNEL void star_QuatInvCayleyJacobian(sfloat D[12], const sfloat q[4]) {
+  star_QuatToRodriguesParamJacobian(D, q);
+  for (int i = 0; i < 12; ++i) {
+    D[i] *= 2;
+  }
+}
+
+STAR_KERNEL void star_QuatToRodriguesParam(sfloat g[3], const sfloat q[4]) {
+  sfloat s = q[0];
   if (fabs(s) < STAR_EPS) {
     g[0] = NAN;
     g[1] = NAN;
@@ -345,16 +642,16 @@ void star_QuatToRodriguesParam(double g[3], const double q[4]) {
   g[2] = q[3] / s;
 }
 
-void star_RodriguesParamToQuat(double q[4], const double g[3]) {
-  double M = 1.0 / sqrt(1 + g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+STAR_KERNEL void star_RodriguesParamToQuat(sfloat q[4], const sfloat g[3]) {
+  sfloat M = 1.0 / sqrt(1 + g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
   q[0] = M;
   q[1] = g[0] * M;
   q[2] = g[1] * M;
   q[3] = g[2] * M;
 }
 
-void star_QuatToMRP(double p[3], const double q[4]) {
-  double s = q[0];
+STAR_KERNEL void star_QuatToMRP(sfloat p[3], const sfloat q[4]) {
+  sfloat s = q[0];
 
   if (fabs(s + 1) < STAR_EPS) {
     p[0] = NAN;
@@ -367,18 +664,43 @@ void star_QuatToMRP(double p[3], const double q[4]) {
   p[2] = q[3] / (1 + s);
 }
 
-void star_MRPToQuat(double q[4], const double p[3]) {
-  double norm2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
-  double M = 2.0 / (1 + norm2);
+STAR_KERNEL void star_MRPToQuat(sfloat q[4], const sfloat p[3]) {
+  sfloat norm2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+  sfloat M = 2.0 / (1 + norm2);
   q[0] = (1 - norm2) / (1 + norm2);
   q[1] = p[0] * M;
   q[2] = p[1] * M;
   q[3] = p[2] * M;
 }
 
-void star_QuatToAxisAngle(double aa[4], const double q[4]) {
+STAR_KERNEL void star_QuatCayley(sfloat q[4], const sfloat phi[3]) {
+  const sfloat g[3] = {phi[0] / 2, phi[1] / 2, phi[2] / 2};
+  star_RodriguesParamToQuat(q, g);
+}
+
+STAR_KERNEL void star_QuatInvCayley(sfloat phi[3], const sfloat q[4]) {
+  star_QuatToRodriguesParam(phi, q);
+  phi[0] *= 2;
+  phi[1] *= 2;
+  phi[2] *= 2;
+}
+
+STAR_KERNEL void star_QuatError(sfloat phi[3], const sfloat q[4], const sfloat q_ref[4]) {
+  sfloat dq[4];
+  star_QuatDiff(dq, q, q_ref);
+  star_QuatInvCayley(phi, dq);
+}
+
+STAR_KERNEL void star_QuatAddError(sfloat q[4], const sfloat q_ref[4],
+                                   const sfloat phi[3]) {
+  sfloat dq[4];
+  star_QuatCayley(dq, phi);
+  star_QuatCompose(q, q_ref, dq);
+}
+
+STAR_KERNEL void star_QuatToAxisAngle(sfloat aa[4], const sfloat q[4]) {
   star_QuatLogm(aa + 1, q);
-  double theta = sqrt(aa[1] * aa[1] + aa[2] * aa[2] + aa[3] * aa[3]);
+  sfloat theta = sqrt(aa[1] * aa[1] + aa[2] * aa[2] + aa[3] * aa[3]);
   if (fabs(theta) < STAR_EPS) {
     aa[0] = 0;
     aa[1] = 1;
@@ -392,75 +714,75 @@ void star_QuatToAxisAngle(double aa[4], const double q[4]) {
   aa[3] /= theta;
 }
 
-void star_AxisAngleToQuat(double q[4], const double aa[4]) {
-  double theta = aa[0];
-  const double* u = aa + 1;
+STAR_KERNEL void star_AxisAngleToQuat(sfloat q[4], const sfloat aa[4]) {
+  sfloat theta = aa[0];
+  const sfloat* u = aa + 1;
   q[1] = u[0] * theta;
   q[2] = u[1] * theta;
   q[3] = u[2] * theta;
   star_QuatExpm(q, q + 1);
 }
 
-void star_QuatToEulerXYZ(double e[3], const double q[4]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
-
-  double Q23 = 2 * (yz - xw);
-  double Q33 = ww - xx - yy + zz;
-
-  double Q11 = ww + xx - yy - zz;
-  double Q12 = 2 * (xy - zw);
-  double Q13 = 2 * (xz + yw);
+STAR_KERNEL void star_QuatToEulerXYZ(sfloat e[3], const sfloat q[4]) {
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
+
+  sfloat Q23 = 2 * (yz - xw);
+  sfloat Q33 = ww - xx - yy + zz;
+
+  sfloat Q11 = ww + xx - yy - zz;
+  sfloat Q12 = 2 * (xy - zw);
+  sfloat Q13 = 2 * (xz + yw);
 
   e[0] = atan2(-Q23, Q33);
   e[1] = atan2(Q13, sqrt(Q11 * Q11 + Q12 * Q12));
   e[2] = atan2(-Q12, Q11);
 }
 
-// void star_EulerXYZToQuat(double q[4], const double e[3]) {
+// void star_EulerXYZToQuat(sfloat q[4], const sfloat e[3]) {
 //
 // }
 
-void star_QuatToEulerZYX(double e[3], const double q[4]) {
-  double w = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
-  double ww = w * w;
-  double xx = x * x;
-  double yy = y * y;
-  double zz = z * z;
-  double xy = x * y;
-  double zw = z * w;
-  double xz = x * z;
-  double yw = y * w;
-  double yz = y * z;
-  double xw = x * w;
-
-  double Q11 = ww + xx - yy - zz;
-  double Q21 = 2 * (xy + zw);
-  double Q31 = 2 * (xz - yw);
-  double Q32 = 2 * (yz + xw);
-  double Q33 = ww - xx - yy + zz;
+STAR_KERNEL void star_QuatToEulerZYX(sfloat e[3], const sfloat q[4]) {
+  sfloat w = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
+  sfloat ww = w * w;
+  sfloat xx = x * x;
+  sfloat yy = y * y;
+  sfloat zz = z * z;
+  sfloat xy = x * y;
+  sfloat zw = z * w;
+  sfloat xz = x * z;
+  sfloat yw = y * w;
+  sfloat yz = y * z;
+  sfloat xw = x * w;
+
+  sfloat Q11 = ww + xx - yy - zz;
+  sfloat Q21 = 2 * (xy + zw);
+  sfloat Q31 = 2 * (xz - yw);
+  sfloat Q32 = 2 * (yz + xw);
+  sfloat Q33 = ww - xx - yy + zz;
 
   e[0] = atan2(Q21, Q11);
   e[1] = atan2(-Q31, sqrt(Q32 * Q32 + Q33 * Q33));
   e[2] = atan2(Q32, Q33);
 }
 
-void star_SkewSymmetricMatrix(double S[9], const double x[3]) {
+STAR_KERNEL void star_SkewSymmetricMatrix(sfloat S[9], const sfloat x[3]) {
   S[0] = 0;
   S[1] = x[2];
   S[2] = -x[1];
@@ -474,13 +796,13 @@ void star_SkewSymmetricMatrix(double S[9], const double x[3]) {
   S[8] = 0;
 }
 
-void star_LMat(double L[16], const double q[4]) {
+STAR_KERNEL void star_LMat(sfloat L[16], const sfloat q[4]) {
   // L = [ s -v;
   //       v s*I + skew(v) ]
-  double s = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
+  sfloat s = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
 
   L[0] = s;
   L[1] = x;
@@ -503,13 +825,13 @@ void star_LMat(double L[16], const double q[4]) {
   L[15] = s;
 }
 
-void star_RMat(double R[16], const double q[4]) {
+STAR_KERNEL void star_RMat(sfloat R[16], const sfloat q[4]) {
   // R = [ s -v;
   //       v s*I - skew(v) ]
-  double s = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
+  sfloat s = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
 
   R[0] = s;
   R[1] = x;
@@ -532,11 +854,11 @@ void star_RMat(double R[16], const double q[4]) {
   R[15] = s;
 }
 
-void star_GMat(double G[12], const double q[4]) {
-  double s = q[0];
-  double x = q[1];
-  double y = q[2];
-  double z = q[3];
+STAR_KERNEL void star_GMat(sfloat G[12], const sfloat q[4]) {
+  sfloat s = q[0];
+  sfloat x = q[1];
+  sfloat y = q[2];
+  sfloat z = q[3];
 
   G[0] = -x;
   G[1] = s;
@@ -554,3 +876,123 @@ void star_GMat(double G[12], const double q[4]) {
   G[11] = s;
 
 }
+
+STAR_KERNEL void star_AttitudeProjectHessian(sfloat P[9], const sfloat q[4],
+                                             const sfloat H[16]) {
+  const sfloat s = q[0];
+  const sfloat x = q[1];
+  const sfloat y = q[2];
+  const sfloat z = q[3];
+
+  // Columns of G(q), see star_GMat
+  const sfloat G[3][4] = {{-x, s, z, -y}, {-y, -z, s, x}, {-z, y, -x, s}};
+
+  // Mirror the upper triangle of H
+  sfloat h[4][4];
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      h[i][j] = H[i + 4 * j];
+      h[j][i] = H[i + 4 * j];
+    }
+  }
+
+  // T = H G, one column at a time
+  sfloat T[3][4];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      T[j][i] =
+          h[i][0] * G[j][0] + h[i][1] * G[j][1] + h[i][2] * G[j][2] + h[i][3] * G[j][3];
+    }
+  }
+
+  // Upper triangle of P = G^T T
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      const sfloat p =
+          G[i][0] * T[j][0] + G[i][1] * T[j][1] + G[i][2] * T[j][2] + G[i][3] * T[j][3];
+      P[i + 3 * j] = p;
+      P[j + 3 * i] = p;
+    }
+  }
+}
+
+// Sum of the element-wise products x0 y0 + x1 y1 + x2 y2 + x3 y3 of arrays of 4 vectors
+#define star_SimdDot4(x, y)                                    \
+  star_SimdFmadd((x)[3], (y)[3],                               \
+                 star_SimdFmadd((x)[2], (y)[2],                \
+                                star_SimdFmadd((x)[1], (y)[1], \
+                                               star_SimdMul((x)[0], (y)[0]))))
+
+static inline void star_AttitudeProjectHessianBatch_Generic(sfloat* P, const sfloat* q,
+                                                            const sfloat* H, int n) {
+  int k = 0;
+#if STAR_SIMD_LANES > 0
+  // Blocks of quaternions and Hessians are transposed into these buffers, so that each
+  // register holds the same entry of STAR_SIMD_LANES consecutive problems
+  sfloat qb[4][STAR_SIMD_LANES];
+  sfloat hb[4][4][STAR_SIMD_LANES];
+  sfloat pb[3][3][STAR_SIMD_LANES];
+  const star_simd minus_one = star_SimdSet1(-1);
+  for (; k + STAR_SIMD_LANES <= n; k += STAR_SIMD_LANES) {
+    for (int l = 0; l < STAR_SIMD_LANES; ++l) {
+      const sfloat* ql = q + 4 * (k + l);
+      const sfloat* Hl = H + 16 * (k + l);
+      for (int i = 0; i < 4; ++i) {
+        qb[i][l] = ql[i];
+      }
+      for (int j = 0; j < 4; ++j) {
+        for (int i = 0; i <= j; ++i) {
+          hb[i][j][l] = Hl[i + 4 * j];
+        }
+      }
+    }
+
+    const star_simd s = star_SimdLoad(qb[0]);
+    const star_simd x = star_SimdLoad(qb[1]);
+    const star_simd y = star_SimdLoad(qb[2]);
+    const star_simd z = star_SimdLoad(qb[3]);
+    const star_simd nx = star_SimdMul(minus_one, x);
+    const star_simd ny = star_SimdMul(minus_one, y);
+    const star_simd nz = star_SimdMul(minus_one, z);
+    const star_simd G[3][4] = {{nx, s, z, ny}, {ny, nz, s, x}, {nz, y, nx, s}};
+
+    star_simd h[4][4];
+    for (int j = 0; j < 4; ++j) {
+      for (int i = 0; i <= j; ++i) {
+        h[i][j] = star_SimdLoad(hb[i][j]);
+        h[j][i] = h[i][j];
+      }
+    }
+
+    star_simd T[3][4];
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i < 4; ++i) {
+        T[j][i] = star_SimdDot4(h[i], G[j]);
+      }
+    }
+
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i <= j; ++i) {
+        star_SimdStore(pb[i][j], star_SimdDot4(G[i], T[j]));
+      }
+    }
+
+    for (int l = 0; l < STAR_SIMD_LANES; ++l) {
+      sfloat* Pl = P + 9 * (k + l);
+      for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i <= j; ++i) {
+          Pl[i + 3 * j] = pb[i][j][l];
+          Pl[j + 3 * i] = pb[i][j][l];
+        }
+      }
+    }
+  }
+#endif
+  for (; k < n; ++k) {
+    star_AttitudeProjectHessian(P + 9 * k, q + 4 * k, H + 16 * k);
+  }
+}
+STAR_DISPATCH(star_AttitudeProjectHessianBatch,
+              (sfloat* P, const sfloat* q, const sfloat* H, int n), (P, q, H, n))
+
+#undef star_SimdDot4
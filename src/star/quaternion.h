@@ -8,73 +8,130 @@
 #include "typedefs.h"
 
 // Scalar values
-double star_QuatNorm(const double q[4]);
-double star_QuatNormSquared(const double q[4]);
-double star_QuatVecNorm(const double q[4]);
-double star_QuatVecNormSquared(const double q[4]);
-double star_PrincipalAngle(const double q[4]);
-double star_QuatAngleBetween(const double q1[4], const double q2[4]);
+STAR_KERNEL sfloat star_QuatNorm(const sfloat q[4]);
+STAR_KERNEL sfloat star_QuatNormSquared(const sfloat q[4]);
+STAR_KERNEL sfloat star_QuatVecNorm(const sfloat q[4]);
+STAR_KERNEL sfloat star_QuatVecNormSquared(const sfloat q[4]);
+STAR_KERNEL sfloat star_PrincipalAngle(const sfloat q[4]);
+STAR_KERNEL sfloat star_QuatAngleBetween(const sfloat q1[4], const sfloat q2[4]);
 
 // Quaternion operations
-void star_QuatIdentity(double q[4]);
-void star_QuatNormalize(double q_normalized[4], const double q[4]);
-void star_QuatFlip(double q_flip[4], const double q[4]);
-void star_QuatVec(double vec[3], const double q[4]);
-void star_QuatConjugate(double q_conj[4], const double q[4]);
-void star_QuatInverse(double q_inv[4], const double q[4]);
-void star_QuatCompose(double q12[4], const double q1[4], const double q2[4]);
-void star_QuatComposeLeft(double q21[4], const double q1[4], const double q2[4]);
-void star_QuatDiff(double dq[4], const double q1[4], const double q2[4]);
+STAR_KERNEL void star_QuatIdentity(sfloat q[4]);
+STAR_KERNEL void star_QuatNormalize(sfloat q_normalized[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatFlip(sfloat q_flip[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatVec(sfloat vec[3], const sfloat q[4]);
+STAR_KERNEL void star_QuatConjugate(sfloat q_conj[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatInverse(sfloat q_inv[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatCompose(sfloat q12[4], const sfloat q1[4], const sfloat q2[4]);
+STAR_KERNEL void star_QuatComposeLeft(sfloat q21[4], const sfloat q1[4],
+                                      const sfloat q2[4]);
+STAR_KERNEL void star_QuatDiff(sfloat dq[4], const sfloat q1[4], const sfloat q2[4]);
 
 // Operations on vectors
-void star_QuatLogm(double phi[3], const double q[4]);
-void star_QuatLog(double q_log[4], const double q[4]);
-void star_QuatExpm(double q[4], const double phi[3]);
-void star_QuatExp(double q_exp[4], const double q[4]);
-void star_QuatRotateActive(double v_rot[3], const double q[4], const double v[3]);
-void star_QuatRotatePassive(double v_rot[3], const double q[4], const double v[3]);
-void star_QuatPure(double q[4], const double x[3]);
-void star_QuatComposePure(double qv[4], const double q[4], const double v[3]);
+STAR_KERNEL void star_QuatLogm(sfloat phi[3], const sfloat q[4]);
+STAR_KERNEL void star_QuatLog(sfloat q_log[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatExpm(sfloat q[4], const sfloat phi[3]);
+STAR_KERNEL void star_QuatExp(sfloat q_exp[4], const sfloat q[4]);
+STAR_KERNEL void star_QuatRotateActive(sfloat v_rot[3], const sfloat q[4],
+                                       const sfloat v[3]);
+STAR_KERNEL void star_QuatRotatePassive(sfloat v_rot[3], const sfloat q[4],
+                                        const sfloat v[3]);
+STAR_KERNEL void star_QuatPure(sfloat q[4], const sfloat x[3]);
+STAR_KERNEL void star_QuatComposePure(sfloat qv[4], const sfloat q[4], const sfloat v[3]);
+
+// Batched operations on n vectors stored as separate x, y, z arrays. The rotation matrix
+// is built once from q and the outputs may alias the inputs.
+STAR_KERNEL void star_QuatRotateActiveBatch(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot,
+                                            const sfloat q[4], const sfloat* x,
+                                            const sfloat* y, const sfloat* z, int n);
+STAR_KERNEL void star_QuatRotatePassiveBatch(sfloat* x_rot, sfloat* y_rot, sfloat* z_rot,
+                                             const sfloat q[4], const sfloat* x,
+                                             const sfloat* y, const sfloat* z, int n);
+
+// Interpolation between unit quaternions along the shorter arc. The slerp weights are
+// evaluated with a polynomial in cos(theta) instead of acos and sin.
+STAR_KERNEL void star_QuatSlerp(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                sfloat t);
+STAR_KERNEL void star_QuatNlerp(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                sfloat t);
+STAR_KERNEL void star_QuatSquad(sfloat q[4], const sfloat q0[4], const sfloat q1[4],
+                                const sfloat s0[4], const sfloat s1[4], sfloat t);
+STAR_KERNEL void star_QuatSquadControlPoint(sfloat s[4], const sfloat q_prev[4],
+                                            const sfloat q[4], const sfloat q_next[4]);
 
 // Conversions
-void star_QuatToRotMatActive(double Q[9], const double q[4]);
-void star_QuatToRotMatPassive(double Q[9], const double q[4]);
+STAR_KERNEL void star_QuatToRotMatActive(sfloat Q[9], const sfloat q[4]);
+STAR_KERNEL void star_QuatToRotMatPassive(sfloat Q[9], const sfloat q[4]);
 
-void star_QuatToRodriguesParam(double g[3], const double q[4]);
-void star_RodriguesParamToQuat(double q[4], const double g[3]);
+STAR_KERNEL void star_QuatToRodriguesParam(sfloat g[3], const sfloat q[4]);
+STAR_KERNEL void star_RodriguesParamToQuat(sfloat q[4], const sfloat g[3]);
 
-void star_QuatToMRP(double p[3], const double q[4]);
-void star_MRPToQuat(double q[4], const double p[3]);
+STAR_KERNEL void star_QuatToMRP(sfloat p[3], const sfloat q[4]);
+STAR_KERNEL void star_MRPToQuat(sfloat q[4], const sfloat p[3]);
 
-void star_QuatToAxisAngle(double aa[4], const double q[4]);
-void star_AxisAngleToQuat(double q[4], const double qq[4]);
+// Cayley map q = [1; phi / 2] / sqrt(1 + |phi / 2|^2), the Rodrigues parameters scaled like
+// star_QuatExpm so that phi is the rotation vector to first order
+STAR_KERNEL void star_QuatCayley(sfloat q[4], const sfloat phi[3]);
+STAR_KERNEL void star_QuatInvCayley(sfloat phi[3], const sfloat q[4]);
 
-void star_QuatToEulerXYZ(double e[3], const double q[4]);
-void star_EulerXYZToQuat(double q[4], const double e[3]);
+// Attitude error phi = InvCayley(q_ref^* q) and its inverse q = q_ref Cayley(phi)
+STAR_KERNEL void star_QuatError(sfloat phi[3], const sfloat q[4], const sfloat q_ref[4]);
+STAR_KERNEL void star_QuatAddError(sfloat q[4], const sfloat q_ref[4], const sfloat phi[3]);
 
-void star_QuatToEulerZYX(double e[3], const double q[4]);
-void star_EulerZYXToQuat(double q[4], const double e[3]);
+STAR_KERNEL void star_QuatToAxisAngle(sfloat aa[4], const sfloat q[4]);
+STAR_KERNEL void star_AxisAngleToQuat(sfloat q[4], const sfloat qq[4]);
 
-// Cardinal Rotations
-void star_QuatRotX(double q[4], double angle);
-void star_QuatRotY(double q[4], double angle);
-void star_QuatRotZ(double q[4], double angle);
-
-// Jacobians
-void star_QuatRotateActiveJacobian(double* D, const double q[4], const double x[3]);
-void star_QuatRotatePassiveJacobian(double* D, const double q[4], const double x[3]);
-
-// Matrices
-void star_SkewSymmetricMatrix(double S[9], const double x[3]);
-void star_LMat(double L[16], const double q[4]);
-void star_RMat(double R[16], const double q[4]);
-void star_GMat(double G[12], const double q[4]);
+STAR_KERNEL void star_QuatToEulerXYZ(sfloat e[3], const sfloat q[4]);
+void star_EulerXYZToQuat(sfloat q[4], const sfloat e[3]);
 
+STAR_KERNEL void star_QuatToEulerZYX(sfloat e[3], const sfloat q[4]);
+void star_EulerZYXToQuat(sfloat q[4], const sfloat e[3]);
 
+// Cardinal Rotations
+STAR_KERNEL void star_QuatRotX(sfloat q[4], sfloat angle);
+STAR_KERNEL void star_QuatRotY(sfloat q[4], sfloat angle);
+STAR_KERNEL void star_QuatRotZ(sfloat q[4], sfloat angle);
+
+// Jacobians, stored in column-major order. Those of functions of a quaternion are 3x4,
+// those of functions returning a quaternion are 4x3.
+STAR_KERNEL void star_QuatRotateActiveJacobian(sfloat* D, const sfloat q[4],
+                                               const sfloat x[3]);
+STAR_KERNEL void star_QuatRotatePassiveJacobian(sfloat* D, const sfloat q[4],
+                                                const sfloat x[3]);
+STAR_KERNEL void star_QuatExpmJacobian(sfloat D[12], const sfloat phi[3]);
+STAR_KERNEL void star_QuatLogmJacobian(sfloat D[12], const sfloat q[4]);
+STAR_KERNEL void star_QuatToRodriguesParamJacobian(sfloat D[12], const sfloat q[4]);
+STAR_KERNEL void star_RodriguesParamToQuatJacobian(sfloat D[12], const sfloat g[3]);
+STAR_KERNEL void star_QuatToMRPJacobian(sfloat D[12], const sfloat q[4]);
+STAR_KERNEL void star_MRPToQuatJacobian(sfloat D[12], const sfloat p[3]);
+STAR_KERNEL void star_QuatCayleyJacobian(sfloat D[12], const sfloat phi[3]);
+STAR_KERNEL void star_QuatInvCayleyJacobian(sfloat D[12], const sfloat q[4]);
 
-void qmat_err(double phi[3], const double q1[4], const double q2[4]);
-void qmat_adderr(double q[4], const double q0[4], const double phi[3]);
-
-void qmat_cay(double q[4], const double phi[3]);
-void qmat_icay(double phi[3], const double q[4]);
-void qmat_dcay(double* D, const double phi[3]);
+// Matrices
+STAR_KERNEL void star_SkewSymmetricMatrix(sfloat S[9], const sfloat x[3]);
+STAR_KERNEL void star_LMat(sfloat L[16], const sfloat q[4]);
+STAR_KERNEL void star_RMat(sfloat R[16], const sfloat q[4]);
+STAR_KERNEL void star_GMat(sfloat G[12], const sfloat q[4]);
+
+/*
+ * @brief Project a Hessian onto the attitude tangent space, P = G(q)^T H G(q)
+ *
+ * Gives the same 3x3 result as building G with star_GMat and multiplying, but reads the
+ * entries of G straight from q and only computes the upper triangle of P. H must be
+ * symmetric and only its upper triangle is read.
+ */
+STAR_KERNEL void star_AttitudeProjectHessian(sfloat P[9], const sfloat q[4],
+                                             const sfloat H[16]);
+
+/*
+ * @brief Batched star_AttitudeProjectHessian over n contiguous problems
+ *
+ * P, q and H point to n column-major 3x3 matrices, quaternions and 4x4 matrices. Vectorizes
+ * across problems.
+ */
+STAR_KERNEL void star_AttitudeProjectHessianBatch(sfloat* P, const sfloat* q,
+                                                  const sfloat* H, int n);
+
+#ifdef STAR_HEADER_ONLY
+#include "quaternion.c"
+#endif
@@ -0,0 +1,259 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "dispatch.h"
+#include "fastmath.h"
+#include "quaternion.h"
+#include "quaternion_array.h"
+
+#include <math.h>
+
+#define B STAR_BLOCK_SIZE
+
+STAR_KERNEL int star_NumBlocks(int n) { return (n + B - 1) / B; }
+
+/*---------------------------------*/
+/* Quaternion operations           */
+/*---------------------------------*/
+
+static inline void star_QuatNormalizeBlocked_Generic(sfloat* q_normalized, const sfloat* q,
+                                                     int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q + 4 * B * blk;
+    sfloat out[4 * B];
+    for (int l = 0; l < B; ++l) {
+      sfloat w = a[l];
+      sfloat x = a[B + l];
+      sfloat y = a[2 * B + l];
+      sfloat z = a[3 * B + l];
+      sfloat s = 1 / sqrt(w * w + x * x + y * y + z * z);
+      out[l] = w * s;
+      out[B + l] = x * s;
+      out[2 * B + l] = y * s;
+      out[3 * B + l] = z * s;
+    }
+    for (int i = 0; i < 4 * B; ++i) {
+      q_normalized[4 * B * blk + i] = out[i];
+    }
+  }
+}
+STAR_DISPATCH(star_QuatNormalizeBlocked, (sfloat* q_normalized, const sfloat* q, int n),
+              (q_normalized, q, n))
+
+static inline void star_QuatInverseBlocked_Generic(sfloat* q_inv, const sfloat* q, int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q + 4 * B * blk;
+    sfloat out[4 * B];
+    for (int l = 0; l < B; ++l) {
+      sfloat w = a[l];
+      sfloat x = a[B + l];
+      sfloat y = a[2 * B + l];
+      sfloat z = a[3 * B + l];
+      sfloat s = 1 / (w * w + x * x + y * y + z * z);
+      out[l] = w * s;
+      out[B + l] = -x * s;
+      out[2 * B + l] = -y * s;
+      out[3 * B + l] = -z * s;
+    }
+    for (int i = 0; i < 4 * B; ++i) {
+      q_inv[4 * B * blk + i] = out[i];
+    }
+  }
+}
+STAR_DISPATCH(star_QuatInverseBlocked, (sfloat* q_inv, const sfloat* q, int n),
+              (q_inv, q, n))
+
+static inline void star_QuatComposeBlocked_Generic(sfloat* q12, const sfloat* q1,
+                                                   const sfloat* q2, int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q1 + 4 * B * blk;
+    const sfloat* b = q2 + 4 * B * blk;
+    sfloat out[4 * B];
+    for (int l = 0; l < B; ++l) {
+      sfloat w1 = a[l];
+      sfloat x1 = a[B + l];
+      sfloat y1 = a[2 * B + l];
+      sfloat z1 = a[3 * B + l];
+      sfloat w2 = b[l];
+      sfloat x2 = b[B + l];
+      sfloat y2 = b[2 * B + l];
+      sfloat z2 = b[3 * B + l];
+      out[l] = w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2;
+      out[B + l] = x1 * w2 + w1 * x2 + y1 * z2 - z1 * y2;
+      out[2 * B + l] = y1 * w2 + z1 * x2 + w1 * y2 - x1 * z2;
+      out[3 * B + l] = z1 * w2 + w1 * z2 + x1 * y2 - y1 * x2;
+    }
+    for (int i = 0; i < 4 * B; ++i) {
+      q12[4 * B * blk + i] = out[i];
+    }
+  }
+}
+STAR_DISPATCH(star_QuatComposeBlocked,
+              (sfloat* q12, const sfloat* q1, const sfloat* q2, int n), (q12, q1, q2, n))
+
+static inline void star_QuatDiffBlocked_Generic(sfloat* dq, const sfloat* q1,
+                                                const sfloat* q2, int n) {
+  // conjugate(q2) * q1, as in star_QuatDiff
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q1 + 4 * B * blk;
+    const sfloat* b = q2 + 4 * B * blk;
+    sfloat out[4 * B];
+    for (int l = 0; l < B; ++l) {
+      sfloat w1 = a[l];
+      sfloat x1 = a[B + l];
+      sfloat y1 = a[2 * B + l];
+      sfloat z1 = a[3 * B + l];
+      sfloat w2 = b[l];
+      sfloat x2 = b[B + l];
+      sfloat y2 = b[2 * B + l];
+      sfloat z2 = b[3 * B + l];
+      out[l] = w2 * w1 + x2 * x1 + y2 * y1 + z2 * z1;
+      out[B + l] = -x2 * w1 + w2 * x1 - y2 * z1 + z2 * y1;
+      out[2 * B + l] = -y2 * w1 - z2 * x1 + w2 * y1 + x2 * z1;
+      out[3 * B + l] = -z2 * w1 + w2 * z1 - x2 * y1 + y2 * x1;
+    }
+    for (int i = 0; i < 4 * B; ++i) {
+      dq[4 * B * blk + i] = out[i];
+    }
+  }
+}
+STAR_DISPATCH(star_QuatDiffBlocked,
+              (sfloat* dq, const sfloat* q1, const sfloat* q2, int n), (dq, q1, q2, n))
+
+/*---------------------------------*/
+/* Operations on vectors           */
+/*---------------------------------*/
+
+// The logarithm and exponential evaluate both sides of the small-angle branch of
+// star_QuatLogm and star_QuatExpm in every lane and select the result, so the lanes of a
+// block run without branches.
+static inline void star_QuatLogmBlocked_Generic(sfloat* phi, const sfloat* q, int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q + 4 * B * blk;
+    sfloat* v = phi + 3 * B * blk;
+    for (int l = 0; l < B; ++l) {
+      sfloat w = a[l];
+      sfloat x = a[B + l];
+      sfloat y = a[2 * B + l];
+      sfloat z = a[3 * B + l];
+      sfloat theta = sqrt(x * x + y * y + z * z);
+      int small = theta < 1e-6;
+      int zero = fabs(w) < STAR_EPS;
+      sfloat w_safe = zero ? 1 : w;
+      sfloat M_series = zero ? 0 : (1 - theta * theta / (3 * w_safe * w_safe)) / w_safe;
+      sfloat theta_safe = small ? 1 : theta;
+      sfloat M = small ? M_series : star_Atan2(theta, w) / theta_safe;
+      v[l] = x * M * 2;
+      v[B + l] = y * M * 2;
+      v[2 * B + l] = z * M * 2;
+    }
+  }
+}
+STAR_DISPATCH(star_QuatLogmBlocked, (sfloat* phi, const sfloat* q, int n), (phi, q, n))
+
+static inline void star_QuatExpmBlocked_Generic(sfloat* q, const sfloat* phi, int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    sfloat* a = q + 4 * B * blk;
+    const sfloat* v = phi + 3 * B * blk;
+    for (int l = 0; l < B; ++l) {
+      sfloat x = v[l];
+      sfloat y = v[B + l];
+      sfloat z = v[2 * B + l];
+      sfloat theta = sqrt(x * x + y * y + z * z);
+      int small = theta < sqrt(STAR_EPS);
+      sfloat theta_safe = small ? 1 : theta;
+      sfloat s;
+      sfloat c;
+      star_SinCos(theta / 2, &s, &c);
+      // Second-order expansions of sin(theta / 2) / theta and cos(theta / 2)
+      sfloat s_theta = small ? 0.5 - theta * theta / 48 : s / theta_safe;
+      sfloat c_theta = small ? 1 - theta * theta / 8 : c;
+      a[l] = c_theta;
+      a[B + l] = x * s_theta;
+      a[2 * B + l] = y * s_theta;
+      a[3 * B + l] = z * s_theta;
+    }
+  }
+}
+STAR_DISPATCH(star_QuatExpmBlocked, (sfloat* q, const sfloat* phi, int n), (q, phi, n))
+
+static inline void star_QuatRotateActiveBlocked_Generic(sfloat* v_rot, const sfloat* q,
+                                                        const sfloat* v, int n) {
+  for (int blk = 0; blk < star_NumBlocks(n); ++blk) {
+    const sfloat* a = q + 4 * B * blk;
+    const sfloat* u = v + 3 * B * blk;
+    sfloat out[3 * B];
+    for (int l = 0; l < B; ++l) {
+      sfloat w = a[l];
+      sfloat x = a[B + l];
+      sfloat y = a[2 * B + l];
+      sfloat z = a[3 * B + l];
+      sfloat v0 = u[l];
+      sfloat v1 = u[B + l];
+      sfloat v2 = u[2 * B + l];
+      sfloat ww = w * w;
+      sfloat xx = x * x;
+      sfloat yy = y * y;
+      sfloat zz = z * z;
+      sfloat xy = x * y;
+      sfloat zw = z * w;
+      sfloat xz = x * z;
+      sfloat yw = y * w;
+      sfloat yz = y * z;
+      sfloat xw = x * w;
+      out[l] = (ww + xx - yy - zz) * v0 + 2 * (xy - zw) * v1 + 2 * (xz + yw) * v2;
+      out[B + l] = 2 * (xy + zw) * v0 + (ww - xx + yy - zz) * v1 + 2 * (yz - xw) * v2;
+      out[2 * B + l] = 2 * (xz - yw) * v0 + 2 * (yz + xw) * v1 + (ww - xx - yy + zz) * v2;
+    }
+    for (int i = 0; i < 3 * B; ++i) {
+      v_rot[3 * B * blk + i] = out[i];
+    }
+  }
+}
+STAR_DISPATCH(star_QuatRotateActiveBlocked,
+              (sfloat* v_rot, const sfloat* q, const sfloat* v, int n), (v_rot, q, v, n))
+
+/*---------------------------------*/
+/* Interpolation                   */
+/*---------------------------------*/
+
+static inline void star_QuatGetBlocked(sfloat qi[4], const sfloat* q, int i) {
+  const sfloat* a = q + 4 * B * (i / B) + i % B;
+  for (int k = 0; k < 4; ++k) {
+    qi[k] = a[k * B];
+  }
+}
+
+static inline void star_QuatSetBlocked(sfloat* q, int i, const sfloat qi[4]) {
+  sfloat* a = q + 4 * B * (i / B) + i % B;
+  for (int k = 0; k < 4; ++k) {
+    a[k * B] = qi[k];
+  }
+}
+
+STAR_KERNEL void star_QuatResampleBlocked(sfloat* q_out, const sfloat* t_out, int m,
+                                          const sfloat* q, const sfloat* t, int n) {
+  int k = 0;  // Start of the interval [t[k], t[k + 1]] holding the current query
+  for (int j = 0; j < m; ++j) {
+    sfloat q0[4];
+    sfloat q1[4];
+    sfloat qj[4];
+    while (k + 2 < n && t[k + 1] <= t_out[j]) {
+      ++k;
+    }
+    star_QuatGetBlocked(q0, q, k);
+    if (n == 1) {
+      star_QuatSetBlocked(q_out, j, q0);
+      continue;
+    }
+    star_QuatGetBlocked(q1, q, k + 1);
+    sfloat tau = (t_out[j] - t[k]) / (t[k + 1] - t[k]);
+    tau = tau < 0 ? 0 : tau > 1 ? 1 : tau;
+    star_QuatSlerp(qj, q0, q1, tau);
+    star_QuatSetBlocked(q_out, j, qj);
+  }
+}
+
+#undef B
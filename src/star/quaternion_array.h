@@ -0,0 +1,61 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "typedefs.h"
+
+/*
+ * Bulk operations on arrays of quaternions and 3-vectors in a blocked layout (AoSoA).
+ *
+ * The elements are grouped into blocks of STAR_BLOCK_SIZE. A block of quaternions stores
+ * the w components of its elements, then the x, y and z components, so quaternion i of an
+ * array q has components
+ *
+ *   q[4 * STAR_BLOCK_SIZE * (i / STAR_BLOCK_SIZE) + k * STAR_BLOCK_SIZE + i % STAR_BLOCK_SIZE]
+ *
+ * for k = 0, ..., 3. Blocks of 3-vectors are stored the same way with 3 components. Each
+ * component of a block fills a 64-byte cache line, so the kernels below run as loops over
+ * whole lines that vectorize for any SIMD width. Kernels process every block touched by
+ * the first n elements, so arrays must be allocated for a whole number of blocks and should
+ * be aligned to STAR_BLOCK_ALIGNMENT bytes. Outputs may alias the inputs.
+ */
+
+#define STAR_BLOCK_ALIGNMENT 64
+#ifdef STAR_SINGLE_PRECISION
+#define STAR_BLOCK_SIZE 16
+#else
+#define STAR_BLOCK_SIZE 8
+#endif
+
+// Number of blocks holding n elements
+STAR_KERNEL int star_NumBlocks(int n);
+
+// Quaternion operations
+STAR_KERNEL void star_QuatNormalizeBlocked(sfloat* q_normalized, const sfloat* q, int n);
+STAR_KERNEL void star_QuatInverseBlocked(sfloat* q_inv, const sfloat* q, int n);
+STAR_KERNEL void star_QuatComposeBlocked(sfloat* q12, const sfloat* q1, const sfloat* q2,
+                                         int n);
+STAR_KERNEL void star_QuatDiffBlocked(sfloat* dq, const sfloat* q1, const sfloat* q2, int n);
+
+// Operations on vectors
+STAR_KERNEL void star_QuatLogmBlocked(sfloat* phi, const sfloat* q, int n);
+STAR_KERNEL void star_QuatExpmBlocked(sfloat* q, const sfloat* phi, int n);
+STAR_KERNEL void star_QuatRotateActiveBlocked(sfloat* v_rot, const sfloat* q,
+                                              const sfloat* v, int n);
+
+/*
+ * @brief Interpolates a trajectory at new times in a single pass
+ *
+ * Slerps the n quaternions q sampled at the increasing times t to the m increasing query
+ * times t_out. Queries outside [t[0], t[n - 1]] take the value at the nearest end.
+ * Requires n >= 1.
+ */
+STAR_KERNEL void star_QuatResampleBlocked(sfloat* q_out, const sfloat* t_out, int m,
+                                          const sfloat* q, const sfloat* t, int n);
+
+#ifdef STAR_HEADER_ONLY
+#include "quaternion_array.c"
+#endif
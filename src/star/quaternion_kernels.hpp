@@ -0,0 +1,676 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+
+#include "star/fastmath.hpp"
+#include "star/typedefs.h"
+
+namespace star {
+
+/*
+ * Templated counterparts of the quaternion kernels in quaternion.h. Quat<T> calls them for
+ * every scalar type, sfloat as well as e.g. Dual<N> to differentiate a cost function
+ * through rotations, so both take the same branches.
+ *
+ * They follow the same algorithms and conventions as the C kernels: quaternions are stored
+ * as [w, x, y, z], matrices in column-major order, and the outputs may alias the inputs.
+ * The transcendental functions go through fastmath.hpp, so for sfloat the results agree
+ * with the C kernels in every STAR_FASTMATH tier. The small-angle branches test the
+ * squared angle, theta^2 < eps instead of theta < sqrt(eps), so that derivatives at the
+ * identity are finite.
+ */
+
+template <class T>
+inline void QuatConjugate(T q_conj[4], const T q[4]) {
+  q_conj[0] = q[0];
+  q_conj[1] = -q[1];
+  q_conj[2] = -q[2];
+  q_conj[3] = -q[3];
+}
+
+template <class T>
+inline void QuatNormalize(T q_normalized[4], const T q[4]) {
+  const T n = RSqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  for (int i = 0; i < 4; ++i) {
+    q_normalized[i] = q[i] * n;
+  }
+}
+
+template <class T>
+inline void QuatCompose(T q12[4], const T q1[4], const T q2[4]) {
+  T out[4];
+  out[0] = q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2] - q1[3] * q2[3];
+  out[1] = q1[1] * q2[0] + q1[0] * q2[1] + q1[2] * q2[3] - q1[3] * q2[2];
+  out[2] = q1[2] * q2[0] + q1[3] * q2[1] + q1[0] * q2[2] - q1[1] * q2[3];
+  out[3] = q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1];
+  for (int i = 0; i < 4; ++i) {
+    q12[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatToRotMatActive(T Q[9], const T q[4]) {
+  const T ww = q[0] * q[0];
+  const T xx = q[1] * q[1];
+  const T yy = q[2] * q[2];
+  const T zz = q[3] * q[3];
+  const T xy = q[1] * q[2];
+  const T zw = q[3] * q[0];
+  const T xz = q[1] * q[3];
+  const T yw = q[2] * q[0];
+  const T yz = q[2] * q[3];
+  const T xw = q[1] * q[0];
+  Q[0] = ww + xx - yy - zz;
+  Q[1] = 2 * (xy + zw);
+  Q[2] = 2 * (xz - yw);
+  Q[3] = 2 * (xy - zw);
+  Q[4] = ww - xx + yy - zz;
+  Q[5] = 2 * (yz + xw);
+  Q[6] = 2 * (xz + yw);
+  Q[7] = 2 * (yz - xw);
+  Q[8] = ww - xx - yy + zz;
+}
+
+template <class T>
+inline void QuatRotateActive(T v_rot[3], const T q[4], const T v[3]) {
+  T Q[9];
+  QuatToRotMatActive(Q, q);
+  T out[3];
+  for (int i = 0; i < 3; ++i) {
+    out[i] = Q[i] * v[0] + Q[i + 3] * v[1] + Q[i + 6] * v[2];
+  }
+  for (int i = 0; i < 3; ++i) {
+    v_rot[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatRotatePassive(T v_rot[3], const T q[4], const T v[3]) {
+  T Q[9];
+  QuatToRotMatActive(Q, q);
+  T out[3];
+  for (int i = 0; i < 3; ++i) {
+    out[i] = Q[3 * i] * v[0] + Q[3 * i + 1] * v[1] + Q[3 * i + 2] * v[2];
+  }
+  for (int i = 0; i < 3; ++i) {
+    v_rot[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatExpm(T q[4], const T phi[3]) {
+  using std::sqrt;
+  const T theta2 = phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+  T s_theta;
+  T c_theta;
+  if (theta2 < STAR_EPS) {
+    // Second-order expansions of sin(theta / 2) / theta and cos(theta / 2)
+    s_theta = 0.5 - theta2 / 48;
+    c_theta = 1 - theta2 / 8;
+  } else {
+    const T theta = sqrt(theta2);
+    SinCos(theta / 2, s_theta, c_theta);
+    s_theta /= theta;
+  }
+  q[1] = phi[0] * s_theta;
+  q[2] = phi[1] * s_theta;
+  q[3] = phi[2] * s_theta;
+  q[0] = c_theta;
+}
+
+template <class T>
+inline void QuatLogm(T phi[3], const T q[4]) {
+  using std::abs;
+  using std::sqrt;
+  const T theta2 = q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+  T M;
+  if (theta2 < 1e-12) {
+    if (abs(q[0]) < STAR_EPS) {
+      phi[0] = 0;
+      phi[1] = 0;
+      phi[2] = 0;
+      return;
+    }
+    M = (1 - theta2 / (3 * q[0] * q[0])) / q[0];
+  } else {
+    const T theta = sqrt(theta2);
+    M = Atan2(theta, q[0]) / theta;
+  }
+  phi[0] = 2 * M * q[1];
+  phi[1] = 2 * M * q[2];
+  phi[2] = 2 * M * q[3];
+}
+
+template <class T>
+inline T QuatVecNormSquared(const T q[4]) {
+  return q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+}
+
+template <class T>
+inline T QuatVecNorm(const T q[4]) {
+  using std::sqrt;
+  return sqrt(QuatVecNormSquared(q));
+}
+
+template <class T>
+inline void QuatDiff(T dq[4], const T q1[4], const T q2[4]) {
+  // conjugate(q2) * q1, the quaternion equivalent of q1 - q2
+  T out[4];
+  out[0] = +q2[0] * q1[0] + q2[1] * q1[1] + q2[2] * q1[2] + q2[3] * q1[3];
+  out[1] = -q2[1] * q1[0] + q2[0] * q1[1] - q2[2] * q1[3] + q2[3] * q1[2];
+  out[2] = -q2[2] * q1[0] - q2[3] * q1[1] + q2[0] * q1[2] + q2[1] * q1[3];
+  out[3] = -q2[3] * q1[0] + q2[0] * q1[3] - q2[1] * q1[2] + q2[2] * q1[1];
+  for (int i = 0; i < 4; ++i) {
+    dq[i] = out[i];
+  }
+}
+
+template <class T>
+inline T QuatAngleBetween(const T q1[4], const T q2[4]) {
+  T dq[4];
+  QuatDiff(dq, q1, q2);
+  return 2 * Atan2(QuatVecNorm(dq), dq[0]);
+}
+
+template <class T>
+inline void QuatComposeLeft(T q3[4], const T q1[4], const T q2[4]) {
+  QuatCompose(q3, q2, q1);
+}
+
+template <class T>
+inline void QuatComposePure(T qv[4], const T q1[4], const T v[3]) {
+  T out[4];
+  out[0] = -q1[1] * v[0] - q1[2] * v[1] - q1[3] * v[2];
+  out[1] = +q1[0] * v[0] + q1[2] * v[2] - q1[3] * v[1];
+  out[2] = +q1[3] * v[0] + q1[0] * v[1] - q1[1] * v[2];
+  out[3] = +q1[0] * v[2] + q1[1] * v[1] - q1[2] * v[0];
+  for (int i = 0; i < 4; ++i) {
+    qv[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatToRotMatPassive(T Q[9], const T q[4]) {
+  QuatToRotMatActive(Q, q);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = i + 1; j < 3; ++j) {
+      const T Qij = Q[i + 3 * j];
+      Q[i + 3 * j] = Q[j + 3 * i];
+      Q[j + 3 * i] = Qij;
+    }
+  }
+}
+
+template <class T>
+inline void QuatLog(T q_log[4], const T q[4]) {
+  using std::log;
+  using std::sqrt;
+  const T norm = sqrt(q[0] * q[0] + QuatVecNormSquared(q));
+  QuatLogm(q_log + 1, q);
+  q_log[0] = log(norm);
+  q_log[1] *= 0.5;
+  q_log[2] *= 0.5;
+  q_log[3] *= 0.5;
+}
+
+template <class T>
+inline void QuatExp(T q_exp[4], const T q[4]) {
+  using std::exp;
+  const T phi[3] = {2 * q[1], 2 * q[2], 2 * q[3]};
+  const T s = exp(q[0]);
+  QuatExpm(q_exp, phi);
+  for (int i = 0; i < 4; ++i) {
+    q_exp[i] *= s;
+  }
+}
+
+// Rotation by angle about the x (axis = 1), y (axis = 2) or z (axis = 3) axis
+template <class T>
+inline void QuatRotAxis(T q[4], const T& angle, int axis) {
+  T s;
+  T c;
+  SinCos(angle / 2, s, c);
+  q[0] = c;
+  q[1] = 0;
+  q[2] = 0;
+  q[3] = 0;
+  q[axis] = s;
+}
+
+/*-------------------------------------
+ * Interpolation
+ *-----------------------------------*/
+// Terms of the series of the slerp weights, which reach full precision for
+// cos(theta) >= 0.9, as in quaternion.c
+#ifdef STAR_SINGLE_PRECISION
+inline constexpr int kQuatSlerpTerms = 5;
+#else
+inline constexpr int kQuatSlerpTerms = 10;
+#endif
+
+// Slerp weight sin(t * theta) / sin(theta) given x = cos(theta), see star_SlerpWeight
+template <class T>
+inline T QuatSlerpWeight(const T& t, const T& x) {
+  const T y = x - 1;
+  const T t2 = t * t;
+  T b = t;
+  T f = t;
+  for (int i = 1; i <= kQuatSlerpTerms; ++i) {
+    b *= (t2 - i * i) * y / (i * (2 * i + 1));
+    f += b;
+  }
+  return f;
+}
+
+template <class T>
+inline void QuatSlerp(T q[4], const T q0[4], const T q1[4], T t) {
+  using std::sqrt;
+  T x = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+  const sfloat sign = x < 0 ? -1 : 1;
+  T a[4] = {q0[0], q0[1], q0[2], q0[3]};
+  T b[4] = {sign * q1[0], sign * q1[1], sign * q1[2], sign * q1[3]};
+  x *= sign;
+
+  // Bisect the arc until the series converges. Two steps suffice since x >= 0.
+  for (int k = 0; k < 2; ++k) {
+    if (x < 0.9) {
+      const T s = 1 / sqrt(2 + 2 * x);
+      T* end = t < 0.5 ? b : a;
+      for (int i = 0; i < 4; ++i) {
+        end[i] = (a[i] + b[i]) * s;
+      }
+      t = t < 0.5 ? 2 * t : 2 * t - 1;
+      x = (1 + x) * s;
+    }
+  }
+  const T w0 = QuatSlerpWeight(1 - t, x);
+  const T w1 = QuatSlerpWeight(t, x);
+  for (int i = 0; i < 4; ++i) {
+    q[i] = w0 * a[i] + w1 * b[i];
+  }
+}
+
+template <class T>
+inline void QuatNlerp(T q[4], const T q0[4], const T q1[4], const T& t) {
+  const T x = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+  const T w1 = x < 0 ? -t : t;
+  T out[4];
+  for (int i = 0; i < 4; ++i) {
+    out[i] = (1 - t) * q0[i] + w1 * q1[i];
+  }
+  QuatNormalize(q, out);
+}
+
+template <class T>
+inline void QuatSquad(T q[4], const T q0[4], const T q1[4], const T s0[4], const T s1[4],
+                      const T& t) {
+  T q01[4];
+  T s01[4];
+  QuatSlerp(q01, q0, q1, t);
+  QuatSlerp(s01, s0, s1, t);
+  QuatSlerp(q, q01, s01, T(2 * t * (1 - t)));
+}
+
+template <class T>
+inline void QuatSquadControlPoint(T s[4], const T q_prev[4], const T q[4],
+                                  const T q_next[4]) {
+  // s = q * exp(-(log(q^* q_next) + log(q^* q_prev)) / 4), along the shorter arcs
+  T dq[4];
+  T phi_next[3];
+  T phi_prev[3];
+  QuatDiff(dq, q_next, q);
+  if (dq[0] < 0) {
+    for (int i = 0; i < 4; ++i) {
+      dq[i] = -dq[i];
+    }
+  }
+  QuatLogm(phi_next, dq);
+  QuatDiff(dq, q_prev, q);
+  if (dq[0] < 0) {
+    for (int i = 0; i < 4; ++i) {
+      dq[i] = -dq[i];
+    }
+  }
+  QuatLogm(phi_prev, dq);
+
+  // Logm and Expm use phi = 2 log(q), so the factor of 2 cancels
+  T phi[3];
+  for (int i = 0; i < 3; ++i) {
+    phi[i] = -(phi_next[i] + phi_prev[i]) / 4;
+  }
+  QuatExpm(dq, phi);
+  QuatCompose(s, q, dq);
+}
+
+/*-------------------------------------
+ * Three-parameter Representations
+ *-----------------------------------*/
+template <class T>
+inline void QuatToRodriguesParam(T g[3], const T q[4]) {
+  using std::abs;
+  const T s = q[0];
+  if (abs(s) < STAR_EPS) {
+    g[0] = NAN;
+    g[1] = NAN;
+    g[2] = NAN;
+    return;
+  }
+  g[0] = q[1] / s;
+  g[1] = q[2] / s;
+  g[2] = q[3] / s;
+}
+
+template <class T>
+inline void RodriguesParamToQuat(T q[4], const T g[3]) {
+  using std::sqrt;
+  const T M = 1 / sqrt(1 + g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+  const T out[4] = {M, g[0] * M, g[1] * M, g[2] * M};
+  for (int i = 0; i < 4; ++i) {
+    q[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatToMRP(T p[3], const T q[4]) {
+  using std::abs;
+  const T s = q[0];
+  if (abs(s + 1) < STAR_EPS) {
+    p[0] = NAN;
+    p[1] = NAN;
+    p[2] = NAN;
+    return;
+  }
+  p[0] = q[1] / (1 + s);
+  p[1] = q[2] / (1 + s);
+  p[2] = q[3] / (1 + s);
+}
+
+template <class T>
+inline void MRPToQuat(T q[4], const T p[3]) {
+  const T norm2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+  const T M = 2 / (1 + norm2);
+  const T out[4] = {(1 - norm2) / (1 + norm2), p[0] * M, p[1] * M, p[2] * M};
+  for (int i = 0; i < 4; ++i) {
+    q[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatCayley(T q[4], const T phi[3]) {
+  const T g[3] = {phi[0] / 2, phi[1] / 2, phi[2] / 2};
+  RodriguesParamToQuat(q, g);
+}
+
+template <class T>
+inline void QuatInvCayley(T phi[3], const T q[4]) {
+  QuatToRodriguesParam(phi, q);
+  phi[0] *= 2;
+  phi[1] *= 2;
+  phi[2] *= 2;
+}
+
+template <class T>
+inline void QuatError(T phi[3], const T q[4], const T q_ref[4]) {
+  T dq[4];
+  QuatDiff(dq, q, q_ref);
+  QuatInvCayley(phi, dq);
+}
+
+template <class T>
+inline void QuatAddError(T q[4], const T q_ref[4], const T phi[3]) {
+  T dq[4];
+  QuatCayley(dq, phi);
+  QuatCompose(q, q_ref, dq);
+}
+
+/*-------------------------------------
+ * Matrices and Jacobians
+ *-----------------------------------*/
+template <class T>
+inline void LMat(T L[16], const T q[4]) {
+  // L = [ s -v;
+  //       v s*I + skew(v) ]
+  const T s = q[0];
+  const T x = q[1];
+  const T y = q[2];
+  const T z = q[3];
+  const T out[16] = {s, x, y, z, -x, s, z, -y, -y, -z, s, x, -z, y, -x, s};
+  for (int i = 0; i < 16; ++i) {
+    L[i] = out[i];
+  }
+}
+
+template <class T>
+inline void RMat(T R[16], const T q[4]) {
+  // R = [ s -v;
+  //       v s*I - skew(v) ]
+  const T s = q[0];
+  const T x = q[1];
+  const T y = q[2];
+  const T z = q[3];
+  const T out[16] = {s, x, y, z, -x, s, -z, y, -y, z, s, -x, -z, -y, x, s};
+  for (int i = 0; i < 16; ++i) {
+    R[i] = out[i];
+  }
+}
+
+template <class T>
+inline void GMat(T G[12], const T q[4]) {
+  const T s = q[0];
+  const T x = q[1];
+  const T y = q[2];
+  const T z = q[3];
+  const T out[12] = {-x, s, z, -y, -y, -z, s, x, -z, y, -x, s};
+  for (int i = 0; i < 12; ++i) {
+    G[i] = out[i];
+  }
+}
+
+template <class T>
+inline void QuatRotateActiveJacobian(T D[12], const T q[4], const T x[3]) {
+  D[0] = 2 * q[0] * x[0] + 2 * q[2] * x[2] - 2 * q[3] * x[1];
+  D[1] = 2 * q[3] * x[0] + 2 * q[0] * x[1] - 2 * q[1] * x[2];
+  D[2] = 2 * q[0] * x[2] + 2 * q[1] * x[1] - 2 * q[2] * x[0];
+
+  D[3] = 2 * q[1] * x[0] + 2 * q[2] * x[1] + 2 * q[3] * x[2];
+  D[4] = 2 * q[2] * x[0] - 2 * q[0] * x[2] - 2 * q[1] * x[1];
+  D[5] = 2 * q[3] * x[0] + 2 * q[0] * x[1] - 2 * q[1] * x[2];
+
+  D[6] = 2 * q[0] * x[2] + 2 * q[1] * x[1] - 2 * q[2] * x[0];
+  D[7] = 2 * q[1] * x[0] + 2 * q[2] * x[1] + 2 * q[3] * x[2];
+  D[8] = 2 * q[3] * x[1] - 2 * q[0] * x[0] - 2 * q[2] * x[2];
+
+  D[9] = 2 * q[1] * x[2] - 2 * q[3] * x[0] - 2 * q[0] * x[1];
+  D[10] = 2 * q[0] * x[0] + 2 * q[2] * x[2] - 2 * q[3] * x[1];
+  D[11] = 2 * q[1] * x[0] + 2 * q[2] * x[1] + 2 * q[3] * x[2];
+}
+
+template <class T>
+inline void QuatRotatePassiveJacobian(T D[12], const T q[4], const T x[3]) {
+  // A passive rotation is the active rotation by the conjugate
+  T q_conj[4];
+  QuatConjugate(q_conj, q);
+  QuatRotateActiveJacobian(D, q_conj, x);
+  for (int i = 3; i < 12; ++i) {
+    D[i] = -D[i];
+  }
+}
+
+template <class T>
+inline void QuatExpmJacobian(T D[12], const T phi[3]) {
+  // dq/dphi = [-s_theta / 2 phi^T; s_theta I + k phi phi^T], see star_QuatExpmJacobian
+  using std::sqrt;
+  const T theta2 = phi[0] * phi[0] + phi[1] * phi[1] + phi[2] * phi[2];
+  T s_theta;
+  T k;
+  if (theta2 < STAR_EPS) {
+    s_theta = 0.5 - theta2 / 48;
+    k = -1.0 / 24 + theta2 / 960;
+  } else {
+    const T theta = sqrt(theta2);
+    T c;
+    SinCos(theta / 2, s_theta, c);
+    s_theta /= theta;
+    k = (c / 2 - s_theta) / theta2;
+  }
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -s_theta / 2 * phi[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = k * phi[i] * phi[j];
+    }
+    D[1 + j + 4 * j] += s_theta;
+  }
+}
+
+template <class T>
+inline void QuatLogmJacobian(T D[12], const T q[4]) {
+  // dphi/ds = 2 v dM/ds and dphi/dv = 2 M I + 2 k v v^T, see star_QuatLogmJacobian
+  using std::abs;
+  using std::sqrt;
+  const T s = q[0];
+  const T* v = q + 1;
+  const T theta2 = QuatVecNormSquared(q);
+  T M;
+  T dM_ds;
+  T k;
+  if (theta2 < 1e-12) {
+    if (abs(s) < STAR_EPS) {
+      for (int i = 0; i < 12; ++i) {
+        D[i] = 0;
+      }
+      return;
+    }
+    const T s2 = s * s;
+    M = (1 - theta2 / (3 * s2)) / s;
+    dM_ds = (theta2 / s2 - 1) / s2;
+    k = -2 / (3 * s2 * s);
+  } else {
+    const T theta = sqrt(theta2);
+    const T n2 = s * s + theta2;
+    M = Atan2(theta, s) / theta;
+    dM_ds = -1 / n2;
+    k = (s / n2 - M) / theta2;
+  }
+  for (int i = 0; i < 3; ++i) {
+    D[i] = 2 * dM_ds * v[i];
+  }
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      D[i + 3 * (j + 1)] = 2 * k * v[i] * v[j];
+    }
+    D[j + 3 * (j + 1)] += 2 * M;
+  }
+}
+
+template <class T>
+inline void QuatToRodriguesParamJacobian(T D[12], const T q[4]) {
+  // g = v / s
+  const T s_inv = 1 / q[0];
+  for (int i = 0; i < 3; ++i) {
+    D[i] = -q[i + 1] * s_inv * s_inv;
+  }
+  for (int i = 3; i < 12; ++i) {
+    D[i] = 0;
+  }
+  D[3] = s_inv;
+  D[7] = s_inv;
+  D[11] = s_inv;
+}
+
+template <class T>
+inline void RodriguesParamToQuatJacobian(T D[12], const T g[3]) {
+  // q = M [1; g] with M = (1 + g^T g)^(-1/2), so dM/dg = -M^3 g^T
+  using std::sqrt;
+  const T M = 1 / sqrt(1 + g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+  const T M3 = M * M * M;
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -M3 * g[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = -M3 * g[i] * g[j];
+    }
+    D[1 + j + 4 * j] += M;
+  }
+}
+
+template <class T>
+inline void QuatToMRPJacobian(T D[12], const T q[4]) {
+  // p = v / (1 + s)
+  const T a = 1 / (1 + q[0]);
+  for (int i = 0; i < 3; ++i) {
+    D[i] = -q[i + 1] * a * a;
+  }
+  for (int i = 3; i < 12; ++i) {
+    D[i] = 0;
+  }
+  D[3] = a;
+  D[7] = a;
+  D[11] = a;
+}
+
+template <class T>
+inline void MRPToQuatJacobian(T D[12], const T p[3]) {
+  // q = [(1 - n) / (1 + n); 2 p / (1 + n)] with n = p^T p
+  const T a = 1 / (1 + p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  for (int j = 0; j < 3; ++j) {
+    D[4 * j] = -4 * a * a * p[j];
+    for (int i = 0; i < 3; ++i) {
+      D[1 + i + 4 * j] = -4 * a * a * p[i] * p[j];
+    }
+    D[1 + j + 4 * j] += 2 * a;
+  }
+}
+
+template <class T>
+inline void QuatCayleyJacobian(T D[12], const T phi[3]) {
+  const T g[3] = {phi[0] / 2, phi[1] / 2, phi[2] / 2};
+  RodriguesParamToQuatJacobian(D, g);
+  for (int i = 0; i < 12; ++i) {
+    D[i] /= 2;
+  }
+}
+
+template <class T>
+inline void QuatInvCayleyJacobian(T D[12], const T q[4]) {
+  QuatToRodriguesParamJacobian(D, q);
+  for (int i = 0; i < 12; ++i) {
+    D[i] *= 2;
+  }
+}
+
+// G(q)^T H G(q) for a symmetric H, reading only its upper triangle
+template <class T>
+inline void AttitudeProjectHessian(T P[9], const T q[4], const T H[16]) {
+  T G[12];
+  GMat(G, q);
+
+  // T = H G, one column at a time
+  T HG[12];
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      T sum = 0;
+      for (int k = 0; k < 4; ++k) {
+        sum += (i <= k ? H[i + 4 * k] : H[k + 4 * i]) * G[k + 4 * j];
+      }
+      HG[i + 4 * j] = sum;
+    }
+  }
+
+  // Upper triangle of P = G^T H G
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      T p = 0;
+      for (int k = 0; k < 4; ++k) {
+        p += G[k + 4 * i] * HG[k + 4 * j];
+      }
+      P[i + 3 * j] = p;
+      P[j + 3 * i] = p;
+    }
+  }
+}
+
+}  // namespace star
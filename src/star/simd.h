@@ -0,0 +1,69 @@
+//
+// Created by Brian Jackson on 5/6/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include "star/dispatch.h"
+#include "star/typedefs.h"
+
+/*
+ * Portable SIMD vectors used by the batched kernels, built on the vector extensions of GCC
+ * and Clang. A star_simd holds STAR_SIMD_LANES values of type sfloat, and the compiler
+ * lowers its operations to the instruction set of the function using them, so kernels
+ * defined with STAR_DISPATCH get AVX2 or AVX-512 code with fused multiply-adds in their
+ * dispatched variants from a single body.
+ *
+ * Vectors are 256 bits wide whenever the kernels may run on AVX, which is faster than
+ * 512 bits for the batched kernels even on AVX-512 hosts, since their blocks fit the
+ * register file and transpose with less traffic. Builds that can only target 128-bit
+ * instruction sets, e.g. SSE2 without runtime dispatch, use 128-bit vectors.
+ *
+ * The operations are macros rather than functions, since passing vectors wider than the
+ * registers of the baseline by value would change the ABI between the dispatched variants.
+ *
+ * Without vector extensions, STAR_SIMD_LANES is 0 and the batched kernels fall back to
+ * their scalar loops.
+ */
+
+#if defined(__GNUC__)
+
+#if defined(STAR_DISPATCH_ENABLED) || defined(__AVX__)
+#define STAR_SIMD_BYTES 32
+#else
+#define STAR_SIMD_BYTES 16
+#endif
+
+#ifdef STAR_SINGLE_PRECISION
+#define STAR_SIMD_LANES (STAR_SIMD_BYTES / 4)
+#else
+#define STAR_SIMD_LANES (STAR_SIMD_BYTES / 8)
+#endif
+
+typedef sfloat star_simd __attribute__((vector_size(STAR_SIMD_BYTES)));
+
+// View of STAR_SIMD_LANES consecutive values of an sfloat array, at any alignment
+typedef sfloat star_simd_unaligned
+    __attribute__((vector_size(STAR_SIMD_BYTES), aligned(sizeof(sfloat)), may_alias));
+
+#ifdef __cplusplus
+#define STAR_SIMD_ZERO (star_simd{})
+#else
+#define STAR_SIMD_ZERO ((star_simd){0})
+#endif
+
+#define star_SimdLoad(x) (*(const star_simd_unaligned*)(x))
+#define star_SimdStore(x, v) (*(star_simd_unaligned*)(x) = (v))
+#define star_SimdSet1(a) (STAR_SIMD_ZERO + (sfloat)(a))
+#define star_SimdAdd(a, b) ((a) + (b))
+#define star_SimdMul(a, b) ((a) * (b))
+
+// Contracted into a fused multiply-add on targets that have one
+#define star_SimdFmadd(a, b, c) ((a) * (b) + (c))
+
+#else
+
+#define STAR_SIMD_LANES 0
+
+#endif
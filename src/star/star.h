@@ -3,4 +3,15 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include "star/attitude.h"
+#include "star/dispatch.h"
+#include "star/lie.h"
+#include "star/matrix3.h"
+#include "star/matrix4.h"
+#include "star/matrix43.h"
+#include "star/quaternion.h"
+#include "star/quaternion_array.h"
+#include "star/vector3.h"
+#include "star/vector4.h"
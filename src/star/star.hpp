@@ -5,4 +5,27 @@
 
 #pragma once
 
-#include "Vec3.hpp"
\ No newline at end of file
+#include "star/AttitudeProfile.hpp"
+#include "star/Dual.hpp"
+#include "star/Expression.hpp"
+#include "star/Mat3.hpp"
+#include "star/Mat4.hpp"
+#include "star/Mat43.hpp"
+#include "star/Matrix.hpp"
+#include "star/MatrixBase.hpp"
+#include "star/Mekf.hpp"
+#include "star/MekfBank.hpp"
+#include "star/Pose.hpp"
+#include "star/Preintegrator.hpp"
+#include "star/Quaternion.hpp"
+#include "star/QuaternionArray.hpp"
+#include "star/RotMat.hpp"
+#include "star/RotationOperator.hpp"
+#include "star/Transpose.hpp"
+#include "star/Vec3.hpp"
+#include "star/Vec4.hpp"
+#include "star/Workspace.hpp"
+#include "star/lie_groups.hpp"
+#include "star/matrix_kernels.hpp"
+#include "star/matrix_multiplication.hpp"
+#include "star/quaternion_kernels.hpp"
@@ -11,10 +11,32 @@ typedef STAR_FLOAT sfloat;
 typedef double sfloat;
 #endif
 
+// Detect single precision at preprocessing time, e.g. to select SIMD instructions
+#define STAR_CONCAT_(a, b) a##b
+#define STAR_CONCAT(a, b) STAR_CONCAT_(a, b)
+#define STAR_IS_SINGLE_float 1
+#if defined(STAR_FLOAT) && STAR_CONCAT(STAR_IS_SINGLE_, STAR_FLOAT)
+#define STAR_SINGLE_PRECISION
+#endif
+
 #define STAR_EPS 1e-8
 
+// Linkage of the kernels. With STAR_HEADER_ONLY every C kernel and C++ method is defined in
+// its header, so calls can be inlined across the C/C++ boundary without LTO.
+#ifdef STAR_HEADER_ONLY
+#define STAR_KERNEL static inline
+#define STAR_INLINE inline
+#else
+#define STAR_KERNEL
+#define STAR_INLINE
+#endif
+
 // check if c++
 #ifdef __cplusplus
 #include <utility>
 using IndexPair = std::pair<int, int>;
+
+// True while a constexpr function is evaluated at compile time, where it can't call the C
+// kernels. Equivalent to C++20's std::is_constant_evaluated().
+#define STAR_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 #endif
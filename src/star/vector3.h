@@ -81,58 +81,22 @@ static inline void star_Normalize3(sfloat out[3], const sfloat x[3]) {
   out[2] *= inv_norm;
 }
 
-sfloat star_Dot3(const sfloat x[3], const sfloat y[3]) {
-  return x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
-}
-
-void star_Cross(sfloat out[3], const sfloat x[3], const sfloat y[3]) {
-  out[0] = x[1] * y[2] - x[2] * y[1];
-  out[1] = x[2] * y[0] - x[0] * y[2];
-  out[2] = x[0] * y[1] - x[1] * y[0];
-}
+STAR_KERNEL sfloat star_Dot3(const sfloat x[3], const sfloat y[3]);
+STAR_KERNEL void star_Cross(sfloat out[3], const sfloat x[3], const sfloat y[3]);
 
 /*---------------------------------*/
 /* Element-wise operations         */
 /*---------------------------------*/
-void star_Add3(sfloat out[3], const sfloat x[3], const sfloat y[3]) {
-  out[0] = x[0] + y[0];
-  out[1] = x[1] + y[1];
-  out[2] = x[2] + y[2];
-}
-
-void star_Sub3(sfloat out[3], const sfloat x[3], const sfloat y[3]) {
-  out[0] = x[0] - y[0];
-  out[1] = x[1] - y[1];
-  out[2] = x[2] - y[2];
-}
-
-void star_Mul3(sfloat out[3], const sfloat x[3], const sfloat y[3]) {
-  out[0] = x[0] * y[0];
-  out[1] = x[1] * y[1];
-  out[2] = x[2] * y[2];
-}
-
-void star_Div3(sfloat out[3], const sfloat x[3], const sfloat y[3]) {
-  out[0] = x[0] / y[0];
-  out[1] = x[1] / y[1];
-  out[2] = x[2] / y[2];
-}
-
-void star_Scale3(sfloat out[3], sfloat scale, const sfloat x[3]) {
-  out[0] = x[0] * scale;
-  out[1] = x[1] * scale;
-  out[2] = x[2] * scale;
-}
-
-void star_UnaryMap(sfloat out[3], const sfloat x[3], sfloat (*function)(sfloat)) {
-  out[0] = function(x[0]);
-  out[1] = function(x[1]);
-  out[2] = function(x[2]);
-}
-
-void star_BinaryMap(sfloat out[3], const sfloat x[3], const sfloat y[3],
-                    sfloat (*function)(sfloat, sfloat)) {
-  out[0] = function(x[0], y[0]);
-  out[1] = function(x[1], y[1]);
-  out[2] = function(x[2], y[2]);
-}
+STAR_KERNEL void star_Add3(sfloat out[3], const sfloat x[3], const sfloat y[3]);
+STAR_KERNEL void star_Sub3(sfloat out[3], const sfloat x[3], const sfloat y[3]);
+STAR_KERNEL void star_Mul3(sfloat out[3], const sfloat x[3], const sfloat y[3]);
+STAR_KERNEL void star_Div3(sfloat out[3], const sfloat x[3], const sfloat y[3]);
+STAR_KERNEL void star_Scale3(sfloat out[3], sfloat scale, const sfloat x[3]);
+STAR_KERNEL void star_UnaryMap(sfloat out[3], const sfloat x[3],
+                               sfloat (*function)(sfloat));
+STAR_KERNEL void star_BinaryMap(sfloat out[3], const sfloat x[3], const sfloat y[3],
+                                sfloat (*function)(sfloat, sfloat));
+
+#ifdef STAR_HEADER_ONLY
+#include "vector3.c"
+#endif
@@ -59,52 +59,20 @@ static inline void star_Normalize4(sfloat out[4], const sfloat x[4]) {
   out[3] *= inv_norm;
 }
 
-sfloat star_Dot4(const sfloat x[4], const sfloat y[4]) {
-  return x[0] * y[0] + x[1] * y[1] + x[2] * y[2] + x[3] * y[3];
-}
+STAR_KERNEL sfloat star_Dot4(const sfloat x[4], const sfloat y[4]);
 
 /*---------------------------------*/
 /* Element-wise operations         */
 /*---------------------------------*/
-void star_Add4(sfloat out[4], const sfloat x[4], const sfloat y[4]) {
-  out[0] = x[0] + y[0];
-  out[1] = x[1] + y[1];
-  out[2] = x[2] + y[2];
-  out[3] = x[3] + y[3];
-}
-
-void star_Sub4(sfloat out[4], const sfloat x[4], const sfloat y[4]) {
-  out[0] = x[0] - y[0];
-  out[1] = x[1] - y[1];
-  out[2] = x[2] - y[2];
-  out[3] = x[3] - y[3];
-}
-
-void star_Mul4(sfloat out[4], const sfloat x[4], const sfloat y[4]) {
-  out[0] = x[0] * y[0];
-  out[1] = x[1] * y[1];
-  out[2] = x[2] * y[2];
-  out[3] = x[3] * y[3];
-}
-
-void star_Div4(sfloat out[4], const sfloat x[4], const sfloat y[4]) {
-  out[0] = x[0] / y[0];
-  out[1] = x[1] / y[1];
-  out[2] = x[2] / y[2];
-  out[3] = x[3] / y[3];
-}
-
-void star_UnaryMap4(sfloat out[4], const sfloat x[4], sfloat (*function)(sfloat)) {
-  out[0] = function(x[0]);
-  out[1] = function(x[1]);
-  out[2] = function(x[2]);
-  out[3] = function(x[3]);
-}
-
-void star_BinaryMap4(sfloat out[4], const sfloat x[4], const sfloat y[4],
-                    sfloat (*function)(sfloat, sfloat)) {
-  out[0] = function(x[0], y[0]);
-  out[1] = function(x[1], y[1]);
-  out[2] = function(x[2], y[2]);
-  out[3] = function(x[3], y[3]);
-}
+STAR_KERNEL void star_Add4(sfloat out[4], const sfloat x[4], const sfloat y[4]);
+STAR_KERNEL void star_Sub4(sfloat out[4], const sfloat x[4], const sfloat y[4]);
+STAR_KERNEL void star_Mul4(sfloat out[4], const sfloat x[4], const sfloat y[4]);
+STAR_KERNEL void star_Div4(sfloat out[4], const sfloat x[4], const sfloat y[4]);
+STAR_KERNEL void star_UnaryMap4(sfloat out[4], const sfloat x[4],
+                                sfloat (*function)(sfloat));
+STAR_KERNEL void star_BinaryMap4(sfloat out[4], const sfloat x[4], const sfloat y[4],
+                                 sfloat (*function)(sfloat, sfloat));
+
+#ifdef STAR_HEADER_ONLY
+#include "vector4.c"
+#endif
@@ -0,0 +1,200 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "star/AttitudeProfile.hpp"
+
+extern "C" {
+#include "star/attitude.h"
+#include "star/fastmath.h"
+}
+
+using namespace star;
+
+// Well-conditioned problems lose a few digits in the closed forms of QUEST and ESOQ2. The
+// Newton iteration runs until rounding stops it, so the eigenvalue does not limit them to
+// sqrt(eps). Tolerances include the error of the configured STAR_FASTMATH tier.
+static const sfloat kTol = 1e3 * std::numeric_limits<sfloat>::epsilon() +
+                           10 * STAR_FASTMATH_TOL;
+
+// Directions of a few stars in the reference frame, spread over the sky
+static std::vector<Vec3> References() {
+  return {Vec3(1, 0, 0), Vec3(0, 0.6, 0.8), Vec3(-0.48, 0.6, -0.64), Vec3(0.36, -0.48, 0.8),
+          Vec3(0, -1, 0)};
+}
+
+static std::vector<Vec3> Measure(const Quaternion& q, const std::vector<Vec3>& references) {
+  std::vector<Vec3> body;
+  for (const Vec3& r : references) {
+    body.push_back(q.RotatePassive(r));
+  }
+  return body;
+}
+
+// Attitudes covering the singularities of QUEST (180 degrees) and ESOQ2 (the identity)
+static std::vector<Quaternion> TestAttitudes() {
+  return {Quaternion::Identity(),
+          Quaternion::Expm(Vec3(1e-4, -2e-4, 5e-5)),
+          Quaternion::Expm(Vec3(0.3, -1.2, 0.5)),
+          Quaternion::RotX(M_PI),
+          Quaternion::RotY(M_PI),
+          Quaternion::FromAxisAngle(M_PI, Vec3(1, 2, -2).Normalize()),
+          Quaternion::FromAxisAngle(M_PI - 1e-4, Vec3(-3, 1, 2).Normalize()),
+          Quaternion(0.1, -0.7, 0.4, 0.5).Normalize()};
+}
+
+static AttitudeProfile Profile(const Quaternion& q) {
+  const std::vector<Vec3> references = References();
+  const std::vector<Vec3> body = Measure(q, references);
+  const std::vector<sfloat> weights = {1, 2, 0.5, 1, 3};
+  return {body.data(), references.data(), weights.data(), static_cast<int>(body.size())};
+}
+
+static sfloat MaxAbsDiff(const Mat3& A, const Mat3& B) {
+  sfloat diff = 0;
+  for (int k = 0; k < 9; ++k) {
+    diff = std::max(diff, std::abs(A[k] - B[k]));
+  }
+  return diff;
+}
+
+static sfloat AngleBetween(const Quaternion& q, const Quaternion& q_ref) {
+  return q.Error(q_ref).Norm();
+}
+
+TEST(Attitude, SolversRecoverAttitude) {
+  for (const Quaternion& q : TestAttitudes()) {
+    const AttitudeProfile profile = Profile(q);
+    for (const AttitudeEstimate& estimate :
+         {profile.Quest(), profile.Esoq2(), profile.DavenportQ()}) {
+      EXPECT_LT(AngleBetween(estimate.attitude, q), kTol);
+      EXPECT_NEAR(estimate.attitude.Norm(), 1, kTol);
+      EXPECT_GE(estimate.attitude.w, 0);
+      EXPECT_NEAR(estimate.loss, 0, kTol * profile.WeightSum());
+      EXPECT_TRUE(estimate.observable);
+    }
+  }
+}
+
+TEST(Attitude, SolversAgreeWithNoise) {
+  const Quaternion q = Quaternion(0.9, 0.2, -0.3, 0.1).Normalize();
+  const std::vector<Vec3> references = References();
+  std::vector<Vec3> body = Measure(q, references);
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<sfloat> dist(-1e-3, 1e-3);
+  for (Vec3& b : body) {
+    b = Vec3(b + Vec3(dist(gen), dist(gen), dist(gen))).Normalize();
+  }
+  const std::vector<sfloat> weights = {1, 1, 2, 1, 0.5};
+  const AttitudeProfile profile(body.data(), references.data(), weights.data(), 5);
+
+  // The q-method minimizes the loss, which it reports
+  const AttitudeEstimate q_method = profile.DavenportQ();
+  sfloat loss = 0;
+  for (int i = 0; i < 5; ++i) {
+    const Vec3 r = Vec3(body[i] - q_method.attitude.RotatePassive(references[i]));
+    loss += weights[i] * r.Dot(r) / 2;
+  }
+  EXPECT_NEAR(q_method.loss, loss, kTol * profile.WeightSum());
+  EXPECT_GT(loss, 0);
+  EXPECT_LT(AngleBetween(q_method.attitude, q), 1e-2);
+  for (const AttitudeEstimate& estimate : {profile.Quest(), profile.Esoq2()}) {
+    EXPECT_LT(AngleBetween(estimate.attitude, q_method.attitude), kTol);
+    EXPECT_NEAR(estimate.loss, q_method.loss, kTol * profile.WeightSum());
+  }
+}
+
+TEST(Attitude, Covariance) {
+  // Noise-free, the covariance is the inverse of sum_i w_i (I - b_i b_i^T)
+  const Quaternion q = Quaternion(0.1, -0.7, 0.4, 0.5).Normalize();
+  const std::vector<Vec3> references = References();
+  const std::vector<Vec3> body = Measure(q, references);
+  const std::vector<sfloat> weights = {1e4, 2e4, 5e3, 1e4, 3e4};
+  const AttitudeProfile profile(body.data(), references.data(), weights.data(), 5);
+  Mat3 F = Mat3::Zero();
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        F(j, k) += weights[i] * ((j == k) - body[i][j] * body[i][k]);
+      }
+    }
+  }
+  const Mat3 P = F.Inverse();
+  const AttitudeEstimate estimate = profile.Quest();
+  ASSERT_TRUE(estimate.observable);
+  EXPECT_LT(MaxAbsDiff(estimate.covariance, P), kTol * MaxAbsDiff(P, Mat3::Zero()));
+
+  // A single direction leaves the rotation about it unobservable
+  AttitudeProfile single;
+  single.Add(body[0], references[0], 1e4);
+  const AttitudeEstimate partial = single.DavenportQ();
+  EXPECT_FALSE(partial.observable);
+  EXPECT_LT(Vec3(partial.attitude.RotatePassive(references[0]) - body[0]).Norm(), kTol);
+}
+
+TEST(Attitude, Accumulation) {
+  // Partial blocks, one and several blocks
+  for (int n : {5, STAR_BLOCK_SIZE, 3 * STAR_BLOCK_SIZE + 5}) {
+    std::mt19937 gen(n);
+    std::uniform_real_distribution<sfloat> dist(-1, 1);
+    std::vector<Vec3> body(n);
+    std::vector<Vec3> references(n);
+    std::vector<sfloat> weights(n);
+    Vec3Array body_blocked(n);
+    Vec3Array references_blocked(n);
+    AttitudeProfile single;
+    for (int i = 0; i < n; ++i) {
+      body[i] = Vec3(dist(gen), dist(gen), dist(gen)).Normalize();
+      references[i] = Vec3(dist(gen), dist(gen), dist(gen)).Normalize();
+      weights[i] = 1 + dist(gen) / 2;
+      body_blocked.Set(i, body[i]);
+      references_blocked.Set(i, references[i]);
+      single.Add(body[i], references[i], weights[i]);
+    }
+    const AttitudeProfile batch(body.data(), references.data(), weights.data(), n);
+    AttitudeProfile blocked;
+    blocked.Add(body_blocked, references_blocked, weights.data());
+
+    // Profiles of two chunks merge into the profile of both
+    const int half = n / 2;
+    AttitudeProfile merged(body.data(), references.data(), weights.data(), half);
+    merged.Add(AttitudeProfile(body.data() + half, references.data() + half,
+                               weights.data() + half, n - half));
+
+    for (const AttitudeProfile* profile :
+         std::initializer_list<const AttitudeProfile*>{&batch, &blocked, &merged}) {
+      EXPECT_NEAR(profile->WeightSum(), single.WeightSum(), kTol * n);
+      EXPECT_LT(MaxAbsDiff(profile->ProfileMatrix(), single.ProfileMatrix()), kTol * n);
+    }
+  }
+  AttitudeProfile profile = Profile(Quaternion::Identity());
+  profile.Reset();
+  EXPECT_EQ(profile.WeightSum(), 0);
+  EXPECT_EQ(MaxAbsDiff(profile.ProfileMatrix(), Mat3::Zero()), 0);
+}
+
+TEST(Attitude, ChooseFrameRotation) {
+  // The C kernels solve the problems of the rotated frames directly from B
+  for (const Quaternion& q : TestAttitudes()) {
+    const AttitudeProfile profile = Profile(q);
+    const Mat3& B = profile.ProfileMatrix();
+    Quaternion q_quest;
+    Quaternion q_esoq;
+    const sfloat lambda_quest = star_Quest(q_quest.data(), B.data(), profile.WeightSum());
+    const sfloat lambda_esoq = star_Esoq2(q_esoq.data(), B.data(), profile.WeightSum());
+    EXPECT_NEAR(lambda_quest, profile.WeightSum(), kTol * profile.WeightSum());
+    EXPECT_NEAR(lambda_esoq, profile.WeightSum(), kTol * profile.WeightSum());
+    EXPECT_LT(AngleBetween(q_quest, q), kTol);
+    EXPECT_LT(AngleBetween(q_esoq, q), kTol);
+  }
+}
@@ -0,0 +1,211 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "star/star.h"
+}
+
+// Variants may contract products into fused multiply-adds, so results differ in rounding
+constexpr sfloat TOL = 100 * std::numeric_limits<sfloat>::epsilon();
+
+template <int N>
+static void ExpectNear(const sfloat (&x)[N], const sfloat (&y)[N]) {
+  for (int i = 0; i < N; ++i) {
+    EXPECT_NEAR(x[i], y[i], TOL * (1 + std::abs(y[i])));
+  }
+}
+
+TEST(Dispatch, SetIsa) {
+  star_Isa host = star_DetectIsa();
+  EXPECT_EQ(star_SetIsa(STAR_ISA_BASELINE), STAR_ISA_BASELINE);
+  EXPECT_EQ(star_GetIsa(), STAR_ISA_BASELINE);
+
+  // Unsupported instruction sets fall back to the widest one the host supports
+  EXPECT_EQ(star_SetIsa(STAR_ISA_AVX512), host);
+  EXPECT_EQ(star_GetIsa(), host);
+  EXPECT_STREQ(star_IsaName(STAR_ISA_AVX2), "avx2");
+}
+
+TEST(Dispatch, KernelsMatchBaseline) {
+  sfloat A44[16];
+  sfloat B44[16];
+  sfloat A43[12];
+  sfloat B43[12];
+  sfloat A33[9];
+  sfloat B33[9];
+  for (int i = 0; i < 16; ++i) {
+    A44[i] = std::sin(i + 1);
+    B44[i] = std::cos(2 * i);
+  }
+  for (int i = 0; i < 12; ++i) {
+    A43[i] = std::sin(3 * i);
+    B43[i] = std::cos(i + 2);
+  }
+  for (int i = 0; i < 9; ++i) {
+    A33[i] = std::cos(i + 5);
+    B33[i] = std::sin(2 * i + 1);
+  }
+  sfloat q1[4] = {0.5, 0.5, -0.5, 0.5};
+  sfloat q2[4] = {0.9, 0.1, 0.3, -0.3};
+  sfloat x3[3] = {1, -2, 3};
+  sfloat x4[4] = {1, -2, 3, -4};
+
+  star_SetIsa(STAR_ISA_BASELINE);
+  sfloat C44[16];
+  sfloat C33[9];
+  sfloat C433[12];
+  sfloat C433t[12];
+  sfloat C443[12];
+  sfloat C443t[12];
+  sfloat y43[4];
+  sfloat y43t[3];
+  sfloat q12[4];
+  sfloat v_rot[3];
+  star_MatMul44(C44, A44, B44);
+  star_MatMul33(C33, A33, B33);
+  star_MatMul433(C433, A43, B33);
+  star_MatMulTransposed433(C433t, A43, B33);
+  star_MatMul443(C443, A44, B43);
+  star_TransposedMatMul443(C443t, A44, B43);
+  star_VecMul43(y43, A43, x3);
+  star_TransposedVecMul43(y43t, A43, x4);
+  star_QuatCompose(q12, q1, q2);
+  star_QuatRotateActive(v_rot, q1, x3);
+
+  for (int isa = STAR_ISA_BASELINE + 1; isa <= star_DetectIsa(); ++isa) {
+    SCOPED_TRACE(star_IsaName(static_cast<star_Isa>(isa)));
+    star_SetIsa(static_cast<star_Isa>(isa));
+    sfloat D44[16];
+    sfloat D33[9];
+    sfloat D433[12];
+    sfloat D433t[12];
+    sfloat D443[12];
+    sfloat D443t[12];
+    sfloat z43[4];
+    sfloat z43t[3];
+    sfloat p12[4];
+    sfloat w_rot[3];
+    star_MatMul44(D44, A44, B44);
+    star_MatMul33(D33, A33, B33);
+    star_MatMul433(D433, A43, B33);
+    star_MatMulTransposed433(D433t, A43, B33);
+    star_MatMul443(D443, A44, B43);
+    star_TransposedMatMul443(D443t, A44, B43);
+    star_VecMul43(z43, A43, x3);
+    star_TransposedVecMul43(z43t, A43, x4);
+    star_QuatCompose(p12, q1, q2);
+    star_QuatRotateActive(w_rot, q1, x3);
+    ExpectNear(D44, C44);
+    ExpectNear(D33, C33);
+    ExpectNear(D433, C433);
+    ExpectNear(D433t, C433t);
+    ExpectNear(D443, C443);
+    ExpectNear(D443t, C443t);
+    ExpectNear(z43, y43);
+    ExpectNear(z43t, y43t);
+    ExpectNear(p12, q12);
+    ExpectNear(w_rot, v_rot);
+  }
+  star_SetIsa(star_DetectIsa());
+}
+
+TEST(Dispatch, BatchKernelsMatchSingle) {
+  // Enough problems for full vectors in every variant and a remainder
+  const int n = 37;
+  std::vector<sfloat> A(9 * n);
+  std::vector<sfloat> P(9 * n);
+  std::vector<sfloat> q(4 * n);
+  std::vector<sfloat> H(16 * n);
+  std::vector<sfloat> x(3 * n);
+  for (int k = 0; k < n; ++k) {
+    for (int i = 0; i < 9; ++i) {
+      A[9 * k + i] = std::sin(k + 2 * i);
+      P[9 * k + i] = std::cos(3 * k + i);
+    }
+    for (int i = 0; i < 4; ++i) {
+      q[4 * k + i] = std::sin(2 * k + i + 1);
+    }
+    for (int i = 0; i < 16; ++i) {
+      H[16 * k + i] = std::cos(k - i);
+    }
+    for (int i = 0; i < 3; ++i) {
+      x[3 * k + i] = std::sin(k * i + 0.5);
+    }
+  }
+  const sfloat* x0 = x.data();
+  const sfloat* x1 = x.data() + n;
+  const sfloat* x2 = x.data() + 2 * n;
+  const sfloat b[3] = {0.5, -1, 2};
+
+  for (int isa = STAR_ISA_BASELINE; isa <= star_DetectIsa(); ++isa) {
+    SCOPED_TRACE(star_IsaName(static_cast<star_Isa>(isa)));
+    star_SetIsa(static_cast<star_Isa>(isa));
+    std::vector<sfloat> C(9 * n);
+    std::vector<sfloat> Ph(9 * n);
+    std::vector<sfloat> y(3 * n);
+    std::vector<sfloat> z(3 * n);
+    std::vector<sfloat> v(x);
+    star_CongruenceTransformBatch33(C.data(), A.data(), P.data(), n);
+    star_AttitudeProjectHessianBatch(Ph.data(), q.data(), H.data(), n);
+    star_VecMulBatch33(y.data(), y.data() + n, y.data() + 2 * n, A.data(), x0, x1, x2, n);
+    star_AffineMulBatch33(z.data(), z.data() + n, z.data() + 2 * n, A.data(), b, x0, x1,
+                          x2, n);
+    star_VecMulBatch33(v.data(), v.data() + n, v.data() + 2 * n, A.data(), v.data(),
+                       v.data() + n, v.data() + 2 * n, n);
+    for (int k = 0; k < n; ++k) {
+      sfloat C_k[9];
+      sfloat Ph_k[9];
+      sfloat C_batch[9];
+      sfloat Ph_batch[9];
+      star_CongruenceTransform33(C_k, A.data() + 9 * k, P.data() + 9 * k);
+      star_AttitudeProjectHessian(Ph_k, q.data() + 4 * k, H.data() + 16 * k);
+      for (int i = 0; i < 9; ++i) {
+        C_batch[i] = C[9 * k + i];
+        Ph_batch[i] = Ph[9 * k + i];
+      }
+      ExpectNear(C_batch, C_k);
+      ExpectNear(Ph_batch, Ph_k);
+
+      const sfloat x_k[3] = {x0[k], x1[k], x2[k]};
+      sfloat y_k[3];
+      star_VecMul33(y_k, A.data(), x_k);
+      const sfloat z_k[3] = {y_k[0] + b[0], y_k[1] + b[1], y_k[2] + b[2]};
+      const sfloat y_batch[3] = {y[k], y[n + k], y[2 * n + k]};
+      const sfloat z_batch[3] = {z[k], z[n + k], z[2 * n + k]};
+      const sfloat v_batch[3] = {v[k], v[n + k], v[2 * n + k]};
+      ExpectNear(y_batch, y_k);
+      ExpectNear(z_batch, z_k);
+      ExpectNear(v_batch, y_k);
+    }
+  }
+  star_SetIsa(star_DetectIsa());
+}
+
+TEST(Dispatch, InPlace) {
+  // Outputs are written after all inputs are read, so they may alias them
+  sfloat A[16];
+  sfloat B[16];
+  for (int i = 0; i < 16; ++i) {
+    A[i] = i + 1;
+    B[i] = 0.5 * i - 3;
+  }
+  sfloat C[16];
+  star_MatMul44(C, A, B);
+  star_MatMul44(A, A, B);
+  ExpectNear(A, C);
+
+  sfloat q1[4] = {0.5, 0.5, -0.5, 0.5};
+  sfloat q2[4] = {0.9, 0.1, 0.3, -0.3};
+  sfloat q12[4];
+  star_QuatCompose(q12, q1, q2);
+  star_QuatCompose(q1, q1, q2);
+  ExpectNear(q1, q12);
+}
@@ -0,0 +1,525 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "star/Dual.hpp"
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+#include "star/RotMat.hpp"
+#include "star/Transpose.hpp"
+#include "star/matrix_multiplication.hpp"
+#include "star/quaternion_kernels.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+}
+
+using namespace star;
+
+// Derivatives are exact, so only rounding errors remain
+static const sfloat kTol = 100 * std::numeric_limits<sfloat>::epsilon();
+
+// Tolerance of comparisons with sfloat, whose sin, cos and atan2 use the STAR_FASTMATH tier
+static const sfloat kKernelTol = kTol + 10 * STAR_FASTMATH_TOL;
+
+TEST(Dual, Arithmetic) {
+  using D2 = Dual<2>;
+  const sfloat x0 = 1.5;
+  const sfloat y0 = -0.7;
+  const D2 x = D2::Variable(x0, 0);
+  const D2 y = D2::Variable(y0, 1);
+
+  // f = x y + 3 x - y / x + 2 / y - (1 - x)
+  const D2 f = x * y + 3 * x - y / x + 2 / y - (1 - x);
+  EXPECT_NEAR(f.Value(), x0 * y0 + 3 * x0 - y0 / x0 + 2 / y0 - (1 - x0), kTol);
+  EXPECT_NEAR(f.Grad(0), y0 + 3 + y0 / (x0 * x0) + 1, kTol);
+  EXPECT_NEAR(f.Grad(1), x0 - 1 / x0 - 2 / (y0 * y0), kTol);
+
+  D2 g = x;
+  g *= y;
+  g -= 2 * x;
+  g /= y;
+  EXPECT_NEAR(g.Value(), x0 - 2 * x0 / y0, kTol);
+  EXPECT_NEAR(g.Grad(0), 1 - 2 / y0, kTol);
+  EXPECT_NEAR(g.Grad(1), 2 * x0 / (y0 * y0), kTol);
+
+  // Comparisons only look at the values
+  EXPECT_TRUE(y < x);
+  EXPECT_TRUE(x > 0);
+  EXPECT_TRUE(D2(x0) == x);
+}
+
+TEST(Dual, MathFunctions) {
+  using D1 = Dual<1>;
+  const sfloat x0 = 0.4;
+  const D1 x = D1::Variable(x0, 0);
+  const D1 y = D1::Variable(-1.3, 0);
+  EXPECT_NEAR(sqrt(x).Grad(0), 0.5 / std::sqrt(x0), kTol);
+  EXPECT_NEAR(sin(x).Grad(0), std::cos(x0), kTol);
+  EXPECT_NEAR(cos(x).Grad(0), -std::sin(x0), kTol);
+  EXPECT_NEAR(tan(x).Grad(0), 1 / (std::cos(x0) * std::cos(x0)), kTol);
+  EXPECT_NEAR(asin(x).Grad(0), 1 / std::sqrt(1 - x0 * x0), kTol);
+  EXPECT_NEAR(acos(x).Grad(0), -1 / std::sqrt(1 - x0 * x0), kTol);
+  EXPECT_NEAR(atan(x).Grad(0), 1 / (1 + x0 * x0), kTol);
+  EXPECT_NEAR(exp(x).Grad(0), std::exp(x0), kTol);
+  EXPECT_NEAR(log(x).Grad(0), 1 / x0, kTol);
+  EXPECT_NEAR(pow(x, 3).Grad(0), 3 * x0 * x0, kTol);
+  EXPECT_NEAR(abs(y).Value(), 1.3, kTol);
+  EXPECT_NEAR(abs(y).Grad(0), -1, kTol);
+
+  // atan2(y, x) with both arguments depending on t: y = 2 t, x = 1 - t at t = 0.3
+  const D1 t = D1::Variable(0.3, 0);
+  const sfloat ys = 0.6;
+  const sfloat xs = 0.7;
+  EXPECT_NEAR(atan2(2 * t, 1 - t).Value(), std::atan2(ys, xs), kTol);
+  EXPECT_NEAR(atan2(2 * t, 1 - t).Grad(0), (xs * 2 + ys) / (xs * xs + ys * ys), kTol);
+}
+
+// A(x) = A0 + x A1 for a scalar x, with the derivative carried in a single lane
+template <int N>
+static Matrix<N, N, Dual<1>> LinearMatrix(sfloat x) {
+  Matrix<N, N, Dual<1>> A;
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < N; ++i) {
+      A(i, j) = std::sin(i + 2 * j) + (i == j ? N : 0) + Dual<1>::Variable(x, 0) * (i - j);
+    }
+  }
+  return A;
+}
+
+template <int N>
+static Matrix<N, N> Values(const Matrix<N, N, Dual<1>>& A) {
+  Matrix<N, N> V;
+  for (int k = 0; k < N * N; ++k) {
+    V[k] = A[k].Value();
+  }
+  return V;
+}
+
+TEST(Dual, MatrixProductsAndSolves) {
+  constexpr int N = 5;
+  const sfloat x0 = 0.2;
+  const sfloat h = std::cbrt(std::numeric_limits<sfloat>::epsilon());
+  const Matrix<N, N, Dual<1>> A = LinearMatrix<N>(x0);
+  const Matrix<N, N, Dual<1>> B = Matrix<N, N, Dual<1>>::Identity() + A;
+
+  // Products and element-wise expressions, checked against central differences
+  const Matrix<N, N, Dual<1>> C = A * B - 2.0 * A;
+  const Matrix<N, N, Dual<1>> Ct = Transpose(A) * B;
+  Matrix<N, N, Dual<1>> X;
+  ASSERT_TRUE(A.Solve(X, B));
+  for (int k = 0; k < N * N; ++k) {
+    auto at = [&](sfloat x) {
+      Matrix<N, N> Ax = Values(LinearMatrix<N>(x));
+      Matrix<N, N> Bx = Matrix<N, N>::Identity() + Ax;
+      Matrix<N, N> Cx = Ax * Bx - 2.0 * Ax;
+      Matrix<N, N> Ctx = Transpose(Ax) * Bx;
+      Matrix<N, N> Xx;
+      Ax.Solve(Xx, Bx);
+      return std::make_tuple(Cx[k], Ctx[k], Xx[k]);
+    };
+    auto [Cp, Ctp, Xp] = at(x0 + h);
+    auto [Cm, Ctm, Xm] = at(x0 - h);
+    const sfloat tol = 100 * h * h;
+    EXPECT_NEAR(C[k].Grad(0), (Cp - Cm) / (2 * h), tol);
+    EXPECT_NEAR(Ct[k].Grad(0), (Ctp - Ctm) / (2 * h), tol);
+    EXPECT_NEAR(X[k].Grad(0), (Xp - Xm) / (2 * h), tol);
+  }
+}
+
+TEST(QuaternionKernels, MatchCKernels) {
+  const Quaternion q = Quaternion(0.9, -0.2, 0.3, 0.1).Normalize();
+  const Quaternion p = Quaternion(0.2, 0.7, -0.1, 0.4).Normalize();
+  const Vec3 v = {1, -2, 3};
+  const Vec3 phi = {0.3, -0.2, 0.5};
+
+  Quaternion qp;
+  QuatCompose(qp.data(), q.data(), p.data());
+  EXPECT_TRUE(qp.IsApprox(q.Compose(p)));
+
+  Vec3 v_rot;
+  QuatRotateActive(v_rot.data(), q.data(), v.data());
+  EXPECT_LT(Vec3(v_rot - q.RotateActive(v)).Norm(), kKernelTol);
+  QuatRotatePassive(v_rot.data(), q.data(), v.data());
+  EXPECT_LT(Vec3(v_rot - q.RotatePassive(v)).Norm(), kKernelTol);
+
+  Quaternion q_exp;
+  QuatExpm(q_exp.data(), phi.data());
+  EXPECT_LT(Vec4(q_exp - Quaternion::Expm(phi)).Norm(), kKernelTol);
+
+  Vec3 phi_log;
+  QuatLogm(phi_log.data(), q.data());
+  EXPECT_LT(Vec3(phi_log - q.Logm()).Norm(), kKernelTol);
+}
+
+// Seeds each element of an array as its own input
+template <int N>
+static void Variables(Dual<N> x[N], const sfloat* values) {
+  for (int i = 0; i < N; ++i) {
+    x[i] = Dual<N>::Variable(values[i], i);
+  }
+}
+
+template <class Mat, int N>
+static void ExpectJacobian(const Mat& D, const Dual<N>* y, int rows) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < N; ++j) {
+      EXPECT_NEAR(y[i].Grad(j), D(i, j), kKernelTol) << "at (" << i << ", " << j << ")";
+    }
+  }
+}
+
+TEST(QuaternionKernels, JacobiansMatchAnalytic) {
+  const Quaternion q = Quaternion(0.9, -0.2, 0.3, 0.1).Normalize();
+  Dual<4> qd[4];
+  Variables(qd, q.data());
+
+  const Vec3 v = {1, -2, 3};
+  const Dual<4> vd[3] = {v.x, v.y, v.z};
+  Dual<4> v_rot[3];
+  QuatRotateActive(v_rot, qd, vd);
+  ExpectJacobian(q.RotateActiveJacobian(v), v_rot, 3);
+  QuatRotatePassive(v_rot, qd, vd);
+  ExpectJacobian(q.RotatePassiveJacobian(v), v_rot, 3);
+
+  Dual<4> phi[3];
+  QuatLogm(phi, qd);
+  ExpectJacobian(q.LogmJacobian(), phi, 3);
+
+  // Expm, including at the identity where the angle is not differentiable
+  for (const Vec3& phi0 : {Vec3(0.3, -0.2, 0.5), Vec3(0, 0, 0)}) {
+    Dual<3> phid[3];
+    Variables(phid, phi0.data());
+    Dual<3> q_exp[4];
+    QuatExpm(q_exp, phid);
+    ExpectJacobian(Quaternion::ExpmJacobian(phi0), q_exp, 4);
+  }
+}
+
+TEST(QuaternionKernels, CostGradient) {
+  // f(q) = |R(q) v - w|^2 has the gradient 2 D^T (R(q) v - w), D the rotation Jacobian
+  const Quaternion q = Quaternion(0.9, -0.2, 0.3, 0.1).Normalize();
+  const Vec3 v = {1, -2, 3};
+  const Vec3 w = {0.5, 1, -1};
+  Dual<4> qd[4];
+  Variables(qd, q.data());
+  const Dual<4> vd[3] = {v.x, v.y, v.z};
+  Dual<4> r[3];
+  QuatRotateActive(r, qd, vd);
+  Dual<4> f = 0;
+  for (int i = 0; i < 3; ++i) {
+    f += (r[i] - w[i]) * (r[i] - w[i]);
+  }
+
+  const Vec3 residual = q.RotateActive(v) - w;
+  const Matrix<3, 4> D = q.RotateActiveJacobian(v);
+  for (int j = 0; j < 4; ++j) {
+    sfloat grad = 0;
+    for (int i = 0; i < 3; ++i) {
+      grad += 2 * D(i, j) * residual[i];
+    }
+    EXPECT_NEAR(f.Grad(j), grad, kKernelTol);
+  }
+}
+
+/*---------------------------------*/
+/* Classes of dual numbers         */
+/*---------------------------------*/
+// Compares the values of a vector, quaternion or matrix of dual numbers with the result of
+// the same method for sfloat
+template <class DualMat, class Mat>
+static void ExpectValues(const DualMat& a, const Mat& b) {
+  Mat values = b;
+  for (int k = 0; k < Mat::kSize; ++k) {
+    values[k] = a[k].Value();
+  }
+  test::ExpectNear(values, b, kKernelTol);
+}
+
+// The quaternion q with each of its elements as an input
+static Quat<Dual<4>> QuatVariable(const Quaternion& q) {
+  using D4 = Dual<4>;
+  return {D4::Variable(q.w, 0), D4::Variable(q.x, 1), D4::Variable(q.y, 2),
+          D4::Variable(q.z, 3)};
+}
+
+static Vector<3, Dual<3>> VecVariable(const Vec3& v) {
+  using D3 = Dual<3>;
+  return {D3::Variable(v.x, 0), D3::Variable(v.y, 1), D3::Variable(v.z, 2)};
+}
+
+TEST(DualClasses, QuaternionMatchesCKernels) {
+  using D4 = Dual<4>;
+  using Vec3D = Vector<3, D4>;
+  const Quaternion q = test::TestQuaternion();
+  const Quaternion p = Quaternion(0.2, 0.7, -0.1, 0.4).Normalize();
+  const Vec3 v = {1, -2, 3};
+  const Vec3 phi = {0.3, -0.2, 0.5};
+  const Quat<D4> qd = QuatVariable(q);
+  const Quat<D4> pd = {p.w, p.x, p.y, p.z};
+  const Vec3D vd = {v.x, v.y, v.z};
+  const Vec3D phid = {phi.x, phi.y, phi.z};
+
+  ExpectValues(qd.Compose(pd), q.Compose(p));
+  ExpectValues(qd.ComposeLeft(pd), q.ComposeLeft(p));
+  ExpectValues(qd.ComposePure(vd), q.ComposePure(v));
+  ExpectValues(qd.Inverse(), q.Inverse());
+  ExpectValues(qd.Exp(), q.Exp());
+  ExpectValues(qd.Log(), q.Log());
+  ExpectValues(qd.Logm(), q.Logm());
+  ExpectValues(qd.RotateActive(vd), q.RotateActive(v));
+  ExpectValues(qd.RotatePassive(vd), q.RotatePassive(v));
+  ExpectValues(qd.InvCayley(), q.InvCayley());
+  ExpectValues(qd.ToRodriguesParam(), q.ToRodriguesParam());
+  ExpectValues(qd.ToMRP(), q.ToMRP());
+  ExpectValues(qd.Error(pd), q.Error(p));
+  ExpectValues(qd.AddError(phid), q.AddError(phi));
+  ExpectValues(Quat<D4>::Expm(phid), Quaternion::Expm(phi));
+  ExpectValues(Quat<D4>::Cayley(phid), Quaternion::Cayley(phi));
+  ExpectValues(Quat<D4>::FromRodriguesParam(phid), Quaternion::FromRodriguesParam(phi));
+  ExpectValues(Quat<D4>::FromMRP(phid), Quaternion::FromMRP(phi));
+  ExpectValues(Quat<D4>::RotY(0.7), Quaternion::RotY(0.7));
+  EXPECT_NEAR(qd.AngleBetween(pd).Value(), q.AngleBetween(p), kKernelTol);
+  EXPECT_NEAR(qd.VecNorm().Value(), q.VecNorm(), kKernelTol);
+
+  // Interpolation, including the bisection of long arcs in Slerp
+  for (sfloat t : {0.0, 0.3, 0.8}) {
+    ExpectValues(qd.Slerp(pd, t), q.Slerp(p, t));
+    ExpectValues(qd.Nlerp(pd, t), q.Nlerp(p, t));
+    ExpectValues(Quat<D4>::Squad(qd, pd, pd, qd, t), Quaternion::Squad(q, p, p, q, t));
+  }
+  ExpectValues(Quat<D4>::SquadControlPoint(pd, qd, pd.Conjugate()),
+               Quaternion::SquadControlPoint(p, q, p.Conjugate()));
+
+  // Matrices
+  ExpectValues(qd.L(), q.L());
+  ExpectValues(qd.R(), q.R());
+  ExpectValues(qd.AttitudeJacobian(), q.AttitudeJacobian());
+  const Mat4 H = Mat4::ByRows(4, 1, 0, 2, 1, 5, 1, 0, 0, 1, 6, 1, 2, 0, 1, 7);
+  Matrix<4, 4, D4> Hd;
+  for (int k = 0; k < 16; ++k) {
+    Hd[k] = H[k];
+  }
+  ExpectValues(qd.AttitudeProjectHessian(Hd), q.AttitudeProjectHessian(H));
+
+  // A rotation matrix of dual numbers rotates like the quaternion
+  const RotMat<Active, D4> R = RotMat<Active, D4>::FromQuaternion(qd.w, qd.x, qd.y, qd.z);
+  ExpectValues(R * vd, q.RotateActive(v));
+  ExpectValues(Transpose(R) * vd, q.RotatePassive(v));
+}
+
+TEST(DualClasses, QuaternionGradientsMatchJacobians) {
+  const Quaternion q = test::TestQuaternion();
+  const Quaternion p = Quaternion(0.2, 0.7, -0.1, 0.4).Normalize();
+  const Vec3 v = {1, -2, 3};
+  const Quat<Dual<4>> qd = QuatVariable(q);
+  const Quat<Dual<4>> pd = {p.w, p.x, p.y, p.z};
+  const Vector<3, Dual<4>> vd = {v.x, v.y, v.z};
+
+  ExpectJacobian(q.RotateActiveJacobian(v), qd.RotateActive(vd).data(), 3);
+  ExpectJacobian(q.RotatePassiveJacobian(v), qd.RotatePassive(vd).data(), 3);
+  ExpectJacobian(q.LogmJacobian(), qd.Logm().data(), 3);
+  ExpectJacobian(q.InvCayleyJacobian(), qd.InvCayley().data(), 3);
+  ExpectJacobian(q.ToRodriguesParamJacobian(), qd.ToRodriguesParam().data(), 3);
+  ExpectJacobian(q.ToMRPJacobian(), qd.ToMRP().data(), 3);
+  ExpectJacobian(q.ComposeJacobian(p), qd.Compose(pd).data(), 4);
+  ExpectJacobian(q.ComposeLeftJacobian(p), qd.ComposeLeft(pd).data(), 4);
+
+  const Vec3 phi = {0.3, -0.2, 0.5};
+  const Vector<3, Dual<3>> phid = VecVariable(phi);
+  using Quat3 = Quat<Dual<3>>;
+  ExpectJacobian(Quaternion::ExpmJacobian(phi), Quat3::Expm(phid).data(), 4);
+  ExpectJacobian(Quaternion::CayleyJacobian(phi), Quat3::Cayley(phid).data(), 4);
+  ExpectJacobian(Quaternion::FromRodriguesParamJacobian(phi),
+                 Quat3::FromRodriguesParam(phid).data(), 4);
+  ExpectJacobian(Quaternion::FromMRPJacobian(phi), Quat3::FromMRP(phid).data(), 4);
+}
+
+// Central differences with the step in test_utils.hpp are accurate to about kStep^2
+static const sfloat kFiniteDiffTol = 100 * test::kStep * test::kStep;
+
+// Checks the derivative of f(x), a Dual<1> or a vector or matrix of them, against central
+// differences of its values
+template <class F>
+static void ExpectDerivative(const F& f, sfloat x0) {
+  using Y = std::decay_t<decltype(f(x0))>;
+  if constexpr (std::is_same_v<Y, Dual<1>>) {
+    ExpectDerivative([&](sfloat x) { return Matrix<1, 1, Dual<1>>(f(x)); }, x0);
+  } else {
+    const auto values = [&](const Matrix<1, 1>& x) {
+      const Y y = f(x[0]);
+      Matrix<Y::kSize, 1> y_values;
+      for (int k = 0; k < Y::kSize; ++k) {
+        y_values[k] = y[k].Value();
+      }
+      return y_values;
+    };
+    const Matrix<Y::kSize, 1> fd = test::NumericalJacobian(values, Matrix<1, 1>(x0));
+    const Y y = f(x0);
+    for (int k = 0; k < Y::kSize; ++k) {
+      EXPECT_NEAR(y[k].Grad(0), fd[k], kFiniteDiffTol * (1 + std::abs(fd[k])))
+          << "at element " << k;
+    }
+  }
+}
+
+// A(x) = A0 + x A1 for a symmetric, diagonally dominant A0 and a symmetric A1
+template <int N>
+static Matrix<N, N, Dual<1>> SymmetricMatrix(sfloat x) {
+  const Dual<1> xd = Dual<1>::Variable(x, 0);
+  Matrix<N, N, Dual<1>> A;
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < N; ++i) {
+      const sfloat a0 = (i == j ? N + i : 0) + std::sin(i + j + 1) / 2;
+      A(i, j) = a0 + xd * std::cos(i * j + i + j);
+    }
+  }
+  return A;
+}
+
+TEST(DualClasses, Mat3Decompositions) {
+  using D1 = Dual<1>;
+  using Mat3D = Matrix<3, 3, D1>;
+  using Vec3D = Vector<3, D1>;
+  const sfloat x0 = 0.3;
+  const Mat3D A = SymmetricMatrix<3>(x0);
+  const Mat3 A0 = Values(A);
+  const Vec3 b = {1, -2, 0.5};
+  const Vec3D bd = {b.x, b.y, b.z};
+
+  // The values match the ones of Mat3
+  EXPECT_NEAR(A.Determinant().Value(), A0.Determinant(), kKernelTol * A0.Determinant());
+  ExpectValues(A.Inverse(), A0.Inverse());
+  Mat3D U;
+  Mat3 U0;
+  ASSERT_TRUE(A.Cholesky(U));
+  ASSERT_TRUE(A0.Cholesky(U0));
+  ExpectValues(U, U0);
+  Vec3D x;
+  Vec3 x_ref;
+  ASSERT_TRUE(A.CholSolve(x, bd));
+  ASSERT_TRUE(A0.CholSolve(x_ref, b));
+  ExpectValues(x, x_ref);
+  Vec3D lambda;
+  Mat3D V;
+  Vec3 lambda0;
+  Mat3 V0;
+  A.Eigen(lambda, V);
+  A0.Eigen(lambda0, V0);
+  ExpectValues(lambda, lambda0);
+  Mat3D Us;
+  Vec3D S;
+  Mat3 Us0;
+  Vec3 S0;
+  A.SVD(Us, S, V);
+  A0.SVD(Us0, S0, V0);
+  ExpectValues(S, S0);
+
+  // The derivatives match central differences
+  ExpectDerivative([](sfloat t) { return SymmetricMatrix<3>(t).Determinant(); }, x0);
+  ExpectDerivative([](sfloat t) { return SymmetricMatrix<3>(t).Inverse(); }, x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Mat3D P = SymmetricMatrix<3>(t);
+        P.InversePSDInPlace();
+        return P;
+      },
+      x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Mat3D Ut;
+        SymmetricMatrix<3>(t).Cholesky(Ut);
+        return Ut;
+      },
+      x0);
+  ExpectDerivative(
+      [&](sfloat t) {
+        Vec3D xt;
+        SymmetricMatrix<3>(t).CholSolve(xt, bd);
+        return xt;
+      },
+      x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Mat3D Q;
+        Mat3D R;
+        SymmetricMatrix<3>(t).QR(Q, R);
+        return R;
+      },
+      x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Mat3D L;
+        Mat3D Ut;
+        int perm[3];
+        SymmetricMatrix<3>(t).LU(L, Ut, perm);
+        return Ut;
+      },
+      x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Vec3D lambda_t;
+        Mat3D V_t;
+        SymmetricMatrix<3>(t).Eigen(lambda_t, V_t);
+        return lambda_t;
+      },
+      x0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Mat3D Ut;
+        Vec3D St;
+        Mat3D Vt;
+        SymmetricMatrix<3>(t).SVD(Ut, St, Vt);
+        return St;
+      },
+      x0);
+}
+
+TEST(DualClasses, Mat4Eigen) {
+  using D1 = Dual<1>;
+  const sfloat x0 = -0.2;
+  const Matrix<4, 4, D1> A = SymmetricMatrix<4>(x0);
+  Vector<4, D1> lambda;
+  Matrix<4, 4, D1> V;
+  Vec4 lambda0;
+  Mat4 V0;
+  A.Eigen(lambda, V);
+  Values(A).Eigen(lambda0, V0);
+  ExpectValues(lambda, lambda0);
+  ExpectDerivative(
+      [](sfloat t) {
+        Vector<4, D1> lambda_t;
+        Matrix<4, 4, D1> V_t;
+        SymmetricMatrix<4>(t).Eigen(lambda_t, V_t);
+        return lambda_t;
+      },
+      x0);
+}
+
+TEST(DualClasses, RotMat) {
+  // dR/dt = R [x]_x for a rotation by t about x
+  using D1 = Dual<1>;
+  const sfloat t0 = 0.4;
+  const RotMat<Active, D1> R = RotMat<Active, D1>::RotX(D1::Variable(t0, 0));
+  const Mat3 dR = Multiply(Mat3(RotMat<Active>::RotX(t0)),
+                           Mat3::ByRows(0, 0, 0, 0, 0, -1, 0, 1, 0));
+  for (int k = 0; k < 9; ++k) {
+    EXPECT_NEAR(R[k].Grad(0), dR[k], kKernelTol);
+  }
+  ExpectDerivative(
+      [](sfloat t) {
+        RotMat<Passive, D1> Rt = RotMat<Passive, D1>::FromAxisAngle(
+            D1::Variable(t, 0), Vector<3, D1>(0.6, 0, 0.8));
+        return Rt.Orthonormalize();
+      },
+      t0);
+}
@@ -0,0 +1,134 @@
+//
+// Created by Brian Jackson on 5/13/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <limits>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "star/star.hpp"
+
+using namespace star;
+
+constexpr sfloat EPS = 10 * std::numeric_limits<sfloat>::epsilon();
+
+TEST(Expression, IsLazy) {
+  Vec3 a(1, 2, 3);
+  Vec3 b(4, 5, 6);
+  auto expr = a + 2.0 * b;
+  EXPECT_FALSE((std::is_same_v<decltype(expr), Vec3>));
+  EXPECT_TRUE((std::is_same_v<decltype(expr)::ResultType, Vec3>));
+
+  // Operands are held by reference until the expression is evaluated
+  a.x = 10;
+  Vec3 c = expr;
+  EXPECT_DOUBLE_EQ(c.x, 18);
+  EXPECT_DOUBLE_EQ(c.y, 12);
+  EXPECT_DOUBLE_EQ(c.z, 15);
+}
+
+TEST(Expression, Vec3) {
+  Vec3 a(1, 2, 3);
+  Vec3 b(4, 5, 6);
+  Vec3 c(-1, 0.5, 2);
+  Vec3 d(2, 4, 8);
+
+  Vec3 x = a + 2.0 * b - c / d;
+  Vec3 x_eager = a.Add(Vec3::Const(2).Mul(b)).Sub(c.Div(d));
+  EXPECT_LT(x.NormedDifference(x_eager), EPS);
+
+  Vec3 y = (a - b) * (c + d) / 3.0;
+  Vec3 y_eager = a.Sub(b).Mul(c.Add(d)).Div(Vec3::Const(3));
+  EXPECT_LT(y.NormedDifference(y_eager), EPS);
+
+  // Scalar on the left
+  Vec3 z = 1.0 - a;
+  EXPECT_DOUBLE_EQ(z.x, 0);
+  EXPECT_DOUBLE_EQ(z.y, -1);
+  EXPECT_DOUBLE_EQ(z.z, -2);
+  z = 6.0 / a;
+  EXPECT_DOUBLE_EQ(z.x, 6);
+  EXPECT_DOUBLE_EQ(z.y, 3);
+  EXPECT_DOUBLE_EQ(z.z, 2);
+}
+
+TEST(Expression, Vec3Aliasing) {
+  Vec3 a(1, 2, 3);
+  Vec3 b(4, 5, 6);
+  a = b - a * a;
+  EXPECT_DOUBLE_EQ(a.x, 3);
+  EXPECT_DOUBLE_EQ(a.y, 1);
+  EXPECT_DOUBLE_EQ(a.z, -3);
+
+  a += 2.0 * b;
+  EXPECT_DOUBLE_EQ(a.x, 11);
+  EXPECT_DOUBLE_EQ(a.y, 11);
+  EXPECT_DOUBLE_EQ(a.z, 9);
+
+  a *= a - 10.0;
+  EXPECT_DOUBLE_EQ(a.x, 11);
+  EXPECT_DOUBLE_EQ(a.y, 11);
+  EXPECT_DOUBLE_EQ(a.z, -9);
+}
+
+TEST(Expression, Vec4) {
+  Vec4 a(1, 2, 3, 4);
+  Vec4 b(-1, 0.5, 2, 3);
+  Vec4 x = 0.5 * (a + b) - b / a;
+  Vec4 x_eager = Vec4::Const(0.5).Mul(a.Add(b)).Sub(b.Div(a));
+  EXPECT_LT(x.NormedDifference(x_eager), EPS);
+
+  x -= a;
+  EXPECT_LT(x.NormedDifference(x_eager.Sub(a)), EPS);
+
+  // Quaternions evaluate to Vec4 but convert back implicitly
+  Quaternion q1 = Quaternion::RotX(0.1);
+  Quaternion q2 = Quaternion::RotY(-0.2);
+  Quaternion q = 0.5 * (q1 + q2);
+  EXPECT_LT(q.NormedDifference(q1.Add(q2).Mul(Vec4::Const(0.5))), EPS);
+}
+
+TEST(Expression, Mat3) {
+  Mat3 A = Mat3::ByRows(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  Mat3 B = Mat3::Diagonal(1, 2, 3);
+  Mat3 C = A - 2.0 * B + 1.0;
+  for (int k = 0; k < Mat3::kSize; ++k) {
+    EXPECT_DOUBLE_EQ(C[k], A[k] - 2 * B[k] + 1);
+  }
+
+  C += A / 2.0;
+  for (int k = 0; k < Mat3::kSize; ++k) {
+    EXPECT_DOUBLE_EQ(C[k], 1.5 * A[k] - 2 * B[k] + 1);
+  }
+
+  // Matrix products are still evaluated eagerly
+  Vec3 x(1, 2, 3);
+  Vec3 y = (A + B) * x;
+  Vec3 y_expected = Multiply(Mat3(A + B), x);
+  EXPECT_LT(y.NormedDifference(y_expected), EPS);
+}
+
+TEST(Expression, Mat4) {
+  Mat4 A = Mat4::Identity();
+  Mat4 B = Mat4::Const(2);
+  Mat4 C = 3.0 * A - B / 4.0;
+  for (int k = 0; k < Mat4::kSize; ++k) {
+    EXPECT_DOUBLE_EQ(C[k], 3 * A[k] - B[k] / 4);
+  }
+  C *= 2;
+  for (int k = 0; k < Mat4::kSize; ++k) {
+    EXPECT_DOUBLE_EQ(C[k], 6 * A[k] - B[k] / 2);
+  }
+}
+
+TEST(Expression, Mat43) {
+  Quaternion q = Quaternion::RotZ(0.3);
+  Mat43 G = q.AttitudeJacobian();
+  Mat43 H = q.H();
+  Mat43 D = G - H * 2.0;
+  for (int k = 0; k < Mat43::kSize; ++k) {
+    EXPECT_DOUBLE_EQ(D[k], G[k] - 2 * H[k]);
+  }
+}
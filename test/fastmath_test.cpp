@@ -0,0 +1,96 @@
+//
+// Created by Brian Jackson on 5/15/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "star/fastmath.h"
+}
+
+constexpr sfloat kEps = std::numeric_limits<sfloat>::epsilon();
+
+// Documented error bound of each tier, or a few ULP of sfloat if larger
+static double Bound(int tier) {
+  double ulps = 8 * kEps;
+  switch (tier) {
+    case STAR_FASTMATH_HIGH:
+      return std::max(1e-12, ulps);
+    case STAR_FASTMATH_LOW:
+      return std::max(1e-7, ulps);
+    default:
+      return ulps;
+  }
+}
+
+class FastMath : public ::testing::TestWithParam<int> {};
+
+TEST_P(FastMath, SinCosSweep) {
+  const int tier = GetParam();
+  double max_err = 0;
+  for (int i = -200000; i <= 200000; ++i) {
+    sfloat x = i * 1e-4;
+    sfloat s;
+    sfloat c;
+    star_SinCosTier(x, &s, &c, tier);
+    max_err = std::max({max_err, std::abs(s - std::sin(double(x))),
+                        std::abs(c - std::cos(double(x)))});
+  }
+  EXPECT_LT(max_err, Bound(tier));
+
+  // Multiples of pi / 2 and large arguments
+  for (double x : {M_PI_2, M_PI, 3 * M_PI_2, -M_PI_2, 1e3 + 0.1, -4321.5, 9.9e5}) {
+    sfloat s;
+    sfloat c;
+    star_SinCosTier(x, &s, &c, tier);
+    EXPECT_NEAR(s, std::sin(double(sfloat(x))), Bound(tier)) << "x = " << x;
+    EXPECT_NEAR(c, std::cos(double(sfloat(x))), Bound(tier)) << "x = " << x;
+  }
+}
+
+TEST_P(FastMath, Atan2Sweep) {
+  const int tier = GetParam();
+  double max_err = 0;
+  for (int i = 0; i < 100000; ++i) {
+    double angle = -M_PI + 2 * M_PI * i / 100000;
+    for (double r : {1e-3, 1.0, 7.5}) {
+      sfloat y = r * std::sin(angle);
+      sfloat x = r * std::cos(angle);
+      double err = std::abs(star_Atan2Tier(y, x, tier) - std::atan2(double(y), double(x)));
+      max_err = std::max(max_err, err);
+    }
+  }
+  EXPECT_LT(max_err, Bound(tier));
+
+  // Axes, diagonals and the origin
+  const sfloat values[] = {-2, -1, 0, 1, 2};
+  for (sfloat y : values) {
+    for (sfloat x : values) {
+      EXPECT_NEAR(star_Atan2Tier(y, x, tier), std::atan2(y, x), Bound(tier))
+          << "y = " << y << ", x = " << x;
+    }
+  }
+}
+
+TEST_P(FastMath, RSqrtSweep) {
+  const int tier = GetParam();
+  double max_err = 0;
+  for (int i = -600; i <= 600; ++i) {
+    for (double m : {1.0, 1.37, 2.9, 7.1}) {
+      sfloat x = m * std::pow(10.0, i / 100.0);
+      double expected = 1 / std::sqrt(double(x));
+      double err = std::abs(star_RSqrtTier(x, tier) - expected) / expected;
+      max_err = std::max(max_err, err);
+    }
+  }
+  EXPECT_LT(max_err, Bound(tier));
+}
+
+INSTANTIATE_TEST_SUITE_P(Tiers, FastMath,
+                         ::testing::Values(STAR_FASTMATH_LIBM, STAR_FASTMATH_HIGH,
+                                           STAR_FASTMATH_LOW));
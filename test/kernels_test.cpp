@@ -0,0 +1,463 @@
+//
+// Created by Brian Jackson on 5/25/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/matrix_kernels.hpp"
+#include "star/quaternion_kernels.hpp"
+
+extern "C" {
+#include "star/matrix3.h"
+#include "star/matrix4.h"
+#include "star/matrix43.h"
+#include "star/quaternion.h"
+#include "star/vector3.h"
+}
+
+/*
+ * The C++ classes call the templated kernels of matrix_kernels.hpp and
+ * quaternion_kernels.hpp. These tests check that, for sfloat, every one of them agrees with
+ * the C kernel it ports, on inputs that take each branch. They also run for every
+ * STAR_FASTMATH tier (see test/CMakeLists.txt), where both share the same approximations.
+ */
+
+using namespace star;
+
+static const sfloat kTol = 100 * std::numeric_limits<sfloat>::epsilon();
+
+// Compares the output of a port with the one of the C kernel. The non-finite outputs, e.g.
+// the Rodrigues parameters of a half turn, must match exactly.
+static void ExpectSame(const sfloat* a, const sfloat* b, int n) {
+  for (int k = 0; k < n; ++k) {
+    if (std::isnan(b[k])) {
+      EXPECT_TRUE(std::isnan(a[k])) << "at element " << k;
+    } else if (std::isinf(b[k])) {
+      EXPECT_EQ(a[k], b[k]) << "at element " << k;
+    } else {
+      EXPECT_NEAR(a[k], b[k], kTol * (1 + std::abs(b[k]))) << "at element " << k;
+    }
+  }
+}
+
+static void ExpectSame(sfloat a, sfloat b) { ExpectSame(&a, &b, 1); }
+
+// A generic unit axis
+static const sfloat kAxis[3] = {1.0 / 3, -2.0 / 3, 2.0 / 3};
+
+// Rotation angles on either side of the series branches, generic ones and half turns
+static const std::vector<sfloat> kAngles = {0,   1e-9, 1e-7, 1e-5,   2e-4,
+                                            0.3, 2,    3.1,  M_PI, 5};
+
+// Rotation vectors of each angle
+static std::vector<std::vector<sfloat>> RotationVectors() {
+  std::vector<std::vector<sfloat>> phis;
+  for (sfloat theta : kAngles) {
+    phis.push_back({theta * kAxis[0], theta * kAxis[1], theta * kAxis[2]});
+  }
+  return phis;
+}
+
+// Unit quaternions of each angle, where the angles above pi give a negative scalar part, an
+// exact half turn and a quaternion of norm 2
+static std::vector<std::vector<sfloat>> Quaternions() {
+  std::vector<std::vector<sfloat>> quats;
+  for (sfloat theta : kAngles) {
+    const sfloat s = std::sin(theta / 2);
+    quats.push_back({std::cos(theta / 2), s * kAxis[0], s * kAxis[1], s * kAxis[2]});
+  }
+  quats.push_back({0, kAxis[0], kAxis[1], kAxis[2]});
+  quats.push_back({1.8, -0.4, 0.6, 0.2});
+  return quats;
+}
+
+TEST(Kernels, QuaternionAlgebra) {
+  const sfloat v[3] = {0.5, -1.2, 2.0};
+  for (const auto& q1 : Quaternions()) {
+    sfloat a[16];
+    sfloat b[16];
+    QuatConjugate(a, q1.data());
+    star_QuatConjugate(b, q1.data());
+    ExpectSame(a, b, 4);
+    QuatNormalize(a, q1.data());
+    star_QuatNormalize(b, q1.data());
+    ExpectSame(a, b, 4);
+    ExpectSame(QuatVecNorm(q1.data()), star_QuatVecNorm(q1.data()));
+    ExpectSame(QuatVecNormSquared(q1.data()), star_QuatVecNormSquared(q1.data()));
+    QuatRotateActive(a, q1.data(), v);
+    star_QuatRotateActive(b, q1.data(), v);
+    ExpectSame(a, b, 3);
+    QuatRotatePassive(a, q1.data(), v);
+    star_QuatRotatePassive(b, q1.data(), v);
+    ExpectSame(a, b, 3);
+    QuatComposePure(a, q1.data(), v);
+    star_QuatComposePure(b, q1.data(), v);
+    ExpectSame(a, b, 4);
+    QuatToRotMatActive(a, q1.data());
+    star_QuatToRotMatActive(b, q1.data());
+    ExpectSame(a, b, 9);
+    QuatToRotMatPassive(a, q1.data());
+    star_QuatToRotMatPassive(b, q1.data());
+    ExpectSame(a, b, 9);
+    LMat(a, q1.data());
+    star_LMat(b, q1.data());
+    ExpectSame(a, b, 16);
+    RMat(a, q1.data());
+    star_RMat(b, q1.data());
+    ExpectSame(a, b, 16);
+    GMat(a, q1.data());
+    star_GMat(b, q1.data());
+    ExpectSame(a, b, 12);
+    for (const auto& q2 : Quaternions()) {
+      QuatCompose(a, q1.data(), q2.data());
+      star_QuatCompose(b, q1.data(), q2.data());
+      ExpectSame(a, b, 4);
+      QuatComposeLeft(a, q1.data(), q2.data());
+      star_QuatComposeLeft(b, q1.data(), q2.data());
+      ExpectSame(a, b, 4);
+      QuatDiff(a, q1.data(), q2.data());
+      star_QuatDiff(b, q1.data(), q2.data());
+      ExpectSame(a, b, 4);
+      ExpectSame(QuatAngleBetween(q1.data(), q2.data()),
+                 star_QuatAngleBetween(q1.data(), q2.data()));
+    }
+  }
+}
+
+TEST(Kernels, ExpmLogm) {
+  for (const auto& phi : RotationVectors()) {
+    sfloat a[4];
+    sfloat b[4];
+    QuatExpm(a, phi.data());
+    star_QuatExpm(b, phi.data());
+    ExpectSame(a, b, 4);
+    const sfloat q_pure[4] = {0.2, phi[0], phi[1], phi[2]};
+    QuatExp(a, q_pure);
+    star_QuatExp(b, q_pure);
+    ExpectSame(a, b, 4);
+  }
+  for (const auto& q : Quaternions()) {
+    sfloat a[4];
+    sfloat b[4];
+    QuatLogm(a, q.data());
+    star_QuatLogm(b, q.data());
+    ExpectSame(a, b, 3);
+    QuatLog(a, q.data());
+    star_QuatLog(b, q.data());
+    ExpectSame(a, b, 4);
+  }
+  for (sfloat angle : kAngles) {
+    sfloat a[4];
+    sfloat b[4];
+    QuatRotAxis(a, angle, 1);
+    star_QuatRotX(b, angle);
+    ExpectSame(a, b, 4);
+    QuatRotAxis(a, angle, 2);
+    star_QuatRotY(b, angle);
+    ExpectSame(a, b, 4);
+    QuatRotAxis(a, angle, 3);
+    star_QuatRotZ(b, angle);
+    ExpectSame(a, b, 4);
+  }
+}
+
+TEST(Kernels, Interpolation) {
+  const auto quats = Quaternions();
+  const std::vector<sfloat> times = {0, 0.3, 0.5, 1};
+  for (size_t i = 0; i + 1 < kAngles.size(); ++i) {
+    const sfloat* q0 = quats[i].data();
+    const sfloat* q1 = quats[i + 1].data();
+    const sfloat* q2 = quats[(i + 2) % kAngles.size()].data();
+    sfloat s0[4];
+    sfloat s1[4];
+    QuatSquadControlPoint(s0, q2, q0, q1);
+    star_QuatSquadControlPoint(s1, q2, q0, q1);
+    ExpectSame(s0, s1, 4);
+    QuatSquadControlPoint(s1, q0, q1, q2);
+    for (sfloat t : times) {
+      sfloat a[4];
+      sfloat b[4];
+      QuatSlerp(a, q0, q1, t);
+      star_QuatSlerp(b, q0, q1, t);
+      ExpectSame(a, b, 4);
+      QuatNlerp(a, q0, q1, t);
+      star_QuatNlerp(b, q0, q1, t);
+      ExpectSame(a, b, 4);
+      QuatSquad(a, q0, q1, s0, s1, t);
+      star_QuatSquad(b, q0, q1, s0, s1, t);
+      ExpectSame(a, b, 4);
+    }
+  }
+}
+
+TEST(Kernels, ThreeParameterizations) {
+  const auto quats = Quaternions();
+  for (const auto& q : quats) {
+    sfloat a[4];
+    sfloat b[4];
+    QuatToRodriguesParam(a, q.data());
+    star_QuatToRodriguesParam(b, q.data());
+    ExpectSame(a, b, 3);
+    QuatToMRP(a, q.data());
+    star_QuatToMRP(b, q.data());
+    ExpectSame(a, b, 3);
+    QuatInvCayley(a, q.data());
+    star_QuatInvCayley(b, q.data());
+    ExpectSame(a, b, 3);
+    QuatError(a, q.data(), quats[5].data());
+    star_QuatError(b, q.data(), quats[5].data());
+    ExpectSame(a, b, 3);
+  }
+  for (const auto& phi : RotationVectors()) {
+    sfloat a[4];
+    sfloat b[4];
+    RodriguesParamToQuat(a, phi.data());
+    star_RodriguesParamToQuat(b, phi.data());
+    ExpectSame(a, b, 4);
+    MRPToQuat(a, phi.data());
+    star_MRPToQuat(b, phi.data());
+    ExpectSame(a, b, 4);
+    QuatCayley(a, phi.data());
+    star_QuatCayley(b, phi.data());
+    ExpectSame(a, b, 4);
+    QuatAddError(a, quats[5].data(), phi.data());
+    star_QuatAddError(b, quats[5].data(), phi.data());
+    ExpectSame(a, b, 4);
+  }
+}
+
+TEST(Kernels, Jacobians) {
+  const sfloat x[3] = {0.5, -1.2, 2.0};
+  // Symmetric, as star_AttitudeProjectHessian requires
+  const sfloat H[16] = {4, 1, 0.5, -1, 1, 3, 0.2, 0.3, 0.5, 0.2, 2, -0.4, -1, 0.3, -0.4, 5};
+  for (const auto& q : Quaternions()) {
+    sfloat a[12];
+    sfloat b[12];
+    QuatRotateActiveJacobian(a, q.data(), x);
+    star_QuatRotateActiveJacobian(b, q.data(), x);
+    ExpectSame(a, b, 12);
+    QuatRotatePassiveJacobian(a, q.data(), x);
+    star_QuatRotatePassiveJacobian(b, q.data(), x);
+    ExpectSame(a, b, 12);
+    QuatLogmJacobian(a, q.data());
+    star_QuatLogmJacobian(b, q.data());
+    ExpectSame(a, b, 12);
+    QuatToRodriguesParamJacobian(a, q.data());
+    star_QuatToRodriguesParamJacobian(b, q.data());
+    ExpectSame(a, b, 12);
+    QuatToMRPJacobian(a, q.data());
+    star_QuatToMRPJacobian(b, q.data());
+    ExpectSame(a, b, 12);
+    QuatInvCayleyJacobian(a, q.data());
+    star_QuatInvCayleyJacobian(b, q.data());
+    ExpectSame(a, b, 12);
+    AttitudeProjectHessian(a, q.data(), H);
+    star_AttitudeProjectHessian(b, q.data(), H);
+    ExpectSame(a, b, 9);
+  }
+  for (const auto& phi : RotationVectors()) {
+    sfloat a[12];
+    sfloat b[12];
+    QuatExpmJacobian(a, phi.data());
+    star_QuatExpmJacobian(b, phi.data());
+    ExpectSame(a, b, 12);
+    RodriguesParamToQuatJacobian(a, phi.data());
+    star_RodriguesParamToQuatJacobian(b, phi.data());
+    ExpectSame(a, b, 12);
+    MRPToQuatJacobian(a, phi.data());
+    star_MRPToQuatJacobian(b, phi.data());
+    ExpectSame(a, b, 12);
+    QuatCayleyJacobian(a, phi.data());
+    star_QuatCayleyJacobian(b, phi.data());
+    ExpectSame(a, b, 12);
+  }
+}
+
+TEST(Kernels, MatrixProducts) {
+  sfloat A[16];
+  sfloat B[16];
+  for (int i = 0; i < 16; ++i) {
+    A[i] = std::sin(sfloat(i + 1));
+    B[i] = std::cos(sfloat(2 * i + 1));
+  }
+  sfloat a[16];
+  sfloat b[16];
+  MatMul<3, 3, 3>(a, A, B);
+  star_MatMul33(b, A, B);
+  ExpectSame(a, b, 9);
+  MatMul<3, 3, 1>(a, A, B);
+  star_VecMul33(b, A, B);
+  ExpectSame(a, b, 3);
+  TransposedMatMul<3, 3, 3>(a, A, B);
+  star_TransposedMatMul33(b, A, B);
+  ExpectSame(a, b, 9);
+  TransposedMatMul<3, 3, 1>(a, A, B);
+  star_TransposedVecMul33(b, A, B);
+  ExpectSame(a, b, 3);
+  MatMulTransposed<3, 3, 3>(a, A, B);
+  star_MatMulTransposed33(b, A, B);
+  ExpectSame(a, b, 9);
+
+  MatMul<4, 4, 4>(a, A, B);
+  star_MatMul44(b, A, B);
+  ExpectSame(a, b, 16);
+  MatMul<4, 4, 1>(a, A, B);
+  star_VecMul44(b, A, B);
+  ExpectSame(a, b, 4);
+  TransposedMatMul<4, 4, 4>(a, A, B);
+  star_TransposedMatMul44(b, A, B);
+  ExpectSame(a, b, 16);
+  TransposedMatMul<4, 4, 1>(a, A, B);
+  star_TransposedVecMul44(b, A, B);
+  ExpectSame(a, b, 4);
+  MatMulTransposed<4, 4, 4>(a, A, B);
+  star_MatMulTransposed44(b, A, B);
+  ExpectSame(a, b, 16);
+
+  MatMul<4, 3, 3>(a, A, B);
+  star_MatMul433(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMulTransposed<4, 3, 3>(a, A, B);
+  star_MatMulTransposed433(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMul<4, 4, 3>(a, A, B);
+  star_MatMul443(b, A, B);
+  ExpectSame(a, b, 12);
+  TransposedMatMul<4, 4, 3>(a, A, B);
+  star_TransposedMatMul443(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMul<3, 4, 4>(a, A, B);
+  star_MatMul344(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMulTransposed<3, 4, 4>(a, A, B);
+  star_MatMulTransposed344(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMul<3, 3, 4>(a, A, B);
+  star_MatMul334(b, A, B);
+  ExpectSame(a, b, 12);
+  TransposedMatMul<3, 3, 4>(a, A, B);
+  star_TransposedMatMul334(b, A, B);
+  ExpectSame(a, b, 12);
+  MatMul<4, 3, 1>(a, A, B);
+  star_VecMul43(b, A, B);
+  ExpectSame(a, b, 4);
+  TransposedMatMul<3, 4, 1>(a, A, B);
+  star_TransposedVecMul43(b, A, B);
+  ExpectSame(a, b, 3);
+}
+
+// Symmetric 3x3 matrices: generic, positive definite, with a repeated eigenvalue, a
+// multiple of the identity and zero
+static std::vector<std::vector<sfloat>> SymmetricMatrices33() {
+  return {{1, -2, 0.5, -2, 3, 1.5, 0.5, 1.5, -1},
+          {4, 1, 0.5, 1, 3, 0.2, 0.5, 0.2, 2},
+          {2, 0, 0, 0, 1, 0, 0, 0, 1},
+          {3, 0, 0, 0, 3, 0, 0, 0, 3},
+          {0, 0, 0, 0, 0, 0, 0, 0, 0}};
+}
+
+TEST(Kernels, Matrix3) {
+  // Generic, rank deficient and a perturbed rotation
+  std::vector<std::vector<sfloat>> mats = {{1, 2, -1, 0.5, 3, 2, -2, 1, 4},
+                                           {1, 2, 3, 2, 4, 6, -1, 0, 1},
+                                           {0.99, 0.01, -0.02, 0, 1.01, 0.03, 0.02, 0, 1}};
+  for (const auto& m : SymmetricMatrices33()) {
+    mats.push_back(m);
+  }
+  const sfloat x[3] = {0.5, -1.2, 2.0};
+  for (const auto& A : mats) {
+    sfloat a[9];
+    sfloat b[9];
+    sfloat a2[9];
+    sfloat b2[9];
+    ExpectSame(Dot3(A.data(), x), star_Dot3(A.data(), x));
+    Cross3(a, A.data(), x);
+    star_Cross(b, A.data(), x);
+    ExpectSame(a, b, 3);
+    ExpectSame(Det33(A.data()), star_Det33(A.data()));
+    EXPECT_EQ(Chol33(a, A.data()), star_Chol33(b, A.data()));
+    ExpectSame(a, b, 9);
+    EXPECT_EQ(CholSolve33(a, A.data(), x), star_CholSolve33(b, A.data(), x));
+    ExpectSame(a, b, 3);
+    QR33(a, a2, A.data());
+    star_QR33(b, b2, A.data());
+    ExpectSame(a, b, 9);
+    ExpectSame(a2, b2, 9);
+    // The factors of a singular matrix divide by a zero pivot, which rounds to a tiny one
+    // or not depending on the contraction of multiply-adds
+    const bool nonsingular = std::abs(star_Det33(A.data())) > 1e-3;
+    int perm_a[3];
+    int perm_b[3];
+    LU33(a, a2, perm_a, A.data());
+    star_LU33(b, b2, perm_b, A.data());
+    if (nonsingular) {
+      ExpectSame(a, b, 9);
+      ExpectSame(a2, b2, 9);
+    }
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(perm_a[i], perm_b[i]);
+    }
+    sfloat S_a[3];
+    sfloat S_b[3];
+    SVD33(a, S_a, a2, A.data());
+    star_SVD33(b, S_b, b2, A.data());
+    ExpectSame(a, b, 9);
+    ExpectSame(S_a, S_b, 3);
+    ExpectSame(a2, b2, 9);
+    if (nonsingular) {
+      std::copy(A.begin(), A.end(), a);
+      std::copy(A.begin(), A.end(), b);
+      Inverse33(a);
+      star_Inverse33(b);
+      ExpectSame(a, b, 9);
+    }
+    std::copy(A.begin(), A.end(), a);
+    std::copy(A.begin(), A.end(), b);
+    EXPECT_EQ(InversePSD33(a), star_InversePSD33(b));
+    ExpectSame(a, b, 9);
+  }
+  sfloat a[9];
+  sfloat b[9];
+  std::copy(mats[2].begin(), mats[2].end(), a);
+  std::copy(mats[2].begin(), mats[2].end(), b);
+  Orthonormalize33(a);
+  star_Orthonormalize33(b);
+  ExpectSame(a, b, 9);
+}
+
+TEST(Kernels, Eigen33) {
+  for (const auto& A : SymmetricMatrices33()) {
+    sfloat vals_a[3];
+    sfloat vals_b[3];
+    sfloat vecs_a[9];
+    sfloat vecs_b[9];
+    Eigen33(vals_a, vecs_a, A.data());
+    star_Eigen33(vals_b, vecs_b, A.data());
+    ExpectSame(vals_a, vals_b, 3);
+    ExpectSame(vecs_a, vecs_b, 9);
+  }
+}
+
+TEST(Kernels, Eigen44) {
+  // Generic, with a repeated eigenvalue and diagonal
+  const std::vector<std::vector<sfloat>> mats = {
+      {4, 1, 0.5, -1, 1, 3, 0.2, 0.3, 0.5, 0.2, 2, -0.4, -1, 0.3, -0.4, 5},
+      {2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 3},
+      {1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4}};
+  for (const auto& A : mats) {
+    sfloat vals_a[4];
+    sfloat vals_b[4];
+    sfloat vecs_a[16];
+    sfloat vecs_b[16];
+    Eigen44(vals_a, vecs_a, A.data());
+    star_Eigen44(vals_b, vecs_b, A.data());
+    ExpectSame(vals_a, vals_b, 4);
+    ExpectSame(vecs_a, vecs_b, 16);
+  }
+}
@@ -0,0 +1,179 @@
+//
+// Created by Brian Jackson on 5/20/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Pose.hpp"
+#include "star/Quaternion.hpp"
+#include "star/lie_groups.hpp"
+#include "star/matrix_multiplication.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+#include "star/lie.h"
+}
+
+using namespace star;
+using star::test::ExpectNear;
+using star::test::kStep;
+using star::test::NumericalJacobian;
+
+// Tolerances include the error of the configured STAR_FASTMATH tier, amplified by the step
+static const sfloat kTol = 100 * kStep * kStep + 10 * STAR_FASTMATH_TOL / kStep;
+
+// Exact identities only accumulate rounding errors
+static const sfloat kExactTol = 100 * std::numeric_limits<sfloat>::epsilon() +
+                                1000 * STAR_FASTMATH_TOL;
+
+// Rotation vectors at and around the identity, on both sides of the series threshold,
+// and at large angles
+static const Vec3 kRotations[] = {
+    {0, 0, 0},          {1e-5, -2e-5, 1e-5}, {0.01, 0.02, -0.01},
+    {0.02, -0.01, 0.03}, {0.3, -0.2, 0.5},    {-1.5, 2.0, 1.0},
+};
+
+static Matrix<6, 1> Tangent(const Vec3& rho, const Vec3& phi) {
+  return {rho.x, rho.y, rho.z, phi.x, phi.y, phi.z};
+}
+
+/*
+ * Central differences of the left (Exp(x + dx) Exp(x)^-1) or right (Exp(x)^-1 Exp(x + dx))
+ * perturbations of the exponential map of SO(3).
+ */
+static Mat3 SO3JacobianFiniteDiff(const Vec3& phi, bool left) {
+  const Quaternion q_inv = Quaternion::Expm(phi).Conjugate();
+  return NumericalJacobian(
+      [&](const Vec3& x) {
+        const Quaternion q = Quaternion::Expm(x);
+        return left ? q.Compose(q_inv).Logm() : q_inv.Compose(q).Logm();
+      },
+      phi);
+}
+
+static Matrix<6, 6> SE3JacobianFiniteDiff(const Matrix<6, 1>& xi, bool left) {
+  const Pose T_inv = Pose::Expm(xi).Inverse();
+  return NumericalJacobian(
+      [&](const Matrix<6, 1>& x) {
+        const Pose T = Pose::Expm(x);
+        return left ? T.Compose(T_inv).Logm() : T_inv.Compose(T).Logm();
+      },
+      xi);
+}
+
+TEST(SO3, Expm) {
+  for (const Vec3& phi : kRotations) {
+    const Quaternion q = Quaternion::Expm(phi);
+    const RotMat<Active> R = RotMat<Active>::FromQuaternion(q.w, q.x, q.y, q.z);
+    ExpectNear<Mat3>(SO3Expm(phi), R, kExactTol);
+  }
+}
+
+TEST(SO3, Jacobians) {
+  for (const Vec3& phi : kRotations) {
+    const Mat3 J_l = SO3LeftJacobian(phi);
+    const Mat3 J_r = SO3RightJacobian(phi);
+    ExpectNear(J_l, SO3JacobianFiniteDiff(phi, true), kTol);
+    ExpectNear(J_r, SO3JacobianFiniteDiff(phi, false), kTol);
+
+    // J_l(phi) = R(phi) J_r(phi) and J_r(phi) = J_l(phi)^T
+    ExpectNear<Mat3>(SO3Expm(phi) * J_r, J_l, kExactTol);
+    ExpectNear<Mat3>(J_l.Transpose(), J_r, kExactTol);
+
+    ExpectNear<Mat3>(J_l * SO3LeftJacobianInverse(phi), Mat3::Identity(), kExactTol);
+    ExpectNear<Mat3>(J_r * SO3RightJacobianInverse(phi), Mat3::Identity(), kExactTol);
+  }
+}
+
+TEST(SE3, ExpmLogm) {
+  const Vec3 rho = {0.5, -1.0, 2.0};
+  for (const Vec3& phi : kRotations) {
+    const Matrix<6, 1> xi = Tangent(rho, phi);
+    const Pose T = Pose::Expm(xi);
+    EXPECT_TRUE(T.Rotation().IsApprox(Quaternion::Expm(phi)));
+    ExpectNear<Vec3>(T.Translation(), SO3LeftJacobian(phi) * rho, kExactTol);
+    ExpectNear(T.Logm(), xi, kExactTol);
+  }
+
+  // A pose with w < 0 has the same logarithm as the one with the flipped quaternion
+  const Pose T(Quaternion(-0.5, 0.3, 0.6, -0.2).Normalize(), rho);
+  const Pose T_flip(T.Rotation().Flip(), rho);
+  ExpectNear(T.Logm(), T_flip.Logm(), kExactTol);
+  EXPECT_LE(Vec3(T.Logm()[3], T.Logm()[4], T.Logm()[5]).Norm(), M_PI + kExactTol);
+  EXPECT_TRUE(Pose::Expm(T.Logm()).IsApprox(T_flip));
+}
+
+TEST(SE3, Jacobians) {
+  const Vec3 rho = {0.5, -1.0, 2.0};
+  for (const Vec3& phi : kRotations) {
+    const Matrix<6, 1> xi = Tangent(rho, phi);
+    const Matrix<6, 6> J_l = SE3LeftJacobian(xi);
+    const Matrix<6, 6> J_r = SE3RightJacobian(xi);
+    ExpectNear(J_l, SE3JacobianFiniteDiff(xi, true), kTol);
+    ExpectNear(J_r, SE3JacobianFiniteDiff(xi, false), kTol);
+    ExpectNear<Matrix<6, 6>>(J_l * SE3LeftJacobianInverse(xi), Matrix<6, 6>::Identity(),
+                             kExactTol);
+    ExpectNear<Matrix<6, 6>>(J_r * SE3RightJacobianInverse(xi), Matrix<6, 6>::Identity(),
+                             kExactTol);
+  }
+}
+
+TEST(Lie, Batch) {
+  const int n = 6;
+  const Vec3 rho = {0.5, -1.0, 2.0};
+  std::vector<sfloat> phi(3 * n);
+  std::vector<sfloat> xi(6 * n);
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < 3; ++k) {
+      phi[3 * i + k] = kRotations[i][k];
+      xi[6 * i + k] = rho[k];
+      xi[6 * i + 3 + k] = kRotations[i][k];
+    }
+  }
+
+  // The batch kernels may contract and order the arithmetic differently
+  std::vector<sfloat> J(9 * n);
+  std::vector<sfloat> J_inv(9 * n);
+  star_SO3LeftJacobianBatch(J.data(), phi.data(), n);
+  star_SO3LeftJacobianInverseBatch(J_inv.data(), phi.data(), n);
+  for (int i = 0; i < n; ++i) {
+    ExpectNear(J.data() + 9 * i, SO3LeftJacobian(kRotations[i]), kExactTol);
+    ExpectNear(J_inv.data() + 9 * i, SO3LeftJacobianInverse(kRotations[i]), kExactTol);
+  }
+  star_SO3RightJacobianBatch(J.data(), phi.data(), n);
+  star_SO3RightJacobianInverseBatch(J_inv.data(), phi.data(), n);
+  for (int i = 0; i < n; ++i) {
+    ExpectNear(J.data() + 9 * i, SO3RightJacobian(kRotations[i]), kExactTol);
+    ExpectNear(J_inv.data() + 9 * i, SO3RightJacobianInverse(kRotations[i]), kExactTol);
+  }
+
+  std::vector<sfloat> q(4 * n);
+  std::vector<sfloat> t(3 * n);
+  std::vector<sfloat> xi_log(6 * n);
+  std::vector<sfloat> J6(36 * n);
+  star_SE3ExpmBatch(q.data(), t.data(), xi.data(), n);
+  star_SE3LogmBatch(xi_log.data(), q.data(), t.data(), n);
+  for (int i = 0; i < n; ++i) {
+    const Pose T = Pose::Expm(Tangent(rho, kRotations[i]));
+    ExpectNear(q.data() + 4 * i, T.Rotation(), kExactTol);
+    ExpectNear(t.data() + 3 * i, T.Translation(), kExactTol);
+    ExpectNear(xi_log.data() + 6 * i, T.Logm(), kExactTol);
+  }
+  star_SE3LeftJacobianBatch(J6.data(), xi.data(), n);
+  for (int i = 0; i < n; ++i) {
+    const Matrix<6, 1> xi_i = Tangent(rho, kRotations[i]);
+    ExpectNear(J6.data() + 36 * i, SE3LeftJacobian(xi_i), kExactTol);
+  }
+  star_SE3RightJacobianBatch(J6.data(), xi.data(), n);
+  for (int i = 0; i < n; ++i) {
+    const Matrix<6, 1> xi_i = Tangent(rho, kRotations[i]);
+    ExpectNear(J6.data() + 36 * i, SE3RightJacobian(xi_i), kExactTol);
+  }
+}
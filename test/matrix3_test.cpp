@@ -4,12 +4,31 @@
 //
 
 #include <cmath>
+#include <limits>
 #include <gtest/gtest.h>
 
 extern "C" {
 #include "star/matrix3.h"
 }
 
+constexpr sfloat TOL = 1e4 * std::numeric_limits<sfloat>::epsilon();
+
+static sfloat MaxAbsDiff33(const sfloat A[9], const sfloat B[9]) {
+  sfloat err = 0;
+  for (int i = 0; i < 9; i++) {
+    err = std::fmax(err, std::fabs(A[i] - B[i]));
+  }
+  return err;
+}
+
+static sfloat OrthogonalityError33(const sfloat Q[9]) {
+  sfloat QtQ[9];
+  sfloat I[9];
+  star_TransposedMatMul33(QtQ, Q, Q);
+  star_SetIdentity33(I, 1);
+  return MaxAbsDiff33(QtQ, I);
+}
+
 TEST(Matrix3, SetZero) {
   sfloat mat[9];
   star_SetZero33(mat);
@@ -125,6 +144,122 @@ TEST(Matrix3, MulAtx) {
   }
 }
 
+TEST(Matrix3, MulAxBatch) {
+  const sfloat A[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const int n = 37;
+  sfloat x[3][n];
+  sfloat y[3][n];
+  for (int i = 0; i < n; i++) {
+    x[0][i] = i;
+    x[1][i] = -2 * i + 1;
+    x[2][i] = 0.5 * i - 3;
+  }
+  star_VecMulBatch33(y[0], y[1], y[2], A, x[0], x[1], x[2], n);
+  for (int i = 0; i < n; i++) {
+    sfloat xi[3] = {x[0][i], x[1][i], x[2][i]};
+    sfloat yi[3];
+    star_VecMul33(yi, A, xi);
+    EXPECT_EQ(y[0][i], yi[0]);
+    EXPECT_EQ(y[1][i], yi[1]);
+    EXPECT_EQ(y[2][i], yi[2]);
+  }
+
+  // Multiply in place
+  star_VecMulBatch33(x[0], x[1], x[2], A, x[0], x[1], x[2], n);
+  for (int i = 0; i < n; i++) {
+    EXPECT_EQ(x[0][i], y[0][i]);
+    EXPECT_EQ(x[1][i], y[1][i]);
+    EXPECT_EQ(x[2][i], y[2][i]);
+  }
+}
+
+TEST(Matrix3, AffineMulBatch) {
+  const sfloat A[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const sfloat b[3] = {0.5, -1, 2};
+  const int n = 37;
+  sfloat x[3][n];
+  sfloat y[3][n];
+  sfloat xi[3 * n];
+  sfloat yi[3 * n];
+  for (int i = 0; i < n; i++) {
+    x[0][i] = i;
+    x[1][i] = -2 * i + 1;
+    x[2][i] = 0.5 * i - 3;
+    for (int k = 0; k < 3; k++) {
+      xi[3 * i + k] = x[k][i];
+    }
+  }
+  star_AffineMulBatch33(y[0], y[1], y[2], A, b, x[0], x[1], x[2], n);
+  star_AffineMulInterleaved33(yi, A, b, xi, n);
+  for (int i = 0; i < n; i++) {
+    sfloat Ax[3];
+    star_VecMul33(Ax, A, &xi[3 * i]);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(y[k][i], Ax[k] + b[k], TOL * (1 + std::fabs(Ax[k])));
+      EXPECT_NEAR(yi[3 * i + k], Ax[k] + b[k], TOL * (1 + std::fabs(Ax[k])));
+    }
+  }
+
+  // Transform in place
+  star_AffineMulBatch33(x[0], x[1], x[2], A, b, x[0], x[1], x[2], n);
+  star_AffineMulInterleaved33(xi, A, b, xi, n);
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_EQ(x[k][i], y[k][i]);
+      EXPECT_EQ(xi[3 * i + k], yi[3 * i + k]);
+    }
+  }
+}
+
+TEST(Matrix3, CongruenceTransform) {
+  const sfloat A[9] = {1, 2, 3, -4, 5, 6, 7, 0.5, 9};
+  const sfloat P[9] = {4, 2, -1, 2, 5, 1, -1, 1, 3};
+  sfloat AP[9];
+  sfloat APAt[9];
+  star_MatMul33(AP, A, P);
+  star_MatMulTransposed33(APAt, AP, A);
+
+  sfloat C[9];
+  star_CongruenceTransform33(C, A, P);
+  EXPECT_LT(MaxAbsDiff33(C, APAt), TOL);
+
+  // Only the upper triangle of P is read
+  sfloat Pu[9] = {4, 0, 0, 2, 5, 0, -1, 1, 3};
+  star_CongruenceTransform33(C, A, Pu);
+  EXPECT_LT(MaxAbsDiff33(C, APAt), TOL);
+
+  // Transform in place
+  star_CongruenceTransform33(Pu, A, Pu);
+  EXPECT_LT(MaxAbsDiff33(Pu, APAt), TOL);
+}
+
+TEST(Matrix3, CongruenceTransformBatch) {
+  const int n = 37;
+  sfloat A[n][9];
+  sfloat P[n][9];
+  sfloat C[n][9];
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < 9; k++) {
+      A[i][k] = std::sin(i + 2 * k);
+    }
+    const sfloat s = i;
+    const sfloat L[9] = {1 + s / 10, 0.5, -0.2, 0, 2, s / 3, 0, 0, 1};
+    star_MatMulTransposed33(P[i], L, L);
+  }
+  star_CongruenceTransformBatch33(C[0], A[0], P[0], n);
+  for (int i = 0; i < n; i++) {
+    sfloat Ci[9];
+    star_CongruenceTransform33(Ci, A[i], P[i]);
+    EXPECT_LT(MaxAbsDiff33(C[i], Ci), TOL);
+  }
+
+  // Transform in place
+  star_CongruenceTransformBatch33(P[0], A[0], P[0], n);
+  for (int i = 0; i < n; i++) {
+    EXPECT_LT(MaxAbsDiff33(P[i], C[i]), TOL);
+  }
+}
+
 TEST(Matrix3, MatMul_UpperTriangular) {
   sfloat A[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
   sfloat U[9] = {1, 0, 0, 2, 3, 0, 4, 5, 6};
@@ -247,7 +382,185 @@ TEST(Matrix3, Determinant) {
 
   // Check determinant for a rotation matrix
   sfloat theta = 0.5;
-  sfloat R[9] = {cos(theta), -sin(theta), 0, sin(theta), cos(theta), 0, 0, 0, 1};
+  const sfloat c = std::cos(theta);
+  const sfloat s = std::sin(theta);
+  sfloat R[9] = {c, -s, 0, s, c, 0, 0, 0, 1};
   det = star_Det33(R);
   EXPECT_EQ(det, 1);
-}
\ No newline at end of file
+}
+TEST(Matrix3, Cholesky) {
+  const sfloat A[9] = {4, 2, -1, 2, 5, 1, -1, 1, 3};
+  sfloat U[9];
+  EXPECT_TRUE(star_Chol33(U, A));
+  EXPECT_EQ(U[1], 0);
+  EXPECT_EQ(U[2], 0);
+  EXPECT_EQ(U[5], 0);
+  sfloat UtU[9];
+  star_TransposedMatMul33(UtU, U, U);
+  EXPECT_LT(MaxAbsDiff33(UtU, A), TOL);
+
+  const sfloat B[9] = {1, 2, 0, 2, 1, 0, 0, 0, 1};
+  EXPECT_FALSE(star_Chol33(U, B));
+}
+
+TEST(Matrix3, QR) {
+  const sfloat A[9] = {2, -1, 0.5, 1, 3, 2, -1, 0, 4};
+  sfloat Q[9];
+  sfloat R[9];
+  star_QR33(Q, R, A);
+  EXPECT_LT(OrthogonalityError33(Q), TOL);
+  EXPECT_EQ(R[1], 0);
+  EXPECT_EQ(R[2], 0);
+  EXPECT_EQ(R[5], 0);
+  EXPECT_GT(R[0], 0);
+  EXPECT_GT(R[4], 0);
+  EXPECT_GT(R[8], 0);
+  sfloat QR[9];
+  star_MatMul33(QR, Q, R);
+  EXPECT_LT(MaxAbsDiff33(QR, A), TOL);
+}
+
+TEST(Matrix3, LU) {
+  // Zero in the top left corner requires pivoting
+  const sfloat A[9] = {0, 2, 1, 3, 1, -2, 1, 4, 5};
+  sfloat L[9];
+  sfloat U[9];
+  int perm[3];
+  star_LU33(L, U, perm, A);
+  EXPECT_EQ(perm[0], 1);
+  EXPECT_EQ(L[0], 1);
+  EXPECT_EQ(L[4], 1);
+  EXPECT_EQ(L[8], 1);
+  EXPECT_EQ(L[3], 0);
+  EXPECT_EQ(L[6], 0);
+  EXPECT_EQ(L[7], 0);
+  EXPECT_EQ(U[1], 0);
+  EXPECT_EQ(U[2], 0);
+  EXPECT_EQ(U[5], 0);
+
+  sfloat PA[9];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      PA[i + 3 * j] = A[perm[i] + 3 * j];
+    }
+  }
+  sfloat LU[9];
+  star_MatMul33(LU, L, U);
+  EXPECT_LT(MaxAbsDiff33(LU, PA), TOL);
+}
+
+TEST(Matrix3, Eigen) {
+  const sfloat A[9] = {4, 2, -1, 2, 5, 1, -1, 1, 3};
+  sfloat lambda[3];
+  sfloat V[9];
+  star_Eigen33(lambda, V, A);
+  EXPECT_LE(lambda[0], lambda[1]);
+  EXPECT_LE(lambda[1], lambda[2]);
+  EXPECT_NEAR(lambda[0] + lambda[1] + lambda[2], 12, TOL);
+  EXPECT_NEAR(lambda[0] * lambda[1] * lambda[2], star_Det33(A), TOL);
+  EXPECT_LT(OrthogonalityError33(V), TOL);
+  EXPECT_NEAR(star_Det33(V), 1, TOL);
+  for (int k = 0; k < 3; k++) {
+    sfloat Av[3];
+    star_VecMul33(Av, A, V + 3 * k);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(Av[i], lambda[k] * V[3 * k + i], TOL);
+    }
+  }
+
+  // Repeated eigenvalues
+  const sfloat B[9] = {3, 1, 1, 1, 3, 1, 1, 1, 3};
+  star_Eigen33(lambda, V, B);
+  EXPECT_NEAR(lambda[0], 2, TOL);
+  EXPECT_NEAR(lambda[1], 2, TOL);
+  EXPECT_NEAR(lambda[2], 5, TOL);
+  EXPECT_LT(OrthogonalityError33(V), TOL);
+  for (int k = 0; k < 3; k++) {
+    sfloat Bv[3];
+    star_VecMul33(Bv, B, V + 3 * k);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(Bv[i], lambda[k] * V[3 * k + i], TOL);
+    }
+  }
+
+  // Multiple of the identity
+  sfloat C[9];
+  star_SetIdentity33(C, -2);
+  star_Eigen33(lambda, V, C);
+  EXPECT_EQ(lambda[0], -2);
+  EXPECT_EQ(lambda[2], -2);
+  EXPECT_LT(OrthogonalityError33(V), TOL);
+}
+
+TEST(Matrix3, SVD) {
+  const sfloat As[2][9] = {
+      {2, -1, 0.5, 1, 3, 2, -1, 0, 4},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9},  // rank 2
+  };
+  for (const sfloat* A : As) {
+    sfloat U[9];
+    sfloat S[3];
+    sfloat V[9];
+    star_SVD33(U, S, V, A);
+    EXPECT_GE(S[0], S[1]);
+    EXPECT_GE(S[1], S[2]);
+    EXPECT_GE(S[2], 0);
+    EXPECT_LT(OrthogonalityError33(U), TOL);
+    EXPECT_LT(OrthogonalityError33(V), TOL);
+
+    sfloat US[9];
+    for (int j = 0; j < 3; j++) {
+      for (int i = 0; i < 3; i++) {
+        US[i + 3 * j] = U[i + 3 * j] * S[j];
+      }
+    }
+    sfloat USVt[9];
+    star_MatMulTransposed33(USVt, US, V);
+    EXPECT_LT(MaxAbsDiff33(USVt, A), 10 * TOL);
+  }
+}
+
+TEST(Matrix3, CholSolve) {
+  const sfloat A[9] = {4, 2, -1, 2, 5, 1, -1, 1, 3};
+  const sfloat b[3] = {1, -2, 3};
+  sfloat x[3];
+  EXPECT_TRUE(star_CholSolve33(x, A, b));
+  sfloat Ax[3];
+  star_VecMul33(Ax, A, x);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(Ax[i], b[i], TOL);
+  }
+}
+
+TEST(Matrix3, Inverse) {
+  const sfloat A[9] = {2, -1, 0.5, 1, 3, 2, -1, 0, 4};
+  sfloat Ainv[9];
+  star_Copy33(Ainv, A);
+  star_Inverse33(Ainv);
+  sfloat AAinv[9];
+  sfloat I[9];
+  star_MatMul33(AAinv, A, Ainv);
+  star_SetIdentity33(I, 1);
+  EXPECT_LT(MaxAbsDiff33(AAinv, I), TOL);
+}
+
+TEST(Matrix3, InversePSD) {
+  const sfloat A[9] = {4, 2, -1, 2, 5, 1, -1, 1, 3};
+  sfloat Ainv[9];
+  star_Copy33(Ainv, A);
+  EXPECT_TRUE(star_InversePSD33(Ainv));
+  EXPECT_EQ(Ainv[1], Ainv[3]);
+  EXPECT_EQ(Ainv[2], Ainv[6]);
+  EXPECT_EQ(Ainv[5], Ainv[7]);
+  sfloat AAinv[9];
+  sfloat I[9];
+  star_MatMul33(AAinv, A, Ainv);
+  star_SetIdentity33(I, 1);
+  EXPECT_LT(MaxAbsDiff33(AAinv, I), TOL);
+
+  // Matrices that aren't positive definite are left unchanged
+  sfloat B[9] = {1, 2, 0, 2, 1, 0, 0, 0, 1};
+  EXPECT_FALSE(star_InversePSD33(B));
+  EXPECT_EQ(B[0], 1);
+  EXPECT_EQ(B[1], 2);
+}
@@ -3,17 +3,24 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "star/Mat3.hpp"
 #include "star/Mat4.hpp"
 #include "star/Mat43.hpp"
+#include "star/Matrix.hpp"
+#include "star/RotMat.hpp"
 #include "star/Transpose.hpp"
 #include "star/Vec3.hpp"
 #include "star/Vec4.hpp"
 #include "star/matrix_multiplication.hpp"
 
-#define EPS 1e-8
+#define EPS (100 * std::numeric_limits<sfloat>::epsilon())
 
 using namespace star;
 
@@ -50,6 +57,32 @@ TEST(Matrix3, ByRows) {
   }
 }
 
+TEST(Matrix3, Constexpr) {
+  // clang-format off
+  constexpr Mat3 A = Mat3::ByRows(
+      1, 4, 7,
+      2, 5, 8,
+      3, 6, 9
+  );
+  // clang-format on
+  constexpr Mat3 At = A.Transpose();
+  static_assert(At[1] == 4 && At[3] == 2 && At[8] == 9);
+  static_assert(Mat3::Identity()[4] == 1 && Mat3::Identity()[5] == 0);
+  static_assert(Mat3::Diagonal(1, 2, 3).GetDiagonal().z == 3);
+
+  constexpr Mat3 AAt = A * At;
+  static_assert(AAt[0] == 66 && AAt[3] == 78 && AAt[8] == 126);
+  constexpr Vec3 y = A * Vec3(1, 2, 3);
+  static_assert(y.x == 30 && y.y == 36 && y.z == 42);
+
+  // Compile-time and run-time products agree
+  Mat3 B = A;
+  Mat3 BBt = B * B.Transpose();
+  for (int i = 0; i < Mat3::kSize; ++i) {
+    EXPECT_DOUBLE_EQ(BBt[i], AAt[i]);
+  }
+}
+
 TEST(Matrix3, VectorMultiplication) {
   Mat3 A = {1, 2, 3, 4, 5, 6, 7, 8, 9};
   Vec3 v = {1, 2, 3};
@@ -73,6 +106,83 @@ TEST(Matrix3, TransposedVectorMultiplication) {
   EXPECT_NEAR(y1[2], 50, EPS);
 }
 
+TEST(Matrix3, Inverse) {
+  Mat3 A = Mat3::ByRows(2, 1, -1, -1, 3, 0, 0.5, 2, 4);
+  Mat3 I = A * A.Inverse();
+  Mat3 I_expected = Mat3::Identity();
+  for (int i = 0; i < A.Size(); ++i) {
+    EXPECT_NEAR(I[i], I_expected[i], EPS);
+  }
+
+  // Covariance matrix
+  Mat3 P = Mat3::ByRows(4, 2, -1, 2, 5, 1, -1, 1, 3);
+  Mat3 Pinv = P;
+  EXPECT_TRUE(Pinv.InversePSDInPlace());
+  I = P * Pinv;
+  for (int i = 0; i < A.Size(); ++i) {
+    EXPECT_NEAR(I[i], I_expected[i], EPS);
+  }
+
+  Vec3 b = {1, -2, 3};
+  Vec3 x;
+  EXPECT_TRUE(P.CholSolve(x, b));
+  EXPECT_LT((P * x).NormedDifference(b), EPS);
+}
+
+TEST(Matrix3, CongruenceTransform) {
+  Mat3 A = Mat3::ByRows(2, 1, -1, -1, 3, 0, 0.5, 2, 4);
+  Mat3 P = Mat3::ByRows(4, 2, -1, 2, 5, 1, -1, 1, 3);
+  Mat3 C = CongruenceTransform(A, P);
+  Mat3 C_expected = A * P * Transpose(A);
+  for (int i = 0; i < C.Size(); ++i) {
+    EXPECT_NEAR(C[i], C_expected[i], EPS);
+  }
+
+  std::vector<Mat3> As(5, A);
+  std::vector<Mat3> Ps(5, P);
+  CongruenceTransform(Ps.data(), As.data(), Ps.data(), Ps.size());
+  for (const Mat3& Pi : Ps) {
+    for (int i = 0; i < C.Size(); ++i) {
+      EXPECT_NEAR(Pi[i], C_expected[i], EPS);
+    }
+  }
+}
+
+TEST(Matrix3, Decompositions) {
+  Mat3 P = Mat3::ByRows(4, 2, -1, 2, 5, 1, -1, 1, 3);
+  Mat3 U;
+  EXPECT_TRUE(P.Cholesky(U));
+  Mat3 P_chol = Transpose(U) * U;
+  for (int i = 0; i < P.Size(); ++i) {
+    EXPECT_NEAR(P_chol[i], P[i], EPS);
+  }
+
+  Vec3 lambda;
+  Mat3 V;
+  P.Eigen(lambda, V);
+  Mat3 P_eigen = V * Mat3::Diagonal(lambda) * Transpose(V);
+  for (int i = 0; i < P.Size(); ++i) {
+    EXPECT_NEAR(P_eigen[i], P[i], EPS);
+  }
+
+  Mat3 A = Mat3::ByRows(2, 1, -1, -1, 3, 0, 0.5, 2, 4);
+  Mat3 Q;
+  Mat3 R;
+  A.QR(Q, R);
+  Mat3 A_qr = Q * R;
+  for (int i = 0; i < A.Size(); ++i) {
+    EXPECT_NEAR(A_qr[i], A[i], EPS);
+  }
+
+  Vec3 S;
+  A.SVD(U, S, V);
+  Mat3 A_svd = U * Mat3::Diagonal(S) * Transpose(V);
+  for (int i = 0; i < A.Size(); ++i) {
+    EXPECT_NEAR(A_svd[i], A[i], EPS);
+  }
+  EXPECT_NEAR(S[0] * S[1] * S[2], std::abs(A.Determinant()), EPS);
+}
+
 TEST(Matrix4, Zero) {
   Mat4 A = Mat4::Zero();
   for (int i = 0; i < A.Size(); ++i) {
@@ -300,3 +410,263 @@ TEST(Matrix43, MatrixMultiplication) {
   }
 
 }
+
+/*-------------------------------------
+ * Generic Matrices
+ *-----------------------------------*/
+// Deterministic test matrix with entries in [-1, 1]
+template <int R, int C>
+Matrix<R, C> TestMatrix(sfloat seed) {
+  Matrix<R, C> A;
+  for (int k = 0; k < R * C; ++k) {
+    A[k] = std::sin(seed + 0.7 * k);
+  }
+  return A;
+}
+
+template <int M, int K, int N>
+Matrix<M, N> ReferenceMultiply(const Matrix<M, K>& A, const Matrix<K, N>& B) {
+  Matrix<M, N> C;
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      double c = 0;
+      for (int k = 0; k < K; ++k) {
+        c += A[i + M * k] * B[k + K * j];
+      }
+      C[i + M * j] = c;
+    }
+  }
+  return C;
+}
+
+template <int R, int C>
+Matrix<C, R> ReferenceTranspose(const Matrix<R, C>& A) {
+  Matrix<C, R> At;
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < C; ++j) {
+      At[j + C * i] = A[i + R * j];
+    }
+  }
+  return At;
+}
+
+template <int R, int C>
+void ExpectMatrixNear(const Matrix<R, C>& A, const Matrix<R, C>& B, double tol) {
+  for (int k = 0; k < R * C; ++k) {
+    EXPECT_NEAR(A[k], B[k], tol) << "k = " << k;
+  }
+}
+
+TEST(Matrix, Specializations) {
+  static_assert(std::is_same_v<Mat3, Matrix<3, 3>>);
+  static_assert(std::is_same_v<Mat4, Matrix<4, 4>>);
+  static_assert(std::is_same_v<Mat43, Matrix<4, 3>>);
+  static_assert(Matrix<6, 6>::kSize == 36 && Matrix<3, 4>::kCols == 4);
+
+  // The transpose of a generic matrix can be a specialization
+  constexpr auto A = Matrix<3, 4>::ByRows(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+  static_assert(A(1, 0) == 5 && A[1] == 5 && A(0, 3) == 4);
+  Mat43 At = A.Transpose();
+  EXPECT_NEAR(At(3, 0), 4, EPS);
+  EXPECT_NEAR(At(0, 1), 5, EPS);
+
+  constexpr auto I = Matrix<6, 6>::Identity();
+  static_assert(I(5, 5) == 1 && I(4, 5) == 0);
+}
+
+TEST(Matrix, Multiplication) {
+  const double tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  auto A = TestMatrix<6, 12>(0.1);
+  auto B = TestMatrix<12, 6>(0.2);
+  ExpectMatrixNear(Matrix<6, 6>(A * B), ReferenceMultiply(A, B), tol);
+
+  auto At = A.Transpose();
+  ExpectMatrixNear(Matrix<6, 6>(Transpose(At) * B), ReferenceMultiply(A, B), tol);
+  auto Bt = B.Transpose();
+  ExpectMatrixNear(Matrix<6, 6>(A * Transpose(Bt)), ReferenceMultiply(A, B), tol);
+
+  // Generic shapes mixed with specializations
+  Mat3 C = TestMatrix<3, 3>(0.3);
+  auto D = TestMatrix<3, 6>(0.4);
+  ExpectMatrixNear(Matrix<3, 6>(C * D), ReferenceMultiply(C, D), tol);
+}
+
+TEST(Matrix, Multiplication34) {
+  const double tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  Mat3 A = TestMatrix<3, 3>(0.5);
+  Mat4 B = TestMatrix<4, 4>(0.6);
+  auto C = TestMatrix<3, 4>(0.7);
+  ExpectMatrixNear(A * C, ReferenceMultiply(A, C), tol);
+  ExpectMatrixNear(C * B, ReferenceMultiply(C, B), tol);
+
+  Mat3 At = A.Transpose();
+  Mat4 Bt = TestMatrix<4, 4>(0.6).Transpose();
+  ExpectMatrixNear(Transpose(At) * C, ReferenceMultiply(A, C), tol);
+  ExpectMatrixNear(C * Transpose(Bt), ReferenceMultiply(C, B), tol);
+
+  // 3x4 results viewed as the transpose of a 4x3 matrix
+  Mat43 Ct = C.Transpose();
+  Mat43 ACt;
+  Mat43 CBt;
+  Transpose<Mat43> AC(ACt);
+  Transpose<Mat43> CB(CBt);
+  MultiplyInPlace(AC, A, Transpose(Ct));
+  MultiplyInPlace(CB, Transpose(Ct), B);
+  auto AC_expected = ReferenceMultiply(A, C);
+  auto CB_expected = ReferenceMultiply(C, B);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_NEAR(ACt(j, i), AC_expected(i, j), tol);
+      EXPECT_NEAR(CBt(j, i), CB_expected(i, j), tol);
+    }
+  }
+}
+
+TEST(Matrix, Blocks) {
+  // Assemble a 6x6 Jacobian from 3x3 blocks
+  RotMat<Active> R = RotMat<Active>::RotZ(0.3);
+  Mat3 S = TestMatrix<3, 3>(0.8);
+  auto J = Matrix<6, 6>::Identity();
+  J.SetBlock(0, 0, R);
+  J.SetBlock(3, 0, S);
+  Mat3 J10 = J.GetBlock<3, 3>(3, 0);
+  ExpectMatrixNear(J10, S, 0);
+  ExpectMatrixNear(J.GetBlock<3, 3>(0, 0), Mat3(R), 0);
+  ExpectMatrixNear(J.GetBlock<3, 3>(3, 3), Mat3::Identity(), 0);
+  EXPECT_EQ(J(4, 1), S[1 + 3 * 1]);
+}
+
+TEST(Matrix, Solve) {
+  const double tol = 1000 * std::numeric_limits<sfloat>::epsilon();
+
+  // Symmetric positive definite 12x12 matrix
+  auto M = TestMatrix<12, 12>(0.9);
+  Matrix<12, 12> A = ReferenceMultiply(M, M.Transpose()) + 12 * Matrix<12, 12>::Identity();
+  auto B = TestMatrix<12, 2>(1.0);
+
+  Matrix<12, 12> U;
+  ASSERT_TRUE(A.Cholesky(U));
+  ExpectMatrixNear(ReferenceMultiply(U.Transpose(), U), A, tol);
+  EXPECT_EQ(U(1, 0), 0);
+
+  Matrix<12, 2> X;
+  ASSERT_TRUE(A.CholSolve(X, B));
+  ExpectMatrixNear(ReferenceMultiply(A, X), B, tol);
+
+  // General matrix, which needs pivoting
+  auto G = TestMatrix<12, 12>(1.1);
+  G(0, 0) = 0;
+  ASSERT_TRUE(G.Solve(X, B));
+  ExpectMatrixNear(ReferenceMultiply(G, X), B, 10 * tol);
+
+  // The output may alias the input
+  Matrix<12, 2> Y = B;
+  ASSERT_TRUE(G.Solve(Y, Y));
+  ExpectMatrixNear(Y, X, 0);
+
+  // Failures
+  Matrix<12, 12> A_neg = -1 * A;
+  EXPECT_FALSE(A_neg.CholSolve(X, B));
+  auto Z = Matrix<12, 12>::Zero();
+  EXPECT_FALSE(Z.Solve(X, B));
+}
+
+TEST(Matrix, TransposeViews) {
+  // Element access for every shape
+  Mat3 A = TestMatrix<3, 3>(1.2);
+  Mat4 B = TestMatrix<4, 4>(1.3);
+  Mat43 C = TestMatrix<4, 3>(1.4);
+  auto D = TestMatrix<3, 4>(1.5);
+  ExpectMatrixNear(Matrix<3, 3>(Transpose(A)), A.Transpose(), 0);
+  ExpectMatrixNear(Matrix<4, 4>(Transpose(B)), B.Transpose(), 0);
+  auto C_rows = Matrix<3, 4>::ByRows(C[0], C[1], C[2], C[3], C[4], C[5], C[6], C[7], C[8],
+                                     C[9], C[10], C[11]);
+  ExpectMatrixNear(Matrix<3, 4>(Transpose(C)), C_rows, 0);
+  ExpectMatrixNear(Matrix<4, 3>(Transpose(D)), ReferenceTranspose(D), 0);
+  Transpose Ct(C);
+  static_assert(decltype(Ct)::kRows == 3 && decltype(Ct)::kCols == 4);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_EQ(Ct(i, j), C(j, i));
+    }
+  }
+  EXPECT_EQ(Ct.GetRow(1)[3], C(3, 1));
+  EXPECT_EQ(Ct.GetCol(2)[1], C(2, 1));
+
+  // Views of rotation matrices refer to the underlying matrix type
+  RotMat<Active> R = RotMat<Active>::RotZ(0.4);
+  static_assert(std::is_same_v<decltype(Transpose(R)), Transpose<Mat3>>);
+  ExpectMatrixNear(Mat3(Transpose(R) * A), ReferenceMultiply(R.Transpose(), A), EPS);
+  Mat3 ApAt = A + Transpose(A);
+  ExpectMatrixNear(ApAt, Mat3(ApAt.Transpose()), 0);
+
+  // Views of temporaries and expressions would dangle
+  static_assert(!std::is_constructible_v<Transpose<Mat3>, Mat3>);
+  static_assert(!std::is_constructible_v<Transpose<Mat3>, decltype(A + 2.0 * A)>);
+  static_assert(!std::is_constructible_v<Transpose<Mat3>, RotMat<Active>>);
+
+  // Element-wise operations with any shape
+  Matrix<3, 4> E = 2.0 * Transpose(C) - D;
+  for (int k = 0; k < E.Size(); ++k) {
+    EXPECT_NEAR(E[k], 2 * ReferenceTranspose(C)[k] - D[k], EPS);
+  }
+
+  // Views of const matrices, written through a view of a non-const matrix
+  const Mat43& C_const = C;
+  auto Ct_const = Transpose(C_const);
+  Mat43 F = C;
+  Transpose<Mat43> Ft(F);
+  Ft(2, 3) = 42;
+  EXPECT_EQ(F(3, 2), 42);
+  Ft[1] = Ct_const[1];
+  EXPECT_EQ(F[4], C[4]);
+}
+
+TEST(Matrix, TransposedProducts) {
+  const double tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  Mat3 A = TestMatrix<3, 3>(1.6);
+  Mat3 B = TestMatrix<3, 3>(1.7);
+  Mat43 C = TestMatrix<4, 3>(1.8);
+  Mat43 D = TestMatrix<4, 3>(1.9);
+  auto E = TestMatrix<6, 4>(2.0);
+
+  // Both operands transposed
+  ExpectMatrixNear(Mat3(Transpose(A) * Transpose(B)),
+                   ReferenceMultiply(A.Transpose(), B.Transpose()), tol);
+  ExpectMatrixNear(Matrix<3, 6>(Transpose(C) * Transpose(E)),
+                   ReferenceMultiply(ReferenceTranspose(C), E.Transpose()), tol);
+
+  // Transposes of specializations with generic results
+  ExpectMatrixNear(Transpose(C) * D, ReferenceMultiply(ReferenceTranspose(C), D), tol);
+  ExpectMatrixNear(C * Transpose(D), ReferenceMultiply(C, ReferenceTranspose(D)), tol);
+  ExpectMatrixNear(E * Transpose(E), ReferenceMultiply(E, E.Transpose()), tol);
+  ExpectMatrixNear(A * Transpose(C), ReferenceMultiply(A, ReferenceTranspose(C)), tol);
+
+  // Kalman filter innovation covariance and gain, without forming H^T
+  auto H = TestMatrix<3, 6>(2.1);
+  auto P = TestMatrix<6, 6>(2.2);
+  Mat3 Sinv = TestMatrix<3, 3>(2.3);
+  ExpectMatrixNear(Mat3(H * P * Transpose(H)),
+                   ReferenceMultiply(ReferenceMultiply(H, P), H.Transpose()), 10 * tol);
+  ExpectMatrixNear(Matrix<6, 6>(Transpose(H) * Sinv * H),
+                   ReferenceMultiply(ReferenceMultiply(H.Transpose(), Sinv), H), 10 * tol);
+  ExpectMatrixNear(Matrix<6, 3>(P * Transpose(H) * Sinv),
+                   ReferenceMultiply(ReferenceMultiply(P, H.Transpose()), Sinv), 10 * tol);
+}
+
+TEST(Matrix, TransposedSolve) {
+  const double tol = 1000 * std::numeric_limits<sfloat>::epsilon();
+  // Test matrices are low rank, so shift them to be well-conditioned
+  Matrix<6, 6> G = TestMatrix<6, 6>(2.4) + 6 * Matrix<6, 6>::Identity();
+  auto B = TestMatrix<6, 2>(2.5);
+  Matrix<6, 2> X;
+  ASSERT_TRUE(Transpose(G).Solve(X, B));
+  ExpectMatrixNear(ReferenceMultiply(G.Transpose(), X), B, tol);
+
+  Mat3 A = TestMatrix<3, 3>(2.6) + 3 * Mat3::Identity();
+  Mat3 Y;
+  ASSERT_TRUE(Transpose(A).Solve(Y, Mat3::Identity()));
+  ExpectMatrixNear(Y, A.Transpose().Inverse(), tol);
+  const Matrix<6, 6> Z = Matrix<6, 6>::Zero();
+  EXPECT_FALSE(Transpose(Z).Solve(X, B));
+}
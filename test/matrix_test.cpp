@@ -6,8 +6,9 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <limits>
 
-#define EPS 1e-8
+#define EPS (100 * std::numeric_limits<sfloat>::epsilon())
 
 extern "C" {
 #include "star/matrix4.h"
@@ -91,7 +92,7 @@ TEST(Matrix4, SetConst) {
   sfloat A[16];
   star_SetConst44(A, 3.14);
   for (int i = 0; i < 16; i++) {
-    EXPECT_EQ(A[i], 3.14);
+    EXPECT_EQ(A[i], sfloat(3.14));
   }
 }
 
@@ -219,3 +220,54 @@ TEST(Matrix4, AddConst_Aliased) {
     EXPECT_NEAR(A[i], A0[i] + alpha, EPS);
   }
 }
+
+static void ExpectEigen44(const sfloat A[16], const sfloat lambda[4], const sfloat V[16],
+                          sfloat tol) {
+  for (int k = 0; k < 3; k++) {
+    EXPECT_LE(lambda[k], lambda[k + 1]);
+  }
+  sfloat VtV[16];
+  star_TransposedMatMul44(VtV, V, V);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_NEAR(VtV[i + 4 * j], i == j, tol);
+    }
+  }
+  for (int k = 0; k < 4; k++) {
+    sfloat Av[4];
+    star_VecMul44(Av, A, V + 4 * k);
+    for (int i = 0; i < 4; i++) {
+      EXPECT_NEAR(Av[i], lambda[k] * V[4 * k + i], tol);
+    }
+  }
+}
+
+TEST(Matrix4, Eigen) {
+  const sfloat tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  const sfloat A[16] = {4, 1, -2, 2, 1, 2, 0, 1, -2, 0, 3, -2, 2, 1, -2, -1};
+  sfloat lambda[4];
+  sfloat V[16];
+  star_Eigen44(lambda, V, A);
+  EXPECT_NEAR(lambda[0] + lambda[1] + lambda[2] + lambda[3], 8, 10 * tol);
+  ExpectEigen44(A, lambda, V, 10 * tol);
+
+  // Repeated eigenvalues
+  const sfloat B[16] = {3, 1, 1, 1, 1, 3, 1, 1, 1, 1, 3, 1, 1, 1, 1, 3};
+  star_Eigen44(lambda, V, B);
+  EXPECT_NEAR(lambda[0], 2, tol);
+  EXPECT_NEAR(lambda[1], 2, tol);
+  EXPECT_NEAR(lambda[2], 2, tol);
+  EXPECT_NEAR(lambda[3], 6, tol);
+  ExpectEigen44(B, lambda, V, tol);
+
+  // Diagonal, out of order
+  sfloat C[16] = {0};
+  const sfloat d[4] = {3, -1, 0, 2};
+  star_SetDiagonal44(C, d);
+  star_Eigen44(lambda, V, C);
+  EXPECT_EQ(lambda[0], -1);
+  EXPECT_EQ(lambda[1], 0);
+  EXPECT_EQ(lambda[2], 2);
+  EXPECT_EQ(lambda[3], 3);
+  ExpectEigen44(C, lambda, V, 0);
+}
@@ -0,0 +1,205 @@
+//
+// Created by Brian Jackson on 5/22/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Mekf.hpp"
+#include "star/MekfBank.hpp"
+#include "star/matrix_multiplication.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+using namespace star;
+using star::test::ExpectNear;
+
+static const sfloat kTol = 1e3 * std::numeric_limits<sfloat>::epsilon() +
+                           100 * STAR_FASTMATH_TOL;
+
+// The gains amplify rounding errors by the condition number of the innovation covariance
+static const sfloat kUpdateTol = 10 * kTol;
+
+static const sfloat kDt = 0.01;
+static const Mat3 kGyroNoise = Mat3::Identity() * 1e-6;
+static const Mat3 kBiasNoise = Mat3::Identity() * 1e-8;
+static const Mat3 kVectorNoise = Mat3::Identity() * 1e-4;
+static const Vec3 kReferences[2] = {Vec3(1, 0, 0), Vec3(0, 0.6, 0.8)};
+
+// A dense symmetric positive definite matrix
+template <int N>
+static Matrix<N, N> TestCovariance(sfloat scale) {
+  Matrix<N, N> A;
+  for (int j = 0; j < N; ++j) {
+    for (int i = 0; i < N; ++i) {
+      A(i, j) = std::sin(1 + i + 2 * j + scale);
+    }
+  }
+  Matrix<N, N> P;
+  MatMulTransposed<N, N, N>(P.data(), A.data(), A.data());
+  for (int k = 0; k < N * N; ++k) {
+    P[k] *= scale;
+  }
+  for (int i = 0; i < N; ++i) {
+    P(i, i) += scale;
+  }
+  return P;
+}
+
+TEST(Mekf, ConvergesFromVectorMeasurements) {
+  const Quaternion q_true = Quaternion(0.8, -0.3, 0.4, 0.2).Normalize();
+  Mekf<3> filter(kGyroNoise);
+  filter.Reset(q_true.AddError(Vec3(0.3, -0.2, 0.25)), Mat3::Identity() * 0.1);
+  for (int i = 0; i < 50; ++i) {
+    filter.Propagate(Vec3::Zero(), kDt);
+    for (const Vec3& r : kReferences) {
+      ASSERT_TRUE(filter.UpdateVector(q_true.RotatePassive(r), r, kVectorNoise));
+    }
+  }
+  EXPECT_LT(filter.Attitude().AngleBetween(q_true), 1e-3);
+
+  // The measurements shrink the covariance well below its initial value
+  const Mat3 P = filter.Covariance();
+  EXPECT_LT(P(0, 0) + P(1, 1) + P(2, 2), 1e-4);
+}
+
+TEST(Mekf, EstimatesGyroBias) {
+  const Vec3 omega = {0.1, -0.2, 0.15};
+  const Vec3 bias = {0.01, -0.02, 0.015};
+  Quaternion q_true = Quaternion(0.8, -0.3, 0.4, 0.2).Normalize();
+  Mekf<6> filter(kGyroNoise, kBiasNoise);
+  Matrix<6, 6> P0 = Matrix<6, 6>::Identity();
+  for (int i = 3; i < 6; ++i) {
+    P0(i, i) = 1e-3;
+  }
+  filter.Reset(q_true.AddError(Vec3(0.1, 0.05, -0.1)), P0);
+  for (int i = 0; i < 2000; ++i) {
+    filter.Propagate(omega + bias, kDt);
+    q_true = q_true.Compose(Quaternion::Expm(kDt * omega)).Normalize();
+    for (const Vec3& r : kReferences) {
+      ASSERT_TRUE(filter.UpdateVector(q_true.RotatePassive(r), r, kVectorNoise));
+    }
+  }
+  EXPECT_LT(filter.Attitude().AngleBetween(q_true), 1e-4 + kTol);
+  EXPECT_LT(filter.GyroBias().NormedDifference(bias), 1e-4 + kTol);
+}
+
+TEST(Mekf, PropagateCovariance) {
+  const Vec3 gyro = {0.3, -0.5, 0.8};
+  const Vec3 bias = {0.01, -0.02, 0.015};
+  const sfloat dt = 0.05;
+  const Matrix<6, 6> P0 = TestCovariance<6>(0.1);
+  Mekf<6> filter(Mat3::Diagonal(1e-4, 2e-4, 3e-4), Mat3::Diagonal(1e-5, 2e-5, 3e-5));
+  filter.Reset(Quaternion(0.8, -0.3, 0.4, 0.2).Normalize(), P0, bias);
+  filter.Propagate(gyro, dt);
+
+  // Dense F P F^T + Q
+  const Vec3 phi = dt * (gyro - bias);
+  Mat3 dR;
+  Mat3 Jr;
+  star_SO3Expm(dR.data(), phi.data());
+  star_SO3RightJacobian(Jr.data(), phi.data());
+  Matrix<6, 6> F = Matrix<6, 6>::Identity();
+  F.SetBlock(0, 0, dR.Transpose());
+  F.SetBlock(0, 3, Mat3(Jr * -dt));
+  Matrix<6, 6> Q = Matrix<6, 6>::Zero();
+  const Mat3 Ng = Mat3::Diagonal(1e-4, 2e-4, 3e-4);
+  const Mat3 Nb = Mat3::Diagonal(1e-5, 2e-5, 3e-5);
+  Q.SetBlock(0, 0, Mat3(dt * Ng + (dt * dt * dt / 3) * Nb));
+  Q.SetBlock(0, 3, Mat3(Nb * (-dt * dt / 2)));
+  Q.SetBlock(3, 0, Mat3(Nb * (-dt * dt / 2)));
+  Q.SetBlock(3, 3, Mat3(dt * Nb));
+  const Matrix<6, 6> P = F * P0 * F.Transpose() + Q;
+  ExpectNear(filter.Covariance(), P, kTol);
+}
+
+TEST(Mekf, GeneralUpdateMatchesVectorUpdate) {
+  const Vec3 bias = {0.01, -0.02, 0.015};
+  const Quaternion q = Quaternion(0.8, -0.3, 0.4, 0.2).Normalize();
+  const Vec3 body = Vec3(0.1, 0.7, 0.7).Normalize();
+  const Vec3& r = kReferences[1];
+  Mekf<6> vector(kGyroNoise, kBiasNoise);
+  vector.Reset(q, TestCovariance<6>(0.01), bias);
+  Mekf<6> general = vector;
+  ASSERT_TRUE(vector.UpdateVector(body, r, kVectorNoise));
+
+  const Vec3 predicted = q.RotatePassive(r);
+  Mat3 S;
+  star_SkewSymmetricMatrix(S.data(), predicted.data());
+  Matrix<3, 6> H = Matrix<3, 6>::Zero();
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      H(i, j) = S(i, j);
+    }
+  }
+  const Vec3 y = body - predicted;
+  ASSERT_TRUE(general.Update<3>(Matrix<3, 1>(y.x, y.y, y.z), H, kVectorNoise));
+  EXPECT_LT(general.Attitude().AngleBetween(vector.Attitude()), kUpdateTol);
+  ExpectNear(general.GyroBias(), vector.GyroBias(), kUpdateTol);
+  ExpectNear(general.Covariance(), vector.Covariance(), kUpdateTol);
+}
+
+TEST(Mekf, RejectsIndefiniteInnovation) {
+  const Quaternion q = Quaternion(0.8, -0.3, 0.4, 0.2).Normalize();
+  Mekf<3> filter(kGyroNoise);
+  filter.Reset(q, Mat3::Identity() * 0.01);
+  const Vec3& r = kReferences[0];
+  EXPECT_FALSE(filter.UpdateVector(Vec3(0, 1, 0), r, Mat3::Identity() * -1));
+  EXPECT_TRUE(filter.Attitude().IsApprox(q));
+  ExpectNear(filter.Covariance(), Mat3(Mat3::Identity() * 0.01), 0);
+}
+
+// Runs n filters one by one and in a bank through the same steps. The filters amplify
+// rounding errors over many steps, so the bank is synchronized with them after each one.
+template <int N>
+static void ExpectBankMatchesFilters(int n) {
+  std::vector<Mekf<N>> filters(n, Mekf<N>(kGyroNoise, kBiasNoise));
+  MekfBank<N> bank(n, kGyroNoise, kBiasNoise);
+  ASSERT_EQ(bank.Size(), n);
+  std::vector<Quaternion> q_true(n);
+  for (int i = 0; i < n; ++i) {
+    const Quaternion q = Quaternion(1, 0.1 * i, -0.05 * i, 0.3).Normalize();
+    q_true[i] = q.AddError(Vec3(0.02, -0.01, 0.01 * (i % 4)));
+    const Vec3 bias(0.01, -0.002 * i, 0.005);
+    filters[i].Reset(q, TestCovariance<N>(0.01 * (1 + i % 3)), bias);
+  }
+
+  Vec3Array gyro(n);
+  Vec3Array body(n);
+  Vec3Array reference(n);
+  for (int step = 0; step < 10; ++step) {
+    for (int i = 0; i < n; ++i) {
+      // Include rates small enough for the series of the coefficients
+      const sfloat scale = i % 2 ? 1 : 1e-3;
+      const Vec3& r = kReferences[(i + step) % 2];
+      gyro.Set(i, Vec3(std::sin(i + step), 0.5, std::cos(2 * i - step)) * scale);
+      body.Set(i, q_true[i].RotatePassive(r));
+      reference.Set(i, r);
+      bank.Reset(i, filters[i].Attitude(), filters[i].Covariance(), filters[i].GyroBias());
+    }
+    bank.Propagate(gyro, kDt);
+    bank.UpdateVector(body, reference, kVectorNoise);
+    for (int i = 0; i < n; ++i) {
+      filters[i].Propagate(gyro.Get(i), kDt);
+      ASSERT_TRUE(filters[i].UpdateVector(body.Get(i), reference.Get(i), kVectorNoise));
+      EXPECT_LT(bank.Attitude(i).Error(filters[i].Attitude()).Norm(), kUpdateTol);
+      ExpectNear(bank.GyroBias(i), filters[i].GyroBias(), kUpdateTol);
+      ExpectNear(bank.Covariance(i), filters[i].Covariance(), kUpdateTol);
+    }
+  }
+}
+
+TEST(MekfBank, MatchesFilters) {
+  ExpectBankMatchesFilters<3>(MekfBank<3>::kBlockSize + 3);
+  ExpectBankMatchesFilters<6>(2 * MekfBank<6>::kBlockSize + 5);
+}
@@ -0,0 +1,105 @@
+//
+// Created by Brian Jackson on 5/19/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Pose.hpp"
+#include "star/Quaternion.hpp"
+
+using namespace star;
+
+constexpr sfloat kTol = 100 * std::numeric_limits<sfloat>::epsilon();
+
+static Pose TestPose() {
+  return {Quaternion(0.9, -0.2, 0.3, 0.1).Normalize(), Vec3(1.5, -0.3, 2.0)};
+}
+
+static Pose OtherPose() {
+  return {Quaternion(0.2, 0.7, -0.1, 0.4).Normalize(), Vec3(-0.4, 0.8, 0.1)};
+}
+
+static Vec3 TestPoint(int i) {
+  return Vec3(std::sin(0.3 * i), std::cos(0.7 * i), 0.1 * i - 1);
+}
+
+static void ExpectNear(const Vec3& a, const Vec3& b) {
+  for (int k = 0; k < 3; ++k) {
+    EXPECT_NEAR(a[k], b[k], kTol * (1 + std::abs(b[k])));
+  }
+}
+
+TEST(Pose, Identity) {
+  const Pose T = Pose::Identity();
+  const Vec3 p = TestPoint(3);
+  ExpectNear(T.Transform(p), p);
+  EXPECT_TRUE(TestPose().Compose(T).IsApprox(TestPose()));
+  EXPECT_TRUE(T.Compose(TestPose()).IsApprox(TestPose()));
+}
+
+TEST(Pose, Transform) {
+  const Pose T = TestPose();
+  const Vec3 p = TestPoint(5);
+  ExpectNear(T.Transform(p), T.Rotation().RotateActive(p) + T.Translation());
+  ExpectNear(T.InverseTransform(T.Transform(p)), p);
+  ExpectNear(T.Inverse().Transform(p), T.InverseTransform(p));
+
+  const RotMat<Active> R = T.RotationMatrix();
+  ExpectNear(R * p + T.Translation(), T.Transform(p));
+}
+
+TEST(Pose, GroupOperations) {
+  const Pose A = TestPose();
+  const Pose B = OtherPose();
+  const Vec3 p = TestPoint(7);
+
+  // Compose applies the right operand first
+  ExpectNear(A.Compose(B).Transform(p), A.Transform(B.Transform(p)));
+  EXPECT_TRUE(A.Compose(A.Inverse()).IsApprox(Pose::Identity()));
+  EXPECT_TRUE(A.Inverse().Compose(A).IsApprox(Pose::Identity()));
+
+  // A.Between(B) is the pose of B relative to A
+  EXPECT_TRUE(A.Between(B).IsApprox(A.Inverse().Compose(B)));
+  EXPECT_TRUE(A.Compose(A.Between(B)).IsApprox(B));
+}
+
+TEST(Pose, BatchTransform) {
+  const Pose T = TestPose();
+  for (int n : {0, 1, 3, 8, 65}) {
+    std::vector<sfloat> x(n);
+    std::vector<sfloat> y(n);
+    std::vector<sfloat> z(n);
+    std::vector<Vec3> points(n);
+    for (int i = 0; i < n; ++i) {
+      points[i] = TestPoint(i);
+      x[i] = points[i].x;
+      y[i] = points[i].y;
+      z[i] = points[i].z;
+    }
+    std::vector<sfloat> x_out(n);
+    std::vector<sfloat> y_out(n);
+    std::vector<sfloat> z_out(n);
+    std::vector<Vec3> out(n);
+    T.Transform(x_out.data(), y_out.data(), z_out.data(), x.data(), y.data(), z.data(), n);
+    T.Transform(out.data(), points.data(), n);
+    for (int i = 0; i < n; ++i) {
+      const Vec3 expected = T.Transform(points[i]);
+      ExpectNear(Vec3(x_out[i], y_out[i], z_out[i]), expected);
+      ExpectNear(out[i], expected);
+    }
+
+    // Transform back in place
+    T.InverseTransform(x_out.data(), y_out.data(), z_out.data(), x_out.data(), y_out.data(),
+                       z_out.data(), n);
+    T.InverseTransform(out.data(), out.data(), n);
+    for (int i = 0; i < n; ++i) {
+      ExpectNear(Vec3(x_out[i], y_out[i], z_out[i]), points[i]);
+      ExpectNear(out[i], points[i]);
+    }
+  }
+}
@@ -0,0 +1,224 @@
+//
+// Created by Brian Jackson on 5/21/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Preintegrator.hpp"
+#include "star/matrix_multiplication.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+#include "star/lie.h"
+#include "star/quaternion.h"
+}
+
+using namespace star;
+using star::test::ExpectNear;
+using star::test::kStep;
+using star::test::NumericalJacobian;
+
+// Rounding errors accumulate over the samples
+static const sfloat kTol = 1e4 * std::numeric_limits<sfloat>::epsilon() +
+                           1e3 * STAR_FASTMATH_TOL;
+
+// Central differences amplify the error of the STAR_FASTMATH tier by the step
+static const sfloat kDiffTol = 100 * kStep * kStep + 100 * STAR_FASTMATH_TOL / kStep;
+
+static const sfloat kDt = 0.005;
+static const int kSamples = 200;
+
+static Preintegrator TestPreintegrator(const Vec3& gyro_bias = Vec3(0.01, -0.02, 0.005),
+                                       const Vec3& accel_bias = Vec3(0.1, 0.05, -0.2)) {
+  const Mat3 gyro_noise = Mat3::Diagonal(1e-4, 2e-4, 1.5e-4);
+  const Mat3 accel_noise = Mat3::Diagonal(1e-3, 1e-3, 3e-3);
+  return {gyro_noise, accel_noise, gyro_bias, accel_bias};
+}
+
+// A smooth, non-planar motion
+static void TestSamples(std::vector<Vec3>& gyro, std::vector<Vec3>& accel) {
+  gyro.resize(kSamples);
+  accel.resize(kSamples);
+  for (int i = 0; i < kSamples; ++i) {
+    const sfloat t = i * kDt;
+    gyro[i] = Vec3(0.5 * std::sin(2 * t), 0.3 + 0.2 * std::cos(3 * t), -0.4 * t);
+    accel[i] = Vec3(1 + std::cos(t), 9.81 + 0.5 * std::sin(4 * t), -0.3 * t);
+  }
+}
+
+static Preintegrator Integrated(const Vec3& gyro_bias, const Vec3& accel_bias) {
+  std::vector<Vec3> gyro;
+  std::vector<Vec3> accel;
+  TestSamples(gyro, accel);
+  Preintegrator preint = TestPreintegrator(gyro_bias, accel_bias);
+  preint.Integrate(gyro.data(), accel.data(), kDt, kSamples);
+  return preint;
+}
+
+TEST(Preintegrator, ConstantRates) {
+  const Vec3 omega = {0.3, -0.5, 0.8};
+  const Vec3 a = {1.0, -2.0, 9.81};
+  const int n = 100;
+  const sfloat T = n * kDt;
+
+  // Pure rotation
+  Preintegrator rotation = TestPreintegrator(Vec3::Zero(), Vec3::Zero());
+  for (int i = 0; i < n; ++i) {
+    rotation.Integrate(omega, Vec3::Zero(), kDt);
+  }
+  EXPECT_NEAR(rotation.DeltaTime(), T, kTol);
+  EXPECT_LT(rotation.DeltaRotation().AngleBetween(Quaternion::Expm(T * omega)), kTol);
+  ExpectNear(rotation.DeltaVelocity(), Vec3::Zero(), kTol);
+
+  // Pure translation, with the biases removed from the samples
+  const Vec3 accel_bias = {0.1, 0.05, -0.2};
+  Preintegrator translation = TestPreintegrator(Vec3::Zero(), accel_bias);
+  for (int i = 0; i < n; ++i) {
+    translation.Integrate(Vec3::Zero(), a + accel_bias, kDt);
+  }
+  EXPECT_TRUE(translation.DeltaRotation().IsApprox(Quaternion::Identity()));
+  ExpectNear<Vec3>(translation.DeltaVelocity(), T * a, kTol);
+  ExpectNear<Vec3>(translation.DeltaPosition(), (T * T / 2) * a, kTol);
+}
+
+TEST(Preintegrator, Covariance) {
+  std::vector<Vec3> gyro;
+  std::vector<Vec3> accel;
+  TestSamples(gyro, accel);
+  Preintegrator preint = TestPreintegrator();
+  const Vec3 bg = preint.GyroBias();
+  const Vec3 ba = preint.AccelBias();
+
+  // Dense propagation Sigma = F Sigma F^T + G Q G^T, G = [Jr dt 0; 0 R dt; 0 R dt^2 / 2]
+  Matrix<9, 9> cov = Matrix<9, 9>::Zero();
+  Matrix<6, 6> Q = Matrix<6, 6>::Zero();
+  Q.SetBlock(0, 0, Mat3(Mat3::Diagonal(1e-4, 2e-4, 1.5e-4) * (1 / kDt)));
+  Q.SetBlock(3, 3, Mat3(Mat3::Diagonal(1e-3, 1e-3, 3e-3) * (1 / kDt)));
+  Quaternion q = Quaternion::Identity();
+  for (int i = 0; i < kSamples; ++i) {
+    preint.Integrate(gyro[i], accel[i], kDt);
+
+    const Vec3 phi = kDt * (gyro[i] - bg);
+    const Vec3 a = accel[i] - ba;
+    Mat3 R;
+    Mat3 A;
+    Mat3 Jr;
+    star_QuatToRotMatActive(R.data(), q.data());
+    star_SkewSymmetricMatrix(A.data(), a.data());
+    star_SO3RightJacobian(Jr.data(), phi.data());
+    const Quaternion dq = Quaternion::Expm(phi);
+    Mat3 dR;
+    star_QuatToRotMatActive(dR.data(), dq.data());
+
+    Matrix<9, 9> F = Matrix<9, 9>::Identity();
+    F.SetBlock(0, 0, dR.Transpose());
+    F.SetBlock(3, 0, Mat3(Mat3(R * A) * -kDt));
+    F.SetBlock(6, 0, Mat3(Mat3(R * A) * (-kDt * kDt / 2)));
+    F.SetBlock(6, 3, Mat3(Mat3::Identity() * kDt));
+    Matrix<9, 6> G = Matrix<9, 6>::Zero();
+    G.SetBlock(0, 0, Mat3(Jr * kDt));
+    G.SetBlock(3, 3, Mat3(R * kDt));
+    G.SetBlock(6, 3, Mat3(R * (kDt * kDt / 2)));
+    cov = F * cov * F.Transpose() + G * Q * G.Transpose();
+    q = q.Compose(dq).Normalize();
+  }
+  ExpectNear(preint.Covariance(), cov, kTol);
+  ExpectNear(preint.Covariance(), preint.Covariance().Transpose(), kTol);
+}
+
+TEST(Preintegrator, BiasJacobians) {
+  const Vec3 bg = {0.01, -0.02, 0.005};
+  const Vec3 ba = {0.1, 0.05, -0.2};
+  const Preintegrator preint = Integrated(bg, ba);
+  const Quaternion q_inv = preint.DeltaRotation().Conjugate();
+
+  // The deltas as functions of the gyro and accelerometer biases
+  const auto rotation = [&](const Vec3& bg_x, const Vec3& ba_x) {
+    return q_inv.Compose(Integrated(bg_x, ba_x).DeltaRotation()).Logm();
+  };
+  const auto velocity = [&](const Vec3& bg_x, const Vec3& ba_x) {
+    return Integrated(bg_x, ba_x).DeltaVelocity();
+  };
+  const auto position = [&](const Vec3& bg_x, const Vec3& ba_x) {
+    return Integrated(bg_x, ba_x).DeltaPosition();
+  };
+  // Their Jacobians with respect to either bias
+  const auto of_gyro_bias = [&](const auto& f) {
+    return NumericalJacobian([&](const Vec3& x) { return f(x, ba); }, bg);
+  };
+  const auto of_accel_bias = [&](const auto& f) {
+    return NumericalJacobian([&](const Vec3& x) { return f(bg, x); }, ba);
+  };
+  ExpectNear(preint.RotationGyroBiasJacobian(), of_gyro_bias(rotation), kDiffTol);
+  ExpectNear(preint.VelocityGyroBiasJacobian(), of_gyro_bias(velocity), kDiffTol);
+  ExpectNear(preint.PositionGyroBiasJacobian(), of_gyro_bias(position), kDiffTol);
+  ExpectNear(preint.VelocityAccelBiasJacobian(), of_accel_bias(velocity), kDiffTol);
+  ExpectNear(preint.PositionAccelBiasJacobian(), of_accel_bias(position), kDiffTol);
+}
+
+TEST(Preintegrator, BiasCorrection) {
+  const Vec3 bg = {0.01, -0.02, 0.005};
+  const Vec3 ba = {0.1, 0.05, -0.2};
+  const Preintegrator preint = Integrated(bg, ba);
+
+  // The first-order correction is within O(db^2) of integrating again with the new biases,
+  // while the deltas without the correction are off by O(db)
+  const Vec3 dbg = {2e-3, -1e-3, 1.5e-3};
+  const Vec3 dba = {-1e-2, 2e-2, 1e-2};
+  const Vec3 bg_new = bg + dbg;
+  const Vec3 ba_new = ba + dba;
+  const Preintegrator exact = Integrated(bg_new, ba_new);
+  const sfloat tol = 1e-5 + kTol;
+  const Quaternion q = preint.CorrectedDeltaRotation(bg_new);
+  const Vec3 v = preint.CorrectedDeltaVelocity(bg_new, ba_new);
+  const Vec3 p = preint.CorrectedDeltaPosition(bg_new, ba_new);
+  EXPECT_LT(q.AngleBetween(exact.DeltaRotation()), tol);
+  ExpectNear(v, exact.DeltaVelocity(), tol);
+  ExpectNear(p, exact.DeltaPosition(), tol);
+  EXPECT_LT(10 * q.AngleBetween(exact.DeltaRotation()),
+            preint.DeltaRotation().AngleBetween(exact.DeltaRotation()));
+  EXPECT_LT(10 * v.NormedDifference(exact.DeltaVelocity()),
+            preint.DeltaVelocity().NormedDifference(exact.DeltaVelocity()));
+  EXPECT_LT(10 * p.NormedDifference(exact.DeltaPosition()),
+            preint.DeltaPosition().NormedDifference(exact.DeltaPosition()));
+}
+
+TEST(Preintegrator, Batch) {
+  std::vector<Vec3> gyro;
+  std::vector<Vec3> accel;
+  TestSamples(gyro, accel);
+  std::vector<sfloat> dt(kSamples, kDt);
+
+  Preintegrator single = TestPreintegrator();
+  for (int i = 0; i < kSamples; ++i) {
+    single.Integrate(gyro[i], accel[i], kDt);
+  }
+  Preintegrator batch = TestPreintegrator();
+  batch.Integrate(gyro.data(), accel.data(), dt.data(), kSamples);
+  for (int k = 0; k < 4; ++k) {
+    EXPECT_EQ(batch.DeltaRotation()[k], single.DeltaRotation()[k]);
+  }
+  for (int k = 0; k < 3; ++k) {
+    EXPECT_EQ(batch.DeltaVelocity()[k], single.DeltaVelocity()[k]);
+    EXPECT_EQ(batch.DeltaPosition()[k], single.DeltaPosition()[k]);
+  }
+  for (int k = 0; k < 81; ++k) {
+    EXPECT_EQ(batch.Covariance()[k], single.Covariance()[k]);
+  }
+
+  // Reset restarts from the identity with the same biases
+  batch.Reset();
+  EXPECT_EQ(batch.DeltaTime(), 0);
+  EXPECT_TRUE(batch.DeltaRotation().IsApprox(Quaternion::Identity()));
+  for (int k = 0; k < 81; ++k) {
+    EXPECT_EQ(batch.Covariance()[k], 0);
+  }
+  EXPECT_EQ(batch.GyroBias()[0], single.GyroBias()[0]);
+}
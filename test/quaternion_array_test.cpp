@@ -0,0 +1,218 @@
+//
+// Created by Brian Jackson on 5/14/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "star/QuaternionArray.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+#include "star/quaternion.h"
+}
+
+using namespace star;
+
+// Sizes covering an empty array, partial blocks and several blocks
+constexpr int kSizes[] = {0, 1, STAR_BLOCK_SIZE - 1, STAR_BLOCK_SIZE,
+                          3 * STAR_BLOCK_SIZE + 5};
+constexpr sfloat TOL =
+    100 * std::numeric_limits<sfloat>::epsilon() + 10 * STAR_FASTMATH_TOL;
+
+static QuaternionArray RandomQuaternions(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<sfloat> dist(-1, 1);
+  QuaternionArray q(n);
+  for (int i = 0; i < n; ++i) {
+    q.Set(i, Quaternion(dist(gen), dist(gen), dist(gen), dist(gen)).Normalize());
+  }
+  return q;
+}
+
+static Vec3Array RandomVectors(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<sfloat> dist(-1, 1);
+  Vec3Array v(n);
+  for (int i = 0; i < n; ++i) {
+    v.Set(i, Vec3(dist(gen), dist(gen), dist(gen)));
+  }
+  return v;
+}
+
+TEST(QuaternionArray, Layout) {
+  QuaternionArray q(2 * STAR_BLOCK_SIZE + 1);
+  EXPECT_EQ(q.Size(), 2 * STAR_BLOCK_SIZE + 1);
+  EXPECT_EQ(q.NumBlocks(), 3);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q.data()) % STAR_BLOCK_ALIGNMENT, 0u);
+
+  int i = STAR_BLOCK_SIZE + 2;
+  q.Set(i, Quaternion(1, 2, 3, 4));
+  EXPECT_TRUE(q.Get(i).IsApprox(Quaternion(1, 2, 3, 4)));
+  const sfloat* block = q.data() + 4 * STAR_BLOCK_SIZE;
+  for (int k = 0; k < 4; ++k) {
+    EXPECT_EQ(block[k * STAR_BLOCK_SIZE + 2], k + 1);
+  }
+
+  // New elements take the given value, and elements removed by shrinking are reset
+  q.Resize(4 * STAR_BLOCK_SIZE, Quaternion(0, 1, 0, 0));
+  EXPECT_TRUE(q.Get(i).IsApprox(Quaternion(1, 2, 3, 4)));
+  EXPECT_TRUE(q.Get(3 * STAR_BLOCK_SIZE).IsApprox(Quaternion(0, 1, 0, 0)));
+  q.Resize(STAR_BLOCK_SIZE + 1);
+  q.Resize(2 * STAR_BLOCK_SIZE);
+  EXPECT_TRUE(q.Get(i).IsApprox(Quaternion::Identity()));
+}
+
+TEST(QuaternionArray, Normalize) {
+  for (int n : kSizes) {
+    QuaternionArray q(n);
+    for (int i = 0; i < n; ++i) {
+      q.Set(i, Quaternion(1 + i, -2, 3, 0.5 * i));
+    }
+    QuaternionArray q_normalized = q.Normalize();
+    for (int i = 0; i < n; ++i) {
+      EXPECT_TRUE(q_normalized.Get(i).IsApprox(q.Get(i).Normalize(), TOL));
+    }
+    q.NormalizeInPlace();
+    for (int i = 0; i < n; ++i) {
+      EXPECT_TRUE(q.Get(i).IsApprox(q_normalized.Get(i), TOL));
+    }
+  }
+}
+
+TEST(QuaternionArray, Compose) {
+  for (int n : kSizes) {
+    QuaternionArray q1 = RandomQuaternions(n, 1);
+    QuaternionArray q2 = RandomQuaternions(n, 2);
+    QuaternionArray q12 = q1.Compose(q2);
+    QuaternionArray dq = q1.Diff(q2);
+    QuaternionArray q_inv = q1.Inverse();
+    for (int i = 0; i < n; ++i) {
+      EXPECT_TRUE(q12.Get(i).IsApprox(q1.Get(i).Compose(q2.Get(i)), TOL));
+      EXPECT_TRUE(dq.Get(i).IsApprox(q2.Get(i).Conjugate().Compose(q1.Get(i)), TOL));
+      EXPECT_TRUE(q_inv.Get(i).IsApprox(q1.Get(i).Inverse(), TOL));
+    }
+    q1.ComposeInPlace(q2);
+    for (int i = 0; i < n; ++i) {
+      EXPECT_TRUE(q1.Get(i).IsApprox(q12.Get(i), TOL));
+    }
+  }
+}
+
+TEST(QuaternionArray, LogmExpm) {
+  for (int n : kSizes) {
+    QuaternionArray q = RandomQuaternions(n, 3);
+    Vec3Array phi = q.Logm();
+    for (int i = 0; i < n; ++i) {
+      Vec3 phi_i = q.Get(i).Log().Vec() * 2;
+      EXPECT_LT(phi.Get(i).NormedDifference(phi_i), TOL);
+    }
+    QuaternionArray q_exp = QuaternionArray::Expm(phi);
+    for (int i = 0; i < n; ++i) {
+      EXPECT_TRUE(q_exp.Get(i).IsApprox(Quaternion::Expm(phi.Get(i)), TOL));
+      EXPECT_TRUE(q_exp.Get(i).IsApprox(q.Get(i), TOL) ||
+                  q_exp.Get(i).IsApprox(q.Get(i).Flip(), TOL));
+    }
+  }
+}
+
+TEST(QuaternionArray, LogmExpmBranches) {
+  // Angles about a generic axis, spread over several blocks
+  const sfloat angles[] = {
+      0,           1e-9, 1e-7,        1.9e-6, 2.1e-6,           // threshold of Logm
+      1e-5,        9e-5, 1.1e-4,      1,                        // threshold of Expm
+      M_PI - 1e-6, M_PI, M_PI + 1e-6, 4,      2 * M_PI - 1e-6,  // half turn
+  };
+  const Vec3 axis = {1.0 / 3, -2.0 / 3, 2.0 / 3};
+  const int n = sizeof(angles) / sizeof(angles[0]);
+  QuaternionArray q(n + 1);
+  Vec3Array phi(n);
+  for (int i = 0; i < n; ++i) {
+    const sfloat s = std::sin(angles[i] / 2);
+    q.Set(i, Quaternion(std::cos(angles[i] / 2), s * axis.x, s * axis.y, s * axis.z));
+    phi.Set(i, axis * angles[i]);
+  }
+  // Not a rotation, but it takes the zero branch of Logm
+  q.Set(n, Quaternion(0, 1e-8, 0, 0));
+
+  Vec3Array phi_log = q.Logm();
+  for (int i = 0; i < n + 1; ++i) {
+    const Quaternion q_i = q.Get(i);
+    sfloat phi_i[3];
+    star_QuatLogm(phi_i, q_i.data());
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_NEAR(phi_log.Get(i)[k], phi_i[k], TOL * (1 + std::abs(phi_i[k])))
+          << "at element " << i;
+    }
+  }
+  QuaternionArray q_exp = QuaternionArray::Expm(phi);
+  for (int i = 0; i < n; ++i) {
+    const Vec3 phi_i = phi.Get(i);
+    sfloat q_i[4];
+    star_QuatExpm(q_i, phi_i.data());
+    for (int k = 0; k < 4; ++k) {
+      EXPECT_NEAR(q_exp.Get(i).data()[k], q_i[k], TOL * (1 + std::abs(q_i[k])))
+          << "at element " << i;
+    }
+  }
+}
+
+TEST(QuaternionArray, RotateActive) {
+  for (int n : kSizes) {
+    QuaternionArray q = RandomQuaternions(n, 4);
+    Vec3Array v = RandomVectors(n, 5);
+    Vec3Array v_rot = q.RotateActive(v);
+    for (int i = 0; i < n; ++i) {
+      Vec3 expected = q.Get(i).RotateActive(v.Get(i));
+      EXPECT_LT(v_rot.Get(i).NormedDifference(expected), TOL);
+    }
+
+    // In place
+    q.RotateActive(v, v);
+    for (int i = 0; i < n; ++i) {
+      EXPECT_LT(v.Get(i).NormedDifference(v_rot.Get(i)), TOL);
+    }
+  }
+}
+
+TEST(QuaternionArray, Resample) {
+  // Constant rate rotation sampled at uneven times
+  const Vec3 omega(0.3, -1.2, 0.5);
+  const int n = 3 * STAR_BLOCK_SIZE + 2;
+  std::vector<sfloat> times(n);
+  QuaternionArray q(n);
+  for (int i = 0; i < n; ++i) {
+    times[i] = 0.1 * i + 0.02 * (i % 3);
+    q.Set(i, Quaternion::Expm(omega * times[i]));
+  }
+
+  // Queries before, between, on and after the samples
+  std::vector<sfloat> query_times;
+  for (sfloat t = -0.25; t < times.back() + 0.3; t += 0.037) {
+    query_times.push_back(t);
+  }
+  query_times.push_back(times[5]);
+  std::sort(query_times.begin(), query_times.end());
+  const int m = query_times.size();
+  QuaternionArray q_out = q.Resample(times.data(), query_times.data(), m);
+  ASSERT_EQ(q_out.Size(), m);
+  for (int j = 0; j < m; ++j) {
+    sfloat t = std::min(std::max(query_times[j], times.front()), times.back());
+    Quaternion q_expected = Quaternion::Expm(omega * t);
+    EXPECT_TRUE(q_out.Get(j).IsApprox(q_expected, TOL)) << "t = " << query_times[j];
+  }
+
+  // A single sample is held constant
+  QuaternionArray q1(1, q.Get(3));
+  QuaternionArray q1_out = q1.Resample(times.data(), query_times.data(), m);
+  for (int j = 0; j < m; ++j) {
+    EXPECT_TRUE(q1_out.Get(j).IsApprox(q.Get(3)));
+  }
+}
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include "star/Quaternion.hpp"
@@ -13,7 +14,13 @@
 #include "star/Vec3.hpp"
 #include "star/matrix_multiplication.hpp"
 
-#define EPS 1e-8
+extern "C" {
+#include "star/fastmath.h"
+}
+
+// Tolerances scale with the precision of sfloat and include the error of the configured
+// STAR_FASTMATH tier, which is 0 for libm
+#define EPS (100 * std::numeric_limits<sfloat>::epsilon() + 10 * STAR_FASTMATH_TOL)
 
 using namespace star;
 
@@ -89,6 +96,28 @@ TEST(QuaternionClass, Pure) {
   EXPECT_FLOAT_EQ(q2[3], 3);
 }
 
+TEST(QuaternionClass, Constexpr) {
+  // A fixed mounting rotation, 180 degrees about x then 180 degrees about y
+  constexpr Quaternion q_x(0, 1, 0, 0);
+  constexpr Quaternion q_y(0, 0, 1, 0);
+  constexpr Quaternion q_mount = q_x.Compose(q_y);
+  static_assert(q_mount.w == 0 && q_mount.x == 0 && q_mount.y == 0 && q_mount.z == 1);
+  static_assert(q_mount.Conjugate().Compose(q_mount).w == 1);
+  static_assert(Quaternion(2, 0, 0, 0).Inverse().w == 0.5);
+  static_assert(Quaternion::Pure(Vec3::ZAxis()).Vec().z == 1);
+  static_assert(Quaternion::Identity().H()(1, 0) == 1);
+
+  // Compile-time and run-time compositions agree
+  constexpr Quaternion q1(0.5, 0.5, -0.5, 0.5);
+  constexpr Quaternion q2(0.6, 0, 0.8, 0);
+  constexpr Quaternion q12 = q1.Compose(q2);
+  Quaternion q1_runtime = q1;
+  Quaternion q12_runtime = q1_runtime.Compose(q2);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_DOUBLE_EQ(q12_runtime[i], q12[i]);
+  }
+}
+
 TEST(QuaternionClass, Expm) {
   // Rotate 90 degrees about the x-axis
   Quaternion q = Quaternion::Expm(M_PI / 2, 0, 0);
@@ -175,6 +204,62 @@ TEST(QuaternionClass, GMat) {
   EXPECT_TRUE(q3.IsApprox(q4));
 }
 
+// Symmetric 4x4 matrix for the Hessian projection tests
+static Mat4 SymmetricTestMatrix(int seed) {
+  Mat4 H;
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      H(i, j) = std::sin(seed + i + 3 * j);
+      H(j, i) = H(i, j);
+    }
+  }
+  return H;
+}
+
+TEST(QuaternionClass, AttitudeProjectHessian) {
+  const sfloat tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  Quaternion q = Quaternion(1, 2, 3, 4).Normalize();
+  Mat4 H = SymmetricTestMatrix(1);
+  Mat43 G = q.AttitudeJacobian();
+  Mat43 HG = H * G;
+  Mat3 P_expected = Transpose(G) * HG;
+
+  Mat3 P = q.AttitudeProjectHessian(H);
+  for (int k = 0; k < Mat3::kSize; ++k) {
+    EXPECT_NEAR(P[k], P_expected[k], tol);
+  }
+  EXPECT_EQ(P(0, 1), P(1, 0));
+  EXPECT_EQ(P(0, 2), P(2, 0));
+  EXPECT_EQ(P(1, 2), P(2, 1));
+
+  // Only the upper triangle of H is read
+  Mat4 Hu = H;
+  Hu(1, 0) = Hu(2, 0) = Hu(3, 0) = Hu(2, 1) = Hu(3, 1) = Hu(3, 2) = 100;
+  Mat3 Pu = q.AttitudeProjectHessian(Hu);
+  for (int k = 0; k < Mat3::kSize; ++k) {
+    EXPECT_NEAR(Pu[k], P[k], tol);
+  }
+}
+
+TEST(QuaternionClass, AttitudeProjectHessianBatch) {
+  const sfloat tol = 100 * std::numeric_limits<sfloat>::epsilon();
+  const int n = 37;  // Not a multiple of the SIMD width
+  std::vector<Quaternion> q(n);
+  std::vector<Mat4> H(n);
+  std::vector<Mat3> P(n);
+  for (int i = 0; i < n; ++i) {
+    q[i] = Quaternion::FromAxisAngle(0.1 * i, Vec3(1, -2, 0.5 + i).Normalize());
+    H[i] = SymmetricTestMatrix(i);
+  }
+  AttitudeProjectHessian(P.data(), q.data(), H.data(), n);
+  for (int i = 0; i < n; ++i) {
+    Mat3 P_expected = q[i].AttitudeProjectHessian(H[i]);
+    for (int k = 0; k < Mat3::kSize; ++k) {
+      EXPECT_NEAR(P[i][k], P_expected[k], tol);
+    }
+  }
+}
+
 TEST(QuaternionClass, RotationFromMats) {
   sfloat angle = M_PI / 3;
   Vec3 axis = Vec3(1, 2, 3).Normalize();
@@ -188,3 +273,46 @@ TEST(QuaternionClass, RotationFromMats) {
   Vec3 x_rotated2 = Transpose(H) * (L * (Transpose(R) * (H * x)));
   EXPECT_LT(x_rotated.NormedDifference(x_rotated2), EPS);
 }
+
+TEST(QuaternionClass, RotateBatch) {
+  Quaternion q = Quaternion::FromAxisAngle(M_PI / 3, Vec3(1, 2, 3).Normalize());
+  const int n = 19;
+  std::vector<sfloat> x(n);
+  std::vector<sfloat> y(n);
+  std::vector<sfloat> z(n);
+  for (int i = 0; i < n; i++) {
+    x[i] = i;
+    y[i] = 1 - i;
+    z[i] = 2 * i + 3;
+  }
+  std::vector<sfloat> x_rot(n);
+  std::vector<sfloat> y_rot(n);
+  std::vector<sfloat> z_rot(n);
+  q.RotateActive(x_rot.data(), y_rot.data(), z_rot.data(), x.data(), y.data(), z.data(), n);
+  for (int i = 0; i < n; i++) {
+    Vec3 v_rot = q.RotateActive(Vec3(x[i], y[i], z[i]));
+    EXPECT_LT(v_rot.NormedDifference(Vec3(x_rot[i], y_rot[i], z_rot[i])), EPS);
+  }
+  q.RotatePassive(x_rot.data(), y_rot.data(), z_rot.data(), x.data(), y.data(), z.data(), n);
+  for (int i = 0; i < n; i++) {
+    Vec3 v_rot = q.RotatePassive(Vec3(x[i], y[i], z[i]));
+    EXPECT_LT(v_rot.NormedDifference(Vec3(x_rot[i], y_rot[i], z_rot[i])), EPS);
+  }
+}
+
+TEST(QuaternionClass, Interpolation) {
+  const sfloat tol = 16 * std::numeric_limits<sfloat>::epsilon() + 10 * STAR_FASTMATH_TOL;
+  Vec3 axis = Vec3(1, 2, 3).Normalize();
+  Quaternion q0 = Quaternion::FromAxisAngle(0.3, axis);
+  Quaternion q1 = Quaternion::FromAxisAngle(1.5, axis);
+  Quaternion q_expected = Quaternion::FromAxisAngle(0.6, axis);
+  EXPECT_TRUE(q0.Slerp(q1, 0.25).IsApprox(q_expected, tol));
+  EXPECT_TRUE(q0.Slerp(q1.Flip(), 0.25).IsApprox(q_expected, tol));
+  EXPECT_TRUE(q0.Nlerp(q1, 0.5).IsApprox(Quaternion::FromAxisAngle(0.9, axis), tol));
+
+  Quaternion q_prev = Quaternion::FromAxisAngle(-0.9, axis);
+  Quaternion q_next = Quaternion::FromAxisAngle(2.7, axis);
+  Quaternion s0 = Quaternion::SquadControlPoint(q_prev, q0, q1);
+  Quaternion s1 = Quaternion::SquadControlPoint(q0, q1, q_next);
+  EXPECT_TRUE(Quaternion::Squad(q0, q1, s0, s1, 0.25).IsApprox(q_expected, tol));
+}
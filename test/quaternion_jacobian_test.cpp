@@ -0,0 +1,140 @@
+//
+// Created by Brian Jackson on 5/18/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+
+extern "C" {
+#include "star/fastmath.h"
+}
+
+using namespace star;
+using star::test::kStep;
+using star::test::NumericalJacobian;
+using star::test::TestQuaternion;
+
+// Tolerances include the error of the configured STAR_FASTMATH tier, amplified by the step
+static const sfloat kTol = 100 * kStep * kStep + 10 * STAR_FASTMATH_TOL / kStep;
+
+// Central differences of a kernel with the signature f(y, x), for x of size N and y of
+// size M
+template <int M, int N, class Function>
+Matrix<M, N> FiniteDiff(Function f, const sfloat* x) {
+  Matrix<N, 1> x_vec;
+  for (int k = 0; k < N; ++k) {
+    x_vec[k] = x[k];
+  }
+  return NumericalJacobian(
+      [&](const Matrix<N, 1>& x_step) {
+        Matrix<M, 1> y;
+        f(y.data(), x_step.data());
+        return y;
+      },
+      x_vec);
+}
+
+template <class Mat, int M, int N>
+void ExpectNearFiniteDiff(const Mat& D, const Matrix<M, N>& D_fd) {
+  static_assert(Mat::kRows == M && Mat::kCols == N, "Jacobians must have the same size");
+  for (int k = 0; k < M * N; ++k) {
+    EXPECT_NEAR(D[k], D_fd[k], kTol * (1 + std::abs(D_fd[k]))) << "at element " << k;
+  }
+}
+
+TEST(QuaternionJacobian, RotateActive) {
+  const Quaternion q = TestQuaternion();
+  const Vec3 v = {1, -2, 3};
+  auto f = [&](sfloat* y, const sfloat* x) { star_QuatRotateActive(y, x, v.data()); };
+  ExpectNearFiniteDiff(q.RotateActiveJacobian(v), FiniteDiff<3, 4>(f, q.data()));
+}
+
+TEST(QuaternionJacobian, RotatePassive) {
+  const Quaternion q = TestQuaternion();
+  const Vec3 v = {1, -2, 3};
+  auto f = [&](sfloat* y, const sfloat* x) { star_QuatRotatePassive(y, x, v.data()); };
+  ExpectNearFiniteDiff(q.RotatePassiveJacobian(v), FiniteDiff<3, 4>(f, q.data()));
+}
+
+TEST(QuaternionJacobian, Compose) {
+  const Quaternion q = TestQuaternion();
+  const Quaternion p = Quaternion(0.2, 0.7, -0.1, 0.4).Normalize();
+  auto f = [&](sfloat* y, const sfloat* x) { star_QuatCompose(y, x, p.data()); };
+  ExpectNearFiniteDiff(q.ComposeJacobian(p), FiniteDiff<4, 4>(f, q.data()));
+
+  // ComposeLeft(p) applies p on the left, p * q
+  EXPECT_TRUE(q.ComposeLeft(p).IsApprox(p.Compose(q)));
+  auto f_left = [&](sfloat* y, const sfloat* x) { star_QuatCompose(y, p.data(), x); };
+  ExpectNearFiniteDiff(q.ComposeLeftJacobian(p), FiniteDiff<4, 4>(f_left, q.data()));
+}
+
+TEST(QuaternionJacobian, Expm) {
+  const Vec3 phis[] = {{0.3, -0.2, 0.5}, {-2, 1, 0.5}, {1e-5, 2e-5, -1e-5}};
+  for (const Vec3& phi : phis) {
+    ExpectNearFiniteDiff(Quaternion::ExpmJacobian(phi),
+                         FiniteDiff<4, 3>(star_QuatExpm, phi.data()));
+  }
+}
+
+TEST(QuaternionJacobian, Logm) {
+  // Unit, non-unit and nearly identity quaternions, and one with a negative scalar part
+  const Quaternion qs[] = {TestQuaternion(), Quaternion(1, 2, 3, 4) * 0.3,
+                           Quaternion(1, 1e-7, -2e-7, 1e-7),
+                           Quaternion(-0.5, 0.3, 0.6, -0.2).Normalize()};
+  for (const Quaternion& q : qs) {
+    ExpectNearFiniteDiff(q.LogmJacobian(), FiniteDiff<3, 4>(star_QuatLogm, q.data()));
+  }
+  EXPECT_TRUE(Quaternion::Expm(qs[0].Logm()).IsApprox(qs[0]));
+}
+
+TEST(QuaternionJacobian, Cayley) {
+  const Vec3 phi = {0.3, -0.2, 0.5};
+  ExpectNearFiniteDiff(Quaternion::CayleyJacobian(phi),
+                       FiniteDiff<4, 3>(star_QuatCayley, phi.data()));
+
+  const Quaternion q = TestQuaternion();
+  ExpectNearFiniteDiff(q.InvCayleyJacobian(),
+                       FiniteDiff<3, 4>(star_QuatInvCayley, q.data()));
+  EXPECT_TRUE(Quaternion::Cayley(q.InvCayley()).IsApprox(q));
+
+  // The Cayley map agrees with Expm to first order
+  const Vec3 dphi = {1e-4, -2e-4, 3e-4};
+  EXPECT_LT(Quaternion::Cayley(dphi).AngleBetween(Quaternion::Expm(dphi)), 1e-8 + kTol);
+}
+
+TEST(QuaternionJacobian, RodriguesParam) {
+  const Vec3 g = {0.3, -0.2, 0.5};
+  ExpectNearFiniteDiff(Quaternion::FromRodriguesParamJacobian(g),
+                       FiniteDiff<4, 3>(star_RodriguesParamToQuat, g.data()));
+
+  const Quaternion q = TestQuaternion();
+  ExpectNearFiniteDiff(q.ToRodriguesParamJacobian(),
+                       FiniteDiff<3, 4>(star_QuatToRodriguesParam, q.data()));
+  EXPECT_TRUE(Quaternion::FromRodriguesParam(q.ToRodriguesParam()).IsApprox(q));
+}
+
+TEST(QuaternionJacobian, MRP) {
+  const Vec3 p = {0.3, -0.2, 0.5};
+  ExpectNearFiniteDiff(Quaternion::FromMRPJacobian(p),
+                       FiniteDiff<4, 3>(star_MRPToQuat, p.data()));
+
+  const Quaternion q = TestQuaternion();
+  ExpectNearFiniteDiff(q.ToMRPJacobian(), FiniteDiff<3, 4>(star_QuatToMRP, q.data()));
+  EXPECT_TRUE(Quaternion::FromMRP(q.ToMRP()).IsApprox(q));
+}
+
+TEST(QuaternionJacobian, Error) {
+  const Quaternion q_ref = TestQuaternion();
+  const Quaternion q = Quaternion(0.2, 0.7, -0.1, 0.4).Normalize();
+  const Vec3 phi = q.Error(q_ref);
+  EXPECT_TRUE(q_ref.AddError(phi).IsApprox(q));
+  EXPECT_LT(q_ref.Error(q_ref).Norm(), 1e-12 + kTol);
+}
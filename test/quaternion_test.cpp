@@ -3,117 +3,138 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include <cmath>
+#include <limits>
+
 #include <gtest/gtest.h>
 #include <math.h>
 
 extern "C" {
+#include "star/fastmath.h"
 #include "star/matrix3.h"
 #include "star/quaternion.h"
 #include "star/vector3.h"
 #include "star/vector4.h"
 }
 
-#define EPS 1e-8
+// Tolerances scale with the precision of sfloat and include the error of the configured
+// STAR_FASTMATH tier, which is 0 for libm
+static const sfloat kEps = std::numeric_limits<sfloat>::epsilon();
+#define EPS (100 * kEps + 10 * STAR_FASTMATH_TOL)
+
+// Equal up to a few roundings in the precision of sfloat
+#define EXPECT_SFLOAT_EQ(expected, actual) \
+  EXPECT_NEAR(expected, actual, 4 * kEps * std::abs(expected))
+
+// Equal up to a few roundings and the error of the configured STAR_FASTMATH tier
+#define EXPECT_FASTMATH_EQ(expected, actual)                                            \
+  do {                                                                                  \
+    if (STAR_FASTMATH_TOL == 0) {                                                       \
+      EXPECT_SFLOAT_EQ(expected, actual);                                               \
+    } else {                                                                            \
+      EXPECT_NEAR(expected, actual, 10 * STAR_FASTMATH_TOL * (1 + std::abs(expected))); \
+    }                                                                                   \
+  } while (0)
 
 TEST(QuaternionTest, Norm) {
-  double q[4] = {1, 2, 3, 4};
-  EXPECT_DOUBLE_EQ(5.4772255750516612, star_QuatNorm(q));
-  EXPECT_DOUBLE_EQ(30, star_QuatNormSquared(q));
+  sfloat q[4] = {1, 2, 3, 4};
+  EXPECT_SFLOAT_EQ(5.4772255750516612, star_QuatNorm(q));
+  EXPECT_SFLOAT_EQ(30, star_QuatNormSquared(q));
 }
 
 TEST(QuaternionTest, QuatVecNorm) {
-  double q[4] = {1, 2, 3, 4};
-  EXPECT_DOUBLE_EQ(5.385164807134504, star_QuatVecNorm(q));
-  EXPECT_DOUBLE_EQ(29, star_QuatVecNormSquared(q));
+  sfloat q[4] = {1, 2, 3, 4};
+  EXPECT_SFLOAT_EQ(5.385164807134504, star_QuatVecNorm(q));
+  EXPECT_SFLOAT_EQ(29, star_QuatVecNormSquared(q));
 }
 
 TEST(QuaternionTest, Identity) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatIdentity(q);
-  EXPECT_DOUBLE_EQ(1, q[0]);
-  EXPECT_DOUBLE_EQ(0, q[1]);
-  EXPECT_DOUBLE_EQ(0, q[2]);
-  EXPECT_DOUBLE_EQ(0, q[3]);
-  EXPECT_DOUBLE_EQ(1, star_QuatNorm(q));
+  EXPECT_SFLOAT_EQ(1, q[0]);
+  EXPECT_SFLOAT_EQ(0, q[1]);
+  EXPECT_SFLOAT_EQ(0, q[2]);
+  EXPECT_SFLOAT_EQ(0, q[3]);
+  EXPECT_SFLOAT_EQ(1, star_QuatNorm(q));
 }
 
 TEST(QuaternionTest, Normalize) {
-  double q[4] = {1, 2, 3, 4};
-  double q_normalized[4];
-  double q_norm = star_QuatNorm(q);
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_normalized[4];
+  sfloat q_norm = star_QuatNorm(q);
   star_QuatNormalize(q_normalized, q);
-  EXPECT_DOUBLE_EQ(1, star_QuatNorm(q_normalized));
-  EXPECT_DOUBLE_EQ(q[0] / q_norm, q_normalized[0]);
-  EXPECT_DOUBLE_EQ(q[1] / q_norm, q_normalized[1]);
-  EXPECT_DOUBLE_EQ(q[2] / q_norm, q_normalized[2]);
-  EXPECT_DOUBLE_EQ(q[3] / q_norm, q_normalized[3]);
+  EXPECT_FASTMATH_EQ(1, star_QuatNorm(q_normalized));
+  EXPECT_FASTMATH_EQ(q[0] / q_norm, q_normalized[0]);
+  EXPECT_FASTMATH_EQ(q[1] / q_norm, q_normalized[1]);
+  EXPECT_FASTMATH_EQ(q[2] / q_norm, q_normalized[2]);
+  EXPECT_FASTMATH_EQ(q[3] / q_norm, q_normalized[3]);
 }
 
 TEST(QuaternionTest, NormalizeAliased) {
-  double q[4] = {1, 2, 3, 4};
-  double q_norm = star_QuatNorm(q);
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_norm = star_QuatNorm(q);
   star_QuatNormalize(q, q);
-  EXPECT_DOUBLE_EQ(1, star_QuatNorm(q));
-  EXPECT_DOUBLE_EQ(1 / q_norm, q[0]);
-  EXPECT_DOUBLE_EQ(2 / q_norm, q[1]);
-  EXPECT_DOUBLE_EQ(3 / q_norm, q[2]);
-  EXPECT_DOUBLE_EQ(4 / q_norm, q[3]);
+  EXPECT_FASTMATH_EQ(1, star_QuatNorm(q));
+  EXPECT_FASTMATH_EQ(1 / q_norm, q[0]);
+  EXPECT_FASTMATH_EQ(2 / q_norm, q[1]);
+  EXPECT_FASTMATH_EQ(3 / q_norm, q[2]);
+  EXPECT_FASTMATH_EQ(4 / q_norm, q[3]);
 }
 
 TEST(QuaternionTest, Flip) {
-  double q[4] = {1, 2, 3, 4};
-  double q_flip[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_flip[4];
   star_QuatFlip(q_flip, q);
-  EXPECT_DOUBLE_EQ(-1, q_flip[0]);
-  EXPECT_DOUBLE_EQ(-2, q_flip[1]);
-  EXPECT_DOUBLE_EQ(-3, q_flip[2]);
-  EXPECT_DOUBLE_EQ(-4, q_flip[3]);
+  EXPECT_SFLOAT_EQ(-1, q_flip[0]);
+  EXPECT_SFLOAT_EQ(-2, q_flip[1]);
+  EXPECT_SFLOAT_EQ(-3, q_flip[2]);
+  EXPECT_SFLOAT_EQ(-4, q_flip[3]);
 }
 
 TEST(QuaternionTest, QuatVec) {
-  double q[4] = {1, 2, 3, 4};
-  double vec[3];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat vec[3];
   star_QuatVec(vec, q);
-  EXPECT_DOUBLE_EQ(2, vec[0]);
-  EXPECT_DOUBLE_EQ(3, vec[1]);
-  EXPECT_DOUBLE_EQ(4, vec[2]);
+  EXPECT_SFLOAT_EQ(2, vec[0]);
+  EXPECT_SFLOAT_EQ(3, vec[1]);
+  EXPECT_SFLOAT_EQ(4, vec[2]);
 }
 
 TEST(QuaternionTest, Conjugate) {
-  double q[4] = {1, 2, 3, 4};
-  double q_conj[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_conj[4];
   star_QuatConjugate(q_conj, q);
-  EXPECT_DOUBLE_EQ(1, q_conj[0]);
-  EXPECT_DOUBLE_EQ(-2, q_conj[1]);
-  EXPECT_DOUBLE_EQ(-3, q_conj[2]);
-  EXPECT_DOUBLE_EQ(-4, q_conj[3]);
+  EXPECT_SFLOAT_EQ(1, q_conj[0]);
+  EXPECT_SFLOAT_EQ(-2, q_conj[1]);
+  EXPECT_SFLOAT_EQ(-3, q_conj[2]);
+  EXPECT_SFLOAT_EQ(-4, q_conj[3]);
 }
 
 TEST(QuaternionTest, QuatInverse) {
-  double q[4] = {1, 2, 3, 4};
-  double q_inv[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_inv[4];
   star_QuatInverse(q_inv, q);
-  EXPECT_DOUBLE_EQ(1.0 / 30.0, q_inv[0]);
-  EXPECT_DOUBLE_EQ(-2.0 / 30.0, q_inv[1]);
-  EXPECT_DOUBLE_EQ(-3.0 / 30.0, q_inv[2]);
-  EXPECT_DOUBLE_EQ(-4.0 / 30.0, q_inv[3]);
+  EXPECT_SFLOAT_EQ(1.0 / 30.0, q_inv[0]);
+  EXPECT_SFLOAT_EQ(-2.0 / 30.0, q_inv[1]);
+  EXPECT_SFLOAT_EQ(-3.0 / 30.0, q_inv[2]);
+  EXPECT_SFLOAT_EQ(-4.0 / 30.0, q_inv[3]);
 }
 
 TEST(QuaternionTest, QuatCompose) {
-  double q1[4] = {1, 2, 3, 4};
-  double q2[4] = {5, 6, 7, 8};
-  double q3[4];
+  sfloat q1[4] = {1, 2, 3, 4};
+  sfloat q2[4] = {5, 6, 7, 8};
+  sfloat q3[4];
   star_QuatCompose(q3, q1, q2);
-  EXPECT_DOUBLE_EQ(-60, q3[0]);
-  EXPECT_DOUBLE_EQ(12, q3[1]);
-  EXPECT_DOUBLE_EQ(30, q3[2]);
-  EXPECT_DOUBLE_EQ(24, q3[3]);
+  EXPECT_SFLOAT_EQ(-60, q3[0]);
+  EXPECT_SFLOAT_EQ(12, q3[1]);
+  EXPECT_SFLOAT_EQ(30, q3[2]);
+  EXPECT_SFLOAT_EQ(24, q3[3]);
 }
 
 TEST(QuaternionTest, ComposeInverse) {
-  double q[4] = {1, 2, 3, 4};
-  double q_inv[4];
-  double q_compose[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_inv[4];
+  sfloat q_compose[4];
   star_QuatInverse(q_inv, q);
   star_QuatCompose(q_compose, q, q_inv);
   EXPECT_NEAR(1, q_compose[0], EPS);
@@ -123,40 +144,40 @@ TEST(QuaternionTest, ComposeInverse) {
 }
 
 TEST(QuaternionTest, ComposeIdentity) {
-  double q[4] = {1, 2, 3, 4};
-  double qI[4];
-  double q_compose[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat qI[4];
+  sfloat q_compose[4];
   star_QuatIdentity(qI);
   star_QuatCompose(q_compose, q, qI);
-  EXPECT_DOUBLE_EQ(1, q_compose[0]);
-  EXPECT_DOUBLE_EQ(2, q_compose[1]);
-  EXPECT_DOUBLE_EQ(3, q_compose[2]);
-  EXPECT_DOUBLE_EQ(4, q_compose[3]);
+  EXPECT_SFLOAT_EQ(1, q_compose[0]);
+  EXPECT_SFLOAT_EQ(2, q_compose[1]);
+  EXPECT_SFLOAT_EQ(3, q_compose[2]);
+  EXPECT_SFLOAT_EQ(4, q_compose[3]);
 
   star_QuatCompose(q_compose, qI, q);
-  EXPECT_DOUBLE_EQ(1, q_compose[0]);
-  EXPECT_DOUBLE_EQ(2, q_compose[1]);
-  EXPECT_DOUBLE_EQ(3, q_compose[2]);
-  EXPECT_DOUBLE_EQ(4, q_compose[3]);
+  EXPECT_SFLOAT_EQ(1, q_compose[0]);
+  EXPECT_SFLOAT_EQ(2, q_compose[1]);
+  EXPECT_SFLOAT_EQ(3, q_compose[2]);
+  EXPECT_SFLOAT_EQ(4, q_compose[3]);
 }
 
 TEST(QuaternionTest, ComposeLeft) {
-  double q1[4] = {1, 2, 3, 4};
-  double q2[4] = {5, 6, 7, 8};
-  double q3[4];
+  sfloat q1[4] = {1, 2, 3, 4};
+  sfloat q2[4] = {5, 6, 7, 8};
+  sfloat q3[4];
   star_QuatComposeLeft(q3, q2, q1);
-  EXPECT_DOUBLE_EQ(-60, q3[0]);
-  EXPECT_DOUBLE_EQ(12, q3[1]);
-  EXPECT_DOUBLE_EQ(30, q3[2]);
-  EXPECT_DOUBLE_EQ(24, q3[3]);
+  EXPECT_SFLOAT_EQ(-60, q3[0]);
+  EXPECT_SFLOAT_EQ(12, q3[1]);
+  EXPECT_SFLOAT_EQ(30, q3[2]);
+  EXPECT_SFLOAT_EQ(24, q3[3]);
 }
 
 TEST(QuaternionTest, Diff) {
-  double q1[4] = {1, 2, 3, 4};
-  double q2[4] = {5, 6, 7, 8};
-  double dq[4];
-  double q3[4];
-  double q2_inv[4];
+  sfloat q1[4] = {1, 2, 3, 4};
+  sfloat q2[4] = {5, 6, 7, 8};
+  sfloat dq[4];
+  sfloat q3[4];
+  sfloat q2_inv[4];
   star_QuatConjugate(q2_inv, q2);
   star_QuatComposeLeft(q3, q1, q2_inv);
   star_QuatDiff(dq, q1, q2);  // NOTE: doesn't normalize
@@ -167,60 +188,60 @@ TEST(QuaternionTest, Diff) {
 }
 
 TEST(QuaternionTest, Log) {
-  double q[4] = {1, 2, 3, 4};
-  double q_log[4];
-  double phi[3] = {0.515190292664085, 0.7727854389961275, 1.03038058532817};
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_log[4];
+  sfloat phi[3] = {0.515190292664085, 0.7727854389961275, 1.03038058532817};
   star_QuatLog(q_log, q);
-  EXPECT_DOUBLE_EQ(log(star_QuatNorm(q)), q_log[0]);
-  EXPECT_DOUBLE_EQ(phi[0], q_log[1]);
-  EXPECT_DOUBLE_EQ(phi[1], q_log[2]);
-  EXPECT_DOUBLE_EQ(phi[2], q_log[3]);
+  EXPECT_FASTMATH_EQ(log(star_QuatNorm(q)), q_log[0]);
+  EXPECT_FASTMATH_EQ(phi[0], q_log[1]);
+  EXPECT_FASTMATH_EQ(phi[1], q_log[2]);
+  EXPECT_FASTMATH_EQ(phi[2], q_log[3]);
 
   // Normalize and check that the log is zero.
   star_QuatNormalize(q, q);
   star_QuatLog(q_log, q);
-  EXPECT_NEAR(0, q_log[0], 1e-15);
-  EXPECT_DOUBLE_EQ(phi[0], q_log[1]);
-  EXPECT_DOUBLE_EQ(phi[1], q_log[2]);
-  EXPECT_DOUBLE_EQ(phi[2], q_log[3]);
+  EXPECT_NEAR(0, q_log[0], 4 * kEps + STAR_FASTMATH_TOL);
+  EXPECT_FASTMATH_EQ(phi[0], q_log[1]);
+  EXPECT_FASTMATH_EQ(phi[1], q_log[2]);
+  EXPECT_FASTMATH_EQ(phi[2], q_log[3]);
 }
 
 TEST(QuaternionTest, PrincipalAngle) {
-  double q[4];
-  double angle1 = 0.4;
+  sfloat q[4];
+  sfloat angle1 = 0.4;
   star_QuatRotX(q, angle1);
   EXPECT_NEAR(star_PrincipalAngle(q), angle1, EPS);
 
-  double q2[4];
-  double phi[3] = {1, 0, 0};
-  double angle2 = 0.123;
+  sfloat q2[4];
+  sfloat phi[3] = {1, 0, 0};
+  sfloat angle2 = 0.123;
   star_Scale3(phi, angle2, phi);
   star_QuatExpm(q2, phi);
   EXPECT_NEAR(star_PrincipalAngle(q2), angle2, EPS);
 
-  double q3[4];
+  sfloat q3[4];
   star_QuatCompose(q3, q, q2);
   EXPECT_NEAR(star_PrincipalAngle(q3), angle1 + angle2, EPS);
 }
 
 TEST(QuaternionTest, Exp) {
-  double u[3] = {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
-  double theta = 3.2;
-  double phi[3] = {theta * u[0], theta * u[1], theta * u[2]};
-  double q_expected[4] = {cos(theta), sin(theta) * u[0], sin(theta) * u[1],
+  sfloat u[3] = {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
+  sfloat theta = 3.2;
+  sfloat phi[3] = {theta * u[0], theta * u[1], theta * u[2]};
+  sfloat q_expected[4] = {cos(theta), sin(theta) * u[0], sin(theta) * u[1],
                           sin(theta) * u[2]};
-  double q[4] = {0, phi[0], phi[1], phi[2]};
-  double q_exp[4];
+  sfloat q[4] = {0, phi[0], phi[1], phi[2]};
+  sfloat q_exp[4];
   star_QuatExp(q_exp, q);
   EXPECT_NEAR(q_expected[0], q_exp[0], EPS);
   EXPECT_NEAR(q_expected[1], q_exp[1], EPS);
   EXPECT_NEAR(q_expected[2], q_exp[2], EPS);
   EXPECT_NEAR(q_expected[3], q_exp[3], EPS);
   // Check Unit Norm
-  EXPECT_NEAR(1, star_QuatNorm(q_exp), 1e-15);
+  EXPECT_NEAR(1, star_QuatNorm(q_exp), 4 * kEps);
 
   // Check with non-zero scalar
-  double scalar = 1.2;
+  sfloat scalar = 1.2;
   q[0] = scalar;
   star_QuatExp(q_exp, q);
   EXPECT_NEAR(q_expected[0] * exp(scalar), q_exp[0], EPS);
@@ -230,12 +251,12 @@ TEST(QuaternionTest, Exp) {
 }
 
 TEST(QuaternionTest, Exp_SmallAngle) {
-  double u[3] = {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
-  double theta = 1e-8;
-  double phi[3] = {theta * u[0], theta * u[1], theta * u[2]};
-  double q_expected[4] = {1, theta * u[0], theta * u[1], theta * u[2]};
-  double q[4] = {0, phi[0], phi[1], phi[2]};
-  double q_exp[4];
+  sfloat u[3] = {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
+  sfloat theta = 1e-8;
+  sfloat phi[3] = {theta * u[0], theta * u[1], theta * u[2]};
+  sfloat q_expected[4] = {1, theta * u[0], theta * u[1], theta * u[2]};
+  sfloat q[4] = {0, phi[0], phi[1], phi[2]};
+  sfloat q_exp[4];
   star_QuatExp(q_exp, q);
   EXPECT_NEAR(q_expected[0], q_exp[0], EPS);
   EXPECT_NEAR(q_expected[1], q_exp[1], EPS);
@@ -243,13 +264,151 @@ TEST(QuaternionTest, Exp_SmallAngle) {
   EXPECT_NEAR(q_expected[3], q_exp[3], EPS);
 
   // Check Unit Norm
-  EXPECT_NEAR(1, star_QuatNorm(q_exp), 1e-15);
+  EXPECT_NEAR(1, star_QuatNorm(q_exp), 4 * kEps);
+}
+
+// Angles on both sides of the small-angle branches in star_QuatExpm and star_QuatLogm,
+// compared against a reference evaluated in double precision
+static const double kSmallAngles[] = {0,    1e-9, 1e-7, 9.9e-7, 1.01e-6, 1e-5,
+                                      9.9e-5, 1.01e-4, 1e-3, 1e-2, 0.1};
+static const double kAxis[3] = {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
+static const double kSmallAngleTol =
+    4 * std::numeric_limits<sfloat>::epsilon() + STAR_FASTMATH_TOL;
+
+TEST(QuaternionTest, Expm_SmallAngleAccuracy) {
+  for (double theta : kSmallAngles) {
+    sfloat phi[3] = {sfloat(theta * kAxis[0]), sfloat(theta * kAxis[1]),
+                     sfloat(theta * kAxis[2])};
+    sfloat q[4];
+    star_QuatExpm(q, phi);
+    EXPECT_NEAR(q[0], std::cos(theta / 2), kSmallAngleTol);
+    for (int i = 0; i < 3; ++i) {
+      // Relative to the magnitude of the vector part
+      double v = std::sin(theta / 2) * kAxis[i];
+      EXPECT_NEAR(q[i + 1], v, kSmallAngleTol * std::abs(v)) << "theta = " << theta;
+    }
+  }
+}
+
+TEST(QuaternionTest, Logm_SmallAngleAccuracy) {
+  for (double theta : kSmallAngles) {
+    double s = std::sin(theta / 2);
+    sfloat q[4] = {sfloat(std::cos(theta / 2)), sfloat(s * kAxis[0]), sfloat(s * kAxis[1]),
+                   sfloat(s * kAxis[2])};
+    sfloat phi[3];
+    star_QuatLogm(phi, q);
+    for (int i = 0; i < 3; ++i) {
+      double phi_expected = theta * kAxis[i];
+      EXPECT_NEAR(phi[i], phi_expected, kSmallAngleTol * std::abs(phi_expected))
+          << "theta = " << theta;
+    }
+  }
+}
+
+// Rotation angles between the endpoints, short of a half turn where both arcs tie
+static const double kSlerpAngles[] = {0, 1e-8, 1e-4, 0.1, 0.5, 0.9, 1.0, 2.0, 3.0, 3.1};
+static const double kSlerpTol =
+    16 * std::numeric_limits<sfloat>::epsilon() + 10 * STAR_FASTMATH_TOL;
+
+TEST(QuaternionTest, Slerp) {
+  sfloat q0[4] = {0.5, -0.5, 0.1, 0.7};
+  star_QuatNormalize(q0, q0);
+  for (double theta : kSlerpAngles) {
+    sfloat phi[3] = {sfloat(theta * kAxis[0]), sfloat(theta * kAxis[1]),
+                     sfloat(theta * kAxis[2])};
+    sfloat dq[4];
+    sfloat q1[4];
+    star_QuatExpm(dq, phi);
+    star_QuatCompose(q1, q0, dq);
+    for (int k = 0; k <= 20; ++k) {
+      sfloat t = k / 20.0;
+      sfloat phi_t[3] = {t * phi[0], t * phi[1], t * phi[2]};
+      sfloat q_expected[4];
+      star_QuatExpm(dq, phi_t);
+      star_QuatCompose(q_expected, q0, dq);
+
+      sfloat q[4];
+      star_QuatSlerp(q, q0, q1, t);
+      for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(q[i], q_expected[i], kSlerpTol) << "theta = " << theta << ", t = " << t;
+      }
+
+      // Takes the shorter arc regardless of the sign of q1
+      sfloat q1_flip[4];
+      star_QuatFlip(q1_flip, q1);
+      star_QuatSlerp(q, q0, q1_flip, t);
+      for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(q[i], q_expected[i], kSlerpTol) << "theta = " << theta << ", t = " << t;
+      }
+    }
+  }
+}
+
+TEST(QuaternionTest, Nlerp) {
+  sfloat q0[4] = {1, 0, 0, 0};
+  sfloat q1[4];
+  sfloat q[4];
+  star_QuatRotZ(q1, 1.0);
+  star_QuatNlerp(q, q0, q1, 0);
+  EXPECT_NEAR(q[0], 1, kSlerpTol);
+  star_QuatNlerp(q, q0, q1, 1);
+  EXPECT_NEAR(q[0], q1[0], kSlerpTol);
+  EXPECT_NEAR(q[3], q1[3], kSlerpTol);
+
+  // Halfway between the endpoints, where nlerp and slerp agree
+  sfloat q_half[4];
+  star_QuatFlip(q1, q1);
+  star_QuatNlerp(q, q0, q1, 0.5);
+  star_QuatRotZ(q_half, 0.5);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(q[i], q_half[i], kSlerpTol);
+  }
+}
+
+TEST(QuaternionTest, Squad) {
+  // Control points of knots at a constant rate about one axis reduce squad to slerp
+  sfloat q[4][4];
+  for (int k = 0; k < 4; ++k) {
+    star_QuatRotX(q[k], 0.4 * k);
+  }
+  sfloat s1[4];
+  sfloat s2[4];
+  star_QuatSquadControlPoint(s1, q[0], q[1], q[2]);
+  star_QuatSquadControlPoint(s2, q[1], q[2], q[3]);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(s1[i], q[1][i], kSlerpTol);
+  }
+  for (int k = 0; k <= 10; ++k) {
+    sfloat t = k / 10.0;
+    sfloat q_squad[4];
+    sfloat q_expected[4];
+    star_QuatSquad(q_squad, q[1], q[2], s1, s2, t);
+    star_QuatRotX(q_expected, 0.4 * (1 + t));
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_NEAR(q_squad[i], q_expected[i], kSlerpTol);
+    }
+  }
+
+  // Interpolates the knots for general control points
+  sfloat a[4] = {0.3, 0.1, -0.8, 0.2};
+  sfloat b[4] = {0.4, -0.5, 0.1, 0.6};
+  star_QuatNormalize(a, a);
+  star_QuatNormalize(b, b);
+  sfloat q_squad[4];
+  star_QuatSquad(q_squad, q[1], q[2], a, b, 0);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(q_squad[i], q[1][i], kSlerpTol);
+  }
+  star_QuatSquad(q_squad, q[1], q[2], a, b, 1);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NEAR(q_squad[i], q[2][i], kSlerpTol);
+  }
 }
 
 TEST(QuaternionTest, LogExp) {
-  double q[4] = {1, 2, 3, 4};
-  double q_log[4];
-  double q_exp[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_log[4];
+  sfloat q_exp[4];
   star_QuatLog(q_log, q);
   star_QuatExp(q_exp, q_log);
   EXPECT_NEAR(q[0], q_exp[0], EPS);
@@ -259,9 +418,9 @@ TEST(QuaternionTest, LogExp) {
 }
 
 TEST(QuaternionTest, ExpLog) {
-  double q[4] = {1, 2, 3, 4};
-  double q_log[4];
-  double q_exp[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat q_log[4];
+  sfloat q_exp[4];
   star_QuatNormalize(q, q);
   star_QuatExp(q_exp, q);
   star_QuatLog(q_log, q_exp);
@@ -273,20 +432,20 @@ TEST(QuaternionTest, ExpLog) {
 
 TEST(QuaternionTest, RotateActive) {
   // Rotate 90 degrees about Z
-  double phi[3] = {0, 0, M_PI_2};
-  double q[4];
+  sfloat phi[3] = {0, 0, M_PI_2};
+  sfloat q[4];
   star_QuatExpm(q, phi);
   EXPECT_NEAR(sqrt(2) / 2, q[0], EPS);
   EXPECT_NEAR(0, q[1], EPS);
   EXPECT_NEAR(0, q[2], EPS);
   EXPECT_NEAR(sqrt(2) / 2, q[3], EPS);
 
-  double v[3] = {1, -2, 3};
-  double v_rot[3];
+  sfloat v[3] = {1, -2, 3};
+  sfloat v_rot[3];
   star_QuatRotateActive(v_rot, q, v);
-  EXPECT_DOUBLE_EQ(-v[1], v_rot[0]);
-  EXPECT_DOUBLE_EQ(+v[0], v_rot[1]);
-  EXPECT_DOUBLE_EQ(+v[2], v_rot[2]);
+  EXPECT_FASTMATH_EQ(-v[1], v_rot[0]);
+  EXPECT_FASTMATH_EQ(+v[0], v_rot[1]);
+  EXPECT_FASTMATH_EQ(+v[2], v_rot[2]);
 
   // Rotate 90 degrees about X
   phi[0] = M_PI_2;
@@ -294,9 +453,9 @@ TEST(QuaternionTest, RotateActive) {
   phi[2] = 0;
   star_QuatExpm(q, phi);
   star_QuatRotateActive(v_rot, q, v);
-  EXPECT_DOUBLE_EQ(+v[0], v_rot[0]);
-  EXPECT_DOUBLE_EQ(-v[2], v_rot[1]);
-  EXPECT_DOUBLE_EQ(+v[1], v_rot[2]);
+  EXPECT_FASTMATH_EQ(+v[0], v_rot[0]);
+  EXPECT_FASTMATH_EQ(-v[2], v_rot[1]);
+  EXPECT_FASTMATH_EQ(+v[1], v_rot[2]);
 
   // Rotate 90 degrees about Y
   phi[0] = 0;
@@ -311,20 +470,20 @@ TEST(QuaternionTest, RotateActive) {
 
 TEST(QuaternionTest, RotatePassive) {
   // Rotate 90 degrees about Z
-  double phi[3] = {0, 0, M_PI_2};
-  double q[4];
+  sfloat phi[3] = {0, 0, M_PI_2};
+  sfloat q[4];
   star_QuatExpm(q, phi);
   EXPECT_NEAR(sqrt(2) / 2, q[0], EPS);
   EXPECT_NEAR(0, q[1], EPS);
   EXPECT_NEAR(0, q[2], EPS);
   EXPECT_NEAR(sqrt(2) / 2, q[3], EPS);
 
-  double v[3] = {1, -2, 3};
-  double v_rot[3];
+  sfloat v[3] = {1, -2, 3};
+  sfloat v_rot[3];
   star_QuatRotatePassive(v_rot, q, v);
-  EXPECT_DOUBLE_EQ(+v[1], v_rot[0]);
-  EXPECT_DOUBLE_EQ(-v[0], v_rot[1]);
-  EXPECT_DOUBLE_EQ(+v[2], v_rot[2]);
+  EXPECT_FASTMATH_EQ(+v[1], v_rot[0]);
+  EXPECT_FASTMATH_EQ(-v[0], v_rot[1]);
+  EXPECT_FASTMATH_EQ(+v[2], v_rot[2]);
 
   // Rotate 90 degrees about X
   phi[0] = M_PI_2;
@@ -332,9 +491,9 @@ TEST(QuaternionTest, RotatePassive) {
   phi[2] = 0;
   star_QuatExpm(q, phi);
   star_QuatRotatePassive(v_rot, q, v);
-  EXPECT_DOUBLE_EQ(+v[0], v_rot[0]);
-  EXPECT_DOUBLE_EQ(+v[2], v_rot[1]);
-  EXPECT_DOUBLE_EQ(-v[1], v_rot[2]);
+  EXPECT_FASTMATH_EQ(+v[0], v_rot[0]);
+  EXPECT_FASTMATH_EQ(+v[2], v_rot[1]);
+  EXPECT_FASTMATH_EQ(-v[1], v_rot[2]);
 
   // Rotate 90 degrees about Y
   phi[0] = 0;
@@ -347,22 +506,59 @@ TEST(QuaternionTest, RotatePassive) {
   EXPECT_NEAR(+v[0], v_rot[2], EPS);
 }
 
+TEST(QuaternionTest, RotateBatch) {
+  sfloat q[4] = {1, 2, 3, 4};
+  star_QuatNormalize(q, q);
+  const int n = 37;
+  sfloat x[3][n];
+  sfloat y_active[3][n];
+  sfloat y_passive[3][n];
+  for (int i = 0; i < n; i++) {
+    x[0][i] = sin(i);
+    x[1][i] = cos(2 * i);
+    x[2][i] = 0.1 * i - 1;
+  }
+  star_QuatRotateActiveBatch(y_active[0], y_active[1], y_active[2], q, x[0], x[1], x[2], n);
+  star_QuatRotatePassiveBatch(y_passive[0], y_passive[1], y_passive[2], q, x[0], x[1], x[2],
+                              n);
+  for (int i = 0; i < n; i++) {
+    sfloat v[3] = {x[0][i], x[1][i], x[2][i]};
+    sfloat v_rot[3];
+    star_QuatRotateActive(v_rot, q, v);
+    EXPECT_NEAR(v_rot[0], y_active[0][i], EPS);
+    EXPECT_NEAR(v_rot[1], y_active[1][i], EPS);
+    EXPECT_NEAR(v_rot[2], y_active[2][i], EPS);
+    star_QuatRotatePassive(v_rot, q, v);
+    EXPECT_NEAR(v_rot[0], y_passive[0][i], EPS);
+    EXPECT_NEAR(v_rot[1], y_passive[1][i], EPS);
+    EXPECT_NEAR(v_rot[2], y_passive[2][i], EPS);
+  }
+
+  // Rotate in place
+  star_QuatRotateActiveBatch(x[0], x[1], x[2], q, x[0], x[1], x[2], n);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(x[0][i], y_active[0][i], EPS);
+    EXPECT_NEAR(x[1][i], y_active[1][i], EPS);
+    EXPECT_NEAR(x[2][i], y_active[2][i], EPS);
+  }
+}
+
 TEST(QuaternionTest, QuatPure) {
-  double v[3] = {1, -2, 3};
-  double q_pure[4];
+  sfloat v[3] = {1, -2, 3};
+  sfloat q_pure[4];
   star_QuatPure(q_pure, v);
-  EXPECT_DOUBLE_EQ(0, q_pure[0]);
-  EXPECT_DOUBLE_EQ(v[0], q_pure[1]);
-  EXPECT_DOUBLE_EQ(v[1], q_pure[2]);
-  EXPECT_DOUBLE_EQ(v[2], q_pure[3]);
+  EXPECT_SFLOAT_EQ(0, q_pure[0]);
+  EXPECT_SFLOAT_EQ(v[0], q_pure[1]);
+  EXPECT_SFLOAT_EQ(v[1], q_pure[2]);
+  EXPECT_SFLOAT_EQ(v[2], q_pure[3]);
 }
 
 TEST(QuaternionTest, QuatPureCompose) {
-  double q[4] = {1, 2, 3, 4};
-  double v[3] = {1, -2, 3};
-  double q_pure[4];
-  double q_composed[4];
-  double q_composed_pure[4];
+  sfloat q[4] = {1, 2, 3, 4};
+  sfloat v[3] = {1, -2, 3};
+  sfloat q_pure[4];
+  sfloat q_composed[4];
+  sfloat q_composed_pure[4];
   star_QuatPure(q_pure, v);
   star_QuatCompose(q_composed, q, q_pure);
   star_QuatComposePure(q_composed_pure, q, v);
@@ -373,13 +569,13 @@ TEST(QuaternionTest, QuatPureCompose) {
 }
 
 TEST(QuaternionConversions, ToRotMatActive) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double R[9];
+  sfloat R[9];
   star_QuatToRotMatActive(R, q);
-  double x[3] = {1, 2, 3};
-  double y1[3];
-  double y2[3];
+  sfloat x[3] = {1, 2, 3};
+  sfloat y1[3];
+  sfloat y2[3];
   star_QuatRotateActive(y1, q, x);
   star_VecMul33(y2, R, x);
   EXPECT_NEAR(y1[0], y2[0], EPS);
@@ -388,13 +584,13 @@ TEST(QuaternionConversions, ToRotMatActive) {
 }
 
 TEST(QuaternionConversions, ToRotMatPassive) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double R[9];
+  sfloat R[9];
   star_QuatToRotMatPassive(R, q);
-  double x[3] = {1, 2, 3};
-  double y1[3];
-  double y2[3];
+  sfloat x[3] = {1, 2, 3};
+  sfloat y1[3];
+  sfloat y2[3];
   star_QuatRotatePassive(y1, q, x);
   star_VecMul33(y2, R, x);
   EXPECT_NEAR(y1[0], y2[0], EPS);
@@ -403,12 +599,12 @@ TEST(QuaternionConversions, ToRotMatPassive) {
 }
 
 TEST(QuaternionConversions, ToRodriguesParam) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double phi[3];
+  sfloat phi[3];
 
   star_QuatToRodriguesParam(phi, q);
-  double q2[4];
+  sfloat q2[4];
   star_RodriguesParamToQuat(q2, phi);
   EXPECT_NEAR(q[0], q2[0], EPS);
   EXPECT_NEAR(q[1], q2[1], EPS);
@@ -417,12 +613,12 @@ TEST(QuaternionConversions, ToRodriguesParam) {
 }
 
 TEST(QuaternionConversions, ToMRP) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double mrp[3];
+  sfloat mrp[3];
 
   star_QuatToMRP(mrp, q);
-  double q2[4];
+  sfloat q2[4];
   star_MRPToQuat(q2, mrp);
   EXPECT_NEAR(q[0], q2[0], EPS);
   EXPECT_NEAR(q[1], q2[1], EPS);
@@ -431,12 +627,12 @@ TEST(QuaternionConversions, ToMRP) {
 }
 
 TEST(QuaternionConversions, ToAxisAngle) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double aa[4];
+  sfloat aa[4];
 
   star_QuatToAxisAngle(aa, q);
-  double q2[4];
+  sfloat q2[4];
   star_AxisAngleToQuat(q2, aa);
   EXPECT_NEAR(q[0], q2[0], EPS);
   EXPECT_NEAR(q[1], q2[1], EPS);
@@ -445,10 +641,10 @@ TEST(QuaternionConversions, ToAxisAngle) {
 }
 
 TEST(QuaternionConversions, ToEuler123) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double euler[3];
-  double euler_expected[3] = {-1.373400766945016, 0.8232119771258758, -2.9441970937399127};
+  sfloat euler[3];
+  sfloat euler_expected[3] = {-1.373400766945016, 0.8232119771258758, -2.9441970937399127};
 
   star_QuatToEulerXYZ(euler, q);
   EXPECT_NEAR(euler_expected[0], euler[0], EPS);
@@ -456,8 +652,8 @@ TEST(QuaternionConversions, ToEuler123) {
   EXPECT_NEAR(euler_expected[2], euler[2], EPS);
 
   // Rotate about x
-  double angle = 0.2;
-  double phi[3] = {angle, 0, 0};
+  sfloat angle = 0.2;
+  sfloat phi[3] = {angle, 0, 0};
   star_QuatExpm(q, phi);
   star_QuatToEulerXYZ(euler, q);
   EXPECT_NEAR(euler[0], angle, EPS);
@@ -484,10 +680,10 @@ TEST(QuaternionConversions, ToEuler123) {
 }
 
 TEST(QuaternionConversions, ToEulerZYX) {
-  double q[4] = {1, 2, 3, 4};
+  sfloat q[4] = {1, 2, 3, 4};
   star_QuatNormalize(q, q);
-  double euler[3];
-  double euler_expected[3] = {2.356194490192345, -0.3398369094541219, 1.4288992721907328};
+  sfloat euler[3];
+  sfloat euler_expected[3] = {2.356194490192345, -0.3398369094541219, 1.4288992721907328};
 
   star_QuatToEulerZYX(euler, q);
   EXPECT_NEAR(euler_expected[0], euler[0], EPS);
@@ -495,8 +691,8 @@ TEST(QuaternionConversions, ToEulerZYX) {
   EXPECT_NEAR(euler_expected[2], euler[2], EPS);
 
   // Rotate about x
-  double angle = 0.2;
-  double phi[3] = {angle, 0, 0};
+  sfloat angle = 0.2;
+  sfloat phi[3] = {angle, 0, 0};
   star_QuatExpm(q, phi);
   star_QuatToEulerZYX(euler, q);
   EXPECT_NEAR(euler[0], 0, EPS);
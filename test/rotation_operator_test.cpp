@@ -0,0 +1,81 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Quaternion.hpp"
+#include "star/RotMat.hpp"
+#include "star/RotationOperator.hpp"
+
+using namespace star;
+using star::test::TestQuaternion;
+
+constexpr double kTol = 1e-6;
+
+// Rotates n vectors in place and checks them against the quaternion
+static void CheckBatch(const RotationOperator& op, const Quaternion& q, int n) {
+  std::vector<sfloat> x(n);
+  std::vector<sfloat> y(n);
+  std::vector<sfloat> z(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = std::sin(0.3 * i);
+    y[i] = std::cos(0.7 * i);
+    z[i] = 0.1 * i - 1;
+  }
+  std::vector<sfloat> x_passive = x;
+  std::vector<sfloat> y_passive = y;
+  std::vector<sfloat> z_passive = z;
+  op.RotateActive(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), n);
+  op.RotatePassive(x_passive.data(), y_passive.data(), z_passive.data(), x_passive.data(),
+                   y_passive.data(), z_passive.data(), n);
+  for (int i = 0; i < n; ++i) {
+    Vec3 v(std::sin(0.3 * i), std::cos(0.7 * i), 0.1 * i - 1);
+    Vec3 v_active = q.RotateActive(v);
+    Vec3 v_passive = q.RotatePassive(v);
+    EXPECT_NEAR(x[i], v_active.x, kTol);
+    EXPECT_NEAR(y[i], v_active.y, kTol);
+    EXPECT_NEAR(z[i], v_active.z, kTol);
+    EXPECT_NEAR(x_passive[i], v_passive.x, kTol);
+    EXPECT_NEAR(y_passive[i], v_passive.y, kTol);
+    EXPECT_NEAR(z_passive[i], v_passive.z, kTol);
+  }
+}
+
+TEST(RotationOperator, Single) {
+  Quaternion q = TestQuaternion();
+  RotationOperator op(q);
+  Vec3 v(0.4, -1.5, 2.0);
+  Vec3 v_active = op.RotateActive(v);
+  Vec3 v_passive = op.RotatePassive(v);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NEAR(v_active[i], q.RotateActive(v)[i], kTol);
+    EXPECT_NEAR(v_passive[i], q.RotatePassive(v)[i], kTol);
+  }
+}
+
+TEST(RotationOperator, Batch) {
+  Quaternion q = TestQuaternion();
+  RotationOperator op(q);
+  for (int n : {0, 1, 3, 8, 65}) {
+    CheckBatch(op, q, n);
+  }
+}
+
+TEST(RotationOperator, FromRotMat) {
+  Quaternion q = TestQuaternion();
+  RotationOperator op_active(RotMat<Active>::FromQuaternion(q.w, q.x, q.y, q.z));
+  RotationOperator op_passive(RotMat<Passive>::FromQuaternion(q.w, q.x, q.y, q.z));
+  CheckBatch(op_active, q, 2);
+  CheckBatch(op_passive, q, 2);
+  CheckBatch(op_passive, q, 20);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_NEAR(op_passive.Matrix()[i], op_active.Matrix()[i], kTol);
+  }
+}
@@ -3,9 +3,16 @@
 // Copyright (c) 2023. All rights reserved.
 //
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
+#include "star/Quaternion.hpp"
 #include "star/RotMat.hpp"
+#include "star/Transpose.hpp"
+#include "star/matrix_multiplication.hpp"
 
 using namespace star;
 
@@ -22,6 +29,15 @@ TEST(RotMat, DefaultConstructor) {
   EXPECT_FLOAT_EQ(R[8], 1);
 }
 
+TEST(RotMat, Constexpr) {
+  // A mounting rotation baked in at compile time
+  constexpr auto R = RotMat<Active>::ByRows(0, -1, 0, 1, 0, 0, 0, 0, 1);
+  constexpr RotMat<Active> R_T = R.Transpose();
+  constexpr Mat3 I = R * R_T;
+  static_assert(I[0] == 1 && I[1] == 0 && I[4] == 1 && I[8] == 1);
+  static_assert(RotMat<Passive>()[8] == 1);
+}
+
 TEST(RotMat, RotX) {
   sfloat angle = 0.5;
   RotMat<Active> R = RotMat<Active>::RotX(angle);
@@ -54,4 +70,113 @@ TEST(RotMat, Transpose) {
   for (int i = 0; i < 9; i++) {
     EXPECT_FLOAT_EQ(R_T[i], A[i]);
   }
-}
\ No newline at end of file
+}
+TEST(RotMat, SenseConversion) {
+  RotMat<Active> R = RotMat<Active>::RotY(0.3);
+  RotMat<Passive> A(R);
+  RotMat<Passive> A_expected = RotMat<Passive>::RotY(0.3);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(A[i], A_expected[i]);
+  }
+  RotMat<Active> R2(A);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(R2[i], R[i]);
+  }
+}
+
+TEST(RotMat, Inverse) {
+  RotMat<Passive> A = RotMat<Passive>::FromAxisAngle(0.7, Vec3(0.6, 0, 0.8));
+  RotMat<Passive> A_inv = A.Inverse();
+  Mat3 I = A * A_inv;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(I(i, j), i == j ? 1 : 0, 1e-6);
+    }
+  }
+  A_inv.InverseInPlace();
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(A_inv[i], A[i]);
+  }
+}
+
+TEST(RotMat, Compose) {
+  RotMat<Active> Rx = RotMat<Active>::RotX(0.4);
+  RotMat<Active> Rz = RotMat<Active>::RotZ(-1.1);
+  static_assert(std::is_same_v<decltype(Rx * Rz), RotMat<Active>>);
+  RotMat<Active> R = Rx * Rz;
+  Mat3 R_expected = Mat3(Rx) * Mat3(Rz);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(R[i], R_expected[i]);
+  }
+
+  // The passive operand is converted to an active rotation
+  RotMat<Passive> Az = RotMat<Passive>::RotZ(-1.1);
+  static_assert(std::is_same_v<decltype(Rx * Az), RotMat<Active>>);
+  static_assert(std::is_same_v<decltype(Az * Rx), RotMat<Passive>>);
+  RotMat<Active> R_mixed = Rx * Az;
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(R_mixed[i], R[i]);
+  }
+  RotMat<Passive> A_mixed = Az * Rx;
+  RotMat<Passive> A_expected = Az * RotMat<Passive>::RotX(0.4);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_FLOAT_EQ(A_mixed[i], A_expected[i]);
+  }
+}
+
+TEST(RotMat, FromAxisAngle) {
+  sfloat angle = 0.8;
+  RotMat<Active> Rx = RotMat<Active>::FromAxisAngle(angle, 1, 0, 0);
+  RotMat<Active> Rx_expected = RotMat<Active>::RotX(angle);
+  RotMat<Passive> Ay = RotMat<Passive>::FromAxisAngle(angle, Vec3(0, 1, 0));
+  RotMat<Passive> Ay_expected = RotMat<Passive>::RotY(angle);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(Rx[i], Rx_expected[i], 1e-6);
+    EXPECT_NEAR(Ay[i], Ay_expected[i], 1e-6);
+  }
+
+  // The axis is invariant and other vectors rotate by the angle
+  Vec3 axis(2.0 / 3, -1.0 / 3, 2.0 / 3);
+  RotMat<Active> R = RotMat<Active>::FromAxisAngle(angle, axis);
+  Vec3 axis_rot = R * axis;
+  EXPECT_NEAR(Vec3(axis_rot - axis).Norm(), 0, 1e-6);
+  Vec3 v = axis.Cross(Vec3(1, 0, 0));
+  EXPECT_NEAR(v.Dot(R * v) / v.Dot(v), cos(angle), 1e-6);
+}
+
+TEST(RotMat, FromQuaternion) {
+  Quaternion q = Quaternion(0.9, 0.1, -0.3, 0.2).Normalize();
+  Vec3 v(0.5, -1.2, 2.0);
+  RotMat<Active> R = RotMat<Active>::FromQuaternion(q.w, q.x, q.y, q.z);
+  RotMat<Passive> A = RotMat<Passive>::FromQuaternion(q.w, q.x, q.y, q.z);
+  Vec3 v_active = R * v;
+  Vec3 v_passive = A * v;
+  Vec3 v_active_expected = q.RotateActive(v);
+  Vec3 v_passive_expected = q.RotatePassive(v);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(v_active[i], v_active_expected[i], 1e-6);
+    EXPECT_NEAR(v_passive[i], v_passive_expected[i], 1e-6);
+  }
+}
+
+TEST(RotMat, Orthonormalize) {
+  // Accumulate round-off over a long composition of slightly perturbed rotations
+  RotMat<Active> dR = RotMat<Active>::FromAxisAngle(1e-3, 0, 0.6, 0.8);
+  dR[1] += 1e-6;
+  RotMat<Active> R;
+  for (int i = 0; i < 1000; i++) {
+    R = R * dR;
+  }
+  Mat3 RtR = Transpose(R) * R;
+  EXPECT_GT(std::abs(RtR[1]), 1e-4);
+
+  R.Orthonormalize();
+  const double tol = 1e-7 + 10 * std::numeric_limits<sfloat>::epsilon();
+  RtR = Transpose(R) * R;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(RtR(i, j), i == j ? 1 : 0, tol);
+    }
+  }
+  EXPECT_NEAR(R.Determinant(), 1, tol);
+}
@@ -0,0 +1,63 @@
+//
+// Created by Brian Jackson on 5/23/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "star/Matrix.hpp"
+#include "star/Quaternion.hpp"
+#include "star/typedefs.h"
+
+namespace star::test {
+
+// Step of the central differences, which balances truncation and rounding errors
+inline const sfloat kStep = std::cbrt(std::numeric_limits<sfloat>::epsilon());
+
+/*
+ * Central-difference Jacobian of y = f(x), where x and y are vectors or matrices such as
+ * Vec3 or Matrix<6, 1>. The result has a row for every element of y, in column-major order.
+ */
+template <class Function, class X>
+auto NumericalJacobian(Function f, const X& x) {
+  using Y = decltype(f(x));
+  Matrix<Y::kSize, X::kSize> J;
+  for (int j = 0; j < X::kSize; ++j) {
+    X x_plus = x;
+    X x_minus = x;
+    x_plus[j] += kStep;
+    x_minus[j] -= kStep;
+    const Y y_plus = f(x_plus);
+    const Y y_minus = f(x_minus);
+    for (int i = 0; i < Y::kSize; ++i) {
+      J(i, j) = (y_plus[i] - y_minus[i]) / (2 * kStep);
+    }
+  }
+  return J;
+}
+
+// A generic unit quaternion, away from the identity and the half turn
+inline Quaternion TestQuaternion() { return Quaternion(0.9, -0.2, 0.3, 0.1).Normalize(); }
+
+// Compares two vectors or matrices element by element, relative to the magnitude of B
+template <class Mat>
+void ExpectNear(const Mat& A, const Mat& B, sfloat tol) {
+  for (int k = 0; k < Mat::kSize; ++k) {
+    EXPECT_NEAR(A[k], B[k], tol * (1 + std::abs(B[k]))) << "at element " << k;
+  }
+}
+
+// Compares the output of a batch kernel, stored contiguously, with a single result
+template <class Mat>
+void ExpectNear(const sfloat* a, const Mat& B, sfloat tol) {
+  for (int k = 0; k < Mat::kSize; ++k) {
+    EXPECT_NEAR(a[k], B[k], tol * (1 + std::abs(B[k]))) << "at element " << k;
+  }
+}
+
+}  // namespace star::test
@@ -134,6 +134,20 @@ TEST(Vector3, DotProduct) {
   EXPECT_NEAR(dot, 3 + 8 + 15, EPS);
 }
 
+TEST(Vector3, Constexpr) {
+  constexpr Vec3 x = Vec3::XAxis();
+  constexpr Vec3 z = x.Cross(Vec3::YAxis());
+  static_assert(z.x == 0 && z.y == 0 && z.z == 1);
+  static_assert(Vec3(1, 2, 3).Dot(Vec3::Const(2)) == 12);
+  static_assert(Vec4(1, 2, 3, 4).Dot(Vec4::Const(1)) == 10);
+
+  const Vec3 a = {0.3, -1.2, 2.5};
+  const Vec3 b = {1.7, 0.4, -0.9};
+  Vec3 c = a.Cross(b);
+  EXPECT_NEAR(c.Dot(a), 0, EPS);
+  EXPECT_NEAR(c.Dot(b), 0, EPS);
+}
+
 TEST(Vector3, Add) {
   const Vec3 x = {3, 4, 5};
   const Vec3 y = {-1, 2, 3};
@@ -267,6 +281,19 @@ TEST(Vector3, BinaryMap) {
   EXPECT_NEAR(z[2], 0, EPS);
 }
 
+TEST(Vector4, Maps) {
+  const Vec4 x = {4, 9, 16, 25};
+  Vec4 y = x.UnaryMap(std::sqrt);
+  EXPECT_NEAR(y[0], 2, EPS);
+  EXPECT_NEAR(y[3], 5, EPS);
+
+  Vec4 z = x.BinaryMap(y, foo);
+  EXPECT_NEAR(z[0], 6, EPS);
+  EXPECT_NEAR(z[1], 15, EPS);
+  EXPECT_NEAR(z[2], 28, EPS);
+  EXPECT_NEAR(z[3], 45, EPS);
+}
+
 class MRP : public Vec3 {
  public:
   using Vec3::Vec3;
@@ -0,0 +1,215 @@
+//
+// Created by Brian Jackson on 5/17/23.
+// Copyright (c) 2023. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "star/Mat4.hpp"
+#include "star/Mat43.hpp"
+#include "star/Quaternion.hpp"
+#include "star/QuaternionArray.hpp"
+#include "star/RotationOperator.hpp"
+#include "star/Workspace.hpp"
+
+using namespace star;
+
+/*
+ * Count every heap allocation made by the test executable by replacing the global
+ * allocation functions.
+ */
+static int allocation_count = 0;
+
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  ++allocation_count;
+  std::size_t a = static_cast<std::size_t>(alignment);
+  if (void* ptr = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+static bool IsAligned(const void* ptr) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % Workspace::kAlignment == 0;
+}
+
+// One control cycle of batch work using only workspace storage
+static sfloat ControlCycle(Workspace& ws, const Quaternion& q, int n) {
+  ws.Reset();
+
+  // Rotate a batch of vectors stored as separate x, y, z arrays
+  sfloat* x = ws.Allocate<sfloat>(n);
+  sfloat* y = ws.Allocate<sfloat>(n);
+  sfloat* z = ws.Allocate<sfloat>(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = i;
+    y[i] = 1;
+    z[i] = -i;
+  }
+  RotationOperator(q).RotateActive(x, y, z, x, y, z, n);
+
+  // Intermediate Jacobians
+  Mat43* G = ws.Allocate<Mat43>(n);
+  Mat4* L = ws.Allocate<Mat4>(n);
+  WorkspaceAllocator<Quaternion> allocator(ws);
+  std::vector<Quaternion, WorkspaceAllocator<Quaternion>> qs(allocator);
+  qs.reserve(n);
+  sfloat sum = 0;
+  for (int i = 0; i < n; ++i) {
+    qs.push_back(Quaternion::Expm(x[i] / n, y[i] / n, z[i] / n));
+    G[i] = qs[i].AttitudeJacobian();
+    L[i] = qs[i].L();
+    sum += G[i][0] + L[i][5];
+  }
+  return sum;
+}
+
+using WorkspaceQuaternionArray = BasicQuaternionArray<WorkspaceAllocator<sfloat>>;
+using WorkspaceVec3Array = BasicVec3Array<WorkspaceAllocator<sfloat>>;
+
+// One control cycle of bulk operations on blocked arrays drawing from the workspace
+static sfloat ArrayCycle(Workspace& ws, const Quaternion& q, int n) {
+  ws.Reset();
+
+  WorkspaceAllocator<sfloat> allocator(ws);
+  WorkspaceQuaternionArray q1(n, q, allocator);
+  WorkspaceQuaternionArray q2(n, Quaternion::Identity(), allocator);
+  WorkspaceVec3Array v(n, Vec3::Zero(), allocator);
+  for (int i = 0; i < n; ++i) {
+    q2.Set(i, Quaternion::Expm(0.01 * i, 0.02, -0.01 * i));
+    v.Set(i, Vec3(i, 1, -i));
+  }
+  WorkspaceQuaternionArray q12 = q1.Compose(q2);
+  WorkspaceVec3Array v_rot = q12.RotateActive(v);
+  q12.ComposeInPlace(q1);
+  q12.RotateActive(v_rot, v_rot);
+  sfloat sum = 0;
+  for (int i = 0; i < n; ++i) {
+    sum += v_rot.Get(i)[0] + q12.Get(i).w;
+  }
+  return sum;
+}
+
+TEST(Workspace, Allocate) {
+  Workspace ws(1000);
+  EXPECT_EQ(ws.Capacity(), 1024u);
+  EXPECT_EQ(ws.Used(), 0u);
+
+  sfloat* x = ws.Allocate<sfloat>(3);
+  Quaternion* q = ws.Allocate<Quaternion>(5);
+  EXPECT_TRUE(IsAligned(x));
+  EXPECT_TRUE(IsAligned(q));
+  const std::size_t a = Workspace::kAlignment;
+  EXPECT_EQ(ws.Used(), a + (5 * sizeof(Quaternion) + a - 1) / a * a);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(q[i].w, 1);
+    EXPECT_EQ(q[i].x, 0);
+  }
+
+  ws.Reset();
+  EXPECT_EQ(ws.Used(), 0u);
+  EXPECT_EQ(ws.Allocate<sfloat>(3), x);
+}
+
+TEST(Workspace, Overflow) {
+  Workspace ws(128);
+  sfloat* x = ws.Allocate<sfloat>(8);
+  sfloat* y = ws.Allocate<sfloat>(100);
+  EXPECT_TRUE(IsAligned(y));
+  for (int i = 0; i < 100; ++i) {
+    y[i] = i;
+  }
+  EXPECT_GT(ws.Used(), ws.Capacity());
+  (void)x;
+
+  // The buffer grows to fit the whole cycle
+  std::size_t used = ws.Used();
+  ws.Reset();
+  EXPECT_EQ(ws.Capacity(), used);
+  EXPECT_EQ(ws.Used(), 0u);
+}
+
+TEST(Workspace, NoAllocationsInSteadyState) {
+  const Quaternion q = Quaternion(0.9, 0.1, -0.2, 0.3).Normalize();
+  const int n = 50;
+
+  // The first cycle overflows an empty workspace, and the next reset grows it
+  Workspace ws;
+  int start = allocation_count;
+  sfloat expected = ControlCycle(ws, q, n);
+  ws.Reset();
+  EXPECT_GT(allocation_count, start);
+  EXPECT_GE(ws.Capacity(), 5 * n * sizeof(sfloat));
+
+  start = allocation_count;
+  for (int cycle = 0; cycle < 100; ++cycle) {
+    sfloat sum = ControlCycle(ws, q, n);
+    if (sum != expected) {
+      break;
+    }
+  }
+  int allocations = allocation_count - start;
+  EXPECT_EQ(allocations, 0);
+  EXPECT_EQ(ControlCycle(ws, q, n), expected);
+}
+
+TEST(Workspace, ArraysWithoutAllocationsInSteadyState) {
+  const Quaternion q = Quaternion(0.9, 0.1, -0.2, 0.3).Normalize();
+  const int n = 50;
+
+  // Arrays on the workspace match the ones on the heap
+  Workspace ws;
+  WorkspaceAllocator<sfloat> allocator(ws);
+  const QuaternionArray q_heap(n, q);
+  const WorkspaceQuaternionArray q_ws(n, q, allocator);
+  const QuaternionArray q12_heap = q_heap.Compose(q_heap);
+  const WorkspaceQuaternionArray q12_ws = q_ws.Compose(q_ws);
+  EXPECT_TRUE(IsAligned(q12_ws.data()));
+  EXPECT_EQ(q12_ws.GetAllocator().GetWorkspace(), &ws);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(q12_ws.Get(i).w, q12_heap.Get(i).w);
+  }
+
+  // The first cycle overflows the workspace, and the next reset grows it
+  sfloat expected = ArrayCycle(ws, q, n);
+  ws.Reset();
+
+  int start = allocation_count;
+  for (int cycle = 0; cycle < 100; ++cycle) {
+    sfloat sum = ArrayCycle(ws, q, n);
+    if (sum != expected) {
+      break;
+    }
+  }
+  int allocations = allocation_count - start;
+  EXPECT_EQ(allocations, 0);
+  EXPECT_EQ(ArrayCycle(ws, q, n), expected);
+}